@@ -0,0 +1,78 @@
+#! /bin/sh
+
+# Split a problem into cubes and solve them with several csolve
+# processes, collecting the solutions of all cubes.
+#
+# usage: cube-and-conquer.sh <cubes> <jobs> <file> [<options>]
+#
+# The csolve binary can be set with the CSOLVE environment variable,
+# options are passed to all csolve processes.
+
+if [ $# -lt 3 ]; then
+    echo "usage: $0 <cubes> <jobs> <file> [<options>]" >&2
+    exit 1
+fi
+
+CUBES=$1
+JOBS=$2
+FILE=$3
+shift 3
+
+CSOLVE=${CSOLVE:-csolve}
+DIR=`mktemp -d`
+trap 'rm -rf "$DIR"' EXIT
+
+# write one cube per file
+"$CSOLVE" "$@" --cubes "$CUBES" "$FILE" > "$DIR/cubes" || exit 1
+if grep -q "^NO SOLUTION FOUND" "$DIR/cubes"; then
+    echo "NO SOLUTION FOUND"
+    exit 0
+fi
+grep "^CUBE:" "$DIR/cubes" | split -l 1 - "$DIR/cube."
+
+# find out what kind of solution to look for
+OBJECTIVE=`sed -n 's/^[[:space:]]*\(ANY\|ALL\|MIN\|MAX\)\b.*/\1/p' "$FILE" | head -n 1`
+
+# solve a single cube, stopping all workers once a solution is found
+# when looking for any solution
+cat > "$DIR/job.sh" <<'END'
+CUBE=$1
+shift
+[ -e "$DIR/found" ] && exit 0
+"$CSOLVE" "$@" --cube "$CUBE" "$FILE" > "$CUBE.out" &
+echo $! > "$CUBE.pid"
+wait $! 2>/dev/null
+rm -f "$CUBE.pid"
+if [ "$OBJECTIVE" = "ANY" ] && grep -q "SOLUTION: " "$CUBE.out"; then
+    touch "$DIR/found"
+    cat "$DIR"/*.pid 2>/dev/null | xargs -r kill 2>/dev/null
+fi
+exit 0
+END
+
+# solve the cubes, handing them out to the workers through a pipe
+export CSOLVE FILE DIR OBJECTIVE
+ls "$DIR"/cube.* | xargs -P "$JOBS" -I '{}' sh "$DIR/job.sh" '{}' "$@"
+
+# collect the solutions, keeping only the best one when optimizing
+cat "$DIR"/cube.*.out 2>/dev/null | grep "SOLUTION: " | sed 's/^#[0-9]*: //' | \
+    awk -v objective="$OBJECTIVE" '
+        {
+            best = $NF
+            if (objective == "ALL") {
+                print
+            } else if (count == 0 ||
+                       (objective == "MIN" && best < value) ||
+                       (objective == "MAX" && best > value)) {
+                line = $0
+                value = best
+            }
+            count++
+        }
+        END {
+            if (count == 0) {
+                print "NO SOLUTION FOUND"
+            } else if (objective != "ALL") {
+                print line
+            }
+        }'
@@ -83,3 +83,15 @@ domain_t min(const domain_t a, const domain_t b) {
 domain_t max(const domain_t a, const domain_t b) {
   return a > b ? a : b;
 }
+
+// divide and round towards negative infinity
+ddomain_t div_floor(const ddomain_t a, const ddomain_t b) {
+  ddomain_t q = a / b;
+  return (a % b != 0 && (a < 0) != (b < 0)) ? q - 1 : q;
+}
+
+// divide and round towards positive infinity
+ddomain_t div_ceil(const ddomain_t a, const ddomain_t b) {
+  ddomain_t q = a / b;
+  return (a % b != 0 && (a < 0) == (b < 0)) ? q + 1 : q;
+}
@@ -0,0 +1,271 @@
+/* Copyright 2018-2019 Wolfgang Puffitsch
+
+This file is part of CSolve.
+
+CSolve is free software: you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation, either version 3 of the License, or (at your
+option) any later version.
+
+CSolve is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received a copy of the GNU General Public License
+along with CSolve.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "csolve.h"
+
+#include <errno.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/** Entry in the table of already cloned constraints */
+struct clone_entry_t {
+  const struct constr_t *key; ///< Original constraint
+  struct constr_t *val; ///< Cloned constraint
+};
+
+/** Table of already cloned constraints */
+struct clone_map_t {
+  size_t size; ///< Number of slots, always a power of two
+  size_t length; ///< Number of used slots
+  struct clone_entry_t *elems; ///< Slots
+};
+
+// initial number of slots in table of cloned constraints
+#define CLONE_MAP_SIZE_INIT 1024
+
+// compute a constraint hash
+static size_t clone_hash(const struct constr_t *constr) {
+  return (uintptr_t)constr / sizeof(struct constr_t);
+}
+
+// initialize table of cloned constraints
+static void clone_map_init(struct clone_map_t *map, size_t size) {
+  map->size = size;
+  map->length = 0;
+  map->elems = (struct clone_entry_t *)calloc(size, sizeof(struct clone_entry_t));
+  // die if allocation failed
+  if (map->elems == NULL) {
+    print_fatal("%s", strerror(errno));
+  }
+}
+
+// release memory for table of cloned constraints
+static void clone_map_free(struct clone_map_t *map) {
+  free(map->elems);
+  map->elems = NULL;
+  map->size = 0;
+  map->length = 0;
+}
+
+// find slot of a constraint in table of cloned constraints
+static struct clone_entry_t *clone_map_slot(struct clone_map_t *map, const struct constr_t *key) {
+  size_t mask = map->size - 1;
+  size_t i = clone_hash(key) & mask;
+  // linear probing until the key or an empty slot is found
+  while (map->elems[i].key != NULL && map->elems[i].key != key) {
+    i = (i + 1) & mask;
+  }
+  return &map->elems[i];
+}
+
+// find clone of a constraint, NULL if not cloned yet
+static struct constr_t *clone_map_find(struct clone_map_t *map, const struct constr_t *key) {
+  return clone_map_slot(map, key)->val;
+}
+
+// add clone of a constraint to table of cloned constraints
+static void clone_map_add(struct clone_map_t *map, const struct constr_t *key, struct constr_t *val) {
+  // grow table if it becomes half full
+  if (2 * (map->length + 1) > map->size) {
+    struct clone_map_t m;
+    clone_map_init(&m, 2 * map->size);
+    for (size_t i = 0; i < map->size; i++) {
+      if (map->elems[i].key != NULL) {
+        *clone_map_slot(&m, map->elems[i].key) = map->elems[i];
+        m.length++;
+      }
+    }
+    clone_map_free(map);
+    *map = m;
+  }
+
+  struct clone_entry_t *e = clone_map_slot(map, key);
+  e->key = key;
+  e->val = val;
+  map->length++;
+}
+
+// forward declaration
+static struct constr_t *clone_constr(struct clone_map_t *map, struct solver_t *dst, const struct solver_t *src,
+                                     const struct constr_t *constr);
+
+// clone wide-and expression
+static void clone_wand(struct clone_map_t *map, struct solver_t *dst, const struct solver_t *src,
+                       struct constr_t *c, const struct constr_t *constr) {
+  size_t length = constr->constr.wand.length;
+  struct wand_expr_t *elems = (struct wand_expr_t *)alloc(length * sizeof(struct wand_expr_t));
+  for (size_t i = 0; i < length; i++) {
+    // current (normalized) sub-expression becomes the original one of
+    // the clone, compiled clauses refer to variables by index and are
+    // shared with the clone
+    const struct wand_expr_t *elem = &constr->constr.wand.elems[i];
+    struct constr_t *e = clone_constr(map, dst, src, elem->constr);
+    elems[i] = (struct wand_expr_t){ .constr = e, .orig = e, .prop_tag = 0, .code = elem->code };
+  }
+  *c = CONSTRAINT_WAND(length, elems);
+}
+
+// clone conflict expression
+static void clone_confl(struct clone_map_t *map, struct solver_t *dst, const struct solver_t *src,
+                        struct constr_t *c, const struct constr_t *constr) {
+  size_t length = constr->constr.confl.length;
+  struct confl_elem_t *elems = (struct confl_elem_t *)alloc(length * sizeof(struct confl_elem_t));
+  for (size_t i = 0; i < length; i++) {
+    struct confl_elem_t *e = &constr->constr.confl.elems[i];
+    elems[i] = (struct confl_elem_t){ .val = e->val, .var = clone_constr(map, dst, src, e->var) };
+  }
+  *c = CONSTRAINT_CONFL(length, elems);
+}
+
+// clone linear expression
+static void clone_lin(struct clone_map_t *map, struct solver_t *dst, const struct solver_t *src,
+                      struct constr_t *c, const struct constr_t *constr) {
+  size_t length = constr->constr.lin.length;
+  struct lin_term_t *terms = (struct lin_term_t *)alloc(length * sizeof(struct lin_term_t));
+  for (size_t i = 0; i < length; i++) {
+    struct lin_term_t *t = &constr->constr.lin.terms[i];
+    terms[i] = (struct lin_term_t){ .coef = t->coef, .var = clone_constr(map, dst, src, t->var) };
+  }
+  *c = CONSTRAINT_LIN(length, terms);
+}
+
+// clone difference expression
+static void clone_diff(struct clone_map_t *map, struct solver_t *dst, const struct solver_t *src,
+                       struct constr_t *c, const struct constr_t *constr) {
+  const struct diff_t *d = &constr->constr.diff;
+  *c = CONSTRAINT_DIFF(clone_constr(map, dst, src, d->l), clone_constr(map, dst, src, d->r), d->c);
+}
+
+// clone all-different expression
+static void clone_alldiff(struct clone_map_t *map, struct solver_t *dst, const struct solver_t *src,
+                          struct constr_t *c, const struct constr_t *constr) {
+  size_t length = constr->constr.alldiff.length;
+  struct constr_t **elems = (struct constr_t **)alloc(length * sizeof(struct constr_t *));
+  for (size_t i = 0; i < length; i++) {
+    elems[i] = clone_constr(map, dst, src, constr->constr.alldiff.elems[i]);
+  }
+  *c = CONSTRAINT_ALLDIFF(length, elems);
+}
+
+// clone optional sub-expression of scheduling expression
+static struct constr_t *clone_sched_opt(struct clone_map_t *map, struct solver_t *dst, const struct solver_t *src,
+                                        const struct constr_t *constr) {
+  return constr != NULL ? clone_constr(map, dst, src, constr) : NULL;
+}
+
+// clone scheduling expression
+static void clone_sched(struct clone_map_t *map, struct solver_t *dst, const struct solver_t *src,
+                        struct constr_t *c, const struct constr_t *constr) {
+  size_t length = constr->constr.sched.length;
+  struct sched_task_t *tasks = (struct sched_task_t *)alloc(length * sizeof(struct sched_task_t));
+  for (size_t i = 0; i < length; i++) {
+    const struct sched_task_t *t = &constr->constr.sched.tasks[i];
+    tasks[i] = (struct sched_task_t){ .start = clone_constr(map, dst, src, t->start),
+                                .dur = clone_constr(map, dst, src, t->dur),
+                                .demand = clone_sched_opt(map, dst, src, t->demand) };
+  }
+  struct constr_t *cap = clone_sched_opt(map, dst, src, constr->constr.sched.cap);
+  *c = (struct constr_t){ .type = constr->type, .constr = { .sched = { .length = length, .tasks = tasks, .cap = cap } } };
+}
+
+// clone a constraint
+static struct constr_t *clone_constr(struct clone_map_t *map, struct solver_t *dst, const struct solver_t *src,
+                                     const struct constr_t *constr) {
+  // variables are cloned together with the environment
+  if (IS_TYPE(TERM, constr) && constr->constr.term.env != NULL) {
+    return dst->env[constr->constr.term.env - src->env].val;
+  }
+
+  // reuse clone of already seen constraints
+  struct constr_t *c = clone_map_find(map, constr);
+  if (c != NULL) {
+    return c;
+  }
+
+  c = (struct constr_t *)alloc(sizeof(struct constr_t));
+  if (IS_TYPE(TERM, constr)) {
+    *c = *constr;
+  } else if (IS_TYPE(WAND, constr)) {
+    clone_wand(map, dst, src, c, constr);
+  } else if (IS_TYPE(CONFL, constr)) {
+    clone_confl(map, dst, src, c, constr);
+  } else if (IS_TYPE(LIN, constr)) {
+    clone_lin(map, dst, src, c, constr);
+  } else if (IS_TYPE(DIFF, constr)) {
+    clone_diff(map, dst, src, c, constr);
+  } else if (IS_TYPE(ALLDIFF, constr)) {
+    clone_alldiff(map, dst, src, c, constr);
+  } else if (IS_TYPE(DISJ, constr) || IS_TYPE(CUMUL, constr)) {
+    clone_sched(map, dst, src, c, constr);
+  } else {
+    struct constr_t *l = clone_constr(map, dst, src, constr->constr.expr.l);
+    struct constr_t *r = constr->constr.expr.r != NULL
+      ? clone_constr(map, dst, src, constr->constr.expr.r) : NULL;
+    *c = (struct constr_t){ .type = constr->type, .constr = { .expr = { .l = l, .r = r } } };
+  }
+
+  clone_map_add(map, constr, c);
+  return c;
+}
+
+// clone the variable environment
+static void clone_env(struct solver_t *dst, const struct solver_t *src, struct constr_t *obj) {
+  dst->env = (struct env_t *)alloc(src->size * sizeof(struct env_t));
+  dst->obj = NULL;
+
+  for (size_t i = 0; i < src->size; i++) {
+    const struct env_t *e = &src->env[i];
+
+    // use the designated objective value variable if requested
+    struct constr_t *val;
+    if (e->val == src->obj && obj != NULL) {
+      val = obj;
+    } else {
+      val = (struct constr_t *)alloc(sizeof(struct constr_t));
+    }
+    *val = CONSTRAINT_TERM(e->val->constr.term.val);
+    val->constr.term.env = &dst->env[i];
+    if (e->val == src->obj) {
+      dst->obj = val;
+    }
+
+    dst->env[i] = (struct env_t){ .key = e->key,
+                                  .val = val,
+                                  .binds = NULL,
+                                  .clauses = { .length = 0, .elems = NULL, .events = NULL, .dead = 0 },
+                                  .watches = { .length = 0, .elems = NULL, .events = NULL, .dead = 0 },
+                                  .order = SIZE_MAX,
+                                  .prio = e->prio,
+                                  .level = SIZE_MAX,
+                                  .prop_tag = 0,
+                                  .prop_events = 0 };
+  }
+}
+
+// clone the model of a solver context
+void solver_clone(struct solver_t *dst, const struct solver_t *src, struct constr_t *obj) {
+  dst->size = src->size;
+  clone_env(dst, src, obj);
+
+  struct clone_map_t map;
+  clone_map_init(&map, CLONE_MAP_SIZE_INIT);
+  dst->constr = clone_constr(&map, dst, src, src->constr);
+  clone_map_free(&map);
+}
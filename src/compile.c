@@ -0,0 +1,378 @@
+/* Copyright 2018-2019 Wolfgang Puffitsch
+
+This file is part of CSolve.
+
+CSolve is free software: you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation, either version 3 of the License, or (at your
+option) any later version.
+
+CSolve is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received a copy of the GNU General Public License
+along with CSolve.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "csolve.h"
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// return if propagation resulted in an error
+#define CHECK(VAR)                              \
+  if ((VAR) == PROP_ERROR) {                    \
+    return PROP_ERROR;                          \
+  }
+
+// minimum number of instructions of a compiled clause, smaller
+// clauses propagate faster as trees
+#define COMPILE_LENGTH_MIN 12
+
+// variable environment that compiled clauses refer to
+static THREAD_LOCAL struct env_t *_compile_env;
+
+// value of an instruction and the value propagated to it
+struct code_slot_t {
+  struct val_t val;    // value of the instruction
+  struct val_t target; // value propagated to the instruction
+  bool set;            // whether a value is propagated to the instruction
+};
+
+// slots of instructions while evaluating compiled clauses
+static THREAD_LOCAL struct code_slot_t *_code_slots;
+// number of slots that fit into the buffer
+static THREAD_LOCAL size_t _code_slots_size;
+
+// set the variable environment compiled clauses refer to
+void compile_init(struct env_t *env) {
+  _compile_env = env;
+}
+
+// release the buffer for evaluating compiled clauses
+void compile_free(void) {
+  free(_code_slots);
+  _code_slots = NULL;
+  _code_slots_size = 0;
+}
+
+// return the number of instructions of a constraint, 0 if it cannot be compiled
+static size_t compile_length(const struct constr_t *constr) {
+  if (IS_TYPE(TERM, constr)) {
+    // constants must not change when propagating to them
+    return constr->constr.term.env != NULL || is_value(constr->constr.term.val) ? 1 : 0;
+  }
+
+  switch (constr->type->op) {
+  case OP_EQ:
+  case OP_LT:
+  case OP_ADD:
+  case OP_MUL:
+  case OP_AND:
+  case OP_OR: {
+    size_t l = compile_length(constr->constr.expr.l);
+    size_t r = compile_length(constr->constr.expr.r);
+    return l > 0 && r > 0 ? l + r + 1 : 0;
+  }
+  case OP_NEG:
+  case OP_NOT: {
+    size_t l = compile_length(constr->constr.expr.l);
+    return l > 0 ? l + 1 : 0;
+  }
+  default:
+    // wide-and and conflict expressions are not compiled
+    return 0;
+  }
+}
+
+// return the opcode for an expression
+static enum opcode_t compile_opcode(const struct constr_t *constr) {
+  switch (constr->type->op) {
+  case OP_EQ:  return OPC_EQ;
+  case OP_LT:  return OPC_LT;
+  case OP_NEG: return OPC_NEG;
+  case OP_ADD: return OPC_ADD;
+  case OP_MUL: return OPC_MUL;
+  case OP_NOT: return OPC_NOT;
+  case OP_AND: return OPC_AND;
+  case OP_OR:  return OPC_OR;
+  default:
+    // die if encountering an unknown operation
+    print_fatal(ERROR_MSG_INVALID_OPERATION, constr->type->op);
+  }
+  return OPC_CONST;
+}
+
+// emit instructions for a constraint in post-order, return the position after them
+static size_t compile_emit(const struct constr_t *constr, struct instr_t *instrs, size_t pos) {
+  if (IS_TYPE(TERM, constr)) {
+    struct env_t *var = constr->constr.term.env;
+    instrs[pos] = var != NULL
+      ? (struct instr_t){ .op = OPC_VAR, .size = 1, .arg = { .var = (size_t)(var - _compile_env) } }
+      : (struct instr_t){ .op = OPC_CONST, .size = 1, .arg = { .val = constr->constr.term.val } };
+    return pos + 1;
+  }
+
+  size_t start = pos;
+  pos = compile_emit(constr->constr.expr.l, instrs, pos);
+  size_t left = pos - 1;
+  if (constr->constr.expr.r != NULL) {
+    pos = compile_emit(constr->constr.expr.r, instrs, pos);
+  }
+  instrs[pos] = (struct instr_t){ .op = compile_opcode(constr), .size = pos + 1 - start, .arg = { .left = left } };
+  return pos + 1;
+}
+
+// compile a constraint
+struct code_t *compile(const struct constr_t *constr) {
+  size_t length = compile_length(constr);
+  if (length < COMPILE_LENGTH_MIN) {
+    return NULL;
+  }
+
+  struct code_t *code = (struct code_t *)alloc(sizeof(struct code_t));
+  code->length = length;
+  code->instrs = (struct instr_t *)alloc(length * sizeof(struct instr_t));
+  compile_emit(constr, code->instrs, 0);
+  return code;
+}
+
+// compile the clauses of a model
+void compile_clauses(struct constr_t *constr) {
+  if (!IS_TYPE(WAND, constr)) {
+    return;
+  }
+
+  for (size_t i = 0, l = constr->constr.wand.length; i < l; i++) {
+    struct wand_expr_t *elem = &constr->constr.wand.elems[i];
+    if (IS_TYPE(WAND, elem->constr)) {
+      compile_clauses(elem->constr);
+    } else {
+      elem->code = compile(elem->constr);
+    }
+  }
+}
+
+// make room to evaluate a compiled clause
+static struct code_slot_t *code_reserve(const struct code_t *code) {
+  if (code->length > _code_slots_size) {
+    free(_code_slots);
+    _code_slots = (struct code_slot_t *)malloc(code->length * sizeof(struct code_slot_t));
+    // die if allocation failed
+    if (_code_slots == NULL) {
+      print_fatal("%s", strerror(errno));
+    }
+    _code_slots_size = code->length;
+  }
+  return _code_slots;
+}
+
+// evaluate all instructions of a compiled clause in a single forward pass
+static struct val_t code_forward(const struct code_t *code, struct code_slot_t *slots) {
+  const struct instr_t *instrs = code->instrs;
+  struct val_t val = VALUE(0);
+
+  // operands always precede the instructions that use them, the right
+  // operand directly precedes its instruction
+  for (size_t i = 0, n = code->length; i < n; i++) {
+    const struct instr_t *instr = &instrs[i];
+    switch (instr->op) {
+    case OPC_CONST: val = instr->arg.val; break;
+    case OPC_VAR:   val = _compile_env[instr->arg.var].val->constr.term.val; break;
+    case OPC_EQ:    val = eval_eq_vals(slots[instr->arg.left].val, val); break;
+    case OPC_LT:    val = eval_lt_vals(slots[instr->arg.left].val, val); break;
+    case OPC_NEG:   val = eval_neg_vals(val); break;
+    case OPC_ADD:   val = eval_add_vals(slots[instr->arg.left].val, val); break;
+    case OPC_MUL:   val = eval_mul_vals(slots[instr->arg.left].val, val); break;
+    case OPC_NOT:   val = eval_not_vals(val); break;
+    case OPC_AND:   val = eval_and_vals(slots[instr->arg.left].val, val); break;
+    case OPC_OR:    val = eval_or_vals(slots[instr->arg.left].val, val); break;
+    default:
+      // die if encountering an unknown opcode
+      print_fatal(ERROR_MSG_INVALID_OPERATION, instr->op);
+    }
+    slots[i].val = val;
+    slots[i].set = false;
+  }
+  return val;
+}
+
+// evaluate a compiled clause
+struct val_t code_eval(const struct code_t *code) {
+  return code_forward(code, code_reserve(code));
+}
+
+// propagate a value to an instruction
+static inline void code_target(struct code_slot_t *slots, size_t pos, struct val_t val) {
+  slots[pos].target = val;
+  slots[pos].set = true;
+}
+
+// propagate the value "false" to left or right side of equality instruction
+static void code_target_eq_false_lr(struct code_slot_t *slots, size_t p, struct val_t val) {
+  struct val_t pval = slots[p].val;
+
+  // restrict if value of other side hits an interval boundary
+  if (is_value(val) && get_lo(val) != DOMAIN_MIN && get_lo(val) != DOMAIN_MAX) {
+    if (get_lo(val) == get_lo(pval)) {
+      // restrict lower bound
+      code_target(slots, p, INTERVAL(get_lo(val) + 1, DOMAIN_MAX));
+    } else if (get_lo(val) == get_hi(pval)) {
+      // restrict upper bound
+      code_target(slots, p, INTERVAL(DOMAIN_MIN, get_lo(val) - 1));
+    }
+  }
+}
+
+// propagate to left side or right side of addition instruction
+static void code_target_add_lr(struct code_slot_t *slots, size_t p, size_t c, struct val_t val) {
+  struct val_t cval = slots[c].val;
+
+  // propagate value by subtracting value of "other" side from value to be propagated
+  domain_t lo = add(get_lo(val), neg(get_hi(cval)));
+  domain_t hi = add(get_hi(val), neg(get_lo(cval)));
+  code_target(slots, p, INTERVAL(lo, hi));
+}
+
+// propagate to left side or right side of multiplication instruction
+static prop_result_t code_target_mul_lr(struct code_slot_t *slots, size_t p, size_t c, struct val_t val) {
+  // divide value by the value of the "other" side
+  struct val_t q = eval_quot_vals(val, slots[c].val);
+  if (get_lo(q) > get_hi(q)) {
+    // return an error if no value yields the product
+    return PROP_ERROR;
+  }
+  // only propagate if restricting anything
+  if (get_lo(q) != DOMAIN_MIN || get_hi(q) != DOMAIN_MAX) {
+    code_target(slots, p, q);
+  }
+  return PROP_NONE;
+}
+
+// propagate value to logic instruction where only one operand is
+// needed to have the value
+static void code_target_logic_either(struct code_slot_t *slots, size_t l, size_t r, struct val_t val,
+                                     bool (*is_neutral)(struct val_t)) {
+  // if left is the neutral element, propagate value to the right
+  if (is_neutral(slots[l].val)) {
+    code_target(slots, r, val);
+  }
+  // if right is the neutral element, propagate value to the left
+  if (is_neutral(slots[r].val)) {
+    code_target(slots, l, val);
+  }
+}
+
+// propagate the value of an expression instruction to its operands
+static prop_result_t code_backward_expr(const struct instr_t *instr, size_t pos, struct code_slot_t *slots) {
+  struct val_t val = slots[pos].target;
+  size_t l = instr->arg.left;
+  size_t r = pos - 1;
+
+  switch (instr->op) {
+  case OPC_EQ:
+    if (is_true(val)) {
+      // propagate values of both sides to the respective other side
+      code_target(slots, r, slots[l].val);
+      code_target(slots, l, slots[r].val);
+    } else if (is_false(val)) {
+      code_target_eq_false_lr(slots, r, slots[l].val);
+      code_target_eq_false_lr(slots, l, slots[r].val);
+    }
+    break;
+  case OPC_LT:
+    if (is_true(val)) {
+      struct val_t lval = slots[l].val;
+      if (get_lo(lval) != DOMAIN_MIN && get_lo(lval) != DOMAIN_MAX) {
+        // restrict lower bound of right side
+        code_target(slots, r, INTERVAL(get_lo(lval) + 1, DOMAIN_MAX));
+      }
+      struct val_t rval = slots[r].val;
+      if (get_hi(rval) != DOMAIN_MIN && get_hi(rval) != DOMAIN_MAX) {
+        // restrict upper bound of left side
+        code_target(slots, l, INTERVAL(DOMAIN_MIN, get_hi(rval) - 1));
+      }
+    } else if (is_false(val)) {
+      code_target(slots, r, INTERVAL(DOMAIN_MIN, get_hi(slots[l].val)));
+      code_target(slots, l, INTERVAL(get_lo(slots[r].val), DOMAIN_MAX));
+    }
+    break;
+  case OPC_NEG:
+    // flip variable bounds for propagation
+    code_target(slots, l, INTERVAL(neg(get_hi(val)), neg(get_lo(val))));
+    break;
+  case OPC_ADD:
+    code_target_add_lr(slots, r, l, val);
+    code_target_add_lr(slots, l, r, val);
+    break;
+  case OPC_MUL:
+    CHECK(code_target_mul_lr(slots, r, l, val));
+    CHECK(code_target_mul_lr(slots, l, r, val));
+    break;
+  case OPC_NOT:
+    // flip true/false for propagation
+    if (is_true(val)) {
+      code_target(slots, l, VALUE(0));
+    } else if (is_false(val)) {
+      code_target(slots, l, VALUE(1));
+    }
+    break;
+  case OPC_AND:
+    if (is_true(val)) {
+      code_target(slots, r, val);
+      code_target(slots, l, val);
+    } else if (is_false(val)) {
+      code_target_logic_either(slots, l, r, val, is_true);
+    }
+    break;
+  case OPC_OR:
+    if (is_false(val)) {
+      code_target(slots, r, val);
+      code_target(slots, l, val);
+    } else if (is_true(val)) {
+      code_target_logic_either(slots, l, r, val, is_false);
+    }
+    break;
+  default:
+    // die if encountering an unknown opcode
+    print_fatal(ERROR_MSG_INVALID_OPERATION, instr->op);
+  }
+  return PROP_NONE;
+}
+
+// propagate value "true" to a compiled clause
+prop_result_t code_propagate(const struct code_t *code, const struct wand_expr_t *clause) {
+  struct code_slot_t *slots = code_reserve(code);
+  code_forward(code, slots);
+  code_target(slots, code->length - 1, VALUE(1));
+
+  // an instruction is only visited after the instruction that uses
+  // it, operands see the values from before propagation
+  const struct instr_t *instrs = code->instrs;
+  prop_result_t prop = PROP_NONE;
+  for (size_t i = code->length; i-- > 0; ) {
+    if (!slots[i].set) {
+      continue;
+    }
+
+    const struct instr_t *instr = &instrs[i];
+    struct val_t val = slots[i].target;
+    if (instr->op == OPC_VAR) {
+      prop_result_t p = propagate_term(_compile_env[instr->arg.var].val, val, clause);
+      CHECK(p);
+      prop += p;
+    } else if (instr->op == OPC_CONST) {
+      // constants can only conflict with the value
+      if (get_lo(instr->arg.val) > get_hi(val) || get_hi(instr->arg.val) < get_lo(val)) {
+        return PROP_ERROR;
+      }
+    } else {
+      CHECK(code_backward_expr(instr, i, slots));
+    }
+  }
+  return prop;
+}
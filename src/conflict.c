@@ -25,11 +25,32 @@ along with CSolve.  If not, see <http://www.gnu.org/licenses/>.
 #include <string.h>
 
 // the maximum assignment level in this conflict
-static size_t _conflict_max_level;
+static THREAD_LOCAL size_t _conflict_max_level;
 // the assignment level where the conflict should be resolved
-static size_t _conflict_level;
+static THREAD_LOCAL size_t _conflict_level;
 // the conflicting variable
-static struct env_t *_conflict_var;
+static THREAD_LOCAL struct env_t *_conflict_var;
+// whether the search should back-jump to resolve the conflict
+static THREAD_LOCAL bool _conflict_backjump;
+// the binding whose reason is being added to the conflict, which only
+// depends on earlier bindings; NULL for the clause that failed
+static THREAD_LOCAL const struct binding_t *_conflict_bind;
+// number of variables the conflict depends on at the current level
+// whose bindings have not been resolved yet
+static THREAD_LOCAL size_t _conflict_pending;
+// literal being removed when minimizing the conflict
+static THREAD_LOCAL const struct env_t *_conflict_removing;
+// levels of the conflict elements, modulo 64
+static THREAD_LOCAL uint64_t _conflict_levels;
+// maximum number of bindings to visit when checking whether a literal
+// can be removed from the conflict
+#define CONFLICT_MINIMIZE_BUDGET 256
+// number of bindings left to visit for the literal being removed
+static THREAD_LOCAL size_t _conflict_budget;
+// depth of the binding stack below which bindings at the root level
+// hold for every run, bindings at the root level above it only hold
+// for the current run and become conflict elements
+static THREAD_LOCAL size_t _conflict_root_depth = SIZE_MAX;
 
 // definition for return value of conflict-creating functions
 typedef bool confl_result_t;
@@ -44,27 +65,50 @@ typedef bool confl_result_t;
     return CONFL_ERROR;     \
   }
 
-// maximum length of array of already seen conflict elements
-#define SEEN_ARRAY_LENGTH_MAX 1024
-// type to hold already seen conflict elements
-struct seen_array_t {
-  size_t length;
-  void *elems[SEEN_ARRAY_LENGTH_MAX];
-};
+// epoch of creating the current conflict, constraints and variables
+// stamped with it have been seen already
+static THREAD_LOCAL uint64_t _seen_epoch = 1;
 
-// breadth of array of already seen conflict elements
-#define SEEN_ARRAY_WIDTH 64
-// array of already seen conflict elements
-static struct seen_array_t _seen[SEEN_ARRAY_WIDTH];
+// environment of worker to translate variables of shared conflicts
+static THREAD_LOCAL struct env_t *_share_env;
+// ID of worker when sharing conflicts
+static THREAD_LOCAL uint32_t _share_id;
+// number of shared conflicts processed by worker
+static THREAD_LOCAL uint64_t _share_tail;
 
 // conflict memory allocation alignment
 #define ALLOC_ALIGNMENT 8U
 // the conflict allocation stack
-static char *_alloc_stack;
+static THREAD_LOCAL char *_alloc_stack;
 // the total size of the conflict allocation stack
-static size_t _alloc_stack_size;
+static THREAD_LOCAL size_t _alloc_stack_size;
 // the current position in the conflict allocation stack
-static size_t _alloc_stack_pointer;
+static THREAD_LOCAL size_t _alloc_stack_pointer;
+
+/** Learned conflict in the conflict database */
+struct confl_db_entry_t {
+  struct constr_t *confl; ///< Conflict expression, at the start of the conflict memory
+  struct wand_expr_t *clause; ///< Clause list element of the conflict, at the end of the conflict memory
+  size_t size; ///< Size of the conflict memory
+  size_t lbd; ///< Number of different levels of the conflict elements when learning the conflict
+  uint32_t activity; ///< How often the conflict took part in creating other conflicts
+  bool locked; ///< Conflict is referred to from bindings and cannot be removed
+  bool removed; ///< Conflict is being removed
+  char *dest; ///< Where the conflict memory is being moved to
+};
+
+// maximum number of levels distinguished in conflicts
+#define CONFLICT_LBD_MAX 32
+// the learned conflicts, in the order they were allocated
+static THREAD_LOCAL struct confl_db_entry_t *_db;
+// the number of learned conflicts
+static THREAD_LOCAL size_t _db_length;
+// the capacity of the array of learned conflicts
+static THREAD_LOCAL size_t _db_size;
+// the first learned conflict that may be removed
+static THREAD_LOCAL size_t _db_floor;
+// the number of removable conflicts to keep before reducing
+static THREAD_LOCAL size_t _db_limit;
 
 // initialize the conflict allocation stack
 void conflict_alloc_init(size_t size) {
@@ -76,6 +120,10 @@ void conflict_alloc_init(size_t size) {
   if (_alloc_stack == 0) {
     print_fatal("%s", strerror(errno));
   }
+
+  _db_length = 0;
+  _db_floor = 0;
+  _db_limit = CONFLICT_DB_SIZE_INIT;
 }
 
 // free conflict allocation stack memory
@@ -83,6 +131,47 @@ void conflict_alloc_free(void) {
   free(_alloc_stack);
   _alloc_stack = NULL;
   _alloc_stack_size = 0;
+
+  free(_db);
+  _db = NULL;
+  _db_size = 0;
+  _db_length = 0;
+  _db_floor = 0;
+}
+
+// get the size of the conflict allocation stack
+size_t conflict_alloc_size(void) {
+  return _alloc_stack_size;
+}
+
+// get the current position in the conflict allocation stack
+size_t conflict_alloc_depth(void) {
+  return _alloc_stack_pointer;
+}
+
+// forward declaration
+static void conflict_db_unwatch(size_t from);
+
+// release all conflict memory allocated after a position
+void conflict_alloc_release(size_t depth) {
+  if (depth <= _alloc_stack_pointer) {
+    _alloc_stack_pointer = depth;
+    // forget the released conflicts and stop watching them
+    size_t length = _db_length;
+    while (length > 0 && (char *)_db[length-1].confl >= &_alloc_stack[depth]) {
+      _db[--length].removed = true;
+    }
+    if (length < _db_length) {
+      conflict_db_unwatch(length);
+      _db_length = length;
+    }
+    if (_db_floor > _db_length) {
+      _db_floor = _db_length;
+    }
+  } else {
+    // die if trying to release something that was not allocated
+    print_fatal(ERROR_MSG_WRONG_DEALLOC);
+  }
 }
 
 // allocate conflict memory of a certain size
@@ -114,8 +203,35 @@ static void conflict_dealloc(void *ptr) {
   }
 }
 
-// forward declaration
-static confl_result_t conflict_add_var(struct env_t *var, struct constr_t *confl);
+// find the learned conflict whose memory contains a pointer, NULL if
+// it does not point to a learned conflict
+static struct confl_db_entry_t *conflict_db_find(const void *ptr) {
+  size_t lo = 0;
+  size_t hi = _db_length;
+  while (lo < hi) {
+    size_t mid = lo + (hi - lo) / 2;
+    if ((uintptr_t)_db[mid].confl + _db[mid].size <= (uintptr_t)ptr) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  if (lo < _db_length && (uintptr_t)_db[lo].confl <= (uintptr_t)ptr) {
+    return &_db[lo];
+  }
+  return NULL;
+}
+
+// set the depth of the binding stack where the current run starts
+void conflict_root_init(size_t depth) {
+  _conflict_root_depth = depth;
+}
+
+// check whether a binding at a level holds for every run, which is the
+// case for original values and committed bindings at the root level
+static bool conflict_committed(const struct binding_t *b, size_t level) {
+  return b == NULL || (level == SIZE_MAX && (size_t)(b - bind_get(0)) < _conflict_root_depth);
+}
 
 // get the current conflict level
 size_t conflict_level(void) {
@@ -133,127 +249,251 @@ void conflict_reset(void) {
   _conflict_var = NULL;
 }
 
-// reset the information about seen conflict elements
+// forget about the seen constraints and variables by starting a new epoch
 static void conflict_seen_reset(void) {
-  for (size_t i = 0; i < SEEN_ARRAY_WIDTH; i++) {
-    _seen[i].length = 0;
+  _seen_epoch++;
+}
+
+// check whether a constraint already has been seen
+static bool conflict_seen(const struct constr_t *constr) {
+  return constr->seen_epoch == _seen_epoch;
+}
+
+// mark a constraint as seen
+static void conflict_seen_add(struct constr_t *constr) {
+  constr->seen_epoch = _seen_epoch;
+}
+
+// check whether a variable already has been seen
+static bool conflict_var_seen(const struct env_t *var) {
+  return var->seen_epoch == _seen_epoch;
+}
+
+// mark a variable as seen
+static void conflict_var_seen_add(struct env_t *var) {
+  var->seen_epoch = _seen_epoch;
+}
+
+// get the value a variable had before it was first bound
+static struct val_t conflict_term_root(const struct env_t *var, const struct val_t val) {
+  const struct binding_t *b = var != NULL ? var->binds : NULL;
+  if (b == NULL) {
+    return val;
+  }
+  while (b->prev != NULL) {
+    b = b->prev;
   }
+  return b->val;
 }
 
-// calculate hash for a conflict element
-static uint32_t conflict_seen_hash(void *elem) {
-  return (intptr_t)elem / max(sizeof(struct confl_elem_t) + sizeof(size_t),
-                              sizeof(struct env_t));
+// compute the literal a terminal contributes to the conflict, i.e.,
+// the bounds of its current value; bounds that the variable already
+// had before it was first bound hold anyway and are left open, such
+// that the literal reads x <= v, x >= v, or x = v
+static struct val_t conflict_term_lit(const struct env_t *var, const struct val_t val) {
+  if (var == NULL || var->binds == NULL) {
+    return val;
+  }
+  const struct val_t root = conflict_term_root(var, val);
+  domain_t lo = get_lo(val) == get_lo(root) ? DOMAIN_MIN : get_lo(val);
+  domain_t hi = get_hi(val) == get_hi(root) ? DOMAIN_MAX : get_hi(val);
+  return INTERVAL(lo, hi);
 }
 
-// check whether a conflict element already has been seen
-static bool conflict_seen(void *elem) {
-  struct seen_array_t *arr = &_seen[conflict_seen_hash(elem) % SEEN_ARRAY_WIDTH];
-  for (size_t i = 0, l = arr->length; i < l; i++) {
-    if (arr->elems[i] == elem) {
-      return true;
+// get the level where a variable came within the bounds of a literal,
+// which may be lower than the level where it was bound last
+static size_t conflict_lit_level(const struct env_t *var, const struct val_t lit) {
+  size_t level = var->level;
+  for (const struct binding_t *b = var->binds; b != NULL; b = b->prev) {
+    if (get_lo(b->val) < get_lo(lit) || get_hi(b->val) > get_hi(lit)) {
+      break;
     }
+    level = b->level;
   }
-  return false;
+  return level;
 }
 
-// add a conflict element to the array of already seen conflict elements
-static confl_result_t conflict_seen_add(void *elem) {
-  struct seen_array_t *arr = &_seen[conflict_seen_hash(elem) % SEEN_ARRAY_WIDTH];
-  arr->length++;
-  // check if there is space in the array of seen conflict elements
-  if (arr->length > SEEN_ARRAY_LENGTH_MAX) {
-    return CONFL_ERROR;
+// get the level where a conflict element became true
+static size_t conflict_elem_level(const struct confl_elem_t *elem) {
+  return conflict_lit_level(elem->var->constr.term.env, elem->val);
+}
+
+// get the binding where a variable came within the bounds of a literal
+static const struct binding_t *conflict_lit_bind(const struct env_t *var, const struct val_t lit) {
+  const struct binding_t *bind = NULL;
+  for (const struct binding_t *b = var->binds; b != NULL; b = b->prev) {
+    bind = b;
+    if (get_lo(b->val) < get_lo(lit) || get_hi(b->val) > get_hi(lit)) {
+      break;
+    }
   }
-  arr->elems[arr->length-1] = elem;
-  return CONFL_OK;
+  return bind;
 }
 
-// add a terminal to the conflict
-static confl_result_t conflict_add_term(struct constr_t *confl, struct constr_t *constr) {
-  // do not generate conflict for non-binary variables
-  if (!is_value(constr->constr.term.val) ||
-      get_lo(constr->constr.term.val) > 1 ||
-      get_lo(constr->constr.term.val) < 0) {
-    return CONFL_ERROR;
+// get the latest binding of a variable before another binding (or the
+// latest binding at all if that is NULL), together with the level it
+// was made at and the value it left the variable with
+static const struct binding_t *conflict_bind_before(const struct env_t *var, const struct binding_t *bind,
+                                                    size_t *level, struct val_t *val) {
+  *level = var->level;
+  *val = var->val->constr.term.val;
+  for (const struct binding_t *b = var->binds; b != NULL; b = b->prev) {
+    if (bind == NULL || b < bind) {
+      return b;
+    }
+    *level = b->level;
+    *val = b->val;
   }
+  return NULL;
+}
 
+// add a literal of a terminal to the conflict
+static void conflict_add_lit(struct constr_t *confl, struct constr_t *constr, const struct val_t lit) {
   // add new element to the conflict expression
   size_t length = ++confl->constr.confl.length;
   const size_t size = length * sizeof(struct confl_elem_t);
   confl->constr.confl.elems = (struct confl_elem_t *)conflict_alloc(confl->constr.confl.elems, size);
-  confl->constr.confl.elems[length-1] =
-    (struct confl_elem_t) { .val = constr->constr.term.val, .var = constr };
+  confl->constr.confl.elems[length-1] = (struct confl_elem_t) { .val = lit, .var = constr };
 
-  // update maximum conflict level
-  size_t level = constr->constr.term.env->level;
-  if (level > _conflict_max_level) {
+  // update maximum conflict level, elements at the root level hold
+  // throughout the run
+  size_t level = conflict_lit_level(constr->constr.term.env, lit);
+  if (level != SIZE_MAX && level > _conflict_max_level) {
     _conflict_max_level = level;
   }
-
-  return CONFL_OK;
 }
 
-// forward declaration
-static confl_result_t conflict_add_constr(struct env_t *var, struct constr_t *confl, struct constr_t *constr);
+// add a terminal with a value it had to the conflict
+static confl_result_t conflict_add_term(struct constr_t *confl, struct constr_t *constr, const struct val_t val) {
+  const struct env_t *var = constr->constr.term.env;
+  const struct val_t lit = conflict_term_lit(var, val);
+  // skip variables that still have their original value
+  if (get_lo(lit) == DOMAIN_MIN && get_hi(lit) == DOMAIN_MAX) {
+    return CONFL_OK;
+  }
 
-// process terminal when adding a constraint to the conflict
-static confl_result_t conflict_add_constr_term(struct env_t *var, struct constr_t *confl, struct constr_t *constr) {
-  // add terminal if it is a variable and different from the currently processed one
-  if (constr->constr.term.env != NULL && constr->constr.term.env != var) {
-    if (constr->constr.term.env->level < bind_level_get()
-        || (constr->constr.term.env->binds != NULL
-            && constr->constr.term.env->binds->clause == NULL)) {
-      // add terminal if bound at lower level or bound without being inferred
-      return conflict_add_term(confl, constr);
-    }
-    // otherwise, add the variable to the conflict
-    return conflict_add_var(constr->constr.term.env, confl);
+  // back-jumping over integer variables forgets which values the
+  // skipped levels tried already, which usually costs more than it
+  // saves
+  const struct val_t root = conflict_term_root(var, val);
+  if (get_lo(root) < 0 || get_hi(root) > 1) {
+    _conflict_backjump = false;
   }
-  return CONFL_OK;
-}
 
-// process wide-and expression when adding a constraint to the conflict
-static confl_result_t conflict_add_constr_wand(struct env_t *var, struct constr_t *confl, struct constr_t *constr) {
-  // add all sub-expressions of wide-and expression
-  for (size_t i = 0, l = constr->constr.wand.length; i < l; i++) {
-    confl_result_t c = conflict_add_constr(var, confl, constr->constr.wand.elems[i].constr);
-    CHECK(c);
+  // add every variable only once, a duplicate would keep the
+  // conflict from inferring anything
+  if (conflict_seen(constr)) {
+    return CONFL_OK;
   }
-  return CONFL_OK;
-}
+  conflict_seen_add(constr);
 
-// process conflict expression when adding a constraint to the conflict
-static confl_result_t conflict_add_constr_confl(struct env_t *var, struct constr_t *confl, struct constr_t *constr) {
-  // add all variables in conflict expression
-  for (size_t i = 0, l = constr->constr.confl.length; i < l; i++) {
-    confl_result_t c = conflict_add_constr(var, confl, constr->constr.confl.elems[i].var);
-    CHECK(c);
+  // split into separate literals for the lower and upper bound if
+  // they were bound at different levels, such that the conflict can
+  // infer a bound after back-jumping over only one of them
+  if (get_lo(lit) > get_lo(root) && get_hi(lit) < get_hi(root)) {
+    const struct val_t lo = INTERVAL(get_lo(lit), DOMAIN_MAX);
+    const struct val_t hi = INTERVAL(DOMAIN_MIN, get_hi(lit));
+    if (conflict_lit_level(var, lo) != conflict_lit_level(var, hi)) {
+      conflict_add_lit(confl, constr, lo);
+      conflict_add_lit(confl, constr, hi);
+      return CONFL_OK;
+    }
+    // do not generate conflicts for x = v, they hardly ever apply
+    // again and only slow down propagation
+    return CONFL_ERROR;
   }
+
+  conflict_add_lit(confl, constr, lit);
   return CONFL_OK;
 }
 
-// process ordinary expression when adding a constraint to the conflict
-static confl_result_t conflict_add_constr_expr(struct env_t *var, struct constr_t *confl, struct constr_t *constr) {
+// function applied to the sub-expressions of a constraint, the
+// variable is the one whose binding the constraint explains
+typedef confl_result_t (*conflict_fun_t)(struct env_t *var, struct constr_t *confl, struct constr_t *constr);
+
+// apply a function to all sub-expressions of a constraint, stop at the first error
+static confl_result_t conflict_walk(struct env_t *var, struct constr_t *confl, struct constr_t *constr, conflict_fun_t fun) {
+  if (IS_TYPE(WAND, constr)) {
+    for (size_t i = 0, l = constr->constr.wand.length; i < l; i++) {
+      confl_result_t c = fun(var, confl, constr->constr.wand.elems[i].constr);
+      CHECK(c);
+    }
+    return CONFL_OK;
+  }
+  if (IS_TYPE(CONFL, constr)) {
+    for (size_t i = 0, l = constr->constr.confl.length; i < l; i++) {
+      confl_result_t c = fun(var, confl, constr->constr.confl.elems[i].var);
+      CHECK(c);
+    }
+    return CONFL_OK;
+  }
+
   switch (constr->type->op) {
   case OP_EQ:
   case OP_LT:
   case OP_ADD:
   case OP_MUL:
+  case OP_DIV:
+  case OP_MOD:
+  case OP_MIN:
+  case OP_MAX:
   case OP_AND:
   case OP_OR: {
-    // add right sub-expression
-    confl_result_t c = conflict_add_constr(var, confl, constr->constr.expr.r);
+    // walk right sub-expression
+    confl_result_t c = fun(var, confl, constr->constr.expr.r);
     CHECK(c);
     /* fall through */
   }
   case OP_NEG:
+  case OP_ABS:
   case OP_NOT: {
-    // add left sub-expression
-    confl_result_t c = conflict_add_constr(var, confl, constr->constr.expr.l);
+    // walk left sub-expression
+    confl_result_t c = fun(var, confl, constr->constr.expr.l);
     CHECK(c);
     break;
   }
+  case OP_LIN:
+    // walk variables of terms
+    for (size_t i = 0, l = constr->constr.lin.length; i < l; i++) {
+      confl_result_t c = fun(var, confl, constr->constr.lin.terms[i].var);
+      CHECK(c);
+    }
+    break;
+  case OP_DIFF: {
+    // walk both variables
+    confl_result_t c = fun(var, confl, constr->constr.diff.l);
+    CHECK(c);
+    c = fun(var, confl, constr->constr.diff.r);
+    CHECK(c);
+    break;
+  }
+  case OP_ALLDIFF:
+    // walk sub-expressions
+    for (size_t i = 0, l = constr->constr.alldiff.length; i < l; i++) {
+      confl_result_t c = fun(var, confl, constr->constr.alldiff.elems[i]);
+      CHECK(c);
+    }
+    break;
+  case OP_DISJ:
+  case OP_CUMUL: {
+    // walk sub-expressions of tasks and capacity
+    for (size_t i = 0, l = constr->constr.sched.length; i < l; i++) {
+      const struct sched_task_t *t = &constr->constr.sched.tasks[i];
+      confl_result_t c = fun(var, confl, t->start);
+      CHECK(c);
+      c = fun(var, confl, t->dur);
+      CHECK(c);
+      if (t->demand != NULL) {
+        c = fun(var, confl, t->demand);
+        CHECK(c);
+      }
+    }
+    if (constr->constr.sched.cap != NULL) {
+      confl_result_t c = fun(var, confl, constr->constr.sched.cap);
+      CHECK(c);
+    }
+    break;
+  }
   default:
     print_fatal(ERROR_MSG_INVALID_OPERATION, constr->type->op);
   }
@@ -261,78 +501,412 @@ static confl_result_t conflict_add_constr_expr(struct env_t *var, struct constr_
   return CONFL_OK;
 }
 
-// add a constraint to the conflict
-static confl_result_t conflict_add_constr(struct env_t *var, struct constr_t *confl, struct constr_t *constr) {
-  // only process constraints that have not been seen yet
-  if (conflict_seen(constr)) {
+// add the value a variable had at the binding being explained to the
+// conflict; bindings at the current level are only marked, they are
+// resolved later by walking the binding stack
+static confl_result_t conflict_add_env(struct constr_t *confl, struct env_t *var) {
+  size_t level;
+  struct val_t val;
+  const struct binding_t *b = conflict_bind_before(var, _conflict_bind, &level, &val);
+
+  // original values and committed bindings hold anyway
+  if (conflict_committed(b, level)) {
     return CONFL_OK;
   }
-  confl_result_t a = conflict_seen_add(constr);
-  CHECK(a);
 
+  if (level == bind_level_get()) {
+    // remember the latest binding the conflict depends on, earlier
+    // bindings of the variable are resolved along with it
+    if (!conflict_var_seen(var)) {
+      conflict_var_seen_add(var);
+      var->seen_bind = NULL;
+    }
+    if (var->seen_bind == NULL) {
+      var->seen_bind = b;
+      _conflict_pending++;
+    } else if (b > var->seen_bind) {
+      var->seen_bind = b;
+    }
+    return CONFL_OK;
+  }
+
+  return conflict_add_term(confl, var->val, val);
+}
+
+// process terminal when adding a constraint to the conflict
+static confl_result_t conflict_add_constr_term(struct env_t *var, struct constr_t *confl, struct constr_t *constr) {
+  // add terminal if it is a variable and different from the currently processed one
+  if (constr->constr.term.env != NULL && constr->constr.term.env != var) {
+    return conflict_add_env(confl, constr->constr.term.env);
+  }
+  return CONFL_OK;
+}
+
+// add a constraint to the conflict
+static confl_result_t conflict_add_constr(struct env_t *var, struct constr_t *confl, struct constr_t *constr) {
+  // terminals are marked when adding them to the conflict
   if (IS_TYPE(TERM, constr)) {
     return conflict_add_constr_term(var, confl, constr);
   }
-  if (IS_TYPE(WAND, constr)) {
-    return conflict_add_constr_wand(var, confl, constr);
+
+  // only process constraints that have not been seen yet
+  if (conflict_seen(constr)) {
+    return CONFL_OK;
   }
+  conflict_seen_add(constr);
+
+  // learned conflicts that help creating others are worth keeping
   if (IS_TYPE(CONFL, constr)) {
-    return conflict_add_constr_confl(var, confl, constr);
+    struct confl_db_entry_t *e = conflict_db_find(constr);
+    if (e != NULL) {
+      e->activity++;
+    }
   }
-  return conflict_add_constr_expr(var, confl, constr);
+
+  return conflict_walk(var, confl, constr, conflict_add_constr);
 }
 
-// add a variable to the conflict
-static confl_result_t conflict_add_var(struct env_t *var, struct constr_t *confl) {
-  // only process variables that have not been seen yet
-  if (conflict_seen(var)) {
-    return CONFL_OK;
-  }
-  confl_result_t a = conflict_seen_add(var);
-  CHECK(a);
+// replace the bindings at the current level by their reasons, walking
+// the binding stack backwards until only one binding is left (the
+// first unique implication point), which is added to the conflict
+static confl_result_t conflict_resolve(struct constr_t *confl) {
+  for (size_t depth = bind_depth(); depth > 0 && _conflict_pending > 0; ) {
+    const struct binding_t *b = bind_get(--depth);
+    struct env_t *var = b->var;
+    if (!conflict_var_seen(var) || var->seen_bind != b) {
+      continue;
+    }
 
-  // iterate over all the bindings of the variable
-  for (struct binding_t *b = var->binds; b != NULL; b = b->prev) {
-    if (b->clause != NULL) {
-      // add constraint if binding was inferred by a clause
-      confl_result_t c = conflict_add_constr(var, confl, b->clause->orig);
+    var->seen_bind = NULL;
+    _conflict_pending--;
+    _conflict_bind = b;
+
+    if (_conflict_pending == 0 || b->clause == NULL) {
+      // add the value the binding left the variable with, decisions
+      // cannot be resolved any further
+      size_t level;
+      struct val_t val;
+      conflict_bind_before(var, b+1, &level, &val);
+      confl_result_t c = conflict_add_term(confl, var->val, val);
       CHECK(c);
     } else {
-      // add terminal if binding was not inferred
-      confl_result_t c = conflict_add_term(confl, b->var->val);
+      // add the reason of the binding and the value of the variable
+      // before the binding
+      confl_result_t c = conflict_add_constr(var, confl, b->clause->orig);
+      CHECK(c);
+      c = conflict_add_env(confl, var);
       CHECK(c);
     }
   }
-
   return CONFL_OK;
 }
 
+// forward declaration
+static confl_result_t conflict_implied_constr(struct env_t *var, struct constr_t *confl, struct constr_t *constr);
+
+// check whether the value a binding left a variable with follows from
+// the remaining conflict elements
+static confl_result_t conflict_implied(struct env_t *var, const struct binding_t *bind, size_t level) {
+  // values of conflict elements and everything they imply follow
+  if (var != _conflict_removing && conflict_var_seen(var)
+      && var->seen_bind != NULL && var->seen_bind >= bind) {
+    return CONFL_OK;
+  }
+  // decisions do not follow from anything, and bindings at levels
+  // without conflict elements hardly ever do
+  if (bind->clause == NULL || (_conflict_levels & (UINT64_C(1) << (level % 64))) == 0) {
+    return CONFL_ERROR;
+  }
+  if (_conflict_budget == 0) {
+    return CONFL_ERROR;
+  }
+  _conflict_budget--;
+
+  // check the reason of the binding and the value before the binding
+  const struct binding_t *prev = _conflict_bind;
+  _conflict_bind = bind;
+  confl_result_t c = conflict_implied_constr(var, NULL, bind->clause->orig);
+  if (c == CONFL_OK) {
+    c = conflict_implied_constr(NULL, NULL, var->val);
+  }
+  _conflict_bind = prev;
+  return c;
+}
+
+// check whether the value a terminal had at the binding being checked
+// follows from the remaining conflict elements
+static confl_result_t conflict_implied_constr(struct env_t *var, struct constr_t *confl, struct constr_t *constr) {
+  if (!IS_TYPE(TERM, constr)) {
+    return conflict_walk(var, confl, constr, conflict_implied_constr);
+  }
+
+  struct env_t *env = constr->constr.term.env;
+  if (env == NULL || env == var) {
+    return CONFL_OK;
+  }
+  size_t level;
+  struct val_t val;
+  const struct binding_t *b = conflict_bind_before(env, _conflict_bind, &level, &val);
+  // original values and committed bindings hold anyway
+  if (conflict_committed(b, level)) {
+    return CONFL_OK;
+  }
+  return conflict_implied(env, b, level);
+}
+
+// remove conflict elements that follow from the other ones, keeping the
+// element at the maximum level and elements of variables that appear
+// with both bounds
+static void conflict_minimize(struct constr_t *confl) {
+  struct confl_elem_t *elems = confl->constr.confl.elems;
+  const size_t length = confl->constr.confl.length;
+
+  // mark the variables of the conflict with the binding that made their
+  // elements true
+  conflict_seen_reset();
+  for (size_t i = 0; i < length; i++) {
+    struct env_t *var = elems[i].var->constr.term.env;
+    conflict_var_seen_add(var);
+    var->seen_bind = NULL;
+  }
+  _conflict_levels = 0;
+  for (size_t i = 0; i < length; i++) {
+    struct env_t *var = elems[i].var->constr.term.env;
+    const struct binding_t *b = conflict_lit_bind(var, elems[i].val);
+    if (var->seen_bind == NULL || b > var->seen_bind) {
+      var->seen_bind = b;
+    }
+    _conflict_levels |= UINT64_C(1) << (conflict_elem_level(&elems[i]) % 64);
+  }
+
+  size_t k = 0;
+  for (size_t i = 0; i < length; i++) {
+    struct env_t *var = elems[i].var->constr.term.env;
+    size_t level = conflict_elem_level(&elems[i]);
+    bool split = (i > 0 && elems[i-1].var == elems[i].var)
+      || (i+1 < length && elems[i+1].var == elems[i].var);
+    if (level < _conflict_max_level && !split) {
+      _conflict_removing = var;
+      _conflict_budget = CONFLICT_MINIMIZE_BUDGET;
+      if (conflict_implied(var, var->seen_bind, level) == CONFL_OK) {
+        // the element follows from the others and can be removed
+        var->seen_bind = NULL;
+        continue;
+      }
+    }
+    elems[k++] = elems[i];
+  }
+  _conflict_removing = NULL;
+
+  confl->constr.confl.length = k;
+  confl->constr.confl.elems = (struct confl_elem_t *)conflict_alloc(elems, k * sizeof(struct confl_elem_t));
+}
+
 // update the conflict level and conflict variable
 static void conflict_update(struct constr_t *confl) {
   if (confl->constr.confl.length != 0) {
     _conflict_level = 0;
     _conflict_var = confl->constr.confl.elems[0].var->constr.term.env;
+    size_t top_count = 0;
     // find the level where the conflict can be resolved
     for (size_t i = 0, l = confl->constr.confl.length; i < l; i++) {
-      size_t level = confl->constr.confl.elems[i].var->constr.term.env->level;
+      const struct confl_elem_t *elem = &confl->constr.confl.elems[i];
+      size_t level = conflict_elem_level(elem);
       if (level < _conflict_max_level && level+1 > _conflict_level) {
         _conflict_level = level+1;
-        _conflict_var = confl->constr.confl.elems[i].var->constr.term.env;
+        _conflict_var = elem->var->constr.term.env;
+      }
+      if (level == _conflict_max_level) {
+        top_count++;
       }
     }
+    // only back-jump if the conflict infers a bound of its single
+    // element at the maximum level afterwards, otherwise the search
+    // would forget which values it tried already
+    if (top_count != 1) {
+      conflict_reset();
+    }
+  }
+}
+
+// count the different levels of the elements of a conflict, counting
+// stops right after exceeding a maximum
+static size_t conflict_lbd(const struct constr_t *confl, size_t max) {
+  size_t levels[CONFLICT_LBD_MAX+1];
+  size_t count = 0;
+  for (size_t i = 0, l = confl->constr.confl.length; i < l && count <= max; i++) {
+    size_t level = conflict_elem_level(&confl->constr.confl.elems[i]);
+    size_t k = 0;
+    while (k < count && levels[k] != level) {
+      k++;
+    }
+    if (k == count) {
+      levels[count++] = level;
+    }
+  }
+  return count;
+}
+
+// add a conflict to the conflict database, the conflict memory must
+// end at the top of the conflict allocation stack
+static void conflict_db_add(struct constr_t *confl, struct wand_expr_t *clause) {
+  if (_db_length == _db_size) {
+    _db_size = _db_size > 0 ? 2 * _db_size : CONFLICT_DB_SIZE_INIT;
+    _db = (struct confl_db_entry_t *)realloc(_db, _db_size * sizeof(struct confl_db_entry_t));
+    // die if allocation failed
+    if (_db == NULL) {
+      print_fatal("%s", strerror(errno));
+    }
+  }
+  _db[_db_length++] = (struct confl_db_entry_t){ .confl = confl,
+                                                 .clause = clause,
+                                                 .size = (size_t)(&_alloc_stack[_alloc_stack_pointer] - (char *)confl),
+                                                 .lbd = conflict_lbd(confl, CONFLICT_LBD_MAX),
+                                                 .activity = 0,
+                                                 .locked = false,
+                                                 .removed = false,
+                                                 .dest = NULL };
+}
+
+// rank conflict elements for watching them: elements that are not
+// true yet come first, then the ones that became true at the highest
+// levels, bindings at the root level (SIZE_MAX) come last
+static size_t conflict_elem_rank(const struct confl_elem_t *elem) {
+  const struct val_t v = elem->var->constr.term.val;
+  if (get_lo(v) < get_lo(elem->val) || get_hi(v) > get_hi(elem->val)) {
+    return SIZE_MAX;
+  }
+  return conflict_elem_level(elem) + 1;
+}
+
+// find the first conflict element with the highest rank, skipping one element
+static size_t conflict_elem_best(const struct constr_t *confl, size_t skip) {
+  size_t best = SIZE_MAX;
+  size_t rank = 0;
+  for (size_t i = 0, l = confl->constr.confl.length; i < l; i++) {
+    size_t r = conflict_elem_rank(&confl->constr.confl.elems[i]);
+    if (i != skip && (best == SIZE_MAX || r > rank)) {
+      best = i;
+      rank = r;
+    }
+  }
+  return best;
+}
+
+// swap two conflict elements
+static void conflict_elem_swap(struct constr_t *confl, size_t i, size_t k) {
+  struct confl_elem_t t = confl->constr.confl.elems[i];
+  confl->constr.confl.elems[i] = confl->constr.confl.elems[k];
+  confl->constr.confl.elems[k] = t;
+}
+
+// watch the two conflict elements that become false first when
+// back-tracking; for a new conflict, these are the element at the
+// maximum level and the one of the conflict variable, such that
+// propagating the conflict variable after back-jumping infers the
+// former
+static void conflict_attach(struct constr_t *confl) {
+  struct wand_expr_t *c = (struct wand_expr_t *)conflict_alloc(NULL, sizeof(struct wand_expr_t));
+  *c = (struct wand_expr_t){ .constr = confl, .orig = confl, .prop_tag = 0 };
+  conflict_db_add(confl, c);
+
+  if (confl->constr.confl.length > 1) {
+    size_t first = conflict_elem_best(confl, SIZE_MAX);
+    size_t second = conflict_elem_best(confl, first);
+    conflict_elem_swap(confl, 0, first);
+    conflict_elem_swap(confl, 1, second == 0 ? first : second);
+  }
+  propagate_watch(c);
+}
+
+// initialize sharing conflicts for a worker
+void conflict_share_init(struct env_t *env, uint32_t id) {
+  _share_env = env;
+  _share_id = id;
+  _share_tail = 0;
+  if (env != NULL) {
+    sema_wait(&shared()->confl_semaphore);
+    _share_tail = shared()->confl_head;
+    sema_post(&shared()->confl_semaphore);
+  }
+}
+
+// share a conflict with other workers if it is short enough
+static void conflict_export(const struct constr_t *confl) {
+  size_t length = confl->constr.confl.length;
+  if (length > CONFLICT_SHARE_LENGTH_MAX) {
+    return;
+  }
+
+  // only share conflicts over few levels
+  if (conflict_lbd(confl, CONFLICT_SHARE_LEVELS_MAX) > CONFLICT_SHARE_LEVELS_MAX) {
+    return;
+  }
+
+  // write conflict to ring buffer, overwriting the oldest one
+  sema_wait(&shared()->confl_semaphore);
+  struct shared_confl_t *s = &shared()->confls[shared()->confl_head % CONFLICT_SHARE_RING_SIZE];
+  s->worker = _share_id;
+  s->length = length;
+  for (size_t i = 0; i < length; i++) {
+    const struct confl_elem_t *e = &confl->constr.confl.elems[i];
+    s->elems[i] = (struct decision_t){ .var = (size_t)(e->var->constr.term.env - _share_env), .val = e->val };
+  }
+  shared()->confl_head++;
+  sema_post(&shared()->confl_semaphore);
+}
+
+// import conflicts shared by other workers
+void conflict_import(void) {
+  // quick check without locking whether there is anything new
+  if (_share_env == NULL || _share_tail == shared()->confl_head) {
+    return;
+  }
+
+  sema_wait(&shared()->confl_semaphore);
+  uint64_t head = shared()->confl_head;
+  // skip conflicts that have been overwritten already
+  if (head - _share_tail > CONFLICT_SHARE_RING_SIZE) {
+    _share_tail = head - CONFLICT_SHARE_RING_SIZE;
+  }
+  for (; _share_tail < head; _share_tail++) {
+    const struct shared_confl_t *s = &shared()->confls[_share_tail % CONFLICT_SHARE_RING_SIZE];
+    // skip conflicts created by this worker
+    if (s->worker == _share_id) {
+      continue;
+    }
+
+    struct constr_t *confl = (struct constr_t *)conflict_alloc(NULL, sizeof(struct constr_t));
+    struct confl_elem_t *elems = (struct confl_elem_t *)conflict_alloc(NULL, s->length * sizeof(struct confl_elem_t));
+    for (size_t i = 0; i < s->length; i++) {
+      elems[i] = (struct confl_elem_t){ .val = s->elems[i].val, .var = _share_env[s->elems[i].var].val };
+    }
+    *confl = CONSTRAINT_CONFL(s->length, elems);
+    conflict_attach(confl);
   }
+  sema_post(&shared()->confl_semaphore);
 }
 
 // create a conflict
 void conflict_create(struct env_t *var, const struct wand_expr_t *clause) {
+  // reset conflict information
+  conflict_seen_reset();
+  conflict_reset();
+
+  // failing at the root level ends the run, there is nothing to resolve
+  if (bind_level_get() == SIZE_MAX) {
+    return;
+  }
+
   // allocate a new conflict expression
   struct constr_t *confl = (struct constr_t *)conflict_alloc(NULL, sizeof(struct constr_t));
   *confl = CONSTRAINT_CONFL(0, NULL);
 
-  // reset conflict information
-  conflict_seen_reset();
-  conflict_reset();
   _conflict_max_level = 0;
+  _conflict_backjump = true;
+
+  _conflict_bind = NULL;
+  _conflict_pending = 0;
 
   // add the clause that caused the conflict
   confl_result_t c1 = conflict_add_constr(var, confl, clause->orig);
@@ -341,22 +915,241 @@ void conflict_create(struct env_t *var, const struct wand_expr_t *clause) {
     return;
   }
   // add the variable that caused the conflict
-  confl_result_t c2 = conflict_add_var(var, confl);
+  confl_result_t c2 = conflict_add_env(confl, var);
   if (c2 == CONFL_ERROR) {
     conflict_dealloc(confl);
     return;
   }
+  // resolve the bindings at the current level
+  confl_result_t c3 = conflict_resolve(confl);
+  if (c3 == CONFL_ERROR) {
+    conflict_dealloc(confl);
+    return;
+  }
+  // drop elements that follow from the others
+  conflict_minimize(confl);
 
   // update conflict level and variable
   conflict_update(confl);
+  // drop conflict if it cannot infer anything after back-jumping
+  if (_conflict_level == SIZE_MAX) {
+    conflict_dealloc(confl);
+    return;
+  }
 
   // add the newly created conflict to the relevant clause lists
-  struct wand_expr_t *c = (struct wand_expr_t *)conflict_alloc(NULL, sizeof(struct wand_expr_t));
-  *c = (struct wand_expr_t){ .constr = confl, .orig = confl, .prop_tag = 0 };
-  for (size_t i = 0, l = confl->constr.confl.length; i < l; i++) {
-    clause_list_append(&confl->constr.confl.elems[i].var->constr.term.env->clauses, c);
+  conflict_attach(confl);
+
+  // share the conflict with other workers
+  if (_share_env != NULL) {
+    conflict_export(confl);
   }
 
   // update statistics
   stat_inc_confl();
+
+  // keep the conflict, but resolve it by plain back-tracking
+  if (!_conflict_backjump) {
+    conflict_reset();
+  }
+}
+
+// initialize reducing the conflicts learned from now on
+void conflict_reduce_init(void) {
+  _db_floor = _db_length;
+  _db_limit = CONFLICT_DB_SIZE_INIT;
+}
+
+// lock the learned conflict a pointer refers to, leaving the pointer as it is
+static void *conflict_db_lock(const void *ptr) {
+  struct confl_db_entry_t *e = conflict_db_find(ptr);
+  if (e != NULL) {
+    e->locked = true;
+  }
+  return (void *)ptr;
+}
+
+// compare learned conflicts such that the least useful ones come first
+static int conflict_db_compare(const void *a, const void *b) {
+  const struct confl_db_entry_t *x = &_db[*(const size_t *)a];
+  const struct confl_db_entry_t *y = &_db[*(const size_t *)b];
+  if (x->lbd != y->lbd) {
+    return x->lbd > y->lbd ? -1 : 1;
+  }
+  if (x->activity != y->activity) {
+    return x->activity < y->activity ? -1 : 1;
+  }
+  return x < y ? -1 : (x > y ? 1 : 0);
+}
+
+// mark half of the removable learned conflicts as removed, preferring
+// those over many levels that rarely took part in other conflicts;
+// conflicts over very few levels are kept unless running out of memory
+static size_t conflict_db_select(bool full) {
+  size_t *cands = (size_t *)malloc((_db_length - _db_floor) * sizeof(size_t));
+  // die if allocation failed
+  if (cands == NULL) {
+    print_fatal("%s", strerror(errno));
+  }
+
+  size_t count = 0;
+  for (size_t i = _db_floor; i < _db_length; i++) {
+    const struct confl_db_entry_t *e = &_db[i];
+    if (!e->locked && (full || e->lbd > CONFLICT_DB_GLUE_LBD)) {
+      cands[count++] = i;
+    }
+  }
+  qsort(cands, count, sizeof(size_t), conflict_db_compare);
+  for (size_t k = 0; k < count / 2; k++) {
+    _db[cands[k]].removed = true;
+  }
+
+  free(cands);
+  return count / 2;
+}
+
+// compare clause lists by address
+static int conflict_db_compare_lists(const void *a, const void *b) {
+  uintptr_t x = (uintptr_t)*(struct clause_list_t * const *)a;
+  uintptr_t y = (uintptr_t)*(struct clause_list_t * const *)b;
+  return x < y ? -1 : (x > y ? 1 : 0);
+}
+
+// collect the watch lists of the variables of learned conflicts from
+// some position on that are (not) being removed, sorted by address and
+// without duplicates
+static struct clause_list_t **conflict_db_lists(size_t from, bool removed, size_t *count) {
+  struct clause_list_t **lists = NULL;
+  size_t length = 0;
+  size_t size = 0;
+  for (size_t i = from; i < _db_length; i++) {
+    const struct constr_t *confl = _db[i].confl;
+    if (_db[i].removed != removed || (!removed && _db[i].dest == (char *)confl)) {
+      continue;
+    }
+    for (size_t k = 0, l = confl->constr.confl.length; k < l; k++) {
+      if (length == size) {
+        size = size > 0 ? 2 * size : CONFLICT_DB_SIZE_INC;
+        lists = (struct clause_list_t **)realloc(lists, size * sizeof(struct clause_list_t *));
+        // die if allocation failed
+        if (lists == NULL) {
+          print_fatal("%s", strerror(errno));
+        }
+      }
+      lists[length++] = &confl->constr.confl.elems[k].var->constr.term.env->watches;
+    }
+  }
+
+  qsort(lists, length, sizeof(struct clause_list_t *), conflict_db_compare_lists);
+  size_t unique = 0;
+  for (size_t i = 0; i < length; i++) {
+    if (unique == 0 || lists[unique-1] != lists[i]) {
+      lists[unique++] = lists[i];
+    }
+  }
+  *count = unique;
+  return lists;
+}
+
+// check whether a clause list element is kept
+static bool conflict_db_keep(const struct wand_expr_t *clause) {
+  const struct confl_db_entry_t *e = conflict_db_find(clause);
+  return e == NULL || !e->removed;
+}
+
+// stop watching the learned conflicts from some position on that are
+// being removed
+static void conflict_db_unwatch(size_t from) {
+  size_t count;
+  struct clause_list_t **lists = conflict_db_lists(from, true, &count);
+  clause_lists_compact(lists, count, conflict_db_keep);
+  free(lists);
+}
+
+// get where a pointer is moved to if it points into the memory of a
+// learned conflict
+static void *conflict_db_shift(const struct confl_db_entry_t *e, const void *ptr) {
+  if ((uintptr_t)ptr >= (uintptr_t)e->confl && (uintptr_t)ptr < (uintptr_t)e->confl + e->size) {
+    return e->dest + ((const char *)ptr - (const char *)e->confl);
+  }
+  return (void *)ptr;
+}
+
+// get where a pointer is moved to if it points into the memory of any
+// learned conflict that may be moved
+static void *conflict_db_forward(const void *ptr) {
+  const struct confl_db_entry_t *e = conflict_db_find(ptr);
+  if (e != NULL && e >= &_db[_db_floor]) {
+    return conflict_db_shift(e, ptr);
+  }
+  return (void *)ptr;
+}
+
+// move the remaining learned conflicts down to close the gaps left by
+// removed ones, and update everything that refers to them
+static void conflict_db_compact(void) {
+  // compute where learned conflicts are moved to
+  char *dest = (char *)_db[_db_floor].confl;
+  for (size_t i = _db_floor; i < _db_length; i++) {
+    if (!_db[i].removed) {
+      _db[i].dest = dest;
+      dest += _db[i].size;
+    }
+  }
+
+  // update references from watch lists and bindings
+  size_t count;
+  struct clause_list_t **lists = conflict_db_lists(_db_floor, false, &count);
+  for (size_t i = 0; i < count; i++) {
+    for (size_t k = 0, l = lists[i]->length; k < l; k++) {
+      lists[i]->elems[k] = (struct wand_expr_t *)conflict_db_forward(lists[i]->elems[k]);
+    }
+  }
+  free(lists);
+  bind_relocate(conflict_db_forward);
+
+  // move learned conflicts, updating references between their parts
+  size_t length = _db_floor;
+  for (size_t i = _db_floor; i < _db_length; i++) {
+    struct confl_db_entry_t e = _db[i];
+    if (e.removed) {
+      continue;
+    }
+    if (e.dest != (char *)e.confl) {
+      e.clause->constr = (struct constr_t *)conflict_db_shift(&e, e.clause->constr);
+      e.clause->orig = (struct constr_t *)conflict_db_shift(&e, e.clause->orig);
+      e.confl->constr.confl.elems = (struct confl_elem_t *)conflict_db_shift(&e, e.confl->constr.confl.elems);
+      memmove(e.dest, e.confl, e.size);
+      e.clause = (struct wand_expr_t *)conflict_db_shift(&e, e.clause);
+      e.confl = (struct constr_t *)e.dest;
+    }
+    _db[length++] = e;
+  }
+  _db_length = length;
+  _alloc_stack_pointer = dest - &_alloc_stack[0];
+}
+
+// remove learned conflicts that are unlikely to be useful, if there
+// are too many of them or conflict memory is running out
+void conflict_reduce(void) {
+  const size_t count = _db_length - _db_floor;
+  const bool full = _alloc_stack_pointer > _alloc_stack_size / 4 * 3;
+  if (count == 0 || (count <= _db_limit && !full)) {
+    return;
+  }
+
+  // learned conflicts that bindings refer to stay
+  for (size_t i = _db_floor; i < _db_length; i++) {
+    _db[i].locked = false;
+    _db[i].removed = false;
+    _db[i].activity /= 2;
+  }
+  bind_relocate(conflict_db_lock);
+
+  if (conflict_db_select(full) > 0) {
+    conflict_db_unwatch(_db_floor);
+    conflict_db_compact();
+  }
+
+  _db_limit += CONFLICT_DB_SIZE_INC;
 }
@@ -17,25 +17,46 @@ along with CSolve.  If not, see <http://www.gnu.org/licenses/>.
 */
 
 #include "csolve.h"
+#include "parser_support.h"
 
 #include <errno.h>
 #include <limits.h>
+#include <pthread.h>
 #include <semaphore.h>
+#include <signal.h>
 #include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <sys/mman.h>
 #include <sys/types.h>
-#include <sys/wait.h>
 #include <unistd.h>
 
-// maximum number of active worker processes
+// maximum number of workers
 static uint32_t _workers_max;
-// ID of current worker process
-static uint32_t _worker_id;
-// minimum search level for current worker process
-static size_t _worker_min_level;
+// ID of current worker
+static THREAD_LOCAL uint32_t _worker_id;
+// minimum search level for current worker
+static THREAD_LOCAL size_t _worker_min_level;
+// solver context of current worker, the remaining search state is
+// thread-local in the modules that own it
+static THREAD_LOCAL struct solver_t *_solver;
+// the task currently searched by this worker
+static THREAD_LOCAL struct task_t *_worker_task;
+
+// model from which workers clone their private models
+static struct solver_t _template;
+// stack sizes for workers
+static size_t _worker_alloc_size;
+static size_t _worker_bind_size;
+static size_t _worker_patch_size;
+static size_t _worker_confl_size;
+// strategy settings for workers
+static struct strategy_t _worker_strategy;
+// whether workers race with different strategies
+static bool _portfolio;
+// whether the problem is decomposed into subproblems upfront
+static bool _eps;
 
 // pointer to shared data structure
 static struct shared_t *_shared;
@@ -43,12 +64,22 @@ static struct shared_t *_shared;
 // timeout data
 static uint32_t _time_max;
 
+// buffer for solutions found by current worker
+static THREAD_LOCAL FILE *_solution_out;
+static THREAD_LOCAL char *_solution_buf;
+static THREAD_LOCAL size_t _solution_len;
+// size up to which solutions are buffered when looking for all solutions
+#define SOLUTION_BUFFER_SIZE (1 << 16)
+// function to receive solutions instead of printing them
+static solution_callback_t _solution_callback;
+static void *_solution_data;
+
 // number of fails since last restart
-static uint32_t _fail_count = 0;
+static THREAD_LOCAL uint32_t _fail_count = 0;
 // threshold for when to restart next
-static uint64_t _fail_threshold = 1;
+static THREAD_LOCAL uint64_t _fail_threshold = 1;
 // counter to calculate Luby sequence for restart threshold
-static uint64_t _fail_threshold_counter = 1;
+static THREAD_LOCAL uint64_t _fail_threshold_counter = 1;
 
 // print statistics
 static void print_stats(FILE *file) {
@@ -88,105 +119,38 @@ void shared_init(uint32_t workers_max) {
   _shared = (struct shared_t *)mmap(NULL, sizeof(struct shared_t),
                                     PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS,
                                     -1, 0);
-  sema_init(&shared()->semaphore);
+  shared_reset();
+}
+
+// reset shared data for another search
+void shared_reset(void) {
+  sema_init(&shared()->semaphore, 1);
+  sema_init(&shared()->tasks_avail, 0);
+  sema_init(&shared()->confl_semaphore, 1);
+  shared()->tasks = NULL;
+  shared()->subproblems = NULL;
   shared()->workers = 1;
-  shared()->workers_id = 1;
+  shared()->idle = 0;
+  shared()->objective_epoch = 0;
   shared()->timeout = false;
+  shared()->done = false;
+  shared()->confl_head = 0;
+  shared()->solutions = 0;
   _worker_id = 1;
   _worker_min_level = 0;
 }
 
+// release shared data
+void shared_free(void) {
+  munmap(_shared, sizeof(struct shared_t));
+  _shared = NULL;
+}
+
 // return pointer to shared data
 struct shared_t *shared(void) {
   return _shared;
 }
 
-// spawn a new worker process
-void worker_spawn(struct env_t *var, size_t level) {
-
-  // spawn a new worker only if the current variable does not have a
-  // value yet and there may be room for new workers
-  if (!is_value(var->val->constr.term.val) && shared()->workers < _workers_max) {
-
-    sema_wait(&shared()->semaphore);
-    // avoid race condition
-    if (shared()->workers >= _workers_max) {
-      sema_post(&shared()->semaphore);
-      return;
-    }
-    ++shared()->workers;
-    int32_t id = ++shared()->workers_id;
-    sema_post(&shared()->semaphore);
-
-    // split interval of variable in half
-    domain_t lo = get_lo(var->val->constr.term.val);
-    domain_t hi = get_hi(var->val->constr.term.val);
-    domain_t mid = (lo + hi) / 2;
-
-    // pick up any children that may have finished
-    int status;
-    waitpid(-1, &status, WNOHANG);
-
-    pid_t pid = fork();
-    if (pid == -1) {
-      print_error("%s", strerror(errno));
-      exit(EXIT_FAILURE);
-    } else if (pid == 0) {
-      // child gets a new id and searches the upper half
-      _worker_id = id;
-      struct val_t v = (mid+1 == hi) ? VALUE(hi) : INTERVAL(mid+1, hi);
-      bind_level_set(level);
-      bind(var, v, NULL);
-      _worker_min_level = level;
-      // reset stats for child
-      stats_init();
-      stat_set_level_min(level);
-      stat_set_level_max(level);
-    } else {
-      // parent searches the lower half
-      struct val_t v = (lo == mid) ? VALUE(lo) : INTERVAL(lo, mid);
-      bind_level_set(level);
-      bind(var, v, NULL);
-    }
-  }
-}
-
-// wait for all child processes to terminate
-void await_children(void) {
-  for (;;) {
-    int status;
-    pid_t pid = wait(&status);
-    if (pid == -1 && errno == ECHILD) {
-      break;
-    }
-  }
-}
-
-// let this worker process die
-void worker_die(void) {
-  sema_wait(&shared()->semaphore);
-  shared()->workers--;
-  sema_post(&shared()->semaphore);
-
-  // wait for all children before actually dying
-  await_children();
-
-  // print final statistics
-  if (stat_get_calls() > 0) {
-    print_stats(stdout);
-  }
-
-  // print termination information when "main" process dies
-  if (_worker_id == 1) {
-    if (shared()->timeout) {
-      fprintf(stdout, "TIMEOUT\n");
-    }
-    if (shared()->solutions == 0) {
-      fprintf(stdout, "NO SOLUTION FOUND\n");
-    }
-  }
-}
-
 // initialize solving timeout
 void timeout_init(uint32_t time_max) {
   _time_max = time_max;
@@ -218,38 +182,112 @@ static inline bool is_solution_restartable(void) {
   return objective() != OBJ_ALL;
 }
 
-// update the current solution
-static bool update_solution(size_t size, struct env_t *env, struct constr_t *constr) {
-  bool updated = false;
+// check whether the search can back-jump to resolve a conflict, which
+// would find solutions below the skipped levels again
+static inline bool is_backjumpable(void) {
+  return objective() != OBJ_ALL;
+}
 
-  // only update solution if it is actually valid
-  if (is_true(constr->type->eval(constr))) {
-    sema_wait(&shared()->semaphore);
+// set the function to receive solutions
+void solution_callback_init(solution_callback_t callback, void *data) {
+  _solution_callback = callback;
+  _solution_data = data;
+}
+
+// open the solution buffer of the current worker
+static void solution_open(void) {
+  _solution_out = open_memstream(&_solution_buf, &_solution_len);
+  // die if opening the buffer failed
+  if (_solution_out == NULL) {
+    print_fatal("%s", strerror(errno));
+  }
+}
+
+// write the buffered solutions at once and close the solution buffer
+static void solution_close(void) {
+  fclose(_solution_out);
+  _solution_out = NULL;
+  if (_solution_len > 0) {
+    fwrite(_solution_buf, 1, _solution_len, stdout);
+    fflush(stdout);
+  }
+  free(_solution_buf);
+  _solution_buf = NULL;
+  _solution_len = 0;
+}
 
-    // only print solution if it is actually better (inside semaphore to avoid race)
-    if (!found_any() && objective_better()) {
+// write the buffered solutions and start with an empty buffer
+static void solution_flush(void) {
+  solution_close();
+  solution_open();
+}
 
-      objective_update_best();
-      fprintf(stdout, "#%d: ", _worker_id);
-      print_solution(stdout, size, env);
-      shared()->solutions++;
+// publish a valid solution if it is actually better
+static bool publish_solution(size_t size, struct env_t *env) {
+  // only print solution if it is actually better, updating the best
+  // objective value atomically to avoid races with other workers
+  if (found_any() || !objective_better() || !objective_update_best()) {
+    return false;
+  }
 
-      updated = true;
+  if (objective() == OBJ_ANY) {
+    // only the first worker to find a solution prints it
+    uint64_t none = 0;
+    if (!__atomic_compare_exchange_n(&shared()->solutions, &none, 1, false,
+                                     __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST)) {
+      return false;
     }
+  } else {
+    __atomic_add_fetch(&shared()->solutions, 1, __ATOMIC_SEQ_CST);
+  }
+
+  // hand out solution instead of printing it if requested
+  if (_solution_callback != NULL) {
+    _solution_callback(size, env, objective_solution(), _solution_data);
+    return true;
+  }
+
+  fprintf(_solution_out, "#%d: ", _worker_id);
+  print_solution(_solution_out, size, env);
+  // solutions are written in batches when looking for all solutions
+  if (objective() != OBJ_ALL || ftell(_solution_out) >= SOLUTION_BUFFER_SIZE) {
+    solution_flush();
+  }
+
+  return true;
+}
+
+// update the current solution
+static bool update_solution(size_t size, struct env_t *env, struct constr_t *constr) {
+  // only update solution if it is actually valid
+  if (!is_true(constr->type->eval(constr))) {
+    return false;
+  }
 
+  // improvements of the objective value are published one at a time,
+  // such that the last solution written is the best one
+  if (objective() == OBJ_MIN || objective() == OBJ_MAX) {
+    sema_wait(&shared()->semaphore);
+    bool updated = publish_solution(size, env);
     sema_post(&shared()->semaphore);
+    return updated;
   }
 
-  return updated;
+  return publish_solution(size, env);
+}
+
+// propagate the objective value, return whether this failed
+static bool check_objective(void) {
+  return objective_val() != NULL && objective_val()->constr.term.env != NULL &&
+    propagate_clauses(objective_val()->constr.term.env) == PROP_ERROR;
 }
 
 // check the assignment of a value to a variable
 static bool check_assignment(struct env_t *var, size_t level) {
   // propagate values
   bool failed =
-    propagate_clauses(&var->clauses) == PROP_ERROR ||
-    (objective_val() != NULL && objective_val()->constr.term.env != NULL &&
-     propagate_clauses(&objective_val()->constr.term.env->clauses) == PROP_ERROR);
+    propagate_clauses(var) == PROP_ERROR ||
+    check_objective();
 
   // update statistics if propagation failed
   if (failed) {
@@ -281,7 +319,7 @@ static void step_activate(struct step_t *step, struct env_t *var) {
   step->var = var;
   step->bounds = var->val->constr.term.val;
   step->iter = 0;
-  step->seed = is_restartable() ? rand() : 0;
+  step->seed = is_restartable() ? strategy_rand() : 0;
 }
 
 // tear down iteration for a search step
@@ -337,6 +375,155 @@ static domain_t step_val(struct step_t *step) {
   return ((i ^ s) & 1U) ? hi - (i >> 1U) : lo + (i >> 1U);
 }
 
+// allocate a task with decisions down to a certain level
+static struct task_t *task_alloc(size_t level, size_t length) {
+  struct task_t *task = (struct task_t *)malloc(sizeof(struct task_t));
+  struct decision_t *decs = (struct decision_t *)malloc(length * sizeof(struct decision_t));
+  // die if allocation failed
+  if (task == NULL || (decs == NULL && length > 0)) {
+    print_fatal("%s", strerror(errno));
+  }
+  *task = (struct task_t){ .level = level, .length = length, .decs = decs, .next = NULL };
+  return task;
+}
+
+// release memory for a task
+static void task_free(struct task_t *task) {
+  free(task->decs);
+  free(task);
+}
+
+// add a task to the shared queue and signal it to idle workers
+static void task_push(struct task_t *task) {
+  sema_wait(&shared()->semaphore);
+  task->next = shared()->tasks;
+  shared()->tasks = task;
+  sema_post(&shared()->semaphore);
+  sema_post(&shared()->tasks_avail);
+}
+
+// wait for a task from the shared queue, NULL if all work is done
+static struct task_t *task_pop(void) {
+  // announce that this worker is idle
+  sema_wait(&shared()->semaphore);
+  ++shared()->idle;
+  sema_post(&shared()->semaphore);
+
+  sema_wait(&shared()->tasks_avail);
+  sema_wait(&shared()->semaphore);
+  struct task_t *task = shared()->tasks;
+  if (task != NULL) {
+    shared()->tasks = task->next;
+  }
+  sema_post(&shared()->semaphore);
+  return task;
+}
+
+// take a subproblem of the upfront decomposition, or wait for a task
+// from the shared queue if there are none left
+static struct task_t *task_next(void) {
+  sema_wait(&shared()->semaphore);
+  struct task_t *task = shared()->subproblems;
+  if (task != NULL) {
+    shared()->subproblems = task->next;
+  }
+  sema_post(&shared()->semaphore);
+  return task != NULL ? task : task_pop();
+}
+
+// get the values of a search step that have not been tried yet,
+// return whether there are any
+static bool step_remaining(struct step_t *step, domain_t *lo, domain_t *hi) {
+  udomain_t i = step->iter;
+  domain_t l = get_lo(step->bounds);
+  domain_t h = get_hi(step->bounds);
+  if ((udomain_t)(h - l) <= i) {
+    return false;
+  }
+  // values are taken alternately from both edges of the interval
+  udomain_t lo_count = (step->seed & 1U) ? (i + 1) / 2 : i / 2 + 1;
+  udomain_t hi_count = i + 1 - lo_count;
+  *lo = l + lo_count;
+  *hi = h - hi_count;
+  return true;
+}
+
+// give away untried values of the shallowest possible search step to
+// an idle worker
+static void worker_donate(struct step_t *steps, size_t level) {
+
+  // find the shallowest step with values that have not been tried yet
+  domain_t lo = 0;
+  domain_t hi = 0;
+  size_t donor;
+  for (donor = _worker_min_level; donor < _solver->size && donor <= level; donor++) {
+    if (!steps[donor].active || step_remaining(&steps[donor], &lo, &hi)) {
+      break;
+    }
+  }
+  if (donor >= _solver->size || donor > level || !steps[donor].active) {
+    return;
+  }
+
+  sema_wait(&shared()->semaphore);
+  // avoid race condition
+  if (shared()->idle == 0) {
+    sema_post(&shared()->semaphore);
+    return;
+  }
+  --shared()->idle;
+  ++shared()->workers;
+  sema_post(&shared()->semaphore);
+
+  // the idle worker replays the decisions that lead to the donating
+  // step and searches the remaining values of that step
+  struct task_t *task = task_alloc(donor, donor + 1);
+  for (size_t i = 0; i < donor; i++) {
+    task->decs[i] = (struct decision_t){ .var = (size_t)(steps[i].var - _solver->env),
+                                         .val = VALUE(step_val(&steps[i])) };
+  }
+  task->decs[donor] = (struct decision_t){ .var = (size_t)(steps[donor].var - _solver->env),
+                                           .val = INTERVAL(lo, hi) };
+  task_push(task);
+
+  // this worker keeps only the value currently tried
+  steps[donor].bounds = VALUE(step_val(&steps[donor]));
+  steps[donor].iter = 0;
+  if (donor == _worker_task->level && _worker_task->length > donor) {
+    _worker_task->decs[donor].val = steps[donor].bounds;
+  }
+}
+
+// mark the current task of this worker as done
+static void worker_done(void) {
+  sema_wait(&shared()->semaphore);
+  // wake up all workers to terminate when running out of work
+  if (--shared()->workers == 0) {
+    for (uint32_t i = 0; i < _workers_max; i++) {
+      sema_post(&shared()->tasks_avail);
+    }
+  }
+  sema_post(&shared()->semaphore);
+}
+
+// activate the search step at the start level of a task
+static void task_step_activate(struct step_t *step, struct task_t *task) {
+  struct env_t *var = &_solver->env[task->decs[task->level].var];
+  struct val_t v = var->val->constr.term.val;
+  domain_t lo = max(get_lo(v), get_lo(task->decs[task->level].val));
+  domain_t hi = min(get_hi(v), get_hi(task->decs[task->level].val));
+
+  strategy_var_order_remove(var);
+  step_activate(step, var);
+  if (lo <= hi) {
+    step->bounds = INTERVAL(lo, hi);
+  } else {
+    // no values left, mark iteration as exhausted
+    step->bounds = VALUE(lo);
+    step->iter = 1;
+  }
+}
+
 // unwind the search stack down to a certain level
 static void unwind(struct step_t *steps, size_t level, size_t stop) {
   // unwind search steps up to a specified level
@@ -346,21 +533,28 @@ static void unwind(struct step_t *steps, size_t level, size_t stop) {
   }
 }
 
-// back-track search process until a conflict can be resolved
-static size_t conflict_backtrack(struct step_t *steps, size_t level) {
-  prop_result_t p = PROP_ERROR;
+// back-track search process until a conflict can be resolved, return
+// whether propagating at the conflict level failed without a new
+// conflict to resolve, such that the level above must be left as well
+static bool conflict_backtrack(struct step_t *steps, size_t *level) {
+  prop_result_t p = PROP_NONE;
   // unwind search stack down to the conflict level
-  if (conflict_level() <= level) {
-    unwind(steps, level, level);
+  if (conflict_level() <= *level) {
+    unwind(steps, *level, *level);
+    p = PROP_ERROR;
   }
   // keep backtracking while there are (new) conflicts
-  while (p == PROP_ERROR && conflict_level() <= level) {
-    unwind(steps, level-1, conflict_level());
-    level = conflict_level();
-    bind_level_set(level-1);
-    p = propagate_clauses(&conflict_var()->clauses);
+  while (p == PROP_ERROR && conflict_level() <= *level) {
+    unwind(steps, *level-1, conflict_level());
+    *level = conflict_level();
+    bind_level_set(*level-1);
+    p = propagate_clauses(conflict_var());
   }
-  return level;
+  // learn from conflicts of other workers
+  conflict_import();
+  // forget conflicts that are unlikely to be useful
+  conflict_reduce();
+  return p == PROP_ERROR;
 }
 
 // backtrack by one level
@@ -376,15 +570,24 @@ static size_t conflict_backtrack(struct step_t *steps, size_t level) {
 // backtrack to conflict level
 #define CONFLICT_BACKTRACK()                    \
   {                                             \
-    level = conflict_backtrack(steps, level);   \
+    if (conflict_backtrack(steps, &level)) {    \
+      BACKTRACK();                              \
+    }                                           \
     continue;                                   \
   }
 
-// restart the search
+// restart the search, stop if the objective value cannot be improved
 #define RESTART()                               \
   {                                             \
     unwind(steps, level, _worker_min_level);    \
     level = _worker_min_level;                  \
+    conflict_import();                          \
+    conflict_reduce();                          \
+    objective_update_val();                     \
+    bind_level_set(level-1);                    \
+    if (check_objective()) {                    \
+      EXIT();                                   \
+    }                                           \
     continue;                                   \
   }
 
@@ -395,17 +598,11 @@ static size_t conflict_backtrack(struct step_t *steps, size_t level) {
   }
 
 // search algorithm core
-void solve(size_t size, struct env_t *env, struct constr_t *constr) {
+static void search(struct step_t *steps, size_t size, struct env_t *env, struct constr_t *constr) {
 
-  // start timeout
-  timeout_start();
+  size_t level = _worker_min_level;
 
-  // allocate data structure for search steps
-  struct step_t *steps = (struct step_t *)calloc(size, sizeof(struct step_t));
-
-  size_t level = 0;
-
-  while (!shared()->timeout) {
+  while (!shared()->timeout && !shared()->done) {
     if (level < _worker_min_level) {
       EXIT();
     }
@@ -415,6 +612,11 @@ void solve(size_t size, struct env_t *env, struct constr_t *constr) {
       EXIT();
     }
 
+    // share work with idle workers
+    if (!_portfolio && shared()->idle > 0) {
+      worker_donate(steps, level);
+    }
+
     // check if a better feasible solution is reached
     if (level == size) {
       bool update = update_solution(size, env, constr);
@@ -427,11 +629,14 @@ void solve(size_t size, struct env_t *env, struct constr_t *constr) {
     }
 
     if (!steps[level].active) {
-      // pick a variable
-      struct env_t *var = strategy_var_order_pop();
-      // spawn a worker if possible
-      worker_spawn(var, level);
-      step_activate(&steps[level], var);
+      if (level == _worker_task->level && _worker_task->length > level) {
+        // search the values given by the task
+        task_step_activate(&steps[level], _worker_task);
+      } else {
+        // pick a variable
+        struct env_t *var = strategy_var_order_pop();
+        step_activate(&steps[level], var);
+      }
     } else {
       // continue iteration
       step_leave(&steps[level]);
@@ -462,16 +667,363 @@ void solve(size_t size, struct env_t *env, struct constr_t *constr) {
       steps[level].var->prio++;
       if (check_restart()) {
         RESTART();
-      } else if (strategy_create_conflicts()) {
+      } else if (strategy_create_conflicts() && is_backjumpable()) {
         CONFLICT_BACKTRACK();
       }
     }
   }
+}
+
+// replay the decisions of a task, return whether this succeeded
+static bool task_replay(struct step_t *steps, struct task_t *task) {
+  // replay decisions above the start level as search steps
+  for (size_t level = 0; level < task->level; level++) {
+    struct env_t *var = &_solver->env[task->decs[level].var];
+    domain_t val = get_lo(task->decs[level].val);
+
+    // check that the value is still possible
+    struct val_t v = var->val->constr.term.val;
+    if (val < get_lo(v) || val > get_hi(v)) {
+      return false;
+    }
+
+    strategy_var_order_remove(var);
+    step_activate(&steps[level], var);
+    steps[level].bounds = VALUE(val);
+
+    bind_level_set(level);
+    step_enter(&steps[level], val);
+    objective_update_val();
+    if (check_assignment(var, level)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// search the sub-problem of a task
+static void task_run(struct step_t *steps, struct task_t *task) {
+  // mark state before the task
+  void *marker = alloc(0);
+  size_t patches = patch(NULL, NULL);
+  size_t binds = bind_depth();
+
+  // search sub-problem if replaying the decisions succeeded
+  _worker_task = task;
+  objective_update_val();
+  if (task_replay(steps, task)) {
+    _worker_min_level = task->level;
+    search(steps, _solver->size, _solver->env, _solver->constr);
+  }
+
+  // leave all search steps that are still active
+  for (size_t i = _solver->size; i > 0; i--) {
+    if (steps[i-1].active) {
+      step_leave(&steps[i-1]);
+      step_deactivate(&steps[i-1]);
+    }
+  }
+
+  // restore state from before the task
+  unbind(binds);
+  unpatch(patches);
+  dealloc(marker);
+}
+
+// record a subproblem with the values of the search steps above a
+// level, followed by the values to search at that level if any
+static void eps_record(struct step_t *steps, size_t level, size_t length, struct val_t val,
+                       struct task_t ***tail) {
+  struct task_t *task = task_alloc(level, length);
+  for (size_t i = 0; i < level; i++) {
+    task->decs[i] = (struct decision_t){ .var = (size_t)(steps[i].var - _solver->env),
+                                         .val = VALUE(step_val(&steps[i])) };
+  }
+  if (length > level) {
+    task->decs[level] = (struct decision_t){ .var = (size_t)(steps[level].var - _solver->env),
+                                             .val = val };
+  }
+  **tail = task;
+  *tail = &task->next;
+}
+
+// collect the consistent subproblems that result from splitting the
+// domains of variables in half up to a certain number of times, set
+// deeper if splitting further would yield more subproblems, return the
+// number of collected subproblems
+static size_t eps_collect(struct step_t *steps, size_t level, size_t depth, struct task_t ***tail, bool *deeper) {
+  // record complete assignments
+  if (level == _solver->size) {
+    eps_record(steps, level, level, VALUE(0), tail);
+    return 1;
+  }
+
+  struct step_t *step = &steps[level];
+  step_activate(step, strategy_var_order_pop());
+  domain_t lo = get_lo(step->bounds);
+  domain_t hi = get_hi(step->bounds);
+
+  // split the values into up to 2^depth parts of equal size, parts
+  // with a single value use up fewer splits
+  uint64_t width = (uint64_t)((int64_t)hi - lo) + 1;
+  uint64_t parts = depth < 32 && ((uint64_t)1 << depth) < width ? (uint64_t)1 << depth : width;
+  size_t splits = 0;
+  while (((uint64_t)1 << splits) < parts) {
+    splits++;
+  }
+
+  size_t count = 0;
+  for (uint64_t i = 0; i < parts; i++) {
+    // visit the parts alternately from both edges, like the search
+    uint64_t k = ((i ^ step->seed) & 1U) ? parts - 1 - (i >> 1) : i >> 1;
+    domain_t l = (domain_t)(lo + (int64_t)(k * width / parts));
+    domain_t h = (domain_t)(lo + (int64_t)((k + 1) * width / parts) - 1);
+
+    if (l < h) {
+      // leave the remaining values to the subproblem
+      eps_record(steps, level, parts > 1 ? level+1 : level, INTERVAL(l, h), tail);
+      *deeper = true;
+      count++;
+    } else {
+      // assign single values and continue with the next variable
+      step->bounds = VALUE(l);
+      step->iter = 0;
+      bind_level_set(level);
+      step_enter(step, l);
+      objective_update_val();
+      if (!check_assignment(step->var, level)) {
+        count += eps_collect(steps, level+1, depth - splits, tail, deeper);
+      }
+      step_leave(step);
+    }
+  }
+  step_deactivate(step);
+
+  return count;
+}
+
+// decompose the problem into at least a certain number of
+// subproblems where possible, return the list of subproblems
+static struct task_t *decompose(struct solver_t *solver, size_t target, size_t *count) {
+  _solver = solver;
+
+  // allocate data structure for search steps
+  struct step_t *steps = (struct step_t *)calloc(solver->size, sizeof(struct step_t));
+
+  // start with the whole problem
+  struct task_t *tasks = task_alloc(0, 0);
+  *count = 1;
+
+  // split domains once more until there are enough subproblems, which
+  // at most doubles the number of subproblems each time
+  bool deeper = true;
+  for (size_t depth = 1; deeper && *count > 0 && *count < target; depth++) {
+    while (tasks != NULL) {
+      struct task_t *next = tasks->next;
+      task_free(tasks);
+      tasks = next;
+    }
+    struct task_t **tail = &tasks;
+    deeper = false;
+    *count = eps_collect(steps, 0, depth, &tail, &deeper);
+  }
 
   // release memory again
   free(steps);
 
-  // wait for children and die
-  worker_die();
+  return tasks;
 }
 
+// write the subproblems of the decomposition as cubes
+static void write_cubes(struct solver_t *solver) {
+  size_t count;
+  struct task_t *tasks = decompose(solver, cube_count(), &count);
+  while (tasks != NULL) {
+    struct task_t *next = tasks->next;
+    cube_write(stdout, solver->env, tasks);
+    task_free(tasks);
+    tasks = next;
+  }
+
+  if (count == 0) {
+    fprintf(stdout, "NO SOLUTION FOUND\n");
+  } else if (count == 1) {
+    print_warning(WARNING_MSG_SINGLE_CUBE);
+  }
+}
+
+// create the task to start searching with, either the whole problem
+// or the cube to solve
+static struct task_t *task_root(struct solver_t *solver) {
+  if (cube_file() == NULL) {
+    return task_alloc(0, 0);
+  }
+
+  struct decision_t *decs = NULL;
+  size_t length = cube_read(solver->size, solver->env, &decs);
+  // values of a variable restricted to an interval are searched at the
+  // start level
+  size_t level = length > 0 && !is_value(decs[length-1].val) ? length - 1 : length;
+  struct task_t *task = task_alloc(level, length);
+  if (length > 0) {
+    memcpy(task->decs, decs, length * sizeof(struct decision_t));
+  }
+  free(decs);
+  return task;
+}
+
+// search tasks until all work is done
+static void worker_run(struct solver_t *solver, struct task_t *task) {
+  _solver = solver;
+  _worker_id = solver->id;
+  conflict_share_init(_workers_max > 1 ? solver->env : NULL, solver->id);
+  conflict_reduce_init();
+  solution_open();
+
+  // allocate data structure for search steps
+  struct step_t *steps = (struct step_t *)calloc(solver->size, sizeof(struct step_t));
+
+  // wait for work if there is no initial task
+  if (task == NULL) {
+    task = task_next();
+  }
+
+  while (task != NULL) {
+    task_run(steps, task);
+    task_free(task);
+    // the first worker in a portfolio to complete stops all others
+    if (_portfolio && !shared()->timeout) {
+      shared()->done = true;
+    }
+    worker_done();
+    task = task_next();
+  }
+
+  // release memory again
+  free(steps);
+
+  // write remaining solutions
+  solution_close();
+
+  // print final statistics, unless solutions are handed out
+  if (_solution_callback == NULL && stat_get_calls() > 0) {
+    print_stats(stdout);
+  }
+}
+
+// thread function of additional workers
+static void *worker_thread(void *arg) {
+  struct solver_t *solver = (struct solver_t *)arg;
+
+  // initialize private data structures of worker
+  alloc_init(_worker_alloc_size);
+  bind_init(_worker_bind_size);
+  patch_init(_worker_patch_size);
+  conflict_alloc_init(_worker_confl_size);
+  stats_init();
+  strategy_set(&_worker_strategy);
+  if (_portfolio) {
+    strategy_diversify(solver->id);
+  }
+
+  // create private copy of the model
+  solver_clone(solver, &_template, objective_val());
+  clauses_init(solver->constr, NULL);
+  compile_init(solver->env);
+  strategy_var_order_init(solver->size, solver->env);
+
+  // in a portfolio, each worker searches the whole problem
+  worker_run(solver, _portfolio ? task_root(solver) : NULL);
+
+  // release private data structures of worker
+  for (size_t i = 0; i < solver->size; i++) {
+    clause_list_free(&solver->env[i].clauses);
+    clause_list_free(&solver->env[i].watches);
+  }
+  strategy_var_order_free();
+  propagate_free();
+  compile_free();
+  conflict_alloc_free();
+  patch_free();
+  bind_free();
+  alloc_free();
+
+  return NULL;
+}
+
+// find solutions, using all available workers
+void solve(size_t size, struct env_t *env, struct constr_t *constr) {
+
+  // start timeout
+  timeout_start();
+
+  struct solver_t root = { .size = size, .env = env, .constr = constr,
+                           .obj = objective_val(), .id = 1 };
+
+  // only split the problem into cubes if requested
+  if (cube_count() > 0) {
+    write_cubes(&root);
+    return;
+  }
+
+  // race workers with different strategies, unless looking for all solutions
+  _portfolio = strategy_portfolio() && objective() != OBJ_ALL && _workers_max > 1;
+  strategy_get(&_worker_strategy);
+  if (_portfolio) {
+    shared()->workers = _workers_max;
+    strategy_diversify(root.id);
+  }
+
+  // decompose the problem upfront if requested
+  _eps = strategy_eps() > 0 && !_portfolio && _workers_max > 1 && cube_file() == NULL;
+
+  // create template model and start additional workers
+  struct solver_t *workers = (struct solver_t *)calloc(_workers_max, sizeof(struct solver_t));
+  if (_workers_max > 1) {
+    solver_clone(&_template, &root, NULL);
+    _worker_alloc_size = alloc_size();
+    _worker_bind_size = bind_size();
+    _worker_patch_size = patch_size();
+    _worker_confl_size = conflict_alloc_size();
+  }
+  // workers may take all subproblems before this worker starts, so
+  // whether the problem was decomposed must be decided beforehand
+  bool decomposed = false;
+  if (_eps) {
+    size_t count;
+    struct task_t *tasks = decompose(&root, (size_t)strategy_eps() * _workers_max, &count);
+    // make subproblems available to workers
+    if (tasks != NULL) {
+      shared()->subproblems = tasks;
+      shared()->workers = count;
+      decomposed = true;
+    }
+  }
+  for (uint32_t i = 1; i < _workers_max; i++) {
+    workers[i].id = i+1;
+    int status = pthread_create(&workers[i].thread, NULL, worker_thread, &workers[i]);
+    if (status != 0) {
+      print_fatal("%s", strerror(status));
+    }
+  }
+
+  // search the whole problem in this worker, unless it was decomposed
+  worker_run(&root, decomposed ? NULL : task_root(&root));
+
+  // wait for all workers to terminate
+  for (uint32_t i = 1; i < _workers_max; i++) {
+    pthread_join(workers[i].thread, NULL);
+  }
+  free(workers);
+
+  // print termination information, unless solutions are handed out
+  if (_solution_callback == NULL) {
+    if (shared()->timeout) {
+      fprintf(stdout, "TIMEOUT\n");
+    }
+    if (shared()->solutions == 0) {
+      fprintf(stdout, "NO SOLUTION FOUND\n");
+    }
+  }
+}
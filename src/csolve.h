@@ -19,6 +19,7 @@ along with CSolve.  If not, see <http://www.gnu.org/licenses/>.
 #ifndef CSOLVE_H
 #define CSOLVE_H
 
+#include <pthread.h>
 #include <semaphore.h>
 #include <stdbool.h>
 #include <stdint.h>
@@ -88,22 +89,57 @@ typedef int32_t prop_result_t;
 /** Propagation tag type */
 typedef uint64_t prop_tag_t;
 
+/** Type for events of variable changes that clauses subscribe to */
+typedef uint8_t prop_event_t;
+/** Lower bound of variable was raised */
+#define PROP_EVENT_LB  0x01
+/** Upper bound of variable was lowered */
+#define PROP_EVENT_UB  0x02
+/** Variable was fixed to a single value */
+#define PROP_EVENT_FIX 0x04
+/** Any change of a variable */
+#define PROP_EVENT_ANY (PROP_EVENT_LB | PROP_EVENT_UB | PROP_EVENT_FIX)
+
 /** Type for a wide-and element */
 struct wand_expr_t {
   struct constr_t *constr; ///< The constraint
   struct constr_t *orig; ///< The original/unpatched constrained
   prop_tag_t prop_tag; ///< Propagation tag
+  const struct code_t *code; ///< Compiled clause, NULL if the clause is not compiled
 };
 
 /** Type for conflict element */
 struct confl_elem_t {
-  struct val_t val; ///< Conflict value
+  struct val_t val; ///< Conflict bounds, DOMAIN_MIN or DOMAIN_MAX if open
   struct constr_t *var; ///< Conflict variable
 };
 
+/** Type for a term of a linear expression */
+struct lin_term_t {
+  domain_t coef; ///< Coefficient
+  struct constr_t *var; ///< Variable
+};
+
+/** Type for a task of a scheduling expression */
+struct sched_task_t {
+  struct constr_t *start; ///< Start time
+  struct constr_t *dur; ///< Duration
+  struct constr_t *demand; ///< Resource demand, NULL for a demand of one
+};
+
+/** Type for a difference of two variables with an upper bound */
+struct diff_t {
+  struct constr_t *l; ///< Minuend, a variable
+  struct constr_t *r; ///< Subtrahend, a variable
+  domain_t c; ///< Upper bound of the difference
+};
+
 /** Type representing a constraint */
 struct constr_t {
   const struct constr_type_t *type; ///< Type of constraint node
+  struct val_t cache; ///< Value of expression when it was last evaluated
+  uint64_t cache_epoch; ///< Evaluation epoch of the cached value, 0 if there is none
+  uint64_t seen_epoch; ///< Epoch of the latest conflict creation that saw this node, 0 if none
   /** Union to hold either terminal node or expression node */
   union constr_union_t {
     /** Terminal node type */
@@ -116,6 +152,23 @@ struct constr_t {
       struct constr_t *l; ///< Left child of expression
       struct constr_t *r; ///< Right child of expression, NULL for unary operators
     } expr; ///< Expression node
+    /** Linear expression node type */
+    struct lin_t {
+      size_t length; ///< Number of terms
+      struct lin_term_t *terms; ///< Terms, summed up
+    } lin; ///< Linear expression node
+    /** All-different node type */
+    struct alldiff_t {
+      size_t length; ///< Number of sub-expressions
+      struct constr_t **elems; ///< Sub-expressions, which must take different values
+    } alldiff; ///< All-different node
+    struct diff_t diff; ///< Difference node, l - r <= c
+    /** Scheduling node type */
+    struct sched_t {
+      size_t length; ///< Number of tasks
+      struct sched_task_t *tasks; ///< Tasks, which must not overload the resource
+      struct constr_t *cap; ///< Resource capacity, NULL for a capacity of one
+    } sched; ///< Disjunctive or cumulative resource node
     /** Wide-and node type */
     struct wand_t {
       size_t length; ///< Number of sub-expressions
@@ -139,19 +192,39 @@ struct constr_t {
   F(LT,   lt,   '<')                            \
   /** Negation */                               \
   F(NEG,  neg,  '-')                            \
+  /** Absolute value */                         \
+  F(ABS,  abs,  'B')                            \
   /** Addition */                               \
   F(ADD,  add,  '+')                            \
   /** Multiplication */                         \
   F(MUL,  mul,  '*')                            \
+  /** Division towards zero, x / 0 = 0 */       \
+  F(DIV,  div,  '/')                            \
+  /** Remainder of division, x % 0 = x */       \
+  F(MOD,  mod,  '%')                            \
+  /** Minimum */                                \
+  F(MIN,  min,  'N')                            \
+  /** Maximum */                                \
+  F(MAX,  max,  'X')                            \
+  /** Linear expression */                      \
+  F(LIN,  lin,  'L')                            \
   /** Logical not */                            \
   F(NOT,  not,  '!')                            \
   /** Logical and */                            \
   F(AND,  and,  '&')                            \
   /** Logical or */                             \
   F(OR,   or,   '|')                            \
+  /** Difference bound */                       \
+  F(DIFF, diff, 'F')                            \
+  /** All different */                          \
+  F(ALLDIFF, alldiff, 'D')                      \
+  /** Disjunctive resource */                   \
+  F(DISJ, disj, 'J')                            \
+  /** Cumulative resource */                    \
+  F(CUMUL, cumul, 'U')                          \
   /** Wide and */                               \
   F(WAND, wand, 'A')                            \
-  /** Conflict */                               \
+  /** Conflict over bound literals */           \
   F(CONFL, confl, 'C')
 
 /** Supported operators */
@@ -193,6 +266,31 @@ static inline bool is_const(struct constr_t *c) {
   ((struct constr_t){                                                   \
     .type = &(CONSTR_ ## T), .constr = { .expr = { .l = (L), .r = (R) } } } )
 
+/** Create a linear expression */
+#define CONSTRAINT_LIN(L, T)                                            \
+  ((struct constr_t) {                                                  \
+    .type = &CONSTR_LIN, .constr = { .lin = { .length = (L), .terms = (T) } } } )
+
+/** Create an all-different constraint */
+#define CONSTRAINT_ALLDIFF(L, E)                                        \
+  ((struct constr_t) {                                                  \
+    .type = &CONSTR_ALLDIFF, .constr = { .alldiff = { .length = (L), .elems = (E) } } } )
+
+/** Create a difference constraint L - R <= C */
+#define CONSTRAINT_DIFF(L, R, C)                                        \
+  ((struct constr_t) {                                                  \
+    .type = &CONSTR_DIFF, .constr = { .diff = { .l = (L), .r = (R), .c = (C) } } } )
+
+/** Create a disjunctive resource constraint */
+#define CONSTRAINT_DISJ(L, T)                                           \
+  ((struct constr_t) {                                                  \
+    .type = &CONSTR_DISJ, .constr = { .sched = { .length = (L), .tasks = (T), .cap = NULL } } } )
+
+/** Create a cumulative resource constraint */
+#define CONSTRAINT_CUMUL(L, T, C)                                       \
+  ((struct constr_t) {                                                  \
+    .type = &CONSTR_CUMUL, .constr = { .sched = { .length = (L), .tasks = (T), .cap = (C) } } } )
+
 /** Create a wide-and constraint */
 #define CONSTRAINT_WAND(L, E)                                           \
   ((struct constr_t) {                                                  \
@@ -203,10 +301,13 @@ static inline bool is_const(struct constr_t *c) {
   ((struct constr_t) {                                                  \
     .type = &CONSTR_CONFL, .constr = { .confl = { .length = (L), .elems = (E) } } } )
 
-/** Patching entry */
+/** Patching entry, either for a sub-expression or for an element
+    dropped from a clause list */
 struct patching_t {
-  struct wand_expr_t *loc; ///< Location of patched sub-expressions
+  struct wand_expr_t *loc; ///< Location of patched sub-expressions, NULL for dropped elements
   struct constr_t *constr; ///< Original value of patched sub-expressions (for unpatching)
+  struct clause_list_t *list; ///< Clause list an element was dropped from
+  size_t index; ///< Index of dropped element before dropping it
 };
 
 /** Type holding information for a solving step */
@@ -225,6 +326,41 @@ struct step_t {
 struct clause_list_t {
   size_t length; ///< Length of list
   struct wand_expr_t **elems; ///< Clause
+  prop_event_t *events; ///< Events each clause subscribes to
+  size_t dead; ///< Number of entailed clauses at the start of the list, which are not propagated
+};
+
+/** Opcodes of compiled clauses */
+enum opcode_t {
+  OPC_CONST, ///< Constant value
+  OPC_VAR,   ///< Value of variable
+  OPC_EQ,    ///< Equality
+  OPC_LT,    ///< Less-than
+  OPC_NEG,   ///< Negation
+  OPC_ADD,   ///< Addition
+  OPC_MUL,   ///< Multiplication
+  OPC_NOT,   ///< Logical not
+  OPC_AND,   ///< Logical and
+  OPC_OR     ///< Logical or
+};
+
+/** Instruction of a compiled clause, its operands are the instructions
+    preceding it */
+struct instr_t {
+  enum opcode_t op; ///< Opcode
+  size_t size; ///< Number of instructions of the sub-expression that ends with this instruction
+  /** Union to hold the argument of instructions */
+  union instr_arg_t {
+    struct val_t val; ///< Constant value
+    size_t var; ///< Index of variable in environment
+    size_t left; ///< Position of left operand of expressions, the right operand precedes the instruction
+  } arg; ///< Argument
+};
+
+/** Compiled clause, a post-order array of instructions */
+struct code_t {
+  size_t length; ///< Number of instructions
+  struct instr_t *instrs; ///< Instructions
 };
 
 /** Variable environment entry */
@@ -233,9 +369,14 @@ struct env_t {
   struct constr_t *val; ///< Value of variable
   struct binding_t *binds; ///< bindings of this variable
   struct clause_list_t clauses; ///< Clauses affected by this value
+  struct clause_list_t watches; ///< Conflicts watching an element of this variable
   size_t order; ///< Position in variable ordering
   int64_t prio; ///< Priority of this variable
   size_t level; ///< Assignment level of this variable
+  prop_tag_t prop_tag; ///< Propagation tag of latest change while queued, 0 otherwise
+  prop_event_t prop_events; ///< Events of changes while queued
+  uint64_t seen_epoch; ///< Epoch of the latest conflict creation that saw this variable, 0 if none
+  const struct binding_t *seen_bind; ///< Latest binding the conflict being created depends on, valid while seen
 };
 
 /** Types of objective functions */
@@ -255,14 +396,77 @@ enum order_t {
   ORDER_LARGEST_VALUE    ///< Pick variable with highest possible value
 };
 
+/** Orders in which to propagate clauses affected by changed variables */
+enum prop_order_t {
+  PROP_ORDER_FIFO,       ///< Propagate clauses in the order variables changed
+  PROP_ORDER_CHEAP_FIRST ///< Defer expensive clauses until cheap ones reach a fixpoint
+};
+
+/** Strategy settings of a worker */
+struct strategy_t {
+  bool create_conflicts; ///< Whether to create conflict clauses
+  bool prefer_failing; ///< Whether to prefer failing variables when ordering
+  bool compute_weights; ///< Whether to compute weights for initial ordering
+  uint64_t restart_frequency; ///< Restart frequency
+  enum order_t order; ///< Variable ordering
+  enum prop_order_t prop_order; ///< Order of propagating queued clauses
+  unsigned int seed; ///< State of random number generator
+};
+
+/** Decision that leads to a sub-problem */
+struct decision_t {
+  size_t var; ///< Index of decided variable in environment
+  struct val_t val; ///< Value of decided variable
+};
+
+/** A sub-problem to be searched by a worker */
+struct task_t {
+  size_t level; ///< Search level where the sub-problem starts
+  size_t length; ///< Number of decisions
+  struct decision_t *decs; ///< Decisions, one per level below the start level, optionally followed by the values to search at the start level
+  struct task_t *next; ///< Next task in queue
+};
+
+/** Maximum number of elements in conflicts shared between workers */
+#define CONFLICT_SHARE_LENGTH_MAX 8
+/** Maximum number of different levels in conflicts shared between workers */
+#define CONFLICT_SHARE_LEVELS_MAX 4
+/** Number of conflicts kept for exchange between workers */
+#define CONFLICT_SHARE_RING_SIZE 1024
+
+/** Conflict shared between workers */
+struct shared_confl_t {
+  uint32_t worker; ///< Worker that created the conflict
+  size_t length; ///< Number of conflict elements
+  struct decision_t elems[CONFLICT_SHARE_LENGTH_MAX]; ///< Conflict elements, with variables as indices
+};
+
 /** A struct holding shared information */
 struct shared_t {
   sem_t semaphore; ///< Semaphore to synchronize accesses to shared data
-  volatile uint32_t workers; ///< Number of active workers
-  volatile uint32_t workers_id; ///< Number of generated workers
+  sem_t tasks_avail; ///< Semaphore to signal available tasks to idle workers
+  struct task_t *tasks; ///< Tasks waiting for a worker
+  struct task_t *subproblems; ///< Subproblems of the upfront decomposition waiting for a worker
+  volatile uint32_t workers; ///< Number of active workers, including pending tasks
+  volatile uint32_t idle; ///< Number of idle workers not yet served with a task
   volatile domain_t objective_best; ///< The current best objective value
+  volatile uint64_t objective_epoch; ///< Number of updates to the best objective value
   volatile uint64_t solutions; ///< Number of solutions found
   volatile bool     timeout; ///< Whether timeout has occurred
+  volatile bool     done; ///< Whether some worker completed the search
+  sem_t confl_semaphore; ///< Semaphore to synchronize accesses to shared conflicts
+  volatile uint64_t confl_head; ///< Number of conflicts shared so far
+  struct shared_confl_t confls[CONFLICT_SHARE_RING_SIZE]; ///< Ring buffer of shared conflicts
+};
+
+/** Solver context of a worker */
+struct solver_t {
+  size_t size; ///< Number of variables
+  struct env_t *env; ///< Variable environment
+  struct constr_t *constr; ///< Constraint to solve
+  struct constr_t *obj; ///< Objective value variable, NULL if there is none
+  uint32_t id; ///< Worker ID
+  pthread_t thread; ///< Thread running the worker
 };
 
 /* Mark noreturn functions as such, except when unit testing */
@@ -272,6 +476,14 @@ struct shared_t {
 #define noreturn
 #endif
 
+/* State that is private to each worker thread. Search state lives in
+   thread-local module variables instead of being passed around in
+   struct solver_t, so workers can run the same functions concurrently
+   without a context argument. A thread can therefore run only one
+   search at a time, and the state of a search cannot move to another
+   thread. */
+#define THREAD_LOCAL __thread
+
 /** Negate a value */
 domain_t neg(domain_t a);
 /** Add two values */
@@ -282,6 +494,10 @@ domain_t mul(domain_t a, domain_t b);
 domain_t min(domain_t a, domain_t b);
 /** Return maximum of two values */
 domain_t max(domain_t a, domain_t b);
+/** Divide and round towards negative infinity */
+ddomain_t div_floor(ddomain_t a, ddomain_t b);
+/** Divide and round towards positive infinity */
+ddomain_t div_ceil(ddomain_t a, ddomain_t b);
 
 /** Default size of allocation stack */
 #define ALLOC_STACK_SIZE_DEFAULT (128*1024*1024)
@@ -293,6 +509,8 @@ void alloc_free(void);
 void *alloc(size_t size);
 /** Deallocate memory on the allocation stack */
 void dealloc(void *elem);
+/** Get the size of the allocation stack */
+size_t alloc_size(void);
 
 /** Default size of bind stack */
 #define BIND_STACK_SIZE_DEFAULT (1024*1024)
@@ -308,10 +526,19 @@ size_t bind_depth(void);
 void bind_level_set(size_t level);
 /** Set the current bind level */
 size_t bind_level_get(void);
-/** Bind a variable to a specific value */
-void bind(struct env_t *var, struct val_t val, const struct wand_expr_t *clause);
+/** Bind a variable to a specific value, return the events of the change */
+prop_event_t bind(struct env_t *var, struct val_t val, const struct wand_expr_t *clause);
 /** Undo variable binds down to a given depth */
 void unbind(size_t depth);
+/** Get the size of the bind stack */
+size_t bind_size(void);
+/** Get the binding at a certain depth of the binding stack, which
+    must be below the current depth */
+const struct binding_t *bind_get(size_t depth);
+/** Function to move a pointer along with the memory it points to */
+typedef void *(*relocate_t)(const void *ptr);
+/** Relocate the clauses that inferred bindings */
+void bind_relocate(relocate_t relocate);
 
 /** Default size of patch stack */
 #define PATCH_STACK_SIZE_DEFAULT (1024*1024)
@@ -325,9 +552,11 @@ void patch_commit(void);
 size_t patch(struct wand_expr_t *loc, struct constr_t *constr);
 /** Undo patches down to a given depth */
 void unpatch(size_t depth);
+/** Get the size of the patch stack */
+size_t patch_size(void);
 
-/** Initialize a semaphore */
-void sema_init(sem_t *sema);
+/** Initialize a semaphore with an initial value */
+void sema_init(sem_t *sema, uint32_t value);
 /** Wait for a semaphore */
 void sema_wait(sem_t *sema);
 /** Release a semaphore */
@@ -335,14 +564,54 @@ void sema_post(sem_t *sema);
 
 /** Check whether a clause list already contains an element */
 bool clause_list_contains(struct clause_list_t *list, struct wand_expr_t *elem);
-/** Add an element to a clause list */
-void clause_list_append(struct clause_list_t *list, struct wand_expr_t *elem);
+/** Add an element that subscribes to some events to a clause list */
+void clause_list_append(struct clause_list_t *list, struct wand_expr_t *elem, prop_event_t events);
+/** Subscribe an element of a clause list to additional events, adding it if needed */
+void clause_list_subscribe(struct clause_list_t *list, struct wand_expr_t *elem, prop_event_t events);
+/** Release memory of a clause list */
+void clause_list_free(struct clause_list_t *list);
+/** Drop an entailed element from the live part of a clause list until
+    unpatching, return the depth of the patch stack before dropping */
+size_t clause_list_drop(struct clause_list_t *list, size_t index);
+/** Remove an element from a clause list for good, the last element
+    takes its place; only for lists that elements are never dropped from */
+void clause_list_remove(struct clause_list_t *list, size_t index);
+/** Remove the elements that are not to be kept from the live parts of
+    clause lists sorted by address, return the number of removed elements */
+size_t clause_lists_compact(struct clause_list_t **lists, size_t count, bool (*keep)(const struct wand_expr_t *));
+
+/** Evaluation epoch, values cached by expressions are only valid
+    during the epoch they were computed in */
+extern THREAD_LOCAL uint64_t eval_epoch;
+/** Start a new evaluation epoch after changing the value of a terminal */
+static inline void eval_invalidate(void) {
+  eval_epoch++;
+}
 
 /** Evaluation functions for different constraint types */
 #define CONSTR_TYPE_EVAL_FUNCS(UPNAME, NAME, OP)                    \
   struct val_t eval_ ## NAME(const struct constr_t *constr);
 CONSTR_TYPE_LIST(CONSTR_TYPE_EVAL_FUNCS)
 
+/** Evaluation functions for operators applied to values of sub-expressions */
+struct val_t eval_eq_vals(struct val_t a, struct val_t b);
+struct val_t eval_lt_vals(struct val_t a, struct val_t b);
+struct val_t eval_neg_vals(struct val_t a);
+struct val_t eval_add_vals(struct val_t a, struct val_t b);
+struct val_t eval_mul_vals(struct val_t a, struct val_t b);
+struct val_t eval_div_vals(struct val_t a, struct val_t b);
+struct val_t eval_mod_vals(struct val_t a, struct val_t b);
+struct val_t eval_abs_vals(struct val_t a);
+struct val_t eval_min_vals(struct val_t a, struct val_t b);
+struct val_t eval_max_vals(struct val_t a, struct val_t b);
+struct val_t eval_not_vals(struct val_t a);
+struct val_t eval_and_vals(struct val_t lval, struct val_t rval);
+struct val_t eval_or_vals(struct val_t lval, struct val_t rval);
+/** Values a factor may take such that multiplying it with a value of
+    the other factor yields a value of the product, an empty interval
+    (lower bound above upper bound) if there are none */
+struct val_t eval_quot_vals(struct val_t p, struct val_t f);
+
 /** Propagation functions for different constraint types */
 #define CONSTR_TYPE_PROP_FUNCS(UPNAME, NAME, OP)                    \
   prop_result_t propagate_ ## NAME(struct constr_t *constr, struct val_t val, const struct wand_expr_t *clause);
@@ -358,15 +627,48 @@ struct constr_t *normalize(struct constr_t *constr);
 
 /** Propagate "true" to the terminal nodes of the constraint */
 prop_result_t propagate(struct constr_t *constr, size_t limit);
-/** Propagate updates to a list of clauses */
-prop_result_t propagate_clauses(const struct clause_list_t *clauses);
-
+/** Propagate updates to the clauses of a variable */
+prop_result_t propagate_clauses(struct env_t *var);
+/** Watch the first two elements of a conflict clause */
+void propagate_watch(struct wand_expr_t *clause);
+/** Release memory used for queueing clauses during propagation */
+void propagate_free(void);
+
+/** Set the variable environment compiled clauses refer to */
+void compile_init(struct env_t *env);
+/** Compile a constraint, return NULL if it cannot be compiled */
+struct code_t *compile(const struct constr_t *constr);
+/** Compile the clauses of a model */
+void compile_clauses(struct constr_t *constr);
+/** Evaluate a compiled clause */
+struct val_t code_eval(const struct code_t *code);
+/** Propagate "true" to a compiled clause */
+prop_result_t code_propagate(const struct code_t *code, const struct wand_expr_t *clause);
+/** Release memory used for evaluating compiled clauses */
+void compile_free(void);
+
+/** Number of learned conflicts to keep before reducing them for the first time */
+#define CONFLICT_DB_SIZE_INIT 2000
+/** Increment of the number of learned conflicts to keep with each reduction */
+#define CONFLICT_DB_SIZE_INC 300
+/** Learned conflicts over at most this many levels are only removed
+    when running out of conflict memory */
+#define CONFLICT_DB_GLUE_LBD 2
 /** Default size of conflict allocation stack */
 #define CONFLICT_ALLOC_STACK_SIZE_DEFAULT (128*1024*1024)
 /** Initialize the conflict allocation stack */
 void conflict_alloc_init(size_t size);
 /** Deallocate memory occupied by the conflict allocation stack */
 void conflict_alloc_free(void);
+/** Get the size of the conflict allocation stack */
+size_t conflict_alloc_size(void);
+/** Get the current position in the conflict allocation stack */
+size_t conflict_alloc_depth(void);
+/** Release all conflict memory allocated after a position */
+void conflict_alloc_release(size_t depth);
+/** Set the depth of the binding stack where the current run starts,
+    bindings at the root level above it only hold for this run */
+void conflict_root_init(size_t depth);
 /** Create a conflict clause */
 void conflict_create(struct env_t *var, const struct wand_expr_t *clause);
 /** Get level of last generated conflict */
@@ -375,25 +677,51 @@ size_t conflict_level(void);
 struct env_t *conflict_var(void);
 /** Reset information about last generated conflict */
 void conflict_reset(void);
+/** Initialize sharing conflicts for a worker, a NULL environment disables sharing */
+void conflict_share_init(struct env_t *env, uint32_t id);
+/** Import conflicts shared by other workers */
+void conflict_import(void);
+/** Initialize reducing the conflicts learned from now on */
+void conflict_reduce_init(void);
+/** Remove learned conflicts that are unlikely to be useful, only
+    while no propagation is in progress */
+void conflict_reduce(void);
 
 /** Initialize objective function type */
-void objective_init(enum objective_t o, volatile domain_t *best);
+void objective_init(enum objective_t o, volatile domain_t *best, volatile uint64_t *epoch);
+/** Forget the best solution found so far, to search a model again */
+void objective_reset(void);
 /** Get objective function type */
 enum objective_t objective(void);
 /** Check whether the objective value can be possibly better */
 bool objective_better(void);
 /** Get the current best objective value */
 domain_t objective_best(void);
+/** Get the objective value of the last solution found by this worker */
+domain_t objective_solution(void);
 /** Get a pointer to the objective value variable */
 struct constr_t *objective_val(void);
-/** Update the current best objective value */
-void objective_update_best(void);
+/** Atomically update the current best objective value, return
+    whether the objective value is better than the current best one */
+bool objective_update_best(void);
 /** Update the objective value variable */
 void objective_update_val(void);
+/** Check for updates of the best objective value by any worker, return whether the objective value cannot be better anymore */
+bool objective_poll(void);
 
 /** Find solutions */
 void solve(size_t size, struct env_t *env, struct constr_t *constr);
 
+/** Function to receive a solution and the objective value of it, may
+    be called by several workers at the same time */
+typedef void (*solution_callback_t)(size_t size, const struct env_t *env, domain_t objective, void *data);
+/** Set the function to receive solutions instead of printing them,
+    NULL to print solutions */
+void solution_callback_init(solution_callback_t callback, void *data);
+
+/** Clone the model of a solver context, using obj as objective value variable if not NULL */
+void solver_clone(struct solver_t *dst, const struct solver_t *src, struct constr_t *obj);
+
 /** Whether to create conflict clauses as default */
 #define STRATEGY_CREATE_CONFLICTS_DEFAULT true
 /** Set whether to create conflict clauses */
@@ -426,6 +754,37 @@ uint64_t strategy_restart_frequency(void);
 #define STRATEGY_ORDER_DEFAULT ORDER_NONE
 /** Set the ordering to use when searching */
 void strategy_order_init(enum order_t order);
+
+/** Which order to propagate queued clauses in as default */
+#define STRATEGY_PROP_ORDER_DEFAULT PROP_ORDER_FIFO
+/** Set the order to propagate queued clauses in */
+void strategy_prop_order_init(enum prop_order_t prop_order);
+/** Get the order to propagate queued clauses in */
+enum prop_order_t strategy_prop_order(void);
+
+/** Whether to run different strategies in parallel as default */
+#define STRATEGY_PORTFOLIO_DEFAULT false
+/** Set whether to run different strategies in parallel */
+void strategy_portfolio_init(bool portfolio);
+/** Get whether to run different strategies in parallel */
+bool strategy_portfolio(void);
+
+/** Number of subproblems per worker for upfront decomposition as default, 0 to disable */
+#define STRATEGY_EPS_DEFAULT 0
+/** Set the number of subproblems per worker for upfront decomposition */
+void strategy_eps_init(uint32_t eps);
+/** Get the number of subproblems per worker for upfront decomposition */
+uint32_t strategy_eps(void);
+
+/** Get the strategy settings of the current worker */
+void strategy_get(struct strategy_t *strategy);
+/** Set the strategy settings of the current worker */
+void strategy_set(const struct strategy_t *strategy);
+/** Vary the strategy settings of the current worker depending on its ID */
+void strategy_diversify(uint32_t id);
+/** Get a random number from the generator of the current worker */
+int strategy_rand(void);
+
 /** Initialize the variable ordering */
 void strategy_var_order_init(size_t size, struct env_t *env);
 /** Free memory used by the variable ordering */
@@ -434,6 +793,8 @@ void strategy_var_order_free(void);
 struct env_t *strategy_var_order_pop(void);
 /** Put back variable into ordering */
 void strategy_var_order_push(struct env_t *e);
+/** Remove a particular variable from ordering */
+void strategy_var_order_remove(struct env_t *e);
 /** Update position of variable in ordering */
 void strategy_var_order_update(struct env_t *e);
 
@@ -441,6 +802,10 @@ void strategy_var_order_update(struct env_t *e);
 #define WORKERS_MAX_DEFAULT 1
 /** Initialize the shared data area */
 void shared_init(uint32_t workers_max);
+/** Reset the shared data area for another search */
+void shared_reset(void);
+/** Release the shared data area */
+void shared_free(void);
 /** Return pointer to the shared data area */
 struct shared_t *shared(void);
 
@@ -449,6 +814,21 @@ struct shared_t *shared(void);
 /** Initialize the timeout data */
 void timeout_init(uint32_t time_max);
 
+/** Default number of cubes to split the problem into, 0 to solve the problem */
+#define CUBE_COUNT_DEFAULT 0
+/** Set the number of cubes to split the problem into */
+void cube_count_init(uint32_t count);
+/** Get the number of cubes to split the problem into */
+uint32_t cube_count(void);
+/** Set the file containing the cube to solve, NULL to solve the whole problem */
+void cube_file_init(const char *file);
+/** Get the file containing the cube to solve */
+const char *cube_file(void);
+/** Write the decisions of a task as cube */
+void cube_write(FILE *file, struct env_t *env, const struct task_t *task);
+/** Read the cube to solve, return the number of decisions */
+size_t cube_read(size_t size, struct env_t *env, struct decision_t **decs);
+
 /** Print value */
 void print_val(FILE *file, struct val_t val);
 /** Print constraint */
@@ -461,6 +841,8 @@ void print_solution(FILE *file, size_t size, struct env_t *env);
 void print_error(const char *fmt, ...);
 /** Print an error message and die */
 void print_fatal(const char *fmt, ...) noreturn;
+/** Print a warning message */
+void print_warning(const char *fmt, ...);
 
 /** Get the name of the program */
 const char *main_name(void);
@@ -480,7 +862,7 @@ const char *main_name(void);
 
 /** Statistic counter variable */
 #define STAT_EXTVAR(NAME, TYPE, RESET_VAL, ...)    \
-  extern TYPE NAME;
+  extern THREAD_LOCAL TYPE NAME;
 
 /** Declare statistic vounter variables for list of statistic counters */
 STAT_LIST(STAT_EXTVAR)
@@ -524,6 +906,8 @@ uint64_t stats_frequency(void);
 #define ERROR_MSG_NULL_BIND                 "cannot bind NULL"
 /** Error message when exceeding the maximum number of patches */
 #define ERROR_MSG_TOO_MANY_PATCHES          "exceeded maximum number of patches"
+/** Error message when lists of tasks differ in length */
+#define ERROR_MSG_TASK_LISTS_LENGTH         "lists of tasks differ in length"
 /** Error message when encountering an invalid operation */
 #define ERROR_MSG_INVALID_OPERATION         "invalid operation: %02x"
 /** Error message when encountering an invalid variable type */
@@ -536,11 +920,26 @@ uint64_t stats_frequency(void);
 #define ERROR_MSG_INVALID_INT_ARG           "invalid integer argument: %s"
 /** Error message when encountering invalid order arguments on the command line */
 #define ERROR_MSG_INVALID_ORDER_ARG         "invalid order argument: %s"
+/** Error message when encountering invalid queue arguments on the command line */
+#define ERROR_MSG_INVALID_QUEUE_ARG         "invalid queue argument: %s"
 /** Error message when encountering invalid size arguments on the command line */
 #define ERROR_MSG_INVALID_SIZE_ARG          "invalid size argument: %s"
 /** Error message when encountering invalid ordering strategy */
 #define ERROR_MSG_INVALID_STRATEGY_ORDER    "invalid ordering strategy: %02x"
 /** Error message when an unbounded variable is encountered */
 #define ERROR_MSG_UNBOUNDED_VARIABLE        "unbounded variable: %s"
+/** Error message for invalid cubes */
+#define ERROR_MSG_INVALID_CUBE              "invalid cube: %s"
+/** Error message for unknown variables in cubes */
+#define ERROR_MSG_UNKNOWN_CUBE_VARIABLE     "unknown variable in cube: %s"
+/** Error message for changing variables or objective of presolved models */
+#define ERROR_MSG_PRESOLVED_MODEL           "cannot change variables or objective of presolved model"
+/** Error message for popping scopes that were never pushed */
+#define ERROR_MSG_NO_SCOPE                  "no scope to pop"
+/** Error message for assumptions on expressions other than variables */
+#define ERROR_MSG_INVALID_ASSUMPTION        "assumption on expression that is not a variable"
+
+/** Warning message when the problem cannot be split into several cubes */
+#define WARNING_MSG_SINGLE_CUBE             "could not split the problem into several cubes"
 
 #endif
@@ -0,0 +1,149 @@
+/* Copyright 2018-2019 Wolfgang Puffitsch
+
+This file is part of CSolve.
+
+CSolve is free software: you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation, either version 3 of the License, or (at your
+option) any later version.
+
+CSolve is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received a copy of the GNU General Public License
+along with CSolve.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "csolve.h"
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// number of cubes to split the problem into, 0 to solve the problem
+static uint32_t _cube_count;
+// file containing the cube to solve, NULL to solve the whole problem
+static const char *_cube_file;
+
+// prefix of cubes when writing them
+#define CUBE_PREFIX "CUBE:"
+
+// initialize the number of cubes to split the problem into
+void cube_count_init(uint32_t count) {
+  _cube_count = count;
+}
+
+// return the number of cubes to split the problem into
+uint32_t cube_count(void) {
+  return _cube_count;
+}
+
+// initialize the file containing the cube to solve
+void cube_file_init(const char *file) {
+  _cube_file = file;
+}
+
+// return the file containing the cube to solve
+const char *cube_file(void) {
+  return _cube_file;
+}
+
+// write the decisions of a task as cube
+void cube_write(FILE *file, struct env_t *env, const struct task_t *task) {
+  fprintf(file, CUBE_PREFIX " ");
+  for (size_t i = 0; i < task->length; i++) {
+    fprintf(file, "%s =", env[task->decs[i].var].key);
+    print_val(file, task->decs[i].val);
+    fprintf(file, ", ");
+  }
+  fprintf(file, "\n");
+}
+
+// find a variable by its name
+static size_t cube_find(size_t size, struct env_t *env, const char *key) {
+  for (size_t i = 0; i < size; i++) {
+    if (strcmp(env[i].key, key) == 0) {
+      return i;
+    }
+  }
+  print_fatal(ERROR_MSG_UNKNOWN_CUBE_VARIABLE, key);
+  return size;
+}
+
+// parse variable bindings of a cube and append them to the decisions,
+// return the new number of decisions
+static size_t cube_parse(const char *str, size_t size, struct env_t *env,
+                         struct decision_t **decs, size_t length) {
+  // skip prefix if present
+  str += strspn(str, " \t");
+  if (strncmp(str, CUBE_PREFIX, strlen(CUBE_PREFIX)) == 0) {
+    str += strlen(CUBE_PREFIX);
+  }
+
+  for (;;) {
+    // stop at the end of the bindings
+    str += strspn(str, " \t\r\n,");
+    if (*str == '\0') {
+      break;
+    }
+
+    // only the last binding may restrict a variable to an interval
+    if (length > 0 && !is_value((*decs)[length-1].val)) {
+      print_fatal(ERROR_MSG_INVALID_CUBE, str);
+      break;
+    }
+
+    // read a binding of the form "<key> = <value>" or "<key> = [<lo>;<hi>]"
+    char key[256];
+    int lo;
+    int hi;
+    int n = 0;
+    if (sscanf(str, "%255[^ \t=,] = [%d;%d]%n", key, &lo, &hi, &n) != 3 || n == 0) {
+      n = 0;
+      if (sscanf(str, "%255[^ \t=,] = %d%n", key, &lo, &n) != 2 || n == 0) {
+        print_fatal(ERROR_MSG_INVALID_CUBE, str);
+        break;
+      }
+      hi = lo;
+    }
+    if (lo > hi) {
+      print_fatal(ERROR_MSG_INVALID_CUBE, str);
+      break;
+    }
+    str += n;
+
+    *decs = (struct decision_t *)realloc(*decs, (length + 1) * sizeof(struct decision_t));
+    if (*decs == NULL) {
+      print_fatal("%s", strerror(errno));
+    }
+    struct val_t val = lo == hi ? VALUE(lo) : INTERVAL(lo, hi);
+    (*decs)[length] = (struct decision_t){ .var = cube_find(size, env, key), .val = val };
+    length++;
+  }
+
+  return length;
+}
+
+// read the cube to solve, return the number of decisions
+size_t cube_read(size_t size, struct env_t *env, struct decision_t **decs) {
+  FILE *file = fopen(_cube_file, "r");
+  if (file == NULL) {
+    print_fatal("%s: %s", _cube_file, strerror(errno));
+  }
+
+  // read the cube as a whole
+  size_t length = 0;
+  char *line = NULL;
+  size_t n = 0;
+  while (getline(&line, &n, file) != -1) {
+    length = cube_parse(line, size, env, decs, length);
+  }
+
+  free(line);
+  fclose(file);
+
+  return length;
+}
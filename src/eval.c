@@ -23,20 +23,32 @@ along with CSolve.  If not, see <http://www.gnu.org/licenses/>.
 #include <stdlib.h>
 #include <string.h>
 
+// current evaluation epoch, starts at 1 such that expressions
+// without a cached value are never valid
+THREAD_LOCAL uint64_t eval_epoch = 1;
+
+// return the cached value of an expression if no terminal changed
+// since it was computed
+#define EVAL_CACHED(CONSTR)                                     \
+  if ((CONSTR)->cache_epoch == eval_epoch) {                    \
+    return (CONSTR)->cache;                                     \
+  }
+
+// remember the value of an expression until the next terminal changes
+static inline struct val_t eval_cache(const struct constr_t *constr, struct val_t val) {
+  struct constr_t *c = (struct constr_t *)constr;
+  c->cache = val;
+  c->cache_epoch = eval_epoch;
+  return val;
+}
+
 // evaluate a terminal
 struct val_t eval_term(const struct constr_t *constr) {
   return constr->constr.term.val;
 }
 
-// evaluate equality expression
-struct val_t eval_eq(const struct constr_t *constr) {
-  const struct constr_t *l = constr->constr.expr.l;
-  const struct constr_t *r = constr->constr.expr.r;
-
-  // evaluate sub-expressions
-  const struct val_t a = l->type->eval(l);
-  const struct val_t b = r->type->eval(r);
-
+// evaluate equality of two values
+struct val_t eval_eq_vals(const struct val_t a, const struct val_t b) {
   // extract lo/hi values
   domain_t a_lo = get_lo(a);
   domain_t a_hi = get_hi(a);
@@ -62,15 +74,19 @@ struct val_t eval_eq(const struct constr_t *constr) {
   return INTERVAL(0, 1);
 }
 
-// evaluate less-than expression
-struct val_t eval_lt(const struct constr_t *constr) {
+// evaluate equality expression
+struct val_t eval_eq(const struct constr_t *constr) {
+  EVAL_CACHED(constr);
+
   const struct constr_t *l = constr->constr.expr.l;
   const struct constr_t *r = constr->constr.expr.r;
 
   // evaluate sub-expressions
-  const struct val_t a = l->type->eval(l);
-  const struct val_t b = r->type->eval(r);
+  return eval_cache(constr, eval_eq_vals(l->type->eval(l), r->type->eval(r)));
+}
 
+// evaluate less-than of two values
+struct val_t eval_lt_vals(const struct val_t a, const struct val_t b) {
   // extract lo/hi values
   domain_t a_lo = get_lo(a);
   domain_t a_hi = get_hi(a);
@@ -96,13 +112,19 @@ struct val_t eval_lt(const struct constr_t *constr) {
   return INTERVAL(0, 1);
 }
 
-// evaluate negation expression
-struct val_t eval_neg(const struct constr_t *constr) {
+// evaluate less-than expression
+struct val_t eval_lt(const struct constr_t *constr) {
+  EVAL_CACHED(constr);
+
   const struct constr_t *l = constr->constr.expr.l;
+  const struct constr_t *r = constr->constr.expr.r;
 
-  // evaluate sub-expression
-  const struct val_t a = l->type->eval(l);
+  // evaluate sub-expressions
+  return eval_cache(constr, eval_lt_vals(l->type->eval(l), r->type->eval(r)));
+}
 
+// evaluate negation of a value
+struct val_t eval_neg_vals(const struct val_t a) {
   // extract lo/hi values
   domain_t a_lo = get_lo(a);
   domain_t a_hi = get_hi(a);
@@ -113,15 +135,18 @@ struct val_t eval_neg(const struct constr_t *constr) {
   return INTERVAL(lo, hi);
 }
 
-// evaluate addition expression
-struct val_t eval_add(const struct constr_t *constr) {
+// evaluate negation expression
+struct val_t eval_neg(const struct constr_t *constr) {
+  EVAL_CACHED(constr);
+
   const struct constr_t *l = constr->constr.expr.l;
-  const struct constr_t *r = constr->constr.expr.r;
 
-  // evaluate sub-expressions
-  const struct val_t a = l->type->eval(l);
-  const struct val_t b = r->type->eval(r);
+  // evaluate sub-expression
+  return eval_cache(constr, eval_neg_vals(l->type->eval(l)));
+}
 
+// evaluate addition of two values
+struct val_t eval_add_vals(const struct val_t a, const struct val_t b) {
   // extract lo/hi values
   domain_t a_lo = get_lo(a);
   domain_t a_hi = get_hi(a);
@@ -134,15 +159,19 @@ struct val_t eval_add(const struct constr_t *constr) {
   return INTERVAL(lo, hi);
 }
 
-// evaluate multiplication expression
-struct val_t eval_mul(const struct constr_t *constr) {
+// evaluate addition expression
+struct val_t eval_add(const struct constr_t *constr) {
+  EVAL_CACHED(constr);
+
   const struct constr_t *l = constr->constr.expr.l;
   const struct constr_t *r = constr->constr.expr.r;
 
   // evaluate sub-expressions
-  const struct val_t a = l->type->eval(l);
-  const struct val_t b = r->type->eval(r);
+  return eval_cache(constr, eval_add_vals(l->type->eval(l), r->type->eval(r)));
+}
 
+// evaluate multiplication of two values
+struct val_t eval_mul_vals(const struct val_t a, const struct val_t b) {
   // extract lo/hi values
   domain_t a_lo = get_lo(a);
   domain_t a_hi = get_hi(a);
@@ -159,13 +188,253 @@ struct val_t eval_mul(const struct constr_t *constr) {
   return INTERVAL(lo, hi);
 }
 
-// evaluate logical not expression
-struct val_t eval_not(const struct constr_t *constr) {
+// evaluate multiplication expression
+struct val_t eval_mul(const struct constr_t *constr) {
+  EVAL_CACHED(constr);
+
+  const struct constr_t *l = constr->constr.expr.l;
+  const struct constr_t *r = constr->constr.expr.r;
+
+  // evaluate sub-expressions
+  return eval_cache(constr, eval_mul_vals(l->type->eval(l), r->type->eval(r)));
+}
+
+// return whether an interval is empty
+static bool eval_empty(const struct val_t a) {
+  return get_lo(a) > get_hi(a);
+}
+
+// compute the smallest interval containing two intervals, either of
+// which may be empty
+static struct val_t eval_hull(const struct val_t a, const struct val_t b) {
+  if (eval_empty(a)) {
+    return b;
+  }
+  if (eval_empty(b)) {
+    return a;
+  }
+  return INTERVAL(min(get_lo(a), get_lo(b)), max(get_hi(a), get_hi(b)));
+}
+
+// divide a bound of a product by a bound of a factor, rounding up or
+// down, saturated values act as infinity
+static domain_t eval_quot_bound(const domain_t a, const domain_t b, bool up) {
+  if (a == DOMAIN_MIN || a == DOMAIN_MAX) {
+    return (a < 0) != (b < 0) ? DOMAIN_MIN : DOMAIN_MAX;
+  }
+  if (b == DOMAIN_MIN || b == DOMAIN_MAX) {
+    return 0;
+  }
+  return (domain_t)(up ? div_ceil(a, b) : div_floor(a, b));
+}
+
+// compute the values a factor may take for a factor that does not
+// change its sign, the extremes lie at the corners
+static struct val_t eval_quot_part(const struct val_t p, const domain_t f_lo, const domain_t f_hi) {
+  domain_t lo = min(min(eval_quot_bound(get_lo(p), f_lo, true), eval_quot_bound(get_lo(p), f_hi, true)),
+                    min(eval_quot_bound(get_hi(p), f_lo, true), eval_quot_bound(get_hi(p), f_hi, true)));
+  domain_t hi = max(max(eval_quot_bound(get_lo(p), f_lo, false), eval_quot_bound(get_lo(p), f_hi, false)),
+                    max(eval_quot_bound(get_hi(p), f_lo, false), eval_quot_bound(get_hi(p), f_hi, false)));
+  return INTERVAL(lo, hi);
+}
+
+// compute the values a factor may take such that multiplying it with
+// a value of the other factor yields a value of the product
+struct val_t eval_quot_vals(const struct val_t p, const struct val_t f) {
+  // extract lo/hi values
+  domain_t p_lo = get_lo(p);
+  domain_t p_hi = get_hi(p);
+  domain_t f_lo = get_lo(f);
+  domain_t f_hi = get_hi(f);
+
+  // any value fits if both the product and the other factor may be zero
+  if (p_lo <= 0 && p_hi >= 0 && f_lo <= 0 && f_hi >= 0) {
+    return INTERVAL(DOMAIN_MIN, DOMAIN_MAX);
+  }
+
+  // divide by the negative and positive values of the other factor
+  // separately, zero cannot yield the product
+  struct val_t q = INTERVAL(DOMAIN_MAX, DOMAIN_MIN);
+  if (f_lo < 0) {
+    q = eval_hull(q, eval_quot_part(p, f_lo, min(f_hi, -1)));
+  }
+  if (f_hi > 0) {
+    q = eval_hull(q, eval_quot_part(p, max(f_lo, 1), f_hi));
+  }
+  return q;
+}
+
+// divide a bound of a dividend by a bound of a divisor, saturated
+// values act as infinity
+static domain_t eval_div_bound(const domain_t a, const domain_t b) {
+  if (a == DOMAIN_MIN || a == DOMAIN_MAX) {
+    return (a < 0) != (b < 0) ? DOMAIN_MIN : DOMAIN_MAX;
+  }
+  if (b == DOMAIN_MIN || b == DOMAIN_MAX) {
+    return 0;
+  }
+  return (domain_t)((ddomain_t)a / b);
+}
+
+// compute the quotients for a divisor that does not change its sign,
+// the extremes lie at the corners
+static struct val_t eval_div_part(const struct val_t a, const domain_t b_lo, const domain_t b_hi) {
+  domain_t ll = eval_div_bound(get_lo(a), b_lo);
+  domain_t lh = eval_div_bound(get_lo(a), b_hi);
+  domain_t hl = eval_div_bound(get_hi(a), b_lo);
+  domain_t hh = eval_div_bound(get_hi(a), b_hi);
+  return INTERVAL(min(min(ll, lh), min(hl, hh)), max(max(ll, lh), max(hl, hh)));
+}
+
+// evaluate division of two values
+struct val_t eval_div_vals(const struct val_t a, const struct val_t b) {
+  // extract lo/hi values
+  domain_t b_lo = get_lo(b);
+  domain_t b_hi = get_hi(b);
+
+  // divide by the negative and positive values of the divisor
+  // separately, dividing by zero yields zero
+  struct val_t q = b_lo <= 0 && b_hi >= 0 ? VALUE(0) : INTERVAL(DOMAIN_MAX, DOMAIN_MIN);
+  if (b_lo < 0) {
+    q = eval_hull(q, eval_div_part(a, b_lo, min(b_hi, -1)));
+  }
+  if (b_hi > 0) {
+    q = eval_hull(q, eval_div_part(a, max(b_lo, 1), b_hi));
+  }
+  return q;
+}
+
+// evaluate division expression
+struct val_t eval_div(const struct constr_t *constr) {
+  EVAL_CACHED(constr);
+
+  const struct constr_t *l = constr->constr.expr.l;
+  const struct constr_t *r = constr->constr.expr.r;
+
+  // evaluate sub-expressions
+  return eval_cache(constr, eval_div_vals(l->type->eval(l), r->type->eval(r)));
+}
+
+// evaluate remainder of division of two values
+struct val_t eval_mod_vals(const struct val_t a, const struct val_t b) {
+  // extract lo/hi values
+  domain_t a_lo = get_lo(a);
+  domain_t a_hi = get_hi(a);
+  domain_t b_lo = get_lo(b);
+  domain_t b_hi = get_hi(b);
+
+  // the remainder of dividing by zero is the dividend
+  if (b_lo == 0 && b_hi == 0) {
+    return a;
+  }
+
+  // compute the remainder if both values are known, dividing by one
+  // never leaves a remainder
+  if (is_value(a) && is_value(b)) {
+    return VALUE(b_lo == 1 || b_lo == -1 ? 0 : a_lo % b_lo);
+  }
+
+  // the remainder is the dividend if its magnitude is below the one of
+  // any divisor
+  domain_t k = b_lo > 0 ? b_lo : (b_hi < 0 ? neg(b_hi) : 1);
+  if (a_lo > neg(k) && a_hi < k) {
+    return a;
+  }
+
+  // the remainder takes the sign of the dividend, and its magnitude is
+  // below the one of the divisor
+  domain_t m = add(max(neg(b_lo), b_hi), -1);
+  domain_t lo = a_lo >= 0 ? 0 : max(a_lo, neg(m));
+  domain_t hi = a_hi <= 0 ? 0 : min(a_hi, m);
+  struct val_t r = INTERVAL(lo, hi);
+  // the divisor may be zero, which leaves the dividend
+  return b_lo <= 0 && b_hi >= 0 ? eval_hull(r, a) : r;
+}
+
+// evaluate remainder expression
+struct val_t eval_mod(const struct constr_t *constr) {
+  EVAL_CACHED(constr);
+
+  const struct constr_t *l = constr->constr.expr.l;
+  const struct constr_t *r = constr->constr.expr.r;
+
+  // evaluate sub-expressions
+  return eval_cache(constr, eval_mod_vals(l->type->eval(l), r->type->eval(r)));
+}
+
+// evaluate absolute value of a value
+struct val_t eval_abs_vals(const struct val_t a) {
+  // extract lo/hi values
+  domain_t a_lo = get_lo(a);
+  domain_t a_hi = get_hi(a);
+
+  // keep or flip intervals that do not cross zero
+  if (a_lo >= 0) {
+    return a;
+  }
+  if (a_hi <= 0) {
+    return INTERVAL(neg(a_hi), neg(a_lo));
+  }
+  return INTERVAL(0, max(neg(a_lo), a_hi));
+}
+
+// evaluate absolute value expression
+struct val_t eval_abs(const struct constr_t *constr) {
+  EVAL_CACHED(constr);
+
   const struct constr_t *l = constr->constr.expr.l;
 
   // evaluate sub-expression
-  const struct val_t a = l->type->eval(l);
+  return eval_cache(constr, eval_abs_vals(l->type->eval(l)));
+}
+
+// evaluate minimum of two values
+struct val_t eval_min_vals(const struct val_t a, const struct val_t b) {
+  return INTERVAL(min(get_lo(a), get_lo(b)), min(get_hi(a), get_hi(b)));
+}
+
+// evaluate minimum expression
+struct val_t eval_min(const struct constr_t *constr) {
+  EVAL_CACHED(constr);
+
+  const struct constr_t *l = constr->constr.expr.l;
+  const struct constr_t *r = constr->constr.expr.r;
+
+  // evaluate sub-expressions
+  return eval_cache(constr, eval_min_vals(l->type->eval(l), r->type->eval(r)));
+}
+
+// evaluate maximum of two values
+struct val_t eval_max_vals(const struct val_t a, const struct val_t b) {
+  return INTERVAL(max(get_lo(a), get_lo(b)), max(get_hi(a), get_hi(b)));
+}
+
+// evaluate maximum expression
+struct val_t eval_max(const struct constr_t *constr) {
+  EVAL_CACHED(constr);
+
+  const struct constr_t *l = constr->constr.expr.l;
+  const struct constr_t *r = constr->constr.expr.r;
+
+  // evaluate sub-expressions
+  return eval_cache(constr, eval_max_vals(l->type->eval(l), r->type->eval(r)));
+}
 
+// evaluate linear expression
+struct val_t eval_lin(const struct constr_t *constr) {
+  EVAL_CACHED(constr);
+
+  // sum up the products of coefficients and variable values
+  struct val_t val = VALUE(0);
+  for (size_t i = 0, l = constr->constr.lin.length; i < l; i++) {
+    const struct lin_term_t *t = &constr->constr.lin.terms[i];
+    val = eval_add_vals(val, eval_mul_vals(VALUE(t->coef), t->var->type->eval(t->var)));
+  }
+  return eval_cache(constr, val);
+}
+
+// evaluate logical not of a value
+struct val_t eval_not_vals(const struct val_t a) {
   // check whether expression must be false
   if (is_true(a)) {
     return VALUE(0);
@@ -179,54 +448,237 @@ struct val_t eval_not(const struct constr_t *constr) {
   return INTERVAL(0, 1);
 }
 
+// evaluate logical not expression
+struct val_t eval_not(const struct constr_t *constr) {
+  EVAL_CACHED(constr);
+
+  const struct constr_t *l = constr->constr.expr.l;
+
+  // evaluate sub-expression
+  return eval_cache(constr, eval_not_vals(l->type->eval(l)));
+}
+
+// evaluate logical and of two values
+struct val_t eval_and_vals(const struct val_t lval, const struct val_t rval) {
+  // check whether either side is false
+  if (is_false(lval) || is_false(rval)) {
+    return VALUE(0);
+  }
+
+  // check whether both sides are true
+  if (is_true(lval) && is_true(rval)) {
+    return VALUE(1);
+  }
+
+  return INTERVAL(0, 1);
+}
+
 // evaluate logical and expression
 struct val_t eval_and(const struct constr_t *constr) {
+  EVAL_CACHED(constr);
 
   // evaluate left side and short-circuit if it is false
   const struct constr_t *l = constr->constr.expr.l;
   const struct val_t lval = l->type->eval(l);
   if (is_false(lval)) {
-    return VALUE(0);
+    return eval_cache(constr, VALUE(0));
   }
 
-  // evaluate right side and short-circuit if it is false
+  // evaluate right side
   const struct constr_t *r = constr->constr.expr.r;
-  const struct val_t rval = r->type->eval(r);
-  if (is_false(rval)) {
-    return VALUE(0);
-  }
+  return eval_cache(constr, eval_and_vals(lval, r->type->eval(r)));
+}
 
-  // check whether both sides are true
-  if (is_true(lval) && is_true(rval)) {
+// evaluate logical or of two values
+struct val_t eval_or_vals(const struct val_t lval, const struct val_t rval) {
+  // check whether either side is true
+  if (is_true(lval) || is_true(rval)) {
     return VALUE(1);
   }
 
+  // check whether both sides are false
+  if (is_false(lval) && is_false(rval)) {
+    return VALUE(0);
+  }
+
   return INTERVAL(0, 1);
 }
 
 // evaluate logical or expression
 struct val_t eval_or(const struct constr_t *constr) {
+  EVAL_CACHED(constr);
 
   // evaluate left side and short-circuit if it is true
   const struct constr_t *l = constr->constr.expr.l;
   const struct val_t lval = l->type->eval(l);
   if (is_true(lval)) {
-    return VALUE(1);
+    return eval_cache(constr, VALUE(1));
   }
 
-  // evaluate right side and short-circuit if it is true
+  // evaluate right side
   const struct constr_t *r = constr->constr.expr.r;
+  return eval_cache(constr, eval_or_vals(lval, r->type->eval(r)));
+}
+
+// evaluate difference expression
+struct val_t eval_diff(const struct constr_t *constr) {
+  EVAL_CACHED(constr);
+
+  const struct constr_t *l = constr->constr.diff.l;
+  const struct constr_t *r = constr->constr.diff.r;
+  const struct val_t lval = l->type->eval(l);
   const struct val_t rval = r->type->eval(r);
-  if (is_true(rval)) {
-    return VALUE(1);
+
+  // check value saturation
+  if (get_lo(lval) == DOMAIN_MIN || get_hi(lval) == DOMAIN_MAX ||
+      get_lo(rval) == DOMAIN_MIN || get_hi(rval) == DOMAIN_MAX) {
+    return eval_cache(constr, INTERVAL(0, 1));
   }
 
-  // check whether both sides are false
-  if (is_false(lval) && is_false(rval)) {
-    return VALUE(0);
+  // compute bounds of the difference in the wider type
+  ddomain_t c = constr->constr.diff.c;
+  if ((ddomain_t)get_hi(lval) - get_lo(rval) <= c) {
+    return eval_cache(constr, VALUE(1));
+  }
+  if ((ddomain_t)get_lo(lval) - get_hi(rval) > c) {
+    return eval_cache(constr, VALUE(0));
   }
 
-  return INTERVAL(0, 1);
+  return eval_cache(constr, INTERVAL(0, 1));
+}
+
+// compare values by lower bound, then by upper bound
+static int eval_alldiff_cmp(const void *a, const void *b) {
+  const struct val_t *x = (const struct val_t *)a;
+  const struct val_t *y = (const struct val_t *)b;
+  if (get_lo(*x) != get_lo(*y)) {
+    return get_lo(*x) < get_lo(*y) ? -1 : 1;
+  }
+  if (get_hi(*x) != get_hi(*y)) {
+    return get_hi(*x) < get_hi(*y) ? -1 : 1;
+  }
+  return 0;
+}
+
+// evaluate all-different expression
+struct val_t eval_alldiff(const struct constr_t *constr) {
+  EVAL_CACHED(constr);
+
+  // sort values of sub-expressions
+  size_t length = constr->constr.alldiff.length;
+  struct val_t *vals = (struct val_t *)alloc(length * sizeof(struct val_t));
+  for (size_t i = 0; i < length; i++) {
+    const struct constr_t *c = constr->constr.alldiff.elems[i];
+    vals[i] = c->type->eval(c);
+  }
+  qsort(vals, length, sizeof(struct val_t), eval_alldiff_cmp);
+
+  // sub-expressions are different if none of them overlaps with the
+  // ones before, they are not if two of them have the same single
+  // value, which are next to each other after sorting
+  bool disjoint = true;
+  domain_t hi = length > 0 ? get_hi(vals[0]) : DOMAIN_MIN;
+  for (size_t i = 1; i < length; i++) {
+    if (is_value(vals[i-1]) && is_value(vals[i]) && get_lo(vals[i-1]) == get_lo(vals[i])) {
+      dealloc(vals);
+      return eval_cache(constr, VALUE(0));
+    }
+    if (get_lo(vals[i]) <= hi) {
+      disjoint = false;
+    }
+    hi = max(hi, get_hi(vals[i]));
+  }
+  dealloc(vals);
+
+  return eval_cache(constr, disjoint ? VALUE(1) : INTERVAL(0, 1));
+}
+
+/** Change of resource usage at some point in time */
+struct sched_event_t {
+  ddomain_t time; ///< Point in time
+  ddomain_t delta; ///< Change of resource usage
+};
+
+// compare changes of resource usage by time, decreases first
+static int eval_sched_cmp(const void *a, const void *b) {
+  const struct sched_event_t *x = (const struct sched_event_t *)a;
+  const struct sched_event_t *y = (const struct sched_event_t *)b;
+  if (x->time != y->time) {
+    return x->time < y->time ? -1 : 1;
+  }
+  return (x->delta > y->delta) - (x->delta < y->delta);
+}
+
+// compute the peak resource usage from changes of resource usage
+static ddomain_t eval_sched_peak(struct sched_event_t *events, size_t length) {
+  qsort(events, length, sizeof(struct sched_event_t), eval_sched_cmp);
+  ddomain_t usage = 0, peak = 0;
+  for (size_t i = 0; i < length; i++) {
+    usage += events[i].delta;
+    if (usage > peak) {
+      peak = usage;
+    }
+  }
+  return peak;
+}
+
+// evaluate scheduling expression, tasks occupy the resource from
+// their start time up to but excluding their completion time
+static struct val_t eval_sched(const struct constr_t *constr) {
+  size_t length = constr->constr.sched.length;
+  const struct constr_t *c = constr->constr.sched.cap;
+  struct val_t cap = c != NULL ? c->type->eval(c) : VALUE(1);
+
+  // collect where tasks must and may use the resource
+  struct sched_event_t *must = (struct sched_event_t *)alloc(2 * length * sizeof(struct sched_event_t));
+  struct sched_event_t *may = (struct sched_event_t *)alloc(2 * length * sizeof(struct sched_event_t));
+  size_t must_length = 0, may_length = 0;
+  bool overload = false;
+  for (size_t i = 0; i < length; i++) {
+    const struct sched_task_t *t = &constr->constr.sched.tasks[i];
+    struct val_t start = t->start->type->eval(t->start);
+    struct val_t dur = t->dur->type->eval(t->dur);
+    struct val_t demand = t->demand != NULL ? t->demand->type->eval(t->demand) : VALUE(1);
+    ddomain_t dur_lo = max(0, get_lo(dur)), dur_hi = max(0, get_hi(dur));
+    ddomain_t demand_lo = max(0, get_lo(demand)), demand_hi = max(0, get_hi(demand));
+
+    // a task may need more than the resource can ever provide
+    if (dur_lo > 0 && demand_lo > get_hi(cap)) {
+      overload = true;
+    }
+    // the task must run between its latest start time and earliest completion time
+    if (dur_lo > 0 && demand_lo > 0 && get_hi(start) < get_lo(start) + dur_lo) {
+      must[must_length++] = (struct sched_event_t){ .time = get_hi(start), .delta = demand_lo };
+      must[must_length++] = (struct sched_event_t){ .time = get_lo(start) + dur_lo, .delta = -demand_lo };
+    }
+    // the task may run between its earliest start time and latest completion time
+    if (dur_hi > 0 && demand_hi > 0) {
+      may[may_length++] = (struct sched_event_t){ .time = get_lo(start), .delta = demand_hi };
+      may[may_length++] = (struct sched_event_t){ .time = get_hi(start) + dur_hi, .delta = -demand_hi };
+    }
+  }
+
+  struct val_t retval = INTERVAL(0, 1);
+  if (overload || eval_sched_peak(must, must_length) > get_hi(cap)) {
+    retval = VALUE(0);
+  } else if (eval_sched_peak(may, may_length) <= get_lo(cap)) {
+    retval = VALUE(1);
+  }
+  dealloc(must);
+
+  return retval;
+}
+
+// evaluate disjunctive resource expression
+struct val_t eval_disj(const struct constr_t *constr) {
+  EVAL_CACHED(constr);
+  return eval_cache(constr, eval_sched(constr));
+}
+
+// evaluate cumulative resource expression
+struct val_t eval_cumul(const struct constr_t *constr) {
+  EVAL_CACHED(constr);
+  return eval_cache(constr, eval_sched(constr));
 }
 
 // evaluate wide-and expression
@@ -262,13 +714,12 @@ struct val_t eval_confl(const struct constr_t *constr) {
     // evaluate sub-expression
     const struct val_t v = c->var->type->eval(c->var);
 
-    if (is_value(v)) {
-      // short-circuit if value is different from conflict value (no conflict)
-      if (get_lo(v) != get_lo(c->val)) {
-        return VALUE(1);
-      }
-    } else {
-      // short-circuit if true/false cannot be decided
+    // short-circuit if value is outside conflict bounds (no conflict)
+    if (get_hi(v) < get_lo(c->val) || get_lo(v) > get_hi(c->val)) {
+      return VALUE(1);
+    }
+    // short-circuit if true/false cannot be decided
+    if (get_lo(v) < get_lo(c->val) || get_hi(v) > get_hi(c->val)) {
       return INTERVAL(0, 1);
     }
   }
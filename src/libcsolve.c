@@ -0,0 +1,370 @@
+/* Copyright 2018-2019 Wolfgang Puffitsch
+
+This file is part of CSolve.
+
+CSolve is free software: you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation, either version 3 of the License, or (at your
+option) any later version.
+
+CSolve is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received a copy of the GNU General Public License
+along with CSolve.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "csolve.h"
+#include "libcsolve.h"
+#include "parser_support.h"
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/** State to restore when popping a scope */
+struct csolve_scope_t {
+  bool infeasible; ///< Whether the model was known to be infeasible
+  struct constr_t *norm; ///< Constraints of the model
+  size_t bind_depth; ///< Depth of binding stack
+  size_t patch_depth; ///< Depth of patch stack
+  void *alloc_mark; ///< Position of allocation stack
+  size_t conflict_depth; ///< Depth of conflict allocation stack
+  size_t *clauses; ///< Lengths of clause lists of all variables
+};
+
+// return the name used in error messages
+const char *main_name(void) {
+  return "libcsolve";
+}
+
+// start a new model
+static void model_init(struct csolve_t *h) {
+  shared_init(h->workers);
+  objective_init(OBJ_ANY, &shared()->objective_best, &shared()->objective_epoch);
+  bind_level_set(-1);
+
+  // the objective constraint is always the first in the model
+  struct constr_t *obj = (struct constr_t *)alloc(sizeof(struct constr_t));
+  *obj = CONSTRAINT_TERM(VALUE(1));
+  struct wand_expr_t *elems = (struct wand_expr_t *)malloc(sizeof(struct wand_expr_t));
+  // die if allocation failed
+  if (elems == NULL) {
+    print_fatal("%s", strerror(errno));
+  }
+  elems[0] = (struct wand_expr_t){ .constr = obj, .orig = obj, .prop_tag = 0 };
+
+  h->model = (struct constr_t *)alloc(sizeof(struct constr_t));
+  *h->model = CONSTRAINT_WAND(1, elems);
+
+  h->presolved = false;
+  h->infeasible = false;
+  h->size = 0;
+  h->env = NULL;
+  h->base = NULL;
+  h->norm = NULL;
+  h->scopes = NULL;
+  h->depth = 0;
+}
+
+// release constraints added after presolving until reaching the given model
+static void model_free_added(struct csolve_t *h, struct constr_t *norm) {
+  while (h->norm != norm) {
+    struct wand_expr_t *elems = h->norm->constr.wand.elems;
+    expr_free(elems[1].orig);
+    h->norm = elems[0].orig;
+  }
+}
+
+// release all memory of the current model
+static void model_free(struct csolve_t *h) {
+  while (h->depth > 0) {
+    csolve_pop(h);
+  }
+  free(h->scopes);
+  model_free_added(h, h->base);
+
+  if (h->model != NULL) {
+    expr_free(h->model);
+    h->model = NULL;
+  }
+  env_free();
+  strategy_var_order_free();
+
+  // forget conflicts learned for the model
+  conflict_alloc_free();
+  conflict_alloc_init(CONFLICT_ALLOC_STACK_SIZE_DEFAULT);
+
+  dealloc(h->mark);
+  shared_free();
+}
+
+// create a handle
+struct csolve_t *csolve_new(uint32_t workers) {
+  struct csolve_t *h = (struct csolve_t *)malloc(sizeof(struct csolve_t));
+  // die if allocation failed
+  if (h == NULL) {
+    print_fatal("%s", strerror(errno));
+  }
+
+  alloc_init(ALLOC_STACK_SIZE_DEFAULT);
+  bind_init(BIND_STACK_SIZE_DEFAULT);
+  patch_init(PATCH_STACK_SIZE_DEFAULT);
+  conflict_alloc_init(CONFLICT_ALLOC_STACK_SIZE_DEFAULT);
+
+  strategy_create_conflicts_init(STRATEGY_CREATE_CONFLICTS_DEFAULT);
+  strategy_prefer_failing_init(STRATEGY_PREFER_FAILING_DEFAULT);
+  strategy_compute_weights_init(STRATEGY_COMPUTE_WEIGHTS_DEFAULT);
+  strategy_restart_frequency_init(STRATEGY_RESTART_FREQUENCY_DEFAULT);
+  strategy_order_init(STRATEGY_ORDER_DEFAULT);
+  strategy_prop_order_init(STRATEGY_PROP_ORDER_DEFAULT);
+  strategy_portfolio_init(STRATEGY_PORTFOLIO_DEFAULT);
+  strategy_eps_init(STRATEGY_EPS_DEFAULT);
+  cube_count_init(CUBE_COUNT_DEFAULT);
+  cube_file_init(NULL);
+  // the library neither prints statistics nor uses timeouts
+  stats_frequency_init(0);
+  timeout_init(0);
+
+  h->workers = workers;
+  h->mark = alloc(0);
+  model_init(h);
+  return h;
+}
+
+// release a handle
+void csolve_free(struct csolve_t *h) {
+  model_free(h);
+  propagate_free();
+  compile_free();
+  conflict_alloc_free();
+  patch_free();
+  bind_free();
+  alloc_free();
+  free(h);
+}
+
+// discard the current model and start a new one
+void csolve_reset(struct csolve_t *h) {
+  model_free(h);
+  model_init(h);
+}
+
+// set the strategy settings
+void csolve_strategy(struct csolve_t *h __attribute__((unused)), const struct strategy_t *strategy) {
+  strategy_set(strategy);
+}
+
+// presolve the model unless already done
+static void model_presolve_once(struct csolve_t *h) {
+  if (!h->presolved) {
+    h->norm = model_presolve(h->model, &h->env);
+    h->base = h->norm;
+    h->size = var_count();
+    h->infeasible = h->norm == NULL;
+    h->presolved = true;
+  }
+}
+
+// add a variable to the model
+struct constr_t *csolve_var(struct csolve_t *h, const char *key, domain_t lo, domain_t hi) {
+  if (h->presolved) {
+    print_fatal(ERROR_MSG_PRESOLVED_MODEL);
+  }
+
+  struct constr_t *var = (struct constr_t *)alloc(sizeof(struct constr_t));
+  *var = CONSTRAINT_TERM(INTERVAL(lo, hi));
+  vars_add(key, var);
+  return var;
+}
+
+// copy a constraint to the model
+struct constr_t *csolve_constr(struct csolve_t *h __attribute__((unused)), struct constr_t constr) {
+  struct constr_t *c = (struct constr_t *)alloc(sizeof(struct constr_t));
+  *c = constr;
+  return c;
+}
+
+// add a constraint to the model
+void csolve_add(struct csolve_t *h, struct constr_t *constr) {
+  if (h->presolved) {
+    // chain constraints added after presolving, such that popping a
+    // scope can restore the previous model
+    struct wand_expr_t *elems = (struct wand_expr_t *)alloc(2 * sizeof(struct wand_expr_t));
+    elems[0] = (struct wand_expr_t){ .constr = h->norm, .orig = h->norm, .prop_tag = 0 };
+    elems[1] = (struct wand_expr_t){ .constr = constr, .orig = constr, .prop_tag = 0 };
+    h->norm = (struct constr_t *)alloc(sizeof(struct constr_t));
+    *h->norm = CONSTRAINT_WAND(2, elems);
+
+    if (!h->infeasible) {
+      clauses_init(constr, IS_TYPE(WAND, constr) ? NULL : &elems[1]);
+      bind_level_set(-1);
+      h->infeasible = propagate(constr, h->size) == PROP_ERROR;
+    }
+    return;
+  }
+
+  struct constr_t *m = h->model;
+  m->constr.wand.length++;
+  const size_t size = m->constr.wand.length * sizeof(struct wand_expr_t);
+  m->constr.wand.elems = (struct wand_expr_t *)realloc(m->constr.wand.elems, size);
+  // die if allocation failed
+  if (m->constr.wand.elems == NULL) {
+    print_fatal("%s", strerror(errno));
+  }
+  m->constr.wand.elems[m->constr.wand.length-1] =
+    (struct wand_expr_t){ .constr = constr, .orig = constr, .prop_tag = 0 };
+}
+
+// set what solution to look for
+void csolve_objective(struct csolve_t *h, enum objective_t objective, struct constr_t *expr) {
+  if (h->presolved) {
+    print_fatal(ERROR_MSG_PRESOLVED_MODEL);
+  }
+
+  objective_init(objective, &shared()->objective_best, &shared()->objective_epoch);
+
+  // tie the objective value to the expression when optimizing
+  struct constr_t *obj = h->model->constr.wand.elems[0].constr;
+  if (objective == OBJ_MIN || objective == OBJ_MAX) {
+    vars_add("<obj>", objective_val());
+    *obj = objective == OBJ_MIN
+      ? CONSTRAINT_EXPR(EQ, expr, objective_val())
+      : CONSTRAINT_EXPR(EQ, objective_val(), expr);
+  }
+}
+
+// open a scope
+void csolve_push(struct csolve_t *h) {
+  model_presolve_once(h);
+
+  h->scopes = (struct csolve_scope_t *)realloc(h->scopes, (h->depth + 1) * sizeof(struct csolve_scope_t));
+  // die if allocation failed
+  if (h->scopes == NULL) {
+    print_fatal("%s", strerror(errno));
+  }
+
+  struct csolve_scope_t *scope = &h->scopes[h->depth++];
+  scope->infeasible = h->infeasible;
+  scope->norm = h->norm;
+  scope->bind_depth = bind_depth();
+  scope->patch_depth = patch(NULL, NULL);
+  scope->alloc_mark = alloc(0);
+  scope->conflict_depth = conflict_alloc_depth();
+
+  // remember clause list lengths to drop clauses added within the
+  // scope, presolving an infeasible model leaves no variables
+  scope->clauses = NULL;
+  if (h->env != NULL) {
+    scope->clauses = (size_t *)malloc(h->size * sizeof(size_t));
+    // die if allocation failed
+    if (scope->clauses == NULL && h->size > 0) {
+      print_fatal("%s", strerror(errno));
+    }
+    for (size_t i = 0; i < h->size; i++) {
+      scope->clauses[i] = h->env[i].clauses.length;
+    }
+  }
+}
+
+// close the innermost scope
+void csolve_pop(struct csolve_t *h) {
+  if (h->depth == 0) {
+    print_fatal(ERROR_MSG_NO_SCOPE);
+  }
+
+  struct csolve_scope_t *scope = &h->scopes[--h->depth];
+  unbind(scope->bind_depth);
+  unpatch(scope->patch_depth);
+  model_free_added(h, scope->norm);
+
+  // drop the clauses added within the scope
+  if (h->env != NULL) {
+    for (size_t i = 0; i < h->size; i++) {
+      h->env[i].clauses.length = scope->clauses[i];
+    }
+  }
+  free(scope->clauses);
+  // learned conflicts may depend on constraints of the scope, drop them
+  conflict_alloc_release(scope->conflict_depth);
+
+  dealloc(scope->alloc_mark);
+  h->infeasible = scope->infeasible;
+}
+
+// solve the model
+uint64_t csolve_solve(struct csolve_t *h, solution_callback_t callback, void *data) {
+  return csolve_solve_assuming(h, 0, NULL, callback, data);
+}
+
+// assume a variable takes a value, return whether that is consistent
+static bool assume(const struct csolve_assumption_t *assumption) {
+  struct constr_t *var = assumption->var;
+  if (!IS_TYPE(TERM, var) || var->constr.term.env == NULL) {
+    print_fatal(ERROR_MSG_INVALID_ASSUMPTION);
+  }
+
+  struct val_t val = var->constr.term.val;
+  if (assumption->val < get_lo(val) || assumption->val > get_hi(val)) {
+    return false;
+  }
+
+  bind(var->constr.term.env, VALUE(assumption->val), NULL);
+  return propagate_clauses(var->constr.term.env) != PROP_ERROR;
+}
+
+// solve the model under assumptions
+uint64_t csolve_solve_assuming(struct csolve_t *h, size_t length, const struct csolve_assumption_t *assumptions,
+                               solution_callback_t callback, void *data) {
+  model_presolve_once(h);
+  if (h->infeasible) {
+    return 0;
+  }
+
+  size_t depth = bind_depth();
+  size_t patches = patch(NULL, NULL);
+  void *mark = alloc(0);
+  size_t conflicts = conflict_alloc_depth();
+  struct val_t obj = objective_val()->constr.term.val;
+
+  shared_reset();
+  objective_reset();
+
+  // assumptions are bound at the root level, conflicts learned under
+  // them keep them and everything bound at the root level after them
+  // as elements, such that the conflicts remain valid; without
+  // assumptions, root-level bindings follow from the model
+  conflict_root_init(length > 0 ? depth : SIZE_MAX);
+  bind_level_set(-1);
+  bool feasible = true;
+  for (size_t i = 0; i < length && feasible; i++) {
+    feasible = assume(&assumptions[i]);
+  }
+
+  if (feasible) {
+    strategy_var_order_init(h->size, h->env);
+    solution_callback_init(callback, data);
+    solve(h->size, h->env, h->norm);
+    solution_callback_init(NULL, NULL);
+    strategy_var_order_free();
+  }
+
+  // the bound of the objective is tightened off the trail, and
+  // conflicts learned while optimizing depend on it; additional
+  // workers copy the values of assumptions without their bindings and
+  // share conflicts that depend on them
+  objective_val()->constr.term.val = obj;
+  eval_invalidate();
+  if (objective() == OBJ_MIN || objective() == OBJ_MAX || (length > 0 && h->workers > 1)) {
+    conflict_alloc_release(conflicts);
+  }
+
+  unbind(depth);
+  unpatch(patches);
+  dealloc(mark);
+
+  return feasible ? shared()->solutions : 0;
+}
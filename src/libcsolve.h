@@ -0,0 +1,91 @@
+/* Copyright 2018-2019 Wolfgang Puffitsch
+
+This file is part of CSolve.
+
+CSolve is free software: you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation, either version 3 of the License, or (at your
+option) any later version.
+
+CSolve is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received a copy of the GNU General Public License
+along with CSolve.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef LIBCSOLVE_H
+#define LIBCSOLVE_H
+
+#include "csolve.h"
+
+struct csolve_scope_t;
+
+/** Handle to build and solve models. Search state is thread-local, so
+    a handle must only be used from the thread that created it, and each
+    thread can use one handle. Worker setup and shared data are global
+    to the process, so only one handle can solve at a time. */
+struct csolve_t {
+  uint32_t workers; ///< Number of workers to solve models with
+  struct constr_t *model; ///< Conjunction of constraints, objective constraint first
+  void *mark; ///< Position of allocation stack before building models
+  bool presolved; ///< Whether the model has been presolved
+  bool infeasible; ///< Whether the model is known to be infeasible
+  size_t size; ///< Number of variables of the presolved model
+  struct env_t *env; ///< Variable environment of the presolved model
+  struct constr_t *base; ///< Presolved model
+  struct constr_t *norm; ///< Presolved model and constraints added afterwards
+  struct csolve_scope_t *scopes; ///< Scopes opened with csolve_push
+  size_t depth; ///< Number of open scopes
+};
+
+/** Value a variable is assumed to take during a single solver run */
+struct csolve_assumption_t {
+  struct constr_t *var; ///< Variable as returned by csolve_var
+  domain_t val; ///< Assumed value
+};
+
+/** Create a handle that solves models with the given number of workers */
+struct csolve_t *csolve_new(uint32_t workers);
+/** Release a handle and all memory of the solver */
+void csolve_free(struct csolve_t *h);
+/** Discard the model built so far and start a new one */
+void csolve_reset(struct csolve_t *h);
+
+/** Set the strategy settings for solving */
+void csolve_strategy(struct csolve_t *h, const struct strategy_t *strategy);
+
+/** Add a variable with domain [lo;hi] to the model */
+struct constr_t *csolve_var(struct csolve_t *h, const char *key, domain_t lo, domain_t hi);
+/** Copy a constraint built with CONSTRAINT_TERM, CONSTRAINT_EXPR or
+    CONSTRAINT_WAND to the model, the elements of wide-and constraints
+    must be allocated with malloc and are owned by the model */
+struct constr_t *csolve_constr(struct csolve_t *h, struct constr_t constr);
+/** Add a constraint that must hold in all solutions of the model,
+    constraints added after the model was presolved are propagated
+    right away and removed again when popping the enclosing scope */
+void csolve_add(struct csolve_t *h, struct constr_t *constr);
+/** Set what solution to look for, with the expression to minimize or
+    maximize (NULL for any/all solutions), at most once per model and
+    before the model is presolved */
+void csolve_objective(struct csolve_t *h, enum objective_t objective, struct constr_t *expr);
+
+/** Open a scope, presolving the model if needed; variables and the
+    objective cannot be changed once the model is presolved */
+void csolve_push(struct csolve_t *h);
+/** Close the innermost scope, removing the constraints added and the
+    conflicts learned within it */
+void csolve_pop(struct csolve_t *h);
+
+/** Solve the model, handing solutions to the callback; return the
+    number of solutions found. The model is kept, including conflicts
+    learned while solving, until the handle is reset. */
+uint64_t csolve_solve(struct csolve_t *h, solution_callback_t callback, void *data);
+/** Solve the model under the given assumptions, which only hold for
+    this solver run, otherwise like csolve_solve */
+uint64_t csolve_solve_assuming(struct csolve_t *h, size_t length, const struct csolve_assumption_t *assumptions,
+                               solution_callback_t callback, void *data);
+
+#endif
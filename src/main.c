@@ -61,6 +61,18 @@ int yylex_destroy(void);
     "-c --conflicts <bool>       create conflict clauses (default: %s)\n", \
     STRATEGY_CREATE_CONFLICTS_DEFAULT ? STR(true) : STR(false))         \
                                                                         \
+  F('C', "cubes", required_argument, "C:",                               \
+    { cube_count_init(parse_int(optarg)); },                            \
+    { cube_count_init(CUBE_COUNT_DEFAULT); },                           \
+    "-C --cubes <int>            print cubes splitting the problem instead of solving it (default: %u), set to 0 to disable\n", \
+    CUBE_COUNT_DEFAULT)                                                 \
+                                                                        \
+  F('e', "eps", required_argument, "e:",                                 \
+    { strategy_eps_init(parse_int(optarg)); },                          \
+    { strategy_eps_init(STRATEGY_EPS_DEFAULT); },                       \
+    "-e --eps <int>              subproblems per job to decompose the problem into upfront (default: %u), set to 0 to disable\n", \
+    STRATEGY_EPS_DEFAULT)                                               \
+                                                                        \
   F('f', "prefer-failing", required_argument, "f:",                     \
     { strategy_prefer_failing_init(parse_bool(optarg)); },              \
     { strategy_prefer_failing_init(STRATEGY_PREFER_FAILING_DEFAULT); }, \
@@ -77,6 +89,11 @@ int yylex_destroy(void);
     "-j --jobs <int>             number of jobs to run simultaneously (default: %u)\n", \
     WORKERS_MAX_DEFAULT)                                                \
                                                                         \
+  F('k', "cube", required_argument, "k:",                                \
+    { cube_file_init(optarg); },                                        \
+    { cube_file_init(NULL); },                                          \
+    "-k --cube <file>            solve only the cube in the file\n")    \
+                                                                        \
   F('m', "memory", required_argument, "m:",                             \
     { alloc_init(parse_size(optarg)); },                                \
     { alloc_init(ALLOC_STACK_SIZE_DEFAULT); },                          \
@@ -101,6 +118,18 @@ int yylex_destroy(void);
     "-p --patches <size>         maximum number of patches (default: %d)\n", \
     PATCH_STACK_SIZE_DEFAULT)                                           \
                                                                         \
+  F('P', "portfolio", required_argument, "P:",                          \
+    { strategy_portfolio_init(parse_bool(optarg)); },                   \
+    { strategy_portfolio_init(STRATEGY_PORTFOLIO_DEFAULT); },           \
+    "-P --portfolio <bool>       run jobs with different strategies (default: %s)\n", \
+    STRATEGY_PORTFOLIO_DEFAULT ? STR(true) : STR(false))                \
+                                                                        \
+  F('q', "queue", required_argument, "q:",                              \
+    { strategy_prop_order_init(parse_prop_order(optarg)); },            \
+    { strategy_prop_order_init(STRATEGY_PROP_ORDER_DEFAULT); },         \
+    "-q --queue <order>          how to order clauses queued for propagation (default: %s)\n", \
+    STRVAL(STRATEGY_PROP_ORDER_DEFAULT))                                \
+                                                                        \
   F('r', "restart-freq", required_argument, "r:",                       \
     { strategy_restart_frequency_init(parse_int(optarg)); },            \
     { strategy_restart_frequency_init(STRATEGY_RESTART_FREQUENCY_DEFAULT); }, \
@@ -212,6 +241,20 @@ static enum order_t parse_order(const char *str) {
   return ORDER_NONE;
 }
 
+// parse a string to an order of propagating queued clauses
+static enum prop_order_t parse_prop_order(const char *str) {
+  if (strcmp(str, "fifo") == 0) {
+    return PROP_ORDER_FIFO;
+  }
+  if (strcmp(str, "cheap-first") == 0) {
+    return PROP_ORDER_CHEAP_FIRST;
+  }
+
+  // die if the string could not be parsed
+  print_fatal(ERROR_MSG_INVALID_QUEUE_ARG, str);
+  return PROP_ORDER_FIFO;
+}
+
 // parse a string to a size (accepting an integer with a possible k/M/G suffix)
 static size_t parse_size(const char *str) {
   char *endptr;
@@ -317,6 +360,8 @@ static void cleanup() {
   alloc_free();
   conflict_alloc_free();
   strategy_var_order_free();
+  propagate_free();
+  compile_free();
   fclose(yyget_in());
   yylex_destroy();
 }
@@ -23,7 +23,7 @@ along with CSolve.  If not, see <http://www.gnu.org/licenses/>.
 #include <stdlib.h>
 #include <string.h>
 
-static int32_t _patch_count = 0;
+static THREAD_LOCAL int32_t _patch_count = 0;
 
 // check if constraint can be normalized through evaluation and return
 // if this is the case
@@ -44,6 +44,8 @@ static struct constr_t *update_expr(struct constr_t *constr, struct constr_t *l,
     retval->type = constr->type;
     retval->constr.expr.l = l;
     retval->constr.expr.r = r;
+    retval->cache_epoch = 0;
+    retval->seen_epoch = 0;
     return retval;
   }
   return constr;
@@ -58,6 +60,8 @@ static struct constr_t *update_unary_expr(struct constr_t *constr, struct constr
     retval->type = constr->type;
     retval->constr.expr.l = l;
     retval->constr.expr.r = NULL;
+    retval->cache_epoch = 0;
+    retval->seen_epoch = 0;
     return retval;
   }
   return constr;
@@ -160,10 +164,161 @@ struct constr_t *normal_lt(struct constr_t *constr) {
   return update_expr(constr, l, r);
 }
 
+// minimum number of variables to turn a sum into a linear expression
+#define NORM_LIN_VARS_MIN 3
+
+/** Terms collected from a sum when turning it into a linear expression */
+struct norm_lin_t {
+  size_t length; ///< Number of terms
+  struct lin_term_t *terms; ///< Terms, NULL while counting them
+  size_t vars; ///< Number of variables that are not part of a linear expression already
+  size_t lins; ///< Number of linear expressions
+  domain_t offset; ///< Sum of constants
+};
+
+// check whether a value is saturated
+static bool normal_saturated(domain_t a) {
+  return a == DOMAIN_MIN || a == DOMAIN_MAX;
+}
+
+// add a term to the collected terms
+static void normal_lin_append(struct norm_lin_t *lin, domain_t coef, struct constr_t *var) {
+  if (lin->terms != NULL) {
+    lin->terms[lin->length] = (struct lin_term_t){ .coef = coef, .var = var };
+  }
+  lin->length++;
+}
+
+// collect the terms of a sum multiplied with a factor, return false
+// if the sum is not linear
+static bool normal_lin_collect(struct constr_t *constr, domain_t factor, struct norm_lin_t *lin) {
+  if (normal_saturated(factor)) {
+    return false;
+  }
+
+  if (is_const(constr)) {
+    // add up constants
+    domain_t c = mul(factor, get_lo(constr->constr.term.val));
+    lin->offset = add(lin->offset, c);
+    return !normal_saturated(c) && !normal_saturated(lin->offset);
+  }
+
+  if (IS_TYPE(TERM, constr)) {
+    lin->vars++;
+    normal_lin_append(lin, factor, constr);
+    return true;
+  }
+
+  if (IS_TYPE(LIN, constr)) {
+    lin->lins++;
+    for (size_t i = 0, l = constr->constr.lin.length; i < l; i++) {
+      const struct lin_term_t *t = &constr->constr.lin.terms[i];
+      domain_t coef = mul(factor, t->coef);
+      if (normal_saturated(coef)) {
+        return false;
+      }
+      normal_lin_append(lin, coef, t->var);
+    }
+    return true;
+  }
+
+  struct constr_t *l = constr->constr.expr.l;
+  struct constr_t *r = constr->constr.expr.r;
+  switch (constr->type->op) {
+  case OP_ADD:
+    return normal_lin_collect(l, factor, lin) && normal_lin_collect(r, factor, lin);
+  case OP_NEG:
+    return normal_lin_collect(l, neg(factor), lin);
+  case OP_MUL:
+    // only multiplications with constants are linear
+    if (is_const(r)) {
+      return normal_lin_collect(l, mul(factor, get_lo(r->constr.term.val)), lin);
+    }
+    if (is_const(l)) {
+      return normal_lin_collect(r, mul(factor, get_lo(l->constr.term.val)), lin);
+    }
+    return false;
+  default:
+    return false;
+  }
+}
+
+// merge terms of the same variable and drop terms without effect,
+// return the number of remaining terms or 0 if coefficients saturate
+static size_t normal_lin_merge(struct lin_term_t *terms, size_t length) {
+  size_t n = 0;
+  for (size_t i = 0; i < length; i++) {
+    size_t k = 0;
+    while (k < n && terms[k].var != terms[i].var) {
+      k++;
+    }
+    if (k < n) {
+      terms[k].coef = add(terms[k].coef, terms[i].coef);
+      if (normal_saturated(terms[k].coef)) {
+        return 0;
+      }
+    } else {
+      terms[n++] = terms[i];
+    }
+  }
+
+  size_t m = 0;
+  for (size_t i = 0; i < n; i++) {
+    if (terms[i].coef != 0) {
+      terms[m++] = terms[i];
+    }
+  }
+  return m;
+}
+
+// turn a sum into a linear expression, return NULL if the sum is not
+// linear or too small to be worth it
+static struct constr_t *normal_lin_convert(struct constr_t *constr) {
+  // count terms first
+  struct norm_lin_t lin = { .length = 0, .terms = NULL, .vars = 0, .lins = 0, .offset = 0 };
+  if (!normal_lin_collect(constr, 1, &lin) || lin.length < NORM_LIN_VARS_MIN) {
+    return NULL;
+  }
+  // nothing to gain if the sum only adds constants to a linear expression
+  if (lin.vars + lin.lins < 2) {
+    return NULL;
+  }
+
+  struct lin_term_t *terms = (struct lin_term_t *)alloc(lin.length * sizeof(struct lin_term_t));
+  lin = (struct norm_lin_t){ .length = 0, .terms = terms, .vars = 0, .lins = 0, .offset = 0 };
+  normal_lin_collect(constr, 1, &lin);
+
+  size_t length = normal_lin_merge(terms, lin.length);
+  if (length == 0) {
+    return NULL;
+  }
+
+  struct constr_t *retval = (struct constr_t *)alloc(sizeof(struct constr_t));
+  *retval = CONSTRAINT_LIN(length, terms);
+
+  // keep constants outside of the linear expression
+  if (lin.offset != 0) {
+    struct constr_t *c = (struct constr_t *)alloc(sizeof(struct constr_t));
+    *c = CONSTRAINT_TERM(VALUE(lin.offset));
+    struct constr_t *a = (struct constr_t *)alloc(sizeof(struct constr_t));
+    *a = CONSTRAINT_EXPR(ADD, retval, c);
+    retval = a;
+  }
+  return retval;
+}
+
 // normalize an arithmetic expression (ADD, MUL)
 static struct constr_t *normal_arith(struct constr_t *constr, const struct constr_type_t *type, domain_t neutral) {
   NORM_EVAL(constr);
 
+  // turn linear sums into linear expressions
+  if (type == &CONSTR_ADD) {
+    struct constr_t *lin = normal_lin_convert(constr);
+    if (lin != NULL) {
+      return lin;
+    }
+  }
+
   // normalize sub-expressions
   struct constr_t *l = constr->constr.expr.l;
   l = l->type->norm(l);
@@ -203,6 +358,181 @@ struct constr_t *normal_mul(struct constr_t *constr) {
   return normal_arith(constr, &CONSTR_MUL, 1);
 }
 
+// normalize division expression
+struct constr_t *normal_div(struct constr_t *constr) {
+  NORM_EVAL(constr);
+
+  // normalize sub-expressions
+  struct constr_t *l = constr->constr.expr.l;
+  l = l->type->norm(l);
+  struct constr_t *r = constr->constr.expr.r;
+  r = r->type->norm(r);
+
+  // reduce to left side if dividing by one
+  if (is_const(r) && get_lo(r->constr.term.val) == 1) {
+    return l;
+  }
+
+  return update_expr(constr, l, r);
+}
+
+// normalize remainder expression
+struct constr_t *normal_mod(struct constr_t *constr) {
+  NORM_EVAL(constr);
+
+  // normalize sub-expressions
+  struct constr_t *l = constr->constr.expr.l;
+  l = l->type->norm(l);
+  struct constr_t *r = constr->constr.expr.r;
+  r = r->type->norm(r);
+
+  return update_expr(constr, l, r);
+}
+
+// normalize absolute value expression
+struct constr_t *normal_abs(struct constr_t *constr) {
+  NORM_EVAL(constr);
+
+  // normalize sub-expression
+  struct constr_t *l = constr->constr.expr.l;
+  l = l->type->norm(l);
+
+  // the sign of a negated sub-expression does not matter
+  if (IS_TYPE(NEG, l)) {
+    return update_unary_expr(constr, l->constr.expr.l);
+  }
+
+  // reduce to sub-expression if it is already non-negative
+  if (IS_TYPE(ABS, l) || get_lo(l->type->eval(l)) >= 0) {
+    return l;
+  }
+
+  return update_unary_expr(constr, l);
+}
+
+// normalize an extremum expression (MIN, MAX)
+static struct constr_t *normal_extremum(struct constr_t *constr, bool is_min) {
+  NORM_EVAL(constr);
+
+  // normalize sub-expressions
+  struct constr_t *l = constr->constr.expr.l;
+  l = l->type->norm(l);
+  struct constr_t *r = constr->constr.expr.r;
+  r = r->type->norm(r);
+
+  // shortcut if both sides are the same
+  if (l == r) {
+    return l;
+  }
+
+  // reduce to one side if it always is the extremum
+  struct val_t lval = l->type->eval(l);
+  struct val_t rval = r->type->eval(r);
+  if (is_min ? get_hi(lval) <= get_lo(rval) : get_lo(lval) >= get_hi(rval)) {
+    return l;
+  }
+  if (is_min ? get_hi(rval) <= get_lo(lval) : get_lo(rval) >= get_hi(lval)) {
+    return r;
+  }
+
+  return update_expr(constr, l, r);
+}
+
+// normalize minimum expression
+struct constr_t *normal_min(struct constr_t *constr) {
+  return normal_extremum(constr, true);
+}
+
+// normalize maximum expression
+struct constr_t *normal_max(struct constr_t *constr) {
+  return normal_extremum(constr, false);
+}
+
+// normalize linear expression
+struct constr_t *normal_lin(struct constr_t *constr) {
+  NORM_EVAL(constr);
+
+  return constr;
+}
+
+// normalize difference expression
+struct constr_t *normal_diff(struct constr_t *constr) {
+  NORM_EVAL(constr);
+
+  return constr;
+}
+
+// normalize all-different expression
+struct constr_t *normal_alldiff(struct constr_t *constr) {
+  NORM_EVAL(constr);
+
+  // normalize sub-expressions, copy them only if one of them changed
+  size_t length = constr->constr.alldiff.length;
+  struct constr_t **elems = constr->constr.alldiff.elems;
+  for (size_t i = 0; i < length; i++) {
+    struct constr_t *c = elems[i]->type->norm(elems[i]);
+    if (c != elems[i]) {
+      if (elems == constr->constr.alldiff.elems) {
+        elems = (struct constr_t **)alloc(length * sizeof(struct constr_t *));
+        memcpy(elems, constr->constr.alldiff.elems, length * sizeof(struct constr_t *));
+      }
+      elems[i] = c;
+    }
+  }
+
+  if (elems != constr->constr.alldiff.elems) {
+    struct constr_t *retval = (struct constr_t *)alloc(sizeof(struct constr_t));
+    *retval = CONSTRAINT_ALLDIFF(length, elems);
+    return retval;
+  }
+  return constr;
+}
+
+// normalize optional sub-expression of scheduling expression
+static struct constr_t *normal_sched_opt(struct constr_t *constr) {
+  return constr != NULL ? constr->type->norm(constr) : NULL;
+}
+
+// normalize a scheduling expression (DISJ, CUMUL)
+static struct constr_t *normal_sched(struct constr_t *constr) {
+  NORM_EVAL(constr);
+
+  // normalize tasks, copy them only if one of them changed
+  size_t length = constr->constr.sched.length;
+  struct sched_task_t *tasks = constr->constr.sched.tasks;
+  for (size_t i = 0; i < length; i++) {
+    const struct sched_task_t *t = &constr->constr.sched.tasks[i];
+    struct sched_task_t n = { .start = t->start->type->norm(t->start),
+                        .dur = t->dur->type->norm(t->dur),
+                        .demand = normal_sched_opt(t->demand) };
+    if (n.start != t->start || n.dur != t->dur || n.demand != t->demand) {
+      if (tasks == constr->constr.sched.tasks) {
+        tasks = (struct sched_task_t *)alloc(length * sizeof(struct sched_task_t));
+        memcpy(tasks, constr->constr.sched.tasks, length * sizeof(struct sched_task_t));
+      }
+      tasks[i] = n;
+    }
+  }
+  struct constr_t *cap = normal_sched_opt(constr->constr.sched.cap);
+
+  if (tasks != constr->constr.sched.tasks || cap != constr->constr.sched.cap) {
+    struct constr_t *retval = (struct constr_t *)alloc(sizeof(struct constr_t));
+    *retval = (struct constr_t){ .type = constr->type, .constr = { .sched = { .length = length, .tasks = tasks, .cap = cap } } };
+    return retval;
+  }
+  return constr;
+}
+
+// normalize disjunctive resource expression
+struct constr_t *normal_disj(struct constr_t *constr) {
+  return normal_sched(constr);
+}
+
+// normalize cumulative resource expression
+struct constr_t *normal_cumul(struct constr_t *constr) {
+  return normal_sched(constr);
+}
+
 // normalize a unary expression (NEG, NOT)
 static struct constr_t *normal_unary(struct constr_t *constr, const struct constr_type_t *type) {
   NORM_EVAL(constr);
@@ -278,14 +608,84 @@ struct constr_t *normal_or(struct constr_t *constr) {
   return normal_logic(constr, is_false, &CONSTR_AND);
 }
 
+/** Variables and constant collected from a sum when turning a comparison into a difference */
+struct norm_diff_t {
+  struct constr_t *l; ///< Variable with positive sign, NULL if there is none yet
+  struct constr_t *r; ///< Variable with negative sign, NULL if there is none yet
+  domain_t offset; ///< Sum of constants
+};
+
+// collect the variables and constants of a sum with the given sign,
+// return false if the sum is not a difference of two variables plus a
+// constant
+static bool normal_diff_collect(struct constr_t *constr, bool negate, struct norm_diff_t *diff) {
+  if (is_const(constr)) {
+    // add up constants
+    domain_t c = get_lo(constr->constr.term.val);
+    diff->offset = add(diff->offset, negate ? neg(c) : c);
+    return !normal_saturated(c) && !normal_saturated(diff->offset);
+  }
+
+  if (IS_TYPE(TERM, constr)) {
+    struct constr_t **var = negate ? &diff->r : &diff->l;
+    if (*var != NULL) {
+      return false;
+    }
+    *var = constr;
+    return true;
+  }
+
+  switch (constr->type->op) {
+  case OP_ADD:
+    return normal_diff_collect(constr->constr.expr.l, negate, diff) &&
+      normal_diff_collect(constr->constr.expr.r, negate, diff);
+  case OP_NEG:
+    return normal_diff_collect(constr->constr.expr.l, !negate, diff);
+  default:
+    return false;
+  }
+}
+
+// turn a comparison a < b, or a <= b if it is negated, into a
+// difference expression if both sides only consist of one variable
+// each plus constants, return the comparison otherwise
+static struct constr_t *normal_diff_convert(struct constr_t *constr) {
+  bool negated = IS_TYPE(NOT, constr);
+  struct constr_t *c = negated ? constr->constr.expr.l : constr;
+  if (!IS_TYPE(LT, c)) {
+    return constr;
+  }
+
+  // collect a - b for a < b and b - a for !(a < b)
+  struct norm_diff_t diff = { .l = NULL, .r = NULL, .offset = 0 };
+  if (!normal_diff_collect(c->constr.expr.l, negated, &diff) ||
+      !normal_diff_collect(c->constr.expr.r, !negated, &diff) ||
+      diff.l == NULL || diff.r == NULL || diff.l == diff.r) {
+    return constr;
+  }
+
+  // l - r + offset < 0 means l - r <= -offset - 1, l - r + offset <= 0
+  // means l - r <= -offset
+  domain_t bound = negated ? neg(diff.offset) : add(neg(diff.offset), -1);
+  if (normal_saturated(bound)) {
+    return constr;
+  }
+
+  struct constr_t *retval = (struct constr_t *)alloc(sizeof(struct constr_t));
+  *retval = CONSTRAINT_DIFF(diff.l, diff.r, bound);
+  return retval;
+}
+
 // normalize wide-and expression
 struct constr_t *normal_wand(struct constr_t *constr) {
   struct constr_t *retval = constr;
 
-  // patch sub-expressions of wide-and if they could be normalized
+  // patch sub-expressions of wide-and if they could be normalized,
+  // comparisons of two variables become difference expressions, which
+  // propagate along chains of them
   for (size_t i = 0, l = constr->constr.wand.length; i < l; i++) {
     struct constr_t *o = constr->constr.wand.elems[i].constr;
-    struct constr_t *c = o->type->norm(o);
+    struct constr_t *c = normal_diff_convert(o->type->norm(o));
     if (c != o) {
       patch(&retval->constr.wand.elems[i], c);
     }
@@ -27,16 +27,29 @@ along with CSolve.  If not, see <http://www.gnu.org/licenses/>.
 // what solution to look for
 static enum objective_t _objective;
 // the objective value constraint
-static struct constr_t _objective_val;
+static THREAD_LOCAL struct constr_t _objective_val;
 // the value of the best solution found so far
 static volatile domain_t *_objective_best;
+// counter of updates to the best solution found so far
+static volatile uint64_t *_objective_epoch;
+// update counter value last seen by this worker
+static THREAD_LOCAL uint64_t _objective_epoch_seen;
+// objective value of the last solution found by this worker
+static THREAD_LOCAL domain_t _objective_solution;
 
 // initialize the solution to look for
-void objective_init(enum objective_t o, volatile domain_t *best) {
+void objective_init(enum objective_t o, volatile domain_t *best, volatile uint64_t *epoch) {
   _objective = o;
   _objective_val = CONSTRAINT_TERM(INTERVAL(DOMAIN_MIN+1, DOMAIN_MAX-1));
   _objective_best = best;
-  switch (o) {
+  _objective_epoch = epoch;
+  objective_reset();
+}
+
+// forget the best solution found so far
+void objective_reset(void) {
+  _objective_epoch_seen = 0;
+  switch (_objective) {
   case OBJ_ANY:
   case OBJ_ALL:
     *_objective_best = 0;
@@ -77,24 +90,51 @@ bool objective_better(void) {
   return true;
 }
 
-// update the best objective value found so far
-void objective_update_best(void) {
+// atomically replace the best objective value with a better one,
+// return whether the value was replaced
+static bool objective_swap_best(domain_t val, bool (*better)(domain_t, domain_t)) {
+  _objective_solution = val;
+  domain_t best = *_objective_best;
+  while (better(val, best)) {
+    // on failure, best is reloaded with the value of another worker
+    if (__atomic_compare_exchange_n(_objective_best, &best, val, false,
+                                    __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST)) {
+      __atomic_add_fetch(_objective_epoch, 1, __ATOMIC_SEQ_CST);
+      return true;
+    }
+  }
+  return false;
+}
+
+// compare objective values when looking for minimum
+static bool objective_lt(domain_t a, domain_t b) {
+  return a < b;
+}
+
+// compare objective values when looking for maximum
+static bool objective_gt(domain_t a, domain_t b) {
+  return a > b;
+}
+
+// update the best objective value found so far, return whether the
+// value was actually better than the best one of all workers
+bool objective_update_best(void) {
   switch (_objective) {
   case OBJ_ANY:
   case OBJ_ALL:
     // no objective value when looking for all/any solutions
-    break;
+    _objective_solution = *_objective_best;
+    return true;
   case OBJ_MIN:
     // update objective value with lower bound when looking for minimum
-    *_objective_best = get_lo(_objective_val.constr.term.val);
-    break;
+    return objective_swap_best(get_lo(_objective_val.constr.term.val), objective_lt);
   case OBJ_MAX:
     // update objective value with upper bound when looking for maximum
-    *_objective_best = get_hi(_objective_val.constr.term.val);
-    break;
+    return objective_swap_best(get_hi(_objective_val.constr.term.val), objective_gt);
   default:
     print_fatal(ERROR_MSG_INVALID_OBJ_FUNC_TYPE, _objective);
   }
+  return false;
 }
 
 // update the objective value constraint
@@ -109,6 +149,7 @@ void objective_update_val(void) {
     domain_t best = objective_best();
     if (get_hi(_objective_val.constr.term.val) > add(best, neg(1))) {
       _objective_val.constr.term.val.hi = add(best, neg(1));
+      eval_invalidate();
     }
     break;
   }
@@ -117,6 +158,7 @@ void objective_update_val(void) {
     domain_t best = objective_best();
     if (get_lo(_objective_val.constr.term.val) < add(best, 1)) {
       _objective_val.constr.term.val.lo = add(best, 1);
+      eval_invalidate();
     }
     break;
   }
@@ -125,6 +167,21 @@ void objective_update_val(void) {
   }
 }
 
+// check whether the best objective value was updated since the last
+// call, return whether the objective value cannot be better anymore
+bool objective_poll(void) {
+  // cheap check for the common case that nothing changed
+  uint64_t epoch = *_objective_epoch;
+  if (epoch == _objective_epoch_seen) {
+    return false;
+  }
+  _objective_epoch_seen = epoch;
+
+  // tighten objective value to the new best value
+  objective_update_val();
+  return !objective_better();
+}
+
 // return a pointer to the objective value constraint
 struct constr_t *objective_val(void) {
   return &_objective_val;
@@ -134,3 +191,8 @@ struct constr_t *objective_val(void) {
 domain_t objective_best(void) {
   return *_objective_best;
 }
+
+// return the objective value of the last solution found by this worker
+domain_t objective_solution(void) {
+  return _objective_solution;
+}
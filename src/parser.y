@@ -40,13 +40,13 @@ void yyerror(const char *);
 %define parse.error verbose
 %define parse.lac full
 
-%token ANY ALL MIN MAX NEQ LEQ GEQ ALL_DIFFERENT
+%token ANY ALL MIN MAX NEQ LEQ GEQ ALL_DIFFERENT DISJUNCTIVE CUMULATIVE ABS MINIMUM MAXIMUM
 %token <intval> NUM
 %token <strval> IDENT
 
 %type <expr> PrimaryExpr UnaryExpr MultExpr AddExpr RelatExpr EqualExpr AndExpr OrExpr Expr
 %type <expr> Objective Constraint Constraints
-%type <expr_list> ExprList
+%type <expr_list> ExprList ExprArray
 
 %start Input
 
@@ -54,40 +54,10 @@ void yyerror(const char *);
 
 Input : Constraints
       {
-        size_t size = var_count();
-
-        prop_result_t prop = propagate($1, size);
-        struct constr_t *norm = $1;
-
-        if (prop != PROP_ERROR) {
-          struct constr_t *prev;
-          do {
-            prev = norm;
-            norm = normalize(norm);
-            prop = propagate(norm, size);
-          } while (norm != prev && prop != PROP_ERROR);
-        }
-
-        if (prop == PROP_ERROR) {
+        if (!model_solve($1)) {
           fprintf(stdout, "INFEASIBLE PROBLEM\n");
         }
 
-        bind_commit();
-        patch_commit();
-
-        stats_init();
-
-        if (prop != PROP_ERROR) {
-          struct env_t *env = env_generate();
-
-          clauses_init(norm, NULL);
-          strategy_var_order_init(size, env);
-
-          solve(size, env, norm);
-
-          env_free();
-        }
-
         expr_free($1);
       }
 
@@ -107,23 +77,23 @@ Constraints : Constraints Constraint
 ;
 
 Objective : ANY ';'
-          { objective_init(OBJ_ANY, &shared()->objective_best);
+          { objective_init(OBJ_ANY, &shared()->objective_best, &shared()->objective_epoch);
             $$ = alloc(sizeof(struct constr_t));
             *$$ = CONSTRAINT_TERM(VALUE(1));
           }
           | ALL ';'
-          { objective_init(OBJ_ALL, &shared()->objective_best);
+          { objective_init(OBJ_ALL, &shared()->objective_best, &shared()->objective_epoch);
             $$ = alloc(sizeof(struct constr_t));
             *$$ = CONSTRAINT_TERM(VALUE(1));
           }
           | MIN Expr ';'
-          { objective_init(OBJ_MIN, &shared()->objective_best);
+          { objective_init(OBJ_MIN, &shared()->objective_best, &shared()->objective_epoch);
             vars_add("<obj>", objective_val());
             $$ = alloc(sizeof(struct constr_t));
             *$$ = CONSTRAINT_EXPR(EQ, $2, objective_val());
           }
           | MAX Expr ';'
-          { objective_init(OBJ_MAX, &shared()->objective_best);
+          { objective_init(OBJ_MAX, &shared()->objective_best, &shared()->objective_epoch);
             vars_add("<obj>", objective_val());
             $$ = alloc(sizeof(struct constr_t));
             *$$ = CONSTRAINT_EXPR(EQ, objective_val(), $2);
@@ -160,27 +130,68 @@ UnaryExpr : PrimaryExpr
           { $$ = alloc(sizeof(struct constr_t));
             *$$ = CONSTRAINT_EXPR(NOT, $2, NULL);
           }
+          | ABS '(' Expr ')'
+          { $$ = alloc(sizeof(struct constr_t));
+            *$$ = CONSTRAINT_EXPR(ABS, $3, NULL);
+          }
+          | MINIMUM '(' Expr ',' Expr ')'
+          { $$ = alloc(sizeof(struct constr_t));
+            *$$ = CONSTRAINT_EXPR(MIN, $3, $5);
+          }
+          | MAXIMUM '(' Expr ',' Expr ')'
+          { $$ = alloc(sizeof(struct constr_t));
+            *$$ = CONSTRAINT_EXPR(MAX, $3, $5);
+          }
           | ALL_DIFFERENT '(' ExprList ')'
           {
-            // create wide-and node
-            $$ = alloc(sizeof(struct constr_t));
-            *$$ = CONSTRAINT_WAND(0, NULL);
-            // add != constraints for all pairs
+            size_t length = 0;
             for (struct expr_list_t *l = $3; l != NULL; l = l->next) {
-              for (struct expr_list_t *k = l->next; k != NULL; k = k->next) {
-                struct constr_t *a = alloc(sizeof(struct constr_t));
-                *a = CONSTRAINT_EXPR(EQ, l->expr, k->expr);
-                struct constr_t *b = alloc(sizeof(struct constr_t));
-                *b = CONSTRAINT_EXPR(NOT, a, NULL);
-
-                $$->constr.wand.length++;
-                const size_t size = $$->constr.wand.length * sizeof(struct wand_expr_t);
-                $$->constr.wand.elems = realloc($$->constr.wand.elems, size);
-                $$->constr.wand.elems[$$->constr.wand.length-1] =
-                  (struct wand_expr_t) { .constr = b, .orig = b, .prop_tag = 0 };
-              }
+              length++;
+            }
+            // fill in sub-expressions, the list is in reverse order
+            struct constr_t **elems = alloc(length * sizeof(struct constr_t *));
+            size_t i = length;
+            for (struct expr_list_t *l = $3; l != NULL; l = l->next) {
+              elems[--i] = l->expr;
+            }
+            expr_list_free($3);
+
+            $$ = alloc(sizeof(struct constr_t));
+            *$$ = CONSTRAINT_ALLDIFF(length, elems);
+          }
+          | DISJUNCTIVE '(' ExprArray ',' ExprArray ')'
+          {
+            size_t length = 0;
+            struct sched_task_t *tasks = expr_list_tasks($3, $5, NULL, &length);
+            expr_list_free($3);
+            expr_list_free($5);
+            if (tasks == NULL) {
+              yyerror(ERROR_MSG_TASK_LISTS_LENGTH);
+              YYERROR;
             }
+
+            $$ = alloc(sizeof(struct constr_t));
+            *$$ = CONSTRAINT_DISJ(length, tasks);
+          }
+          | CUMULATIVE '(' ExprArray ',' ExprArray ',' ExprArray ',' Expr ')'
+          {
+            size_t length = 0;
+            struct sched_task_t *tasks = expr_list_tasks($3, $5, $7, &length);
             expr_list_free($3);
+            expr_list_free($5);
+            expr_list_free($7);
+            if (tasks == NULL) {
+              yyerror(ERROR_MSG_TASK_LISTS_LENGTH);
+              YYERROR;
+            }
+
+            $$ = alloc(sizeof(struct constr_t));
+            *$$ = CONSTRAINT_CUMUL(length, tasks, $9);
+          }
+;
+
+ExprArray : '[' ExprList ']'
+          { $$ = $2;
           }
 ;
 
@@ -197,6 +208,14 @@ MultExpr : UnaryExpr
          { $$ = alloc(sizeof(struct constr_t));
            *$$ = CONSTRAINT_EXPR(MUL, $1, $3);
          }
+         | MultExpr '/' UnaryExpr
+         { $$ = alloc(sizeof(struct constr_t));
+           *$$ = CONSTRAINT_EXPR(DIV, $1, $3);
+         }
+         | MultExpr '%' UnaryExpr
+         { $$ = alloc(sizeof(struct constr_t));
+           *$$ = CONSTRAINT_EXPR(MOD, $1, $3);
+         }
 ;
 
 AddExpr : MultExpr
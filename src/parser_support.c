@@ -168,10 +168,13 @@ void vars_add(const char *key, struct constr_t *val) {
     (struct env_t){ .key = k,
                     .val = val,
                     .binds = NULL,
-                    .clauses = { .length = 0, .elems = NULL },
+                    .clauses = { .length = 0, .elems = NULL, .events = NULL, .dead = 0 },
+                    .watches = { .length = 0, .elems = NULL, .events = NULL, .dead = 0 },
                     .order = SIZE_MAX,
                     .prio = 0,
-                    .level = SIZE_MAX };
+                    .level = SIZE_MAX,
+                    .prop_tag = 0,
+                    .prop_events = 0 };
 
   // add variable to key/identifier and variables values hash tables
   keytab_add(_var_count-1);
@@ -194,14 +197,54 @@ int32_t vars_count(struct constr_t *constr) {
   case OP_LT:
   case OP_ADD:
   case OP_MUL:
+  case OP_DIV:
+  case OP_MOD:
+  case OP_MIN:
+  case OP_MAX:
   case OP_AND:
   case OP_OR:
     // count variables on right side
     return vars_count(constr->constr.expr.l) + vars_count(constr->constr.expr.r);
   case OP_NEG:
+  case OP_ABS:
   case OP_NOT:
     // count variables on left side
     return vars_count(constr->constr.expr.l);
+  case OP_LIN: {
+    // count variables of terms
+    int32_t count = 0;
+    for (size_t i = 0, l = constr->constr.lin.length; i < l; i++) {
+      count += vars_count(constr->constr.lin.terms[i].var);
+    }
+    return count;
+  }
+  case OP_DIFF:
+    // count variables of both sides
+    return vars_count(constr->constr.diff.l) + vars_count(constr->constr.diff.r);
+  case OP_ALLDIFF: {
+    // count variables of sub-expressions
+    int32_t count = 0;
+    for (size_t i = 0, l = constr->constr.alldiff.length; i < l; i++) {
+      count += vars_count(constr->constr.alldiff.elems[i]);
+    }
+    return count;
+  }
+  case OP_DISJ:
+  case OP_CUMUL: {
+    // count variables of tasks and capacity
+    int32_t count = 0;
+    for (size_t i = 0, l = constr->constr.sched.length; i < l; i++) {
+      const struct sched_task_t *t = &constr->constr.sched.tasks[i];
+      count += vars_count(t->start) + vars_count(t->dur);
+      if (t->demand != NULL) {
+        count += vars_count(t->demand);
+      }
+    }
+    if (constr->constr.sched.cap != NULL) {
+      count += vars_count(constr->constr.sched.cap);
+    }
+    return count;
+  }
   default:
     // die if encountering an unknown operation
     print_fatal(ERROR_MSG_INVALID_OPERATION, constr->type->op);
@@ -224,16 +267,53 @@ void vars_weighten(struct constr_t *constr, int32_t weight) {
     case OP_LT:
     case OP_ADD:
     case OP_MUL:
+    case OP_DIV:
+    case OP_MOD:
+    case OP_MIN:
+    case OP_MAX:
     case OP_AND:
     case OP_OR:
       // weighten variables on right side
       vars_weighten(constr->constr.expr.r, weight);
       /* fall through */
     case OP_NEG:
+    case OP_ABS:
     case OP_NOT:
       // weighten variables on left side
       vars_weighten(constr->constr.expr.l, weight);
       break;
+    case OP_LIN:
+      // weighten variables of terms
+      for (size_t i = 0, l = constr->constr.lin.length; i < l; i++) {
+        vars_weighten(constr->constr.lin.terms[i].var, weight);
+      }
+      break;
+    case OP_DIFF:
+      // weighten variables of both sides
+      vars_weighten(constr->constr.diff.l, weight);
+      vars_weighten(constr->constr.diff.r, weight);
+      break;
+    case OP_ALLDIFF:
+      // weighten variables of sub-expressions
+      for (size_t i = 0, l = constr->constr.alldiff.length; i < l; i++) {
+        vars_weighten(constr->constr.alldiff.elems[i], weight);
+      }
+      break;
+    case OP_DISJ:
+    case OP_CUMUL:
+      // weighten variables of tasks and capacity
+      for (size_t i = 0, l = constr->constr.sched.length; i < l; i++) {
+        const struct sched_task_t *t = &constr->constr.sched.tasks[i];
+        vars_weighten(t->start, weight);
+        vars_weighten(t->dur, weight);
+        if (t->demand != NULL) {
+          vars_weighten(t->demand, weight);
+        }
+      }
+      if (constr->constr.sched.cap != NULL) {
+        vars_weighten(constr->constr.sched.cap, weight);
+      }
+      break;
     default:
       // die if encountering an unknown operation
       print_fatal(ERROR_MSG_INVALID_OPERATION, constr->type->op);
@@ -263,7 +343,8 @@ void env_free(void) {
 
   for (size_t i = 0; i < _var_count; i++) {
     free((char *)_vars[i].key);
-    free(_vars[i].clauses.elems);
+    clause_list_free(&_vars[i].clauses);
+    clause_list_free(&_vars[i].watches);
   }
   free(_vars);
 
@@ -292,6 +373,37 @@ void expr_list_free(struct expr_list_t *list) {
   }
 }
 
+// create the tasks of a scheduling expression from lists of start
+// times, durations, and demands (NULL for demands of one), return
+// NULL if the lists differ in length
+struct sched_task_t *expr_list_tasks(struct expr_list_t *starts, struct expr_list_t *durs, struct expr_list_t *demands,
+                               size_t *length) {
+  size_t n = 0;
+  for (struct expr_list_t *l = starts; l != NULL; l = l->next) {
+    n++;
+  }
+
+  // fill in tasks, the lists are in reverse order
+  struct sched_task_t *tasks = (struct sched_task_t *)alloc(n * sizeof(struct sched_task_t));
+  size_t i = n;
+  struct expr_list_t *d = durs;
+  struct expr_list_t *c = demands;
+  for (struct expr_list_t *s = starts; s != NULL; s = s->next) {
+    if (d == NULL || (demands != NULL && c == NULL)) {
+      return NULL;
+    }
+    tasks[--i] = (struct sched_task_t){ .start = s->expr, .dur = d->expr, .demand = c != NULL ? c->expr : NULL };
+    d = d->next;
+    c = c != NULL ? c->next : NULL;
+  }
+  if (d != NULL || c != NULL) {
+    return NULL;
+  }
+
+  *length = n;
+  return tasks;
+}
+
 // free memory for wide-and expression
 static void expr_free_wand(struct constr_t *constr) {
   for (size_t i = 0; i < constr->constr.wand.length; i++) {
@@ -308,16 +420,46 @@ static void expr_free_constr(struct constr_t *constr) {
   case OP_LT:
   case OP_ADD:
   case OP_MUL:
+  case OP_DIV:
+  case OP_MOD:
+  case OP_MIN:
+  case OP_MAX:
   case OP_AND:
   case OP_OR:
     // weighten variables on right side
     expr_free(constr->constr.expr.r);
     /* fall through */
   case OP_NEG:
+  case OP_ABS:
   case OP_NOT:
     // weighten variables on left side
     expr_free(constr->constr.expr.l);
     break;
+  case OP_LIN:
+  case OP_DIFF:
+    // terms only refer to variables
+    break;
+  case OP_ALLDIFF:
+    // free sub-expressions
+    for (size_t i = 0, l = constr->constr.alldiff.length; i < l; i++) {
+      expr_free(constr->constr.alldiff.elems[i]);
+    }
+    break;
+  case OP_DISJ:
+  case OP_CUMUL:
+    // free sub-expressions of tasks and capacity
+    for (size_t i = 0, l = constr->constr.sched.length; i < l; i++) {
+      const struct sched_task_t *t = &constr->constr.sched.tasks[i];
+      expr_free(t->start);
+      expr_free(t->dur);
+      if (t->demand != NULL) {
+        expr_free(t->demand);
+      }
+    }
+    if (constr->constr.sched.cap != NULL) {
+      expr_free(constr->constr.sched.cap);
+    }
+    break;
   default:
     // die if encountering an unknown operation
     print_fatal(ERROR_MSG_INVALID_OPERATION, constr->type->op);
@@ -335,48 +477,107 @@ void expr_free(struct constr_t *constr) {
   }
 }
 
-// initialize clause list for terminal
-static void clauses_init_term(struct constr_t *constr, struct wand_expr_t *clause) {
+// subscribe clause to events of terminal
+static void clauses_init_term(struct constr_t *constr, struct wand_expr_t *clause, prop_event_t events) {
   // add clause to terminal
   if (!is_value(constr->constr.term.val) && clause != NULL) {
-    struct env_t *e = constr->constr.term.env;
-    if (!clause_list_contains(&e->clauses, clause)) {
-      clause_list_append(&e->clauses, clause);
-    }
+    clause_list_subscribe(&constr->constr.term.env->clauses, clause, events);
   }
 }
 
-// initialize clause list for wide-and expression
-static void clauses_init_wand(struct constr_t *constr, struct wand_expr_t *clause) {
-  // recurse to wide-and sub-expressions
-  for (size_t i = 0, l = constr->constr.wand.length; i < l; i++) {
-    struct wand_expr_t *c = clause;
-    // set clause to sub-expression, unless it is already set or the
-    // sub-expression itself is a wide-and expression
-    if (clause == NULL && !IS_TYPE(WAND, constr->constr.wand.elems[i].constr)) {
-      c = &constr->constr.wand.elems[i];
-    }
-    clauses_init(constr->constr.wand.elems[i].constr, c);
+// return the clause for a sub-expression of a wide-and expression
+static struct wand_expr_t *clauses_init_wand_clause(struct constr_t *constr, struct wand_expr_t *clause, size_t i) {
+  // set clause to sub-expression, unless it is already set or the
+  // sub-expression itself is a wide-and expression
+  if (clause == NULL && !IS_TYPE(WAND, constr->constr.wand.elems[i].constr)) {
+    return &constr->constr.wand.elems[i];
   }
+  return clause;
 }
 
-// initialize clause list for ordinary expressions
-static void clauses_init_expr(struct constr_t *constr, struct wand_expr_t *clause) {
-  // recurse
+// swap lower and upper bound events
+static prop_event_t clauses_init_swap(prop_event_t events) {
+  return (events & PROP_EVENT_FIX) |
+    ((events & PROP_EVENT_LB) ? PROP_EVENT_UB : 0) |
+    ((events & PROP_EVENT_UB) ? PROP_EVENT_LB : 0);
+}
+
+// subscribe clause to events of variables in an expression whose
+// value matters only as far as the events tell
+static void clauses_init_value(struct constr_t *constr, struct wand_expr_t *clause, prop_event_t events) {
+  if (IS_TYPE(TERM, constr)) {
+    clauses_init_term(constr, clause, events);
+    return;
+  }
+
+  if (IS_TYPE(WAND, constr)) {
+    // recurse to wide-and sub-expressions
+    for (size_t i = 0, l = constr->constr.wand.length; i < l; i++) {
+      clauses_init_value(constr->constr.wand.elems[i].constr, clauses_init_wand_clause(constr, clause, i), PROP_EVENT_ANY);
+    }
+    return;
+  }
+
   switch (constr->type->op) {
+  case OP_NEG:
+    // negating flips the bounds
+    clauses_init_value(constr->constr.expr.l, clause, clauses_init_swap(events));
+    break;
+  case OP_ADD:
+  case OP_MIN:
+  case OP_MAX:
+    // adding and taking extrema keep the bounds
+    clauses_init_value(constr->constr.expr.l, clause, events);
+    clauses_init_value(constr->constr.expr.r, clause, events);
+    break;
+  case OP_LIN:
+    // terms keep the bounds for positive coefficients and flip them
+    // for negative ones
+    for (size_t i = 0, l = constr->constr.lin.length; i < l; i++) {
+      const struct lin_term_t *t = &constr->constr.lin.terms[i];
+      clauses_init_value(t->var, clause, t->coef > 0 ? events : clauses_init_swap(events));
+    }
+    break;
+  case OP_DIFF:
+    // any change of either side may matter
+    clauses_init_value(constr->constr.diff.l, clause, PROP_EVENT_ANY);
+    clauses_init_value(constr->constr.diff.r, clause, PROP_EVENT_ANY);
+    break;
+  case OP_ALLDIFF:
+    // any change of sub-expressions may matter
+    for (size_t i = 0, l = constr->constr.alldiff.length; i < l; i++) {
+      clauses_init_value(constr->constr.alldiff.elems[i], clause, PROP_EVENT_ANY);
+    }
+    break;
+  case OP_DISJ:
+  case OP_CUMUL:
+    // any change of tasks or capacity may matter
+    for (size_t i = 0, l = constr->constr.sched.length; i < l; i++) {
+      const struct sched_task_t *t = &constr->constr.sched.tasks[i];
+      clauses_init_value(t->start, clause, PROP_EVENT_ANY);
+      clauses_init_value(t->dur, clause, PROP_EVENT_ANY);
+      if (t->demand != NULL) {
+        clauses_init_value(t->demand, clause, PROP_EVENT_ANY);
+      }
+    }
+    if (constr->constr.sched.cap != NULL) {
+      clauses_init_value(constr->constr.sched.cap, clause, PROP_EVENT_ANY);
+    }
+    break;
   case OP_EQ:
   case OP_LT:
-  case OP_ADD:
   case OP_MUL:
+  case OP_DIV:
+  case OP_MOD:
   case OP_AND:
   case OP_OR:
-    // initialize clauses on right side
-    clauses_init(constr->constr.expr.r, clause);
+    // any change on right side may matter
+    clauses_init_value(constr->constr.expr.r, clause, PROP_EVENT_ANY);
     /* fall through */
-  case OP_NEG:
+  case OP_ABS:
   case OP_NOT:
-    // initialize clauses on left side
-    clauses_init(constr->constr.expr.l, clause);
+    // any change on left side may matter
+    clauses_init_value(constr->constr.expr.l, clause, PROP_EVENT_ANY);
     break;
   default:
     // die if encountering an unknown operation
@@ -384,13 +585,101 @@ static void clauses_init_expr(struct constr_t *constr, struct wand_expr_t *claus
   }
 }
 
-// initialize clause lists for variables in an expression
+// subscribe clause to events of variables in an expression that must
+// evaluate to the given truth value
+static void clauses_init_truth(struct constr_t *constr, struct wand_expr_t *clause, bool truth) {
+  if (IS_TYPE(WAND, constr) && truth) {
+    // recurse to wide-and sub-expressions, which must all be true
+    for (size_t i = 0, l = constr->constr.wand.length; i < l; i++) {
+      clauses_init_truth(constr->constr.wand.elems[i].constr, clauses_init_wand_clause(constr, clause, i), truth);
+    }
+    return;
+  }
+
+  if (IS_TYPE(TERM, constr) || IS_TYPE(WAND, constr)) {
+    clauses_init_value(constr, clause, PROP_EVENT_ANY);
+    return;
+  }
+
+  switch (constr->type->op) {
+  case OP_LT:
+    // l < r can only propagate when l grows or r shrinks, the
+    // negation only when l shrinks or r grows
+    clauses_init_value(constr->constr.expr.l, clause, truth ? PROP_EVENT_LB : PROP_EVENT_UB);
+    clauses_init_value(constr->constr.expr.r, clause, truth ? PROP_EVENT_UB : PROP_EVENT_LB);
+    break;
+  case OP_DIFF:
+    // likewise for l - r <= c
+    clauses_init_value(constr->constr.diff.l, clause, truth ? PROP_EVENT_LB : PROP_EVENT_UB);
+    clauses_init_value(constr->constr.diff.r, clause, truth ? PROP_EVENT_UB : PROP_EVENT_LB);
+    break;
+  case OP_NOT:
+    clauses_init_truth(constr->constr.expr.l, clause, !truth);
+    break;
+  case OP_AND:
+  case OP_OR:
+    // both sides must hold for a true conjunction or a false disjunction
+    if (truth == IS_TYPE(AND, constr)) {
+      clauses_init_truth(constr->constr.expr.l, clause, truth);
+      clauses_init_truth(constr->constr.expr.r, clause, truth);
+      break;
+    }
+    /* fall through */
+  default:
+    clauses_init_value(constr, clause, PROP_EVENT_ANY);
+  }
+}
+
+// initialize clause lists for variables in an expression, subscribing
+// clauses only to the events they can propagate on
 void clauses_init(struct constr_t *constr, struct wand_expr_t *clause) {
-  if (IS_TYPE(TERM, constr)) {
-    clauses_init_term(constr, clause);
-  } else if (IS_TYPE(WAND, constr)) {
-    clauses_init_wand(constr, clause);
-  } else {
-    clauses_init_expr(constr, clause);
+  clauses_init_truth(constr, clause, true);
+}
+
+// presolve a model and generate its variable environment, return the
+// presolved model or NULL if presolving found it infeasible
+struct constr_t *model_presolve(struct constr_t *constr, struct env_t **env) {
+  size_t size = var_count();
+
+  prop_result_t prop = propagate(constr, size);
+  struct constr_t *norm = constr;
+
+  if (prop != PROP_ERROR) {
+    struct constr_t *prev;
+    do {
+      prev = norm;
+      norm = normalize(norm);
+      prop = propagate(norm, size);
+    } while (norm != prev && prop != PROP_ERROR);
   }
+
+  bind_commit();
+  patch_commit();
+
+  stats_init();
+
+  if (prop == PROP_ERROR) {
+    return NULL;
+  }
+
+  *env = env_generate();
+  clauses_init(norm, NULL);
+  compile_init(*env);
+  compile_clauses(norm);
+  return norm;
+}
+
+// presolve and solve a model, return whether presolving found it feasible
+bool model_solve(struct constr_t *constr) {
+  struct env_t *env;
+  struct constr_t *norm = model_presolve(constr, &env);
+
+  if (norm != NULL) {
+    strategy_var_order_init(var_count(), env);
+    solve(var_count(), env, norm);
+  }
+
+  env_free();
+
+  return norm != NULL;
 }
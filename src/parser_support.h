@@ -54,6 +54,11 @@ struct expr_list_t {
 struct expr_list_t *expr_list_append(struct expr_list_t *list, struct constr_t *elem);
 /** Deallocate memory occupied by list of expressions */
 void expr_list_free(struct expr_list_t *list);
+/** Create tasks of a scheduling expression from lists of start times,
+    durations, and demands (NULL for demands of one), return NULL if
+    the lists differ in length */
+struct sched_task_t *expr_list_tasks(struct expr_list_t *starts, struct expr_list_t *durs, struct expr_list_t *demands,
+                               size_t *length);
 
 /** Free the memory allocated for wide-and nodes in an expression */
 void expr_free(struct constr_t *constr);
@@ -61,4 +66,10 @@ void expr_free(struct constr_t *constr);
 /** Initialize clause lists */
 void clauses_init(struct constr_t *constr, struct wand_expr_t *clause);
 
+/** Presolve a model and generate its variable environment, return the
+    presolved model or NULL if presolving found it infeasible */
+struct constr_t *model_presolve(struct constr_t *constr, struct env_t **env);
+/** Presolve and solve a model, return false if presolving found it infeasible */
+bool model_solve(struct constr_t *constr);
+
 #endif
@@ -43,6 +43,43 @@ void print_constr(FILE *file, const struct constr_t *constr) {
       print_constr(file, constr->constr.wand.elems[i].constr);
       fprintf(file, ";");
     }
+  } else if (IS_TYPE(LIN, constr)) {
+    fprintf(file, " (%c", constr->type->op);
+    for (size_t i = 0; i < constr->constr.lin.length; i++) {
+      fprintf(file, " (*");
+      print_val(file, VALUE(constr->constr.lin.terms[i].coef));
+      print_constr(file, constr->constr.lin.terms[i].var);
+      fprintf(file, ")");
+    }
+    fprintf(file, ")");
+  } else if (IS_TYPE(DIFF, constr)) {
+    fprintf(file, " (%c", constr->type->op);
+    print_constr(file, constr->constr.diff.l);
+    print_constr(file, constr->constr.diff.r);
+    print_val(file, VALUE(constr->constr.diff.c));
+    fprintf(file, ")");
+  } else if (IS_TYPE(ALLDIFF, constr)) {
+    fprintf(file, " (%c", constr->type->op);
+    for (size_t i = 0; i < constr->constr.alldiff.length; i++) {
+      print_constr(file, constr->constr.alldiff.elems[i]);
+    }
+    fprintf(file, ")");
+  } else if (IS_TYPE(DISJ, constr) || IS_TYPE(CUMUL, constr)) {
+    fprintf(file, " (%c", constr->type->op);
+    for (size_t i = 0; i < constr->constr.sched.length; i++) {
+      const struct sched_task_t *t = &constr->constr.sched.tasks[i];
+      fprintf(file, " (");
+      print_constr(file, t->start);
+      print_constr(file, t->dur);
+      if (t->demand != NULL) {
+        print_constr(file, t->demand);
+      }
+      fprintf(file, ")");
+    }
+    if (constr->constr.sched.cap != NULL) {
+      print_constr(file, constr->constr.sched.cap);
+    }
+    fprintf(file, ")");
   } else {
     fprintf(file, " (%c", constr->type->op);
     print_constr(file, constr->constr.expr.l);
@@ -66,7 +103,7 @@ void print_env(FILE *file, size_t size, struct env_t *env) {
 void print_solution(FILE *file, size_t size, struct env_t *env) {
   fprintf(file, "SOLUTION: ");
   print_env(file, size, env);
-  fprintf(file, "BEST: %d\n", objective_best());
+  fprintf(file, "BEST: %d\n", objective_solution());
 }
 
 // helper function to print errors
@@ -92,3 +129,13 @@ void print_fatal(const char *fmt, ...) {
     va_end(args);
     exit(EXIT_FAILURE);
 }
+
+// print warning message
+void print_warning(const char *fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    fprintf(stderr, "%s: warning: ", main_name());
+    vfprintf(stderr, fmt, args);
+    fprintf(stderr, "\n");
+    va_end(args);
+}
@@ -18,6 +18,7 @@ along with CSolve.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "csolve.h"
 
+#include <errno.h>
 #include <limits.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -40,17 +41,280 @@ static void propagate_term_confl(struct env_t *var, const struct wand_expr_t *cl
   }
 }
 
-// propagate new variable value to all affected clauses
-static prop_result_t propagate_term_recurse(struct env_t *var) {
-  // propagate to all affected clauses
-  prop_result_t p = propagate_clauses(&var->clauses);
-  if (p == PROP_ERROR) {
-    // update priorty and variable ordering
+/** Variable or clause waiting for propagation */
+struct prop_entry_t {
+  struct wand_expr_t *clause; ///< Clause to propagate, NULL for variables
+  struct env_t *var; ///< Changed variable, or variable that deferred the clause
+};
+
+/** Ring buffer of variables or clauses waiting for propagation */
+struct prop_queue_t {
+  struct prop_entry_t *elems; ///< Queued entries
+  size_t size; ///< Capacity of ring buffer, always a power of two
+  size_t head; ///< Position of the next entry to propagate
+  size_t tail; ///< Position where to queue the next entry
+};
+
+// queues of changed variables and of deferred expensive clauses, and
+// of variables whose lower or upper bound changed while walking the
+// graph of difference constraints
+#define PROP_QUEUE_VARS 0
+#define PROP_QUEUE_CLAUSES 1
+#define PROP_QUEUE_DIFF_LB 2
+#define PROP_QUEUE_DIFF_UB 3
+#define PROP_QUEUES 4
+static THREAD_LOCAL struct prop_queue_t _prop_queue[PROP_QUEUES];
+
+// counter to tag variable changes and clause propagations
+static THREAD_LOCAL prop_tag_t _prop_tag = 0;
+// tag of clauses that are deferred
+#define PROP_TAG_DEFERRED UINT64_MAX
+
+// whether to defer expensive clauses in the current propagation run
+static THREAD_LOCAL bool _prop_defer;
+
+// constraint that entailed clauses are patched to, it is never changed
+// and can therefore be shared between workers
+static struct constr_t _prop_entailed = {
+  .type = &CONSTR_TERM, .constr = { .term = { .val = { .lo = 1, .hi = 1 }, .env = NULL } } };
+
+// initial capacity of propagation queues
+#define PROP_QUEUE_SIZE_INIT 64
+
+// release memory of the propagation queues
+void propagate_free(void) {
+  for (size_t i = 0; i < PROP_QUEUES; i++) {
+    free(_prop_queue[i].elems);
+    _prop_queue[i] = (struct prop_queue_t){ .elems = NULL, .size = 0, .head = 0, .tail = 0 };
+  }
+}
+
+// double the capacity of a propagation queue
+static void propagate_queue_grow(struct prop_queue_t *queue) {
+  size_t size = queue->size > 0 ? 2 * queue->size : PROP_QUEUE_SIZE_INIT;
+  struct prop_entry_t *elems = (struct prop_entry_t *)malloc(size * sizeof(struct prop_entry_t));
+  // die if allocation failed
+  if (elems == NULL) {
+    print_fatal("%s", strerror(errno));
+  }
+
+  // copy queued entries to the start of the new buffer
+  size_t length = queue->tail - queue->head;
+  for (size_t i = 0; i < length; i++) {
+    elems[i] = queue->elems[(queue->head + i) & (queue->size - 1)];
+  }
+  free(queue->elems);
+
+  queue->elems = elems;
+  queue->size = size;
+  queue->head = 0;
+  queue->tail = length;
+}
+
+// append an entry to a propagation queue
+static void propagate_enqueue(struct prop_queue_t *queue, struct wand_expr_t *clause, struct env_t *var) {
+  if (queue->tail - queue->head == queue->size) {
+    propagate_queue_grow(queue);
+  }
+  queue->elems[queue->tail++ & (queue->size - 1)] = (struct prop_entry_t){ .clause = clause, .var = var };
+}
+
+// take the first entry from a propagation queue, return false if it is empty
+static bool propagate_dequeue(struct prop_queue_t *queue, struct prop_entry_t *entry) {
+  if (queue->head == queue->tail) {
+    return false;
+  }
+  *entry = queue->elems[queue->head++ & (queue->size - 1)];
+  return true;
+}
+
+// start a new propagation run, dropping entries of an aborted run
+static void propagate_start(void) {
+  struct prop_entry_t entry;
+  while (propagate_dequeue(&_prop_queue[PROP_QUEUE_VARS], &entry)) {
+    entry.var->prop_tag = 0;
+    entry.var->prop_events = 0;
+  }
+  while (propagate_dequeue(&_prop_queue[PROP_QUEUE_CLAUSES], &entry)) {
+    entry.clause->prop_tag = 0;
+  }
+  _prop_defer = strategy_prop_order() == PROP_ORDER_CHEAP_FIRST;
+}
+
+// queue a changed variable, unless it is queued already
+static void propagate_changed(struct env_t *var, prop_event_t events) {
+  if (var->prop_tag == 0) {
+    propagate_enqueue(&_prop_queue[PROP_QUEUE_VARS], NULL, var);
+    var->prop_events = events;
+  } else {
+    var->prop_events |= events;
+  }
+  // clauses propagated before this change must be propagated again
+  var->prop_tag = ++_prop_tag;
+}
+
+// return whether propagating to a constraint is cheap
+static bool propagate_cheap(const struct constr_t *constr) {
+  if (IS_TYPE(CONFL, constr)) {
+    return true;
+  }
+  if (IS_TYPE(NOT, constr)) {
+    return propagate_cheap(constr->constr.expr.l);
+  }
+  // expressions directly on terms only need to look at their operands
+  return !IS_TYPE(TERM, constr) && !IS_TYPE(WAND, constr) &&
+    !IS_TYPE(LIN, constr) && !IS_TYPE(DIFF, constr) && !IS_TYPE(ALLDIFF, constr) &&
+    !IS_TYPE(DISJ, constr) && !IS_TYPE(CUMUL, constr) &&
+    IS_TYPE(TERM, constr->constr.expr.l) &&
+    (constr->constr.expr.r == NULL || IS_TYPE(TERM, constr->constr.expr.r));
+}
+
+// return whether a clause contains the objective value, whose bound
+// is tightened off the binding trail
+static bool propagate_objective(const struct wand_expr_t *clause) {
+  const struct env_t *obj = objective_val()->constr.term.env;
+  if (obj != NULL) {
+    // only few clauses contain the objective value
+    for (size_t i = 0, l = obj->clauses.length; i < l; i++) {
+      if (obj->clauses.elems[i] == clause) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+// return whether a clause holds for all values its variables may still take
+static bool propagate_entailed(const struct wand_expr_t *clause) {
+  const struct constr_t *c = clause->constr;
+  return IS_TYPE(TERM, c) && is_true(c->constr.term.val);
+}
+
+// update priority and variable ordering after failing propagation
+static void propagate_failed(struct env_t *var) {
+  if (var != NULL) {
     var->prio++;
     strategy_var_order_update(var);
+  }
+}
+
+// propagate value "true" to a single clause
+static prop_result_t propagate_clause(struct wand_expr_t *clause, struct env_t *var) {
+  // remember when the clause saw the values of its variables
+  clause->prop_tag = ++_prop_tag;
+
+  // use the compiled clause unless the clause is entailed already
+  struct constr_t *c = clause->constr;
+  const struct code_t *code = clause->code != NULL && !IS_TYPE(TERM, c) ? clause->code : NULL;
+  prop_result_t p = code != NULL ? code_propagate(code, clause) : c->type->prop(c, VALUE(1), clause);
+  if (p == PROP_ERROR) {
+    propagate_failed(var);
     return PROP_ERROR;
   }
-  return p + 1;
+
+  // mark clause that became entailed without normalizing it, such that
+  // it is dropped from the clause lists of its variables, clauses with
+  // the objective value must see when its bound is tightened
+  if (p != PROP_NONE && !IS_TYPE(TERM, c) && is_true(code != NULL ? code_eval(code) : c->type->eval(c)) &&
+      !propagate_objective(clause)) {
+    patch(clause, &_prop_entailed);
+    return p;
+  }
+
+  // normalize clause that caused a (successful) propagation, compiled
+  // clauses are cheap enough to evaluate as they are
+  if (p != PROP_NONE && code == NULL && !propagate_objective(clause)) {
+    struct constr_t *n = c->type->norm(c);
+    // patch clause if normalizing changed anything
+    if (n != c) {
+      patch(clause, n);
+    }
+  }
+
+  return p;
+}
+
+// propagate to the live clauses in a list that subscribe to the events
+// and did not see a change yet
+static prop_result_t propagate_list(struct clause_list_t *clauses, prop_tag_t tag, prop_event_t events,
+                                    struct env_t *var) {
+  prop_result_t r = PROP_NONE;
+
+  for (size_t i = clauses->dead, l = clauses->length; i < l; i++) {
+    // stop right away if another worker found a better solution
+    if (objective_poll()) {
+      return PROP_ERROR;
+    }
+
+    // skip if the clause cannot propagate anything new from the change
+    if ((clauses->events[i] & events) == 0) {
+      continue;
+    }
+
+    struct wand_expr_t *clause = clauses->elems[i];
+    // skip if the clause was propagated after the change or is deferred
+    if (clause->prop_tag > tag) {
+      continue;
+    }
+
+    // drop entailed clauses until backtracking, the dropped clause is
+    // replaced by one that was visited already
+    if (propagate_entailed(clause)) {
+      clause_list_drop(clauses, i);
+      continue;
+    }
+
+    // defer expensive clauses
+    if (_prop_defer && !propagate_cheap(clause->constr)) {
+      clause->prop_tag = PROP_TAG_DEFERRED;
+      propagate_enqueue(&_prop_queue[PROP_QUEUE_CLAUSES], clause, var);
+      continue;
+    }
+
+    prop_result_t p = propagate_clause(clause, var);
+    CHECK(p);
+    r += p;
+
+    if (propagate_entailed(clause)) {
+      clause_list_drop(clauses, i);
+    }
+  }
+
+  return r;
+}
+
+// forward declaration
+static prop_result_t propagate_watches(struct env_t *var, prop_event_t events);
+
+// propagate changes until reaching a fixpoint
+static prop_result_t propagate_fixpoint(void) {
+  prop_result_t r = PROP_NONE;
+
+  struct prop_entry_t entry;
+  for (;;) {
+    prop_result_t p;
+    if (propagate_dequeue(&_prop_queue[PROP_QUEUE_VARS], &entry)) {
+      // propagate to clauses that did not see the latest change
+      struct env_t *var = entry.var;
+      prop_tag_t tag = var->prop_tag;
+      prop_event_t events = var->prop_events;
+      var->prop_tag = 0;
+      var->prop_events = 0;
+      p = propagate_watches(var, events);
+      CHECK(p);
+      r += p;
+      p = propagate_list(&var->clauses, tag, events, var);
+    } else if (propagate_dequeue(&_prop_queue[PROP_QUEUE_CLAUSES], &entry)) {
+      // propagate deferred clauses only once nothing else is left
+      p = propagate_clause(entry.clause, entry.var);
+    } else {
+      break;
+    }
+    CHECK(p);
+    r += p;
+  }
+
+  return r;
 }
 
 // propagate value to terminal
@@ -73,13 +337,15 @@ prop_result_t propagate_term(struct constr_t *constr, const struct val_t val, co
   if (lo != get_lo(term) || hi != get_hi(term)) {
     struct val_t v = INTERVAL(lo, hi);
     if (var != NULL) {
-      // recurse if variable is defined
-      bind(var, v, clause);
+      // queue variable for propagating to its clauses if defined
+      prop_event_t events = bind(var, v, clause);
       stat_inc_props();
-      return propagate_term_recurse(var);
+      propagate_changed(var, events);
+      return 1;
     }
     // just assign value if there is no variable
     constr->constr.term.val = v;
+    eval_invalidate();
     return 1;
   }
 
@@ -247,26 +513,17 @@ prop_result_t propagate_add(struct constr_t *constr, const struct val_t val, con
 
 // propagate to left side or right side of multiplication expression
 static prop_result_t propagate_mul_lr(struct constr_t *p, struct constr_t *c, struct val_t val, const struct wand_expr_t *clause) {
-
-  // only propagate if value is not saturated
-  if (get_lo(val) != DOMAIN_MIN && get_hi(val) != DOMAIN_MIN) {
-    struct val_t cval = c->type->eval(c);
-    // only propagate if the "other" side has a value
-    if (is_value(cval)) {
-      if (((get_lo(val) > 0 || get_hi(val) < 0) && get_lo(cval) == 0) ||
-          (is_value(val) && get_lo(cval) != 0 && (get_lo(val) % get_lo(cval)) != 0)) {
-        // return an error if the propagation is not possible
-        return PROP_ERROR;
-      }
-      if (get_lo(cval) != 0) {
-        // propagate value
-        domain_t lo = get_lo(val) / get_lo(cval);
-        domain_t hi = get_hi(val) / get_lo(cval);
-        return p->type->prop(p, INTERVAL(min(lo, hi), max(lo, hi)), clause);
-      }
-    }
+  // divide value by the value of the "other" side
+  struct val_t q = eval_quot_vals(val, c->type->eval(c));
+  if (get_lo(q) > get_hi(q)) {
+    // return an error if no value yields the product
+    return PROP_ERROR;
   }
-  return PROP_NONE;
+  // only propagate if restricting anything
+  if (get_lo(q) == DOMAIN_MIN && get_hi(q) == DOMAIN_MAX) {
+    return PROP_NONE;
+  }
+  return p->type->prop(p, q, clause);
 }
 
 // propagate value to multiplication expression
@@ -285,6 +542,294 @@ prop_result_t propagate_mul(struct constr_t *constr, const struct val_t val, con
   return p + q;
 }
 
+// exclude zero from the bounds of a divisor that must not be zero
+static prop_result_t propagate_divisor(struct constr_t *c, const struct wand_expr_t *clause) {
+  struct val_t cval = c->type->eval(c);
+  if (get_lo(cval) == 0) {
+    return c->type->prop(c, INTERVAL(1, DOMAIN_MAX), clause);
+  }
+  if (get_hi(cval) == 0) {
+    return c->type->prop(c, INTERVAL(DOMAIN_MIN, -1), clause);
+  }
+  return PROP_NONE;
+}
+
+// return the smallest magnitude of the values in an interval
+static domain_t propagate_magnitude_min(const struct val_t val) {
+  return get_lo(val) > 0 ? get_lo(val) : (get_hi(val) < 0 ? neg(get_hi(val)) : 0);
+}
+
+// return the largest magnitude of the values in an interval
+static domain_t propagate_magnitude_max(const struct val_t val) {
+  return max(neg(get_lo(val)), get_hi(val));
+}
+
+// restrict the magnitude of a divisor to be above a bound, if the sign
+// of the divisor is known
+static prop_result_t propagate_divisor_above(struct constr_t *c, domain_t bound, const struct wand_expr_t *clause) {
+  struct val_t cval = c->type->eval(c);
+  if (bound > 0 && bound != DOMAIN_MAX) {
+    if (get_lo(cval) > 0) {
+      return c->type->prop(c, INTERVAL(bound + 1, DOMAIN_MAX), clause);
+    }
+    if (get_hi(cval) < 0) {
+      return c->type->prop(c, INTERVAL(DOMAIN_MIN, neg(bound + 1)), clause);
+    }
+  }
+  return PROP_NONE;
+}
+
+// propagate value to division expression
+prop_result_t propagate_div(struct constr_t *constr, const struct val_t val, const struct wand_expr_t *clause) {
+  struct constr_t *l = constr->constr.expr.l;
+  struct constr_t *r = constr->constr.expr.r;
+
+  // dividing by zero yields zero, other quotients need a divisor that
+  // is not zero
+  bool zero = get_lo(val) <= 0 && get_hi(val) >= 0;
+  prop_result_t p = zero ? PROP_NONE : propagate_divisor(r, clause);
+  CHECK(p);
+
+  // the dividend is the product of quotient and divisor plus a
+  // remainder that has the sign of the dividend and a smaller
+  // magnitude than the divisor, unless dividing by zero
+  struct val_t rval = r->type->eval(r);
+  prop_result_t q = PROP_NONE;
+  if (!zero || get_lo(rval) > 0 || get_hi(rval) < 0) {
+    struct val_t prod = eval_mul_vals(val, rval);
+    domain_t rem = add(propagate_magnitude_max(rval), -1);
+    domain_t lo = get_lo(prod) > 0 ? get_lo(prod) : add(get_lo(prod), neg(rem));
+    domain_t hi = get_hi(prod) < 0 ? get_hi(prod) : add(get_hi(prod), rem);
+    q = l->type->prop(l, INTERVAL(lo, hi), clause);
+  }
+  CHECK(q);
+
+  struct val_t lval = l->type->eval(l);
+  prop_result_t s = PROP_NONE;
+  if (get_lo(val) > 0 || get_hi(val) < 0) {
+    // the divisor cannot exceed the dividend divided by the smallest quotient
+    if (get_lo(lval) != DOMAIN_MIN && get_hi(lval) != DOMAIN_MAX) {
+      domain_t bound = propagate_magnitude_max(lval) / propagate_magnitude_min(val);
+      s = r->type->prop(r, INTERVAL(neg(bound), bound), clause);
+    }
+  } else if (get_lo(val) == 0 && get_hi(val) == 0) {
+    // a quotient of zero needs a divisor above the dividend
+    s = propagate_divisor_above(r, propagate_magnitude_min(lval), clause);
+  }
+  CHECK(s);
+
+  return p + q + s;
+}
+
+// propagate value to remainder expression
+prop_result_t propagate_mod(struct constr_t *constr, const struct val_t val, const struct wand_expr_t *clause) {
+  struct constr_t *l = constr->constr.expr.l;
+  struct constr_t *r = constr->constr.expr.r;
+
+  // the remainder has the sign of the dividend and does not exceed it
+  // in magnitude, which also holds for dividing by zero
+  prop_result_t q = PROP_NONE;
+  if (get_lo(val) > 0) {
+    q = l->type->prop(l, INTERVAL(get_lo(val), DOMAIN_MAX), clause);
+  } else if (get_hi(val) < 0) {
+    q = l->type->prop(l, INTERVAL(DOMAIN_MIN, get_hi(val)), clause);
+  }
+  CHECK(q);
+
+  // the dividend is its own remainder if its magnitude is below the
+  // one of any divisor
+  struct val_t lval = l->type->eval(l);
+  domain_t k = propagate_magnitude_min(r->type->eval(r));
+  prop_result_t s = PROP_NONE;
+  if (get_lo(lval) > neg(k) && get_hi(lval) < k) {
+    s = l->type->prop(l, val, clause);
+  }
+  CHECK(s);
+
+  // the divisor exceeds the remainder in magnitude
+  prop_result_t t = propagate_divisor_above(r, propagate_magnitude_min(val), clause);
+  CHECK(t);
+
+  return q + s + t;
+}
+
+// propagate value to absolute value expression
+prop_result_t propagate_abs(struct constr_t *constr, const struct val_t val, const struct wand_expr_t *clause) {
+  struct constr_t *l = constr->constr.expr.l;
+
+  // absolute values are never negative
+  if (get_hi(val) < 0) {
+    return PROP_ERROR;
+  }
+
+  // the argument lies within the negated and the plain upper bound
+  prop_result_t p = l->type->prop(l, INTERVAL(neg(get_hi(val)), get_hi(val)), clause);
+  CHECK(p);
+
+  // the argument lies outside the negated and the plain lower bound,
+  // which fixes its sign if it cannot take one of them
+  prop_result_t q = PROP_NONE;
+  if (get_lo(val) > 0) {
+    struct val_t lval = l->type->eval(l);
+    if (get_lo(lval) > neg(get_lo(val))) {
+      q = l->type->prop(l, INTERVAL(get_lo(val), DOMAIN_MAX), clause);
+    } else if (get_hi(lval) < get_lo(val)) {
+      q = l->type->prop(l, INTERVAL(DOMAIN_MIN, neg(get_lo(val))), clause);
+    }
+  }
+  CHECK(q);
+
+  return p + q;
+}
+
+// propagate value to minimum expression
+prop_result_t propagate_min(struct constr_t *constr, const struct val_t val, const struct wand_expr_t *clause) {
+  struct constr_t *l = constr->constr.expr.l;
+  struct constr_t *r = constr->constr.expr.r;
+
+  // both sides are at least the minimum
+  prop_result_t p = l->type->prop(l, INTERVAL(get_lo(val), DOMAIN_MAX), clause);
+  CHECK(p);
+  prop_result_t q = r->type->prop(r, INTERVAL(get_lo(val), DOMAIN_MAX), clause);
+  CHECK(q);
+
+  // one side must be the minimum if the other side is too large
+  prop_result_t s = PROP_NONE;
+  if (get_lo(r->type->eval(r)) > get_hi(val)) {
+    s = l->type->prop(l, INTERVAL(DOMAIN_MIN, get_hi(val)), clause);
+  } else if (get_lo(l->type->eval(l)) > get_hi(val)) {
+    s = r->type->prop(r, INTERVAL(DOMAIN_MIN, get_hi(val)), clause);
+  }
+  CHECK(s);
+
+  return p + q + s;
+}
+
+// propagate value to maximum expression
+prop_result_t propagate_max(struct constr_t *constr, const struct val_t val, const struct wand_expr_t *clause) {
+  struct constr_t *l = constr->constr.expr.l;
+  struct constr_t *r = constr->constr.expr.r;
+
+  // both sides are at most the maximum
+  prop_result_t p = l->type->prop(l, INTERVAL(DOMAIN_MIN, get_hi(val)), clause);
+  CHECK(p);
+  prop_result_t q = r->type->prop(r, INTERVAL(DOMAIN_MIN, get_hi(val)), clause);
+  CHECK(q);
+
+  // one side must be the maximum if the other side is too small
+  prop_result_t s = PROP_NONE;
+  if (get_hi(r->type->eval(r)) < get_lo(val)) {
+    s = l->type->prop(l, INTERVAL(get_lo(val), DOMAIN_MAX), clause);
+  } else if (get_hi(l->type->eval(l)) < get_lo(val)) {
+    s = r->type->prop(r, INTERVAL(get_lo(val), DOMAIN_MAX), clause);
+  }
+  CHECK(s);
+
+  return p + q + s;
+}
+
+/** Bounds of the sum of linear terms, split into the finite part and
+    the number of terms that make the bound unlimited */
+struct lin_activity_t {
+  ddomain_t lo; ///< Finite part of lower bound
+  ddomain_t hi; ///< Finite part of upper bound
+  ddomain_t lo_inf; ///< Number of terms without lower bound
+  ddomain_t hi_inf; ///< Number of terms without upper bound
+};
+
+// add (sign 1) or remove (sign -1) the contribution of a term with
+// the given variable value to the activity
+static void propagate_lin_account(struct lin_activity_t *act, const struct lin_term_t *t, struct val_t val, ddomain_t sign) {
+  struct val_t p = eval_mul_vals(VALUE(t->coef), val);
+  if (get_lo(p) == DOMAIN_MIN) {
+    act->lo_inf += sign;
+  } else {
+    act->lo += sign * get_lo(p);
+  }
+  if (get_hi(p) == DOMAIN_MAX) {
+    act->hi_inf += sign;
+  } else {
+    act->hi += sign * get_hi(p);
+  }
+}
+
+// saturate value to domain
+static domain_t propagate_clamp(ddomain_t a) {
+  return a < DOMAIN_MIN ? DOMAIN_MIN : (a > DOMAIN_MAX ? DOMAIN_MAX : (domain_t)a);
+}
+
+// propagate value to a term of a linear expression, given the
+// activity of the other terms
+static prop_result_t propagate_lin_term(const struct lin_term_t *t, const struct lin_activity_t *rest,
+                                        struct val_t val, const struct wand_expr_t *clause) {
+  domain_t lo = DOMAIN_MIN;
+  domain_t hi = DOMAIN_MAX;
+
+  // the product can be at most the upper bound minus the least the other terms add
+  if (get_hi(val) != DOMAIN_MAX && rest->lo_inf == 0) {
+    ddomain_t u = (ddomain_t)get_hi(val) - rest->lo;
+    if (t->coef > 0) {
+      hi = propagate_clamp(div_floor(u, t->coef));
+    } else {
+      lo = propagate_clamp(div_ceil(u, t->coef));
+    }
+  }
+
+  // the product must be at least the lower bound minus the most the other terms add
+  if (get_lo(val) != DOMAIN_MIN && rest->hi_inf == 0) {
+    ddomain_t l = (ddomain_t)get_lo(val) - rest->hi;
+    if (t->coef > 0) {
+      lo = propagate_clamp(div_ceil(l, t->coef));
+    } else {
+      hi = propagate_clamp(div_floor(l, t->coef));
+    }
+  }
+
+  if (lo == DOMAIN_MIN && hi == DOMAIN_MAX) {
+    return PROP_NONE;
+  }
+  return t->var->type->prop(t->var, INTERVAL(lo, hi), clause);
+}
+
+// propagate value to linear expression
+prop_result_t propagate_lin(struct constr_t *constr, const struct val_t val, const struct wand_expr_t *clause) {
+  // nothing to propagate if the sum is unconstrained
+  if (get_lo(val) == DOMAIN_MIN && get_hi(val) == DOMAIN_MAX) {
+    return PROP_NONE;
+  }
+
+  size_t length = constr->constr.lin.length;
+  const struct lin_term_t *terms = constr->constr.lin.terms;
+
+  // compute the activity once
+  struct lin_activity_t act = { .lo = 0, .hi = 0, .lo_inf = 0, .hi_inf = 0 };
+  for (size_t i = 0; i < length; i++) {
+    propagate_lin_account(&act, &terms[i], terms[i].var->constr.term.val, 1);
+  }
+
+  prop_result_t r = PROP_NONE;
+  for (size_t i = 0; i < length; i++) {
+    const struct lin_term_t *t = &terms[i];
+    const struct val_t prev = t->var->constr.term.val;
+
+    // propagate to the term what the other terms leave
+    struct lin_activity_t rest = act;
+    propagate_lin_account(&rest, t, prev, -1);
+    prop_result_t p = propagate_lin_term(t, &rest, val, clause);
+    CHECK(p);
+
+    // update the activity with the restricted variable, later terms
+    // see the tighter bounds right away
+    if (p != PROP_NONE) {
+      propagate_lin_account(&act, t, prev, -1);
+      propagate_lin_account(&act, t, t->var->constr.term.val, 1);
+      r += p;
+    }
+  }
+
+  return r;
+}
+
 // propagate value to logical not expression
 prop_result_t propagate_not(struct constr_t *constr, const struct val_t val, const struct wand_expr_t *clause) {
   struct constr_t *l = constr->constr.expr.l;
@@ -375,6 +920,870 @@ prop_result_t propagate_or(struct constr_t *constr, const struct val_t val, cons
   return PROP_NONE;
 }
 
+// propagate the lower bound of the minuend of l - r <= c to the subtrahend
+static prop_result_t propagate_diff_lb(const struct diff_t *diff, const struct wand_expr_t *clause) {
+  struct constr_t *l = diff->l;
+  struct constr_t *r = diff->r;
+  domain_t lo = add(get_lo(l->type->eval(l)), neg(diff->c));
+  return r->type->prop(r, INTERVAL(lo, DOMAIN_MAX), clause);
+}
+
+// propagate the upper bound of the subtrahend of l - r <= c to the minuend
+static prop_result_t propagate_diff_ub(const struct diff_t *diff, const struct wand_expr_t *clause) {
+  struct constr_t *l = diff->l;
+  struct constr_t *r = diff->r;
+  domain_t hi = add(get_hi(r->type->eval(r)), diff->c);
+  return l->type->prop(l, INTERVAL(DOMAIN_MIN, hi), clause);
+}
+
+// return the difference expression of a clause if the clause is a
+// difference between variables, NULL otherwise
+static const struct diff_t *propagate_diff_clause(const struct wand_expr_t *clause) {
+  const struct constr_t *c = clause->constr;
+  if (!IS_TYPE(DIFF, c)) {
+    return NULL;
+  }
+  const struct diff_t *diff = &c->constr.diff;
+  if (!IS_TYPE(TERM, diff->l) || diff->l->constr.term.env == NULL ||
+      !IS_TYPE(TERM, diff->r) || diff->r->constr.term.env == NULL) {
+    return NULL;
+  }
+  return diff;
+}
+
+// relax the difference clauses of the variables in a walk queue until
+// the queue runs empty, lower bounds flow from minuends to subtrahends
+// and upper bounds the other way round; changing the bound of the
+// origin again proves a cycle of negative weight
+static prop_result_t propagate_diff_walk(size_t index, struct env_t *origin) {
+  struct prop_queue_t *queue = &_prop_queue[index];
+  bool lower = index == PROP_QUEUE_DIFF_LB;
+  prop_result_t r = PROP_NONE;
+
+  struct prop_entry_t entry;
+  while (propagate_dequeue(queue, &entry)) {
+    struct clause_list_t *clauses = &entry.var->clauses;
+    for (size_t i = clauses->dead, l = clauses->length; i < l; i++) {
+      // skip clauses that do not read the changed bound
+      if ((clauses->events[i] & (lower ? PROP_EVENT_LB : PROP_EVENT_UB)) == 0) {
+        continue;
+      }
+      const struct wand_expr_t *clause = clauses->elems[i];
+      const struct diff_t *diff = propagate_diff_clause(clause);
+      if (diff == NULL) {
+        continue;
+      }
+      struct constr_t *src = lower ? diff->l : diff->r;
+      struct constr_t *dst = lower ? diff->r : diff->l;
+      if (src->constr.term.env != entry.var) {
+        continue;
+      }
+
+      prop_result_t p = lower ? propagate_diff_lb(diff, clause) : propagate_diff_ub(diff, clause);
+      CHECK(p);
+      if (p != PROP_NONE) {
+        struct env_t *var = dst->constr.term.env;
+        if (var == origin) {
+          propagate_failed(var);
+          return PROP_ERROR;
+        }
+        propagate_enqueue(queue, NULL, var);
+        r += p;
+      }
+    }
+  }
+
+  return r;
+}
+
+// propagate value to difference expression
+prop_result_t propagate_diff(struct constr_t *constr, const struct val_t val, const struct wand_expr_t *clause) {
+  const struct diff_t *diff = &constr->constr.diff;
+
+  if (is_true(val)) {
+    prop_result_t p = propagate_diff_lb(diff, clause);
+    CHECK(p);
+    prop_result_t q = propagate_diff_ub(diff, clause);
+    CHECK(q);
+
+    // walk the graph of difference clauses right away if this is a
+    // clause of its own, such that chains of precedences reach their
+    // fixpoint in one pass
+    if ((p != PROP_NONE || q != PROP_NONE) && clause != NULL && clause->constr == constr &&
+        propagate_diff_clause(clause) != NULL) {
+      struct env_t *lvar = diff->l->constr.term.env;
+      struct env_t *rvar = diff->r->constr.term.env;
+      // drop entries of an aborted walk
+      _prop_queue[PROP_QUEUE_DIFF_LB].head = _prop_queue[PROP_QUEUE_DIFF_LB].tail;
+      _prop_queue[PROP_QUEUE_DIFF_UB].head = _prop_queue[PROP_QUEUE_DIFF_UB].tail;
+
+      if (p != PROP_NONE) {
+        propagate_enqueue(&_prop_queue[PROP_QUEUE_DIFF_LB], NULL, rvar);
+        prop_result_t w = propagate_diff_walk(PROP_QUEUE_DIFF_LB, lvar);
+        CHECK(w);
+        p += w;
+      }
+      if (q != PROP_NONE) {
+        propagate_enqueue(&_prop_queue[PROP_QUEUE_DIFF_UB], NULL, lvar);
+        prop_result_t w = propagate_diff_walk(PROP_QUEUE_DIFF_UB, rvar);
+        CHECK(w);
+        q += w;
+      }
+    }
+
+    return p + q;
+  }
+
+  if (is_false(val)) {
+    // l - r > c is the same as r - l <= -c - 1
+    const struct diff_t flip = { .l = diff->r, .r = diff->l, .c = add(neg(diff->c), -1) };
+    prop_result_t p = propagate_diff_lb(&flip, clause);
+    CHECK(p);
+    prop_result_t q = propagate_diff_ub(&flip, clause);
+    CHECK(q);
+    return p + q;
+  }
+
+  return PROP_NONE;
+}
+
+/** Sub-expression of an all-different expression while computing Hall intervals */
+struct alldiff_elem_t {
+  struct constr_t *constr; ///< Sub-expression
+  ddomain_t min; ///< Lower bound
+  ddomain_t max; ///< Upper bound
+  size_t minrank; ///< Position of lower bound among all bounds
+  size_t maxrank; ///< Position of upper bound plus one among all bounds
+  ddomain_t newmin; ///< Lower bound after propagation
+  ddomain_t newmax; ///< Upper bound after propagation
+};
+
+/** Buffers for computing Hall intervals of an all-different expression */
+struct alldiff_hall_t {
+  struct alldiff_elem_t *elems; ///< Sub-expressions
+  struct alldiff_elem_t **minsorted; ///< Sub-expressions sorted by lower bound
+  struct alldiff_elem_t **maxsorted; ///< Sub-expressions sorted by upper bound
+  ddomain_t *bounds; ///< Distinct bounds in increasing order
+  size_t *t; ///< Links to the next interval with capacity
+  ddomain_t *d; ///< Remaining capacity between adjacent bounds
+  size_t *h; ///< Links to the end of Hall intervals
+  size_t nb; ///< Number of distinct bounds
+};
+
+// compare sub-expressions of all-different expression by lower bound
+static int propagate_alldiff_cmp_min(const void *a, const void *b) {
+  const struct alldiff_elem_t *x = *(const struct alldiff_elem_t * const *)a;
+  const struct alldiff_elem_t *y = *(const struct alldiff_elem_t * const *)b;
+  return (x->min > y->min) - (x->min < y->min);
+}
+
+// compare sub-expressions of all-different expression by upper bound
+static int propagate_alldiff_cmp_max(const void *a, const void *b) {
+  const struct alldiff_elem_t *x = *(const struct alldiff_elem_t * const *)a;
+  const struct alldiff_elem_t *y = *(const struct alldiff_elem_t * const *)b;
+  return (x->max > y->max) - (x->max < y->max);
+}
+
+// follow links while they point downwards
+static size_t propagate_alldiff_pathmin(const size_t *t, size_t i) {
+  while (t[i] < i) {
+    i = t[i];
+  }
+  return i;
+}
+
+// follow links while they point upwards
+static size_t propagate_alldiff_pathmax(const size_t *t, size_t i) {
+  while (t[i] > i) {
+    i = t[i];
+  }
+  return i;
+}
+
+// redirect links on the path from start to end
+static void propagate_alldiff_pathset(size_t *t, size_t start, size_t end, size_t to) {
+  size_t l = start;
+  while (l != end) {
+    size_t k = l;
+    l = t[k];
+    t[k] = to;
+  }
+}
+
+// sort sub-expressions and rank their bounds
+static void propagate_alldiff_sort(struct alldiff_hall_t *a, size_t n) {
+  qsort(a->minsorted, n, sizeof(struct alldiff_elem_t *), propagate_alldiff_cmp_min);
+  qsort(a->maxsorted, n, sizeof(struct alldiff_elem_t *), propagate_alldiff_cmp_max);
+
+  // merge lower bounds and upper bounds plus one, with sentinels at both ends
+  ddomain_t last = a->minsorted[0]->min - 2;
+  size_t nb = 0;
+  a->bounds[0] = last;
+  for (size_t i = 0, j = 0; ; ) {
+    if (i < n && a->minsorted[i]->min <= a->maxsorted[j]->max + 1) {
+      if (a->minsorted[i]->min != last) {
+        a->bounds[++nb] = last = a->minsorted[i]->min;
+      }
+      a->minsorted[i++]->minrank = nb;
+    } else {
+      if (a->maxsorted[j]->max + 1 != last) {
+        a->bounds[++nb] = last = a->maxsorted[j]->max + 1;
+      }
+      a->maxsorted[j]->maxrank = nb;
+      if (++j == n) {
+        break;
+      }
+    }
+  }
+  a->bounds[nb+1] = a->bounds[nb] + 2;
+  a->nb = nb;
+}
+
+// raise lower bounds above Hall intervals, return false if more
+// sub-expressions than values are in some interval
+static bool propagate_alldiff_lower(struct alldiff_hall_t *a, size_t n) {
+  size_t *t = a->t, *h = a->h;
+  ddomain_t *d = a->d, *bounds = a->bounds;
+
+  for (size_t i = 1; i <= a->nb+1; i++) {
+    t[i] = h[i] = i-1;
+    d[i] = bounds[i] - bounds[i-1];
+  }
+  // visit intervals in increasing order of upper bounds
+  for (size_t i = 0; i < n; i++) {
+    struct alldiff_elem_t *e = a->maxsorted[i];
+    size_t x = e->minrank, y = e->maxrank;
+    size_t z = propagate_alldiff_pathmax(t, x+1);
+    size_t j = t[z];
+    if (--d[z] == 0) {
+      t[z] = z+1;
+      z = propagate_alldiff_pathmax(t, t[z]);
+      t[z] = j;
+    }
+    propagate_alldiff_pathset(t, x+1, z, z);
+    if (d[z] < bounds[z] - bounds[y]) {
+      return false;
+    }
+    if (h[x] > x) {
+      size_t w = propagate_alldiff_pathmax(h, h[x]);
+      e->newmin = bounds[w];
+      propagate_alldiff_pathset(h, x, w, w);
+    }
+    if (d[z] == bounds[z] - bounds[y]) {
+      propagate_alldiff_pathset(h, h[y], j-1, y);
+      h[y] = j-1;
+    }
+  }
+  return true;
+}
+
+// lower upper bounds below Hall intervals, return false if more
+// sub-expressions than values are in some interval
+static bool propagate_alldiff_upper(struct alldiff_hall_t *a, size_t n) {
+  size_t *t = a->t, *h = a->h;
+  ddomain_t *d = a->d, *bounds = a->bounds;
+
+  for (size_t i = 0; i <= a->nb; i++) {
+    t[i] = h[i] = i+1;
+    d[i] = bounds[i+1] - bounds[i];
+  }
+  // visit intervals in decreasing order of lower bounds
+  for (size_t i = n; i-- > 0; ) {
+    struct alldiff_elem_t *e = a->minsorted[i];
+    size_t x = e->maxrank, y = e->minrank;
+    size_t z = propagate_alldiff_pathmin(t, x-1);
+    size_t j = t[z];
+    if (--d[z] == 0) {
+      t[z] = z-1;
+      z = propagate_alldiff_pathmin(t, t[z]);
+      t[z] = j;
+    }
+    propagate_alldiff_pathset(t, x-1, z, z);
+    if (d[z] < bounds[y] - bounds[z]) {
+      return false;
+    }
+    if (h[x] < x) {
+      size_t w = propagate_alldiff_pathmin(h, h[x]);
+      e->newmax = bounds[w] - 1;
+      propagate_alldiff_pathset(h, x, w, w);
+    }
+    if (d[z] == bounds[y] - bounds[z]) {
+      propagate_alldiff_pathset(h, h[y], j+1, y);
+      h[y] = j+1;
+    }
+  }
+  return true;
+}
+
+// make bounds of all-different sub-expressions consistent
+static prop_result_t propagate_alldiff_bounds(struct constr_t *constr, const struct wand_expr_t *clause) {
+  size_t n = constr->constr.alldiff.length;
+  if (n < 2) {
+    return PROP_NONE;
+  }
+
+  // allocate buffers for up to two bounds per sub-expression plus sentinels
+  struct alldiff_hall_t a;
+  a.elems = (struct alldiff_elem_t *)alloc(n * sizeof(struct alldiff_elem_t));
+  a.minsorted = (struct alldiff_elem_t **)alloc(n * sizeof(struct alldiff_elem_t *));
+  a.maxsorted = (struct alldiff_elem_t **)alloc(n * sizeof(struct alldiff_elem_t *));
+  a.bounds = (ddomain_t *)alloc((2*n+2) * sizeof(ddomain_t));
+  a.t = (size_t *)alloc((2*n+2) * sizeof(size_t));
+  a.d = (ddomain_t *)alloc((2*n+2) * sizeof(ddomain_t));
+  a.h = (size_t *)alloc((2*n+2) * sizeof(size_t));
+
+  for (size_t i = 0; i < n; i++) {
+    struct constr_t *c = constr->constr.alldiff.elems[i];
+    struct val_t v = c->type->eval(c);
+    a.elems[i] = (struct alldiff_elem_t){ .constr = c, .min = get_lo(v), .max = get_hi(v),
+                                          .minrank = 0, .maxrank = 0,
+                                          .newmin = get_lo(v), .newmax = get_hi(v) };
+    a.minsorted[i] = a.maxsorted[i] = &a.elems[i];
+  }
+
+  // compute new bounds from Hall intervals, as described by
+  // Lopez-Ortiz et al., "A fast and simple algorithm for bounds
+  // consistency of the alldifferent constraint", IJCAI 2003
+  propagate_alldiff_sort(&a, n);
+  prop_result_t r = PROP_ERROR;
+  if (propagate_alldiff_lower(&a, n) && propagate_alldiff_upper(&a, n)) {
+    // restrict sub-expressions whose bounds changed
+    r = PROP_NONE;
+    for (size_t i = 0; i < n; i++) {
+      struct alldiff_elem_t *e = &a.elems[i];
+      if (e->newmin != e->min || e->newmax != e->max) {
+        prop_result_t p = e->constr->type->prop(e->constr, INTERVAL((domain_t)e->newmin, (domain_t)e->newmax), clause);
+        if (p == PROP_ERROR) {
+          r = PROP_ERROR;
+          break;
+        }
+        r += p;
+      }
+    }
+  }
+
+  dealloc(a.elems);
+  return r;
+}
+
+// propagate value to all-different expression
+prop_result_t propagate_alldiff(struct constr_t *constr, const struct val_t val, const struct wand_expr_t *clause) {
+  // make sure sub-expressions can take different values
+  if (is_true(val)) {
+    return propagate_alldiff_bounds(constr, clause);
+  }
+
+  // fail if sub-expressions are known to be different
+  if (is_false(val) && is_true(constr->type->eval(constr))) {
+    return PROP_ERROR;
+  }
+
+  return PROP_NONE;
+}
+
+/** Task of a scheduling expression during propagation */
+struct sched_elem_t {
+  const struct sched_task_t *task; ///< Task
+  ddomain_t est; ///< Earliest start time
+  ddomain_t lct; ///< Latest completion time
+  ddomain_t dur; ///< Minimum duration
+  ddomain_t demand; ///< Minimum resource demand
+  ddomain_t newest; ///< Earliest start time after propagation
+  ddomain_t newlct; ///< Latest completion time after propagation
+  size_t leaf; ///< Index of task's leaf in Theta-Lambda tree
+};
+
+/** Node of a Theta-Lambda tree, for disjunctive resources energies
+    are durations and energy envelopes are earliest completion times */
+struct sched_node_t {
+  ddomain_t energy; ///< Energy of tasks in Theta
+  ddomain_t env; ///< Energy envelope of tasks in Theta
+  ddomain_t energy_bar; ///< Energy of tasks in Theta and at most one task in Lambda
+  ddomain_t env_bar; ///< Energy envelope of tasks in Theta and at most one task in Lambda
+  struct sched_elem_t *energy_resp; ///< Task in Lambda responsible for energy_bar
+  struct sched_elem_t *env_resp; ///< Task in Lambda responsible for env_bar
+};
+
+/** Buffers for propagating a scheduling expression */
+struct sched_buf_t {
+  struct sched_elem_t *tasks; ///< Tasks that use the resource
+  size_t length; ///< Number of tasks that use the resource
+  ddomain_t cap; ///< Capacity of resource
+  struct sched_elem_t **sorted; ///< Tasks in the order an algorithm visits them
+  struct sched_elem_t **queue; ///< Tasks in the order an algorithm adds them
+  struct sched_node_t *tree; ///< Theta-Lambda tree, leaves are ordered by earliest start time
+  size_t leaves; ///< Number of leaves in tree, a power of two
+  ddomain_t origin; ///< Earliest start time of all tasks, to keep energy envelopes small
+  ddomain_t *events; ///< Pairs of time and change of resource usage
+  ddomain_t *times; ///< Start times of resource profile segments
+  ddomain_t *usage; ///< Resource usage during resource profile segments
+};
+
+// energy envelope for empty sets of tasks
+#define SCHED_ENV_NONE (INT64_MIN / 4)
+// limit for energies and energy envelopes
+#define SCHED_ENERGY_MAX (INT64_MAX / 4)
+
+// maximum of two double-width values
+static ddomain_t propagate_sched_max(ddomain_t a, ddomain_t b) {
+  return a > b ? a : b;
+}
+
+// minimum of two double-width values
+static ddomain_t propagate_sched_min(ddomain_t a, ddomain_t b) {
+  return a < b ? a : b;
+}
+
+// compare tasks by earliest start time
+static int propagate_sched_cmp_est(const void *a, const void *b) {
+  const struct sched_elem_t *x = *(const struct sched_elem_t * const *)a;
+  const struct sched_elem_t *y = *(const struct sched_elem_t * const *)b;
+  return (x->est > y->est) - (x->est < y->est);
+}
+
+// compare tasks by latest completion time
+static int propagate_sched_cmp_lct(const void *a, const void *b) {
+  const struct sched_elem_t *x = *(const struct sched_elem_t * const *)a;
+  const struct sched_elem_t *y = *(const struct sched_elem_t * const *)b;
+  return (x->lct > y->lct) - (x->lct < y->lct);
+}
+
+// compare tasks by latest start time
+static int propagate_sched_cmp_lst(const void *a, const void *b) {
+  const struct sched_elem_t *x = *(const struct sched_elem_t * const *)a;
+  const struct sched_elem_t *y = *(const struct sched_elem_t * const *)b;
+  ddomain_t x_lst = x->lct - x->dur, y_lst = y->lct - y->dur;
+  return (x_lst > y_lst) - (x_lst < y_lst);
+}
+
+// sort tasks with some comparison function
+static void propagate_sched_sort(struct sched_buf_t *b, struct sched_elem_t **sorted,
+                                 int (*cmp)(const void *, const void *)) {
+  for (size_t i = 0; i < b->length; i++) {
+    sorted[i] = &b->tasks[i];
+  }
+  qsort(sorted, b->length, sizeof(struct sched_elem_t *), cmp);
+}
+
+// compute energy of a task
+static ddomain_t propagate_sched_energy(const struct sched_buf_t *b, const struct sched_elem_t *t) {
+  return t->demand * t->dur;
+}
+
+// compute energy envelope of a task
+static ddomain_t propagate_sched_env(const struct sched_buf_t *b, const struct sched_elem_t *t) {
+  return b->cap * (t->est - b->origin) + propagate_sched_energy(b, t);
+}
+
+// compute the energy the resource provides up to some point in time
+static ddomain_t propagate_sched_avail(const struct sched_buf_t *b, ddomain_t time) {
+  return b->cap * (time - b->origin);
+}
+
+// check whether energies and energy envelopes of tasks are small enough to compute them
+static bool propagate_sched_bounded(const struct sched_buf_t *b) {
+  ddomain_t est = SCHED_ENERGY_MAX, lct = -SCHED_ENERGY_MAX;
+  for (size_t i = 0; i < b->length; i++) {
+    est = propagate_sched_min(est, b->tasks[i].est);
+    lct = propagate_sched_max(lct, b->tasks[i].lct);
+  }
+  // every task's energy is at most the energy available over all tasks
+  ddomain_t limit = SCHED_ENERGY_MAX / (ddomain_t)(b->length + 1) / b->cap;
+  return lct - est < limit;
+}
+
+// recompute an inner node of the Theta-Lambda tree from its children
+static void propagate_sched_combine(struct sched_node_t *tree, size_t i) {
+  const struct sched_node_t *l = &tree[2*i];
+  const struct sched_node_t *r = &tree[2*i+1];
+  struct sched_node_t *n = &tree[i];
+
+  n->energy = l->energy + r->energy;
+  n->env = propagate_sched_max(r->env, l->env + r->energy);
+
+  if (l->energy_bar + r->energy >= l->energy + r->energy_bar) {
+    n->energy_bar = l->energy_bar + r->energy;
+    n->energy_resp = l->energy_resp;
+  } else {
+    n->energy_bar = l->energy + r->energy_bar;
+    n->energy_resp = r->energy_resp;
+  }
+
+  n->env_bar = r->env_bar;
+  n->env_resp = r->env_resp;
+  if (l->env + r->energy_bar > n->env_bar) {
+    n->env_bar = l->env + r->energy_bar;
+    n->env_resp = r->energy_resp;
+  }
+  if (l->env_bar + r->energy > n->env_bar) {
+    n->env_bar = l->env_bar + r->energy;
+    n->env_resp = l->env_resp;
+  }
+}
+
+// set leaf of a task, in Theta (energy and energy_bar), in Lambda
+// (only energy_bar), or in neither (no energy)
+static void propagate_sched_leaf(struct sched_buf_t *b, struct sched_elem_t *t, bool theta, bool lambda) {
+  ddomain_t energy = propagate_sched_energy(b, t);
+  ddomain_t env = propagate_sched_env(b, t);
+  struct sched_node_t *n = &b->tree[t->leaf];
+  n->energy = theta ? energy : 0;
+  n->env = theta ? env : SCHED_ENV_NONE;
+  n->energy_bar = theta || lambda ? energy : 0;
+  n->env_bar = theta || lambda ? env : SCHED_ENV_NONE;
+  n->energy_resp = n->env_resp = lambda ? t : NULL;
+}
+
+// update a task in the Theta-Lambda tree
+static void propagate_sched_update(struct sched_buf_t *b, struct sched_elem_t *t, bool theta, bool lambda) {
+  propagate_sched_leaf(b, t, theta, lambda);
+  for (size_t i = t->leaf / 2; i > 0; i /= 2) {
+    propagate_sched_combine(b->tree, i);
+  }
+}
+
+// set up the Theta-Lambda tree, with all tasks in Theta or with no tasks at all
+static void propagate_sched_tree(struct sched_buf_t *b, bool theta) {
+  propagate_sched_sort(b, b->sorted, propagate_sched_cmp_est);
+  b->origin = b->sorted[0]->est;
+
+  for (size_t i = 0; i < 2 * b->leaves; i++) {
+    b->tree[i] = (struct sched_node_t){ .energy = 0, .env = SCHED_ENV_NONE, .energy_bar = 0, .env_bar = SCHED_ENV_NONE,
+                                        .energy_resp = NULL, .env_resp = NULL };
+  }
+  for (size_t i = 0; i < b->length; i++) {
+    b->sorted[i]->leaf = b->leaves + i;
+    propagate_sched_leaf(b, b->sorted[i], theta, false);
+  }
+  for (size_t i = b->leaves; i-- > 1; ) {
+    propagate_sched_combine(b->tree, i);
+  }
+}
+
+// raise earliest start times of tasks on a disjunctive resource that
+// must come after a set of other tasks, return false if the resource
+// is overloaded
+static bool propagate_disj_edges(struct sched_buf_t *b) {
+  propagate_sched_tree(b, true);
+  const struct sched_node_t *root = &b->tree[1];
+
+  // remove tasks from Theta in decreasing order of latest completion
+  // times, the tasks in Lambda that would make Theta end too late
+  // must come after all tasks in Theta
+  propagate_sched_sort(b, b->queue, propagate_sched_cmp_lct);
+  for (size_t k = b->length; k-- > 0; ) {
+    struct sched_elem_t *j = b->queue[k];
+    if (root->env > propagate_sched_avail(b, j->lct)) {
+      return false;
+    }
+    if (k == 0) {
+      break;
+    }
+    propagate_sched_update(b, j, false, true);
+
+    ddomain_t avail = propagate_sched_avail(b, b->queue[k-1]->lct);
+    while (root->env_bar > avail && root->env_resp != NULL) {
+      struct sched_elem_t *i = root->env_resp;
+      i->newest = propagate_sched_max(i->newest, b->origin + root->env);
+      propagate_sched_update(b, i, false, false);
+    }
+  }
+  return true;
+}
+
+// lower latest completion times of tasks on a disjunctive resource
+// that cannot come after all tasks that may end later
+static void propagate_disj_not_last(struct sched_buf_t *b) {
+  propagate_sched_tree(b, false);
+  const struct sched_node_t *root = &b->tree[1];
+
+  // add tasks to Theta in increasing order of latest start time
+  // while they may start before the currently visited task ends
+  propagate_sched_sort(b, b->sorted, propagate_sched_cmp_lct);
+  propagate_sched_sort(b, b->queue, propagate_sched_cmp_lst);
+  struct sched_elem_t *last = NULL, *prev = NULL;
+  for (size_t k = 0, q = 0; k < b->length; k++) {
+    struct sched_elem_t *i = b->sorted[k];
+    while (q < b->length && i->lct > b->queue[q]->lct - b->queue[q]->dur) {
+      prev = last;
+      last = b->queue[q++];
+      propagate_sched_update(b, last, true, false);
+    }
+
+    // the task must end before the other task in Theta that starts
+    // last if the other tasks cannot end before it starts
+    struct sched_elem_t *j = last != i ? last : prev;
+    propagate_sched_update(b, i, false, false);
+    if (j != NULL && root->env > propagate_sched_avail(b, i->lct - i->dur)) {
+      i->newlct = propagate_sched_min(i->newlct, j->lct - j->dur);
+    }
+    propagate_sched_update(b, i, true, false);
+  }
+}
+
+// check whether tasks on a cumulative resource need more energy than
+// the resource provides until the tasks must end
+static bool propagate_cumul_overload(struct sched_buf_t *b) {
+  propagate_sched_tree(b, false);
+  const struct sched_node_t *root = &b->tree[1];
+
+  propagate_sched_sort(b, b->queue, propagate_sched_cmp_lct);
+  for (size_t k = 0; k < b->length; k++) {
+    struct sched_elem_t *j = b->queue[k];
+    propagate_sched_update(b, j, true, false);
+    if (root->env > propagate_sched_avail(b, j->lct)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// compare changes of resource usage by time, decreases first
+static int propagate_cumul_cmp_event(const void *a, const void *b) {
+  const ddomain_t *x = (const ddomain_t *)a;
+  const ddomain_t *y = (const ddomain_t *)b;
+  if (x[0] != y[0]) {
+    return x[0] < y[0] ? -1 : 1;
+  }
+  return (x[1] > y[1]) - (x[1] < y[1]);
+}
+
+// build the resource profile from the parts where tasks must run,
+// return the number of profile segments
+static size_t propagate_cumul_profile(struct sched_buf_t *b) {
+  // collect changes of resource usage as pairs of time and change
+  ddomain_t *events = b->events;
+  size_t length = 0;
+  for (size_t i = 0; i < b->length; i++) {
+    const struct sched_elem_t *t = &b->tasks[i];
+    if (t->lct - t->dur < t->est + t->dur) {
+      events[2*length] = t->lct - t->dur;
+      events[2*length+1] = t->demand;
+      length++;
+      events[2*length] = t->est + t->dur;
+      events[2*length+1] = -t->demand;
+      length++;
+    }
+  }
+  qsort(events, length, 2 * sizeof(ddomain_t), propagate_cumul_cmp_event);
+
+  // merge changes at the same time into segments, segment k ranges
+  // from times[k] to times[k+1] and uses usage[k]
+  size_t segments = 0;
+  ddomain_t usage = 0;
+  for (size_t i = 0; i < length; ) {
+    ddomain_t time = events[2*i];
+    while (i < length && events[2*i] == time) {
+      usage += events[2*i+1];
+      i++;
+    }
+    b->times[segments] = time;
+    b->usage[segments] = usage;
+    segments++;
+  }
+  return segments;
+}
+
+// raise earliest start times of tasks on a cumulative resource such
+// that they fit into the resource profile
+static void propagate_cumul_timetable(struct sched_buf_t *b) {
+  size_t segments = propagate_cumul_profile(b);
+  if (segments == 0) {
+    return;
+  }
+
+  for (size_t i = 0; i < b->length; i++) {
+    struct sched_elem_t *t = &b->tasks[i];
+    ddomain_t lst = t->lct - t->dur, ect = t->est + t->dur;
+
+    // find first segment that ends after the task may start
+    size_t lo = 0, hi = segments - 1;
+    while (lo < hi) {
+      size_t mid = (lo + hi) / 2;
+      if (b->times[mid+1] <= t->est) {
+        lo = mid + 1;
+      } else {
+        hi = mid;
+      }
+    }
+
+    // move task past segments where it does not fit while it would
+    // overlap with them, not counting its own usage
+    ddomain_t start = t->est;
+    for (size_t k = lo; k + 1 < segments && b->times[k] < start + t->dur; k++) {
+      ddomain_t usage = b->usage[k];
+      if (lst <= b->times[k] && b->times[k+1] <= ect) {
+        usage -= t->demand;
+      }
+      if (usage + t->demand > b->cap && b->times[k+1] > start) {
+        start = b->times[k+1];
+      }
+    }
+    t->newest = propagate_sched_max(t->newest, start);
+  }
+}
+
+// make new bounds the current bounds, return false if some task has no room left
+static bool propagate_sched_commit(struct sched_buf_t *b) {
+  for (size_t i = 0; i < b->length; i++) {
+    struct sched_elem_t *t = &b->tasks[i];
+    t->est = t->newest;
+    t->lct = t->newlct;
+    if (t->est + t->dur > t->lct) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// mirror tasks in time, such that earliest start times become latest
+// completion times and vice versa
+static void propagate_sched_mirror(struct sched_buf_t *b) {
+  for (size_t i = 0; i < b->length; i++) {
+    struct sched_elem_t *t = &b->tasks[i];
+    ddomain_t est = t->est;
+    t->est = -t->lct;
+    t->lct = -est;
+    t->newest = t->est;
+    t->newlct = t->lct;
+  }
+}
+
+// collect tasks that use the resource, return false if a task can never fit
+static bool propagate_sched_init(struct sched_buf_t *b, struct constr_t *constr) {
+  b->length = 0;
+  for (size_t i = 0; i < constr->constr.sched.length; i++) {
+    const struct sched_task_t *task = &constr->constr.sched.tasks[i];
+    struct val_t start = task->start->type->eval(task->start);
+    struct val_t dur = task->dur->type->eval(task->dur);
+    struct val_t demand = task->demand != NULL ? task->demand->type->eval(task->demand) : VALUE(1);
+
+    // tasks only need the resource if they take time and some of it
+    if (get_lo(dur) > 0 && get_lo(demand) > 0) {
+      if (get_lo(demand) > b->cap) {
+        return false;
+      }
+      b->tasks[b->length++] = (struct sched_elem_t){ .task = task,
+                                                     .est = get_lo(start), .lct = (ddomain_t)get_hi(start) + get_lo(dur),
+                                                     .dur = get_lo(dur), .demand = get_lo(demand),
+                                                     .newest = get_lo(start), .newlct = (ddomain_t)get_hi(start) + get_lo(dur),
+                                                     .leaf = 0 };
+    }
+  }
+  return true;
+}
+
+// restrict start times of tasks whose bounds changed
+static prop_result_t propagate_sched_apply(struct sched_buf_t *b, const struct wand_expr_t *clause) {
+  prop_result_t r = PROP_NONE;
+  for (size_t i = 0; i < b->length; i++) {
+    struct sched_elem_t *t = &b->tasks[i];
+    struct constr_t *start = t->task->start;
+    struct val_t v = start->type->eval(start);
+    if (t->est != get_lo(v) || t->lct - t->dur != get_hi(v)) {
+      prop_result_t p = start->type->prop(start, INTERVAL(propagate_clamp(t->est), propagate_clamp(t->lct - t->dur)), clause);
+      CHECK(p);
+      r += p;
+    }
+  }
+  return r;
+}
+
+// filter start times of tasks on a disjunctive resource
+static bool propagate_disj_filter(struct sched_buf_t *b) {
+  // edge finding and not-last rules, and their mirrored versions
+  // not-first rules
+  for (int pass = 0; pass < 2; pass++) {
+    if (!propagate_disj_edges(b) || !propagate_sched_commit(b)) {
+      return false;
+    }
+    propagate_disj_not_last(b);
+    if (!propagate_sched_commit(b)) {
+      return false;
+    }
+    propagate_sched_mirror(b);
+  }
+  return true;
+}
+
+// filter start times of tasks on a cumulative resource
+static bool propagate_cumul_filter(struct sched_buf_t *b) {
+  if (!propagate_cumul_overload(b)) {
+    return false;
+  }
+  // time-tabling in both directions
+  for (int pass = 0; pass < 2; pass++) {
+    propagate_cumul_timetable(b);
+    if (!propagate_sched_commit(b)) {
+      return false;
+    }
+    propagate_sched_mirror(b);
+  }
+  return true;
+}
+
+// make start times of tasks on a resource consistent with its capacity
+static prop_result_t propagate_sched_bounds(struct constr_t *constr, const struct wand_expr_t *clause,
+                                            bool (*filter)(struct sched_buf_t *)) {
+  size_t n = constr->constr.sched.length;
+  if (n == 0) {
+    return PROP_NONE;
+  }
+
+  struct sched_buf_t b;
+  const struct constr_t *c = constr->constr.sched.cap;
+  b.cap = c != NULL ? get_hi(c->type->eval(c)) : 1;
+  b.tasks = (struct sched_elem_t *)alloc(n * sizeof(struct sched_elem_t));
+  b.sorted = (struct sched_elem_t **)alloc(n * sizeof(struct sched_elem_t *));
+  b.queue = (struct sched_elem_t **)alloc(n * sizeof(struct sched_elem_t *));
+  b.leaves = 1;
+  while (b.leaves < n) {
+    b.leaves *= 2;
+  }
+  b.tree = (struct sched_node_t *)alloc(2 * b.leaves * sizeof(struct sched_node_t));
+  b.events = (ddomain_t *)alloc(4 * n * sizeof(ddomain_t));
+  b.times = (ddomain_t *)alloc(2 * n * sizeof(ddomain_t));
+  b.usage = (ddomain_t *)alloc(2 * n * sizeof(ddomain_t));
+
+  prop_result_t r = PROP_ERROR;
+  if (propagate_sched_init(&b, constr)) {
+    r = PROP_NONE;
+    // skip filtering for tasks whose energies might overflow
+    if (b.length > 1 && propagate_sched_bounded(&b)) {
+      r = filter(&b) ? propagate_sched_apply(&b, clause) : PROP_ERROR;
+    }
+  }
+
+  dealloc(b.tasks);
+  return r;
+}
+
+// propagate value to scheduling expression
+static prop_result_t propagate_sched(struct constr_t *constr, const struct val_t val, const struct wand_expr_t *clause,
+                                     bool (*filter)(struct sched_buf_t *)) {
+  // make sure tasks fit on the resource
+  if (is_true(val)) {
+    return propagate_sched_bounds(constr, clause, filter);
+  }
+
+  // fail if tasks are known to fit on the resource
+  if (is_false(val) && is_true(constr->type->eval(constr))) {
+    return PROP_ERROR;
+  }
+
+  return PROP_NONE;
+}
+
+// propagate value to disjunctive resource expression
+prop_result_t propagate_disj(struct constr_t *constr, const struct val_t val, const struct wand_expr_t *clause) {
+  return propagate_sched(constr, val, clause, propagate_disj_filter);
+}
+
+// propagate value to cumulative resource expression
+prop_result_t propagate_cumul(struct constr_t *constr, const struct val_t val, const struct wand_expr_t *clause) {
+  return propagate_sched(constr, val, clause, propagate_cumul_filter);
+}
+
 // propagate value to wide-and expression
 prop_result_t propagate_wand(struct constr_t *constr, const struct val_t val, const struct wand_expr_t *clause) {
 
@@ -399,31 +1808,52 @@ static void propagate_confl_swap(struct confl_elem_t *a, struct confl_elem_t *b)
   *b = t;
 }
 
-// find if single non-value variable exists in conflict
+// return whether a variable is within the bounds of a conflict element
+static bool propagate_confl_within(const struct confl_elem_t *c) {
+  const struct val_t v = c->var->constr.term.val;
+  return get_lo(v) >= get_lo(c->val) && get_hi(v) <= get_hi(c->val);
+}
+
+// return whether a variable is outside the bounds of a conflict element
+static bool propagate_confl_outside(const struct confl_elem_t *c) {
+  const struct val_t v = c->var->constr.term.val;
+  return get_hi(v) < get_lo(c->val) || get_lo(v) > get_hi(c->val);
+}
+
+// order conflict elements by the level their variables were bound at,
+// bindings at the root level (SIZE_MAX) come first
+static size_t propagate_confl_order(const struct confl_elem_t *c) {
+  const struct env_t *var = c->var->constr.term.env;
+  return var != NULL ? var->level + 1 : 0;
+}
+
+// find the single variable in a conflict that may still leave its
+// bounds, or the variable that was bound last if all variables are
+// within their bounds
 static struct confl_elem_t *propagate_confl_find(struct constr_t *constr) {
   struct confl_elem_t *p = NULL;
+  struct confl_elem_t *q = NULL;
 
   // find whether there is a variable to be inferred
   for (size_t i = 0, l = constr->constr.confl.length; i < l; i++) {
 
     struct confl_elem_t *c = &constr->constr.confl.elems[i];
-    const struct val_t v = c->var->constr.term.val;
-
-    if (is_value(v)) {
-      // stop if some variable is different from its conflict value
-      if (get_lo(v) != get_lo(c->val)) {
-        if (i > 0) {
-          // swap stopping entry forward
-          propagate_confl_swap(&constr->constr.confl.elems[0], c);
-        }
-        return NULL;
+
+    if (propagate_confl_outside(c)) {
+      // stop if some variable is outside its conflict bounds
+      if (i > 0) {
+        // swap stopping entry forward
+        propagate_confl_swap(&constr->constr.confl.elems[0], c);
       }
-    } else {
+      return NULL;
+    }
+
+    if (!propagate_confl_within(c)) {
       if (p == NULL) {
-        // remember if there is a non-value variable
+        // remember if there is an undecided variable
         p = c;
       } else {
-        // stop if there are more than one non-value variables
+        // stop if there are more than one undecided variables
         if (i > 1) {
           // swap stopping entries forward
           propagate_confl_swap(&constr->constr.confl.elems[0], p);
@@ -431,24 +1861,30 @@ static struct confl_elem_t *propagate_confl_find(struct constr_t *constr) {
         }
         return NULL;
       }
+    } else if (q == NULL || propagate_confl_order(c) > propagate_confl_order(q)) {
+      // remember the variable that was bound last
+      q = c;
     }
   }
 
-  return p;
+  return p != NULL ? p : q;
 }
 
-// infer value of variable in conflict
+// infer value of variable in conflict, pushing it out of its conflict
+// bounds; this fails if it was within the bounds already
 static prop_result_t propagate_confl_infer(struct confl_elem_t *p, const struct wand_expr_t *clause) {
   const struct val_t v = p->var->type->eval(p->var);
+  const domain_t lo = get_lo(p->val);
+  const domain_t hi = get_hi(p->val);
 
   // restrict variable value from lower bound
-  if (get_lo(v) == get_lo(p->val) && get_lo(v) != DOMAIN_MIN && get_lo(v) != DOMAIN_MAX) {
-    return p->var->type->prop(p->var, INTERVAL(get_lo(v) + 1, DOMAIN_MAX), clause);
+  if (lo <= get_lo(v) && hi != DOMAIN_MIN && hi != DOMAIN_MAX) {
+    return p->var->type->prop(p->var, INTERVAL(hi + 1, DOMAIN_MAX), clause);
   }
 
   // restrict variable value from upper bound
-  if (get_hi(v) == get_hi(p->val) && get_hi(v) != DOMAIN_MIN && get_hi(v) != DOMAIN_MAX) {
-    return p->var->type->prop(p->var, INTERVAL(DOMAIN_MIN, get_hi(v) - 1), clause);
+  if (hi >= get_hi(v) && lo != DOMAIN_MIN && lo != DOMAIN_MAX) {
+    return p->var->type->prop(p->var, INTERVAL(DOMAIN_MIN, lo - 1), clause);
   }
 
   return PROP_NONE;
@@ -459,9 +1895,9 @@ prop_result_t propagate_confl(struct constr_t *constr, const struct val_t val, c
 
   // only propagate "true" to conflict
   if (is_true(val)) {
-    // find remaining non-value variable
+    // find remaining undecided variable
     struct confl_elem_t *p = propagate_confl_find(constr);
-    // infer value of remaining non-value variable
+    // infer value of remaining undecided variable
     if (p != NULL) {
       return propagate_confl_infer(p, clause);
     }
@@ -470,6 +1906,101 @@ prop_result_t propagate_confl(struct constr_t *constr, const struct val_t val, c
   return PROP_NONE;
 }
 
+// get the events that can make a conflict element true
+static prop_event_t propagate_confl_events(const struct confl_elem_t *c) {
+  prop_event_t events = 0;
+  if (get_lo(c->val) != DOMAIN_MIN) {
+    events |= PROP_EVENT_LB;
+  }
+  if (get_hi(c->val) != DOMAIN_MAX) {
+    events |= PROP_EVENT_UB;
+  }
+  return events;
+}
+
+// watch the first two elements of a conflict, the conflict can only
+// infer something or fail when one of them becomes true
+void propagate_watch(struct wand_expr_t *clause) {
+  const struct constr_t *constr = clause->constr;
+  for (size_t i = 0, l = constr->constr.confl.length; i < l && i < 2; i++) {
+    const struct confl_elem_t *c = &constr->constr.confl.elems[i];
+    clause_list_append(&c->var->constr.term.env->watches, clause, propagate_confl_events(c));
+  }
+}
+
+// propagate a change of a variable to the conflicts watching it; a
+// conflict moves the watch from an element that became true to
+// another one that may still become false, or infers the other
+// watched element if there is none, such that backtracking never
+// needs to update watches
+static prop_result_t propagate_watches(struct env_t *var, prop_event_t events) {
+  prop_result_t r = PROP_NONE;
+  struct clause_list_t *watches = &var->watches;
+
+  size_t i = 0;
+  while (i < watches->length) {
+    // skip if the watched element cannot become true from the change
+    if ((watches->events[i] & events) == 0) {
+      i++;
+      continue;
+    }
+
+    struct wand_expr_t *clause = watches->elems[i];
+    struct confl_elem_t *elems = clause->constr->constr.confl.elems;
+    const size_t length = clause->constr->constr.confl.length;
+
+    // a single element must never become true
+    if (length == 1) {
+      prop_result_t p = propagate_confl_infer(&elems[0], clause);
+      CHECK(p);
+      r += p;
+      i++;
+      continue;
+    }
+
+    // find the watched element of the variable that became true
+    size_t w = 0;
+    if (elems[0].var->constr.term.env != var || !propagate_confl_within(&elems[0])) {
+      w = 1;
+      if (elems[1].var->constr.term.env != var || !propagate_confl_within(&elems[1])) {
+        i++;
+        continue;
+      }
+    }
+    // nothing to do while the other watched element is false
+    struct confl_elem_t *other = &elems[1-w];
+    if (propagate_confl_outside(other)) {
+      i++;
+      continue;
+    }
+
+    // look for another element to watch
+    size_t k = 2;
+    while (k < length && propagate_confl_within(&elems[k])) {
+      k++;
+    }
+    if (k < length) {
+      propagate_confl_swap(&elems[w], &elems[k]);
+      struct env_t *next = elems[w].var->constr.term.env;
+      if (next == var) {
+        watches->events[i++] = propagate_confl_events(&elems[w]);
+      } else {
+        clause_list_append(&next->watches, clause, propagate_confl_events(&elems[w]));
+        clause_list_remove(watches, i);
+      }
+      continue;
+    }
+
+    // infer the other watched element, or fail if it is true as well
+    prop_result_t p = propagate_confl_infer(propagate_confl_within(other) ? &elems[w] : other, clause);
+    CHECK(p);
+    r += p;
+    i++;
+  }
+
+  return r;
+}
+
 // propagate value "true" to expression
 prop_result_t propagate(struct constr_t *constr, size_t limit) {
   prop_result_t r = PROP_NONE;
@@ -477,62 +2008,31 @@ prop_result_t propagate(struct constr_t *constr, size_t limit) {
   // loop until there are no new propagations
   size_t i = 0;
   do {
+    propagate_start();
     p = constr->type->prop(constr, VALUE(1), NULL);
     CHECK(p);
+    prop_result_t q = propagate_fixpoint();
+    CHECK(q);
+    p += q;
     r += p;
   } while (p != PROP_NONE && i++ < limit);
   return r;
 }
 
-// propagate value "true" to expressions in clause list
-prop_result_t propagate_clauses(const struct clause_list_t *clauses) {
-  // update propagation tag
-  static prop_tag_t _prop_tag = 0;
-  prop_tag_t tag = ++_prop_tag;
-
-  prop_result_t r = PROP_NONE;
+// propagate value "true" to the clauses of a variable
+prop_result_t propagate_clauses(struct env_t *var) {
+  propagate_start();
 
   // reset conflicts
   conflict_reset();
 
-  // keep track of clauses that may profit from normalizing
-  bool norm[clauses->length];
-
-  for (size_t i = 0, l = clauses->length; i < l; i++) {
-    struct wand_expr_t *clause = clauses->elems[i];
-    // skip if a later call already propagated this clause
-    if (clause->prop_tag > tag) {
-      norm[i] = false;
-      continue;
-    }
-    // update propagation tag
-    clause->prop_tag = tag;
-
-    // propagate "true" to this clause
-    struct constr_t *c = clause->constr;
-    prop_result_t p = c->type->prop(c, VALUE(1), clause);
-    CHECK(p);
-    r += p;
-
-    // this clause may profit from normalizing
-    norm[i] = p != PROP_NONE;
-  }
-
-  for (size_t i = 0, l = clauses->length; r != PROP_NONE && i < l; i++) {
-    // normalize clause that caused a (successful) propagation
-    if (norm[i]) {
-      struct wand_expr_t *clause = clauses->elems[i];
-      struct constr_t *c = clause->constr;
-
-      // normalize clause
-      struct constr_t *n = c->type->norm(c);
-
-      // patch clause if normalizing changed anything
-      if (n != c) {
-        patch(clause, n);
-      }
-    }
-  }
-
-  return r;
+  // propagate to all clauses of the variable, whatever events they
+  // subscribe to
+  prop_result_t r = propagate_watches(var, PROP_EVENT_ANY);
+  CHECK(r);
+  prop_result_t q = propagate_list(&var->clauses, _prop_tag, PROP_EVENT_ANY, NULL);
+  CHECK(q);
+  prop_result_t p = propagate_fixpoint();
+  CHECK(p);
+  return r + q + p;
 }
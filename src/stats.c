@@ -25,7 +25,7 @@ along with CSolve.  If not, see <http://www.gnu.org/licenses/>.
 static uint64_t _stats_frequency;
 
 #define STAT_VAR(NAME, TYPE, RESET_VAL, ...)    \
-  TYPE NAME;
+  THREAD_LOCAL TYPE NAME;
 
 STAT_LIST(STAT_VAR)
 
@@ -24,11 +24,15 @@ along with CSolve.  If not, see <http://www.gnu.org/licenses/>.
 #include <stdlib.h>
 #include <string.h>
 
-static bool _create_conflicts;
-static bool _prefer_failing;
-static bool _compute_weights;
-static uint64_t _restart_frequency;
-static enum order_t _order;
+static THREAD_LOCAL bool _create_conflicts;
+static THREAD_LOCAL bool _prefer_failing;
+static THREAD_LOCAL bool _compute_weights;
+static THREAD_LOCAL uint64_t _restart_frequency;
+static THREAD_LOCAL enum order_t _order;
+static THREAD_LOCAL enum prop_order_t _prop_order;
+static THREAD_LOCAL unsigned int _seed = 1;
+static bool _portfolio;
+static uint32_t _eps;
 
 // initialize whether to create conflicts
 void strategy_create_conflicts_init(bool create_conflicts) {
@@ -75,6 +79,99 @@ void strategy_order_init(enum order_t order) {
   _order = order;
 }
 
+// initialize the order of propagating queued clauses
+void strategy_prop_order_init(enum prop_order_t prop_order) {
+  _prop_order = prop_order;
+}
+
+// return the order of propagating queued clauses
+enum prop_order_t strategy_prop_order(void) {
+  return _prop_order;
+}
+
+// initialize whether to run different strategies in parallel
+void strategy_portfolio_init(bool portfolio) {
+  _portfolio = portfolio;
+}
+
+// return whether to run different strategies in parallel
+bool strategy_portfolio(void) {
+  return _portfolio;
+}
+
+// initialize the number of subproblems per worker for upfront decomposition
+void strategy_eps_init(uint32_t eps) {
+  _eps = eps;
+}
+
+// return the number of subproblems per worker for upfront decomposition
+uint32_t strategy_eps(void) {
+  return _eps;
+}
+
+// get the strategy settings of the current worker
+void strategy_get(struct strategy_t *strategy) {
+  *strategy = (struct strategy_t){ .create_conflicts = _create_conflicts,
+                                   .prefer_failing = _prefer_failing,
+                                   .compute_weights = _compute_weights,
+                                   .restart_frequency = _restart_frequency,
+                                   .order = _order,
+                                   .prop_order = _prop_order,
+                                   .seed = _seed };
+}
+
+// set the strategy settings of the current worker
+void strategy_set(const struct strategy_t *strategy) {
+  _create_conflicts = strategy->create_conflicts;
+  _prefer_failing = strategy->prefer_failing;
+  _compute_weights = strategy->compute_weights;
+  _restart_frequency = strategy->restart_frequency;
+  _order = strategy->order;
+  _prop_order = strategy->prop_order;
+  _seed = strategy->seed;
+}
+
+// orderings to cycle through in a portfolio
+static const enum order_t _portfolio_orders[] = {
+  ORDER_NONE, ORDER_SMALLEST_DOMAIN, ORDER_LARGEST_VALUE,
+  ORDER_SMALLEST_VALUE, ORDER_LARGEST_DOMAIN
+};
+#define PORTFOLIO_ORDERS (sizeof(_portfolio_orders) / sizeof(_portfolio_orders[0]))
+
+// vary the strategy settings of the current worker depending on its ID,
+// the first worker keeps the configured settings
+void strategy_diversify(uint32_t id) {
+  uint32_t k = id - 1;
+  _seed = id;
+  if (k == 0) {
+    return;
+  }
+
+  // use a different ordering than the configured one
+  size_t pos = 0;
+  while (pos < PORTFOLIO_ORDERS && _portfolio_orders[pos] != _order) {
+    pos++;
+  }
+  _order = _portfolio_orders[(pos + k) % PORTFOLIO_ORDERS];
+
+  // toggle the other settings in turn
+  _prefer_failing = ((k / PORTFOLIO_ORDERS) % 2 == 0) ? _prefer_failing : !_prefer_failing;
+  _create_conflicts = (k % 3 == 2) ? !_create_conflicts : _create_conflicts;
+
+  // restart more or less often
+  switch (k % 4) {
+  case 1: _restart_frequency = (_restart_frequency + 3) / 4; break;
+  case 2: _restart_frequency = _restart_frequency * 4; break;
+  case 3: _restart_frequency = (_restart_frequency + 15) / 16; break;
+  default: break;
+  }
+}
+
+// get a random number from the generator of the current worker
+int strategy_rand(void) {
+  return rand_r(&_seed);
+}
+
 // compare two variables according to the variable ordering
 static int strategy_var_cmp(struct env_t *e1, struct env_t *e2) {
   struct val_t v1 = e1->val->constr.term.val;
@@ -122,8 +219,8 @@ static int strategy_var_cmp(struct env_t *e1, struct env_t *e2) {
 
 // definitions for priority queue of variables
 #define VAR_ORDER_HEAP_ARITY 2
-size_t _var_order_size;
-struct env_t **_var_order;
+THREAD_LOCAL size_t _var_order_size;
+THREAD_LOCAL struct env_t **_var_order;
 
 // get index of parent of priority queue entry
 static inline size_t parent(size_t child) {
@@ -163,7 +260,13 @@ void strategy_var_order_init(size_t size, struct env_t *env) {
 
 // release memory for priority queue of variables
 void strategy_var_order_free(void) {
+  // variables outlive the queue and must not refer to it anymore
+  for (size_t i = 0; i < _var_order_size; i++) {
+    _var_order[i]->order = SIZE_MAX;
+  }
+  _var_order_size = 0;
   free(_var_order);
+  _var_order = NULL;
 }
 
 // swap two variables in priority queue of variables
@@ -244,3 +347,21 @@ void strategy_var_order_update(struct env_t *e) {
     strategy_var_order_down(e->order);
   }
 }
+
+// remove a particular variable from the priority queue
+void strategy_var_order_remove(struct env_t *e) {
+  if (e->order != SIZE_MAX) {
+    size_t pos = e->order;
+    e->order = SIZE_MAX;
+    --_var_order_size;
+
+    // fill the gap with the last entry and move it to its correct position
+    if (pos < _var_order_size) {
+      struct env_t *last = _var_order[_var_order_size];
+      _var_order[pos] = last;
+      last->order = pos;
+      strategy_var_order_up(pos);
+      strategy_var_order_down(last->order);
+    }
+  }
+}
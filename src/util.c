@@ -31,11 +31,11 @@ along with CSolve.  If not, see <http://www.gnu.org/licenses/>.
 #define ALLOC_ALIGNMENT 8U
 
 // the allocation stack
-static char *_alloc_stack;
+static THREAD_LOCAL char *_alloc_stack;
 // the total size of the allocation stack
-static size_t _alloc_stack_size;
+static THREAD_LOCAL size_t _alloc_stack_size;
 // the current position in the allocation stack
-static size_t _alloc_stack_pointer;
+static THREAD_LOCAL size_t _alloc_stack_pointer;
 
 // initialize the allocation stack
 void alloc_init(size_t size) {
@@ -84,14 +84,19 @@ void dealloc(void *elem) {
   }
 }
 
+// get the size of the allocation stack
+size_t alloc_size(void) {
+  return _alloc_stack_size;
+}
+
 // the binding stack
-static struct binding_t *_bind_stack;
+static THREAD_LOCAL struct binding_t *_bind_stack;
 // the total size of the binding stack
-static size_t _bind_stack_size;
+static THREAD_LOCAL size_t _bind_stack_size;
 // the current depth of the binding stack
-static size_t _bind_depth;
+static THREAD_LOCAL size_t _bind_depth;
 // the binding level (assignment level of solving algorithm)
-static size_t _bind_level;
+static THREAD_LOCAL size_t _bind_level;
 
 // initialize the binding stack
 void bind_init(size_t size) {
@@ -134,14 +139,28 @@ size_t bind_level_get(void) {
 }
 
 // bind a variable to a value
-void bind(struct env_t *var, const struct val_t val, const struct wand_expr_t *clause) {
+prop_event_t bind(struct env_t *var, const struct val_t val, const struct wand_expr_t *clause) {
+  prop_event_t events = 0;
   if (var != NULL) {
     if (_bind_depth < _bind_stack_size) {
       _bind_stack[_bind_depth].var = var;
 
+      // classify the change
+      const struct val_t prev = var->val->constr.term.val;
+      if (get_lo(val) > get_lo(prev)) {
+        events |= PROP_EVENT_LB;
+      }
+      if (get_hi(val) < get_hi(prev)) {
+        events |= PROP_EVENT_UB;
+      }
+      if (is_value(val) && !is_value(prev)) {
+        events |= PROP_EVENT_FIX;
+      }
+
       // update value and store binding level
-      _bind_stack[_bind_depth].val = var->val->constr.term.val;
+      _bind_stack[_bind_depth].val = prev;
       var->val->constr.term.val = val;
+      eval_invalidate();
       _bind_stack[_bind_depth].level = var->level;
       var->level = _bind_level;
 
@@ -159,6 +178,7 @@ void bind(struct env_t *var, const struct val_t val, const struct wand_expr_t *c
     // die if trying to bind a null variable
     print_fatal(ERROR_MSG_NULL_BIND);
   }
+  return events;
 }
 
 // unbind all locations above a certain depth
@@ -167,17 +187,47 @@ void unbind(size_t depth) {
     --_bind_depth;
     struct env_t *var = _bind_stack[_bind_depth].var;
     var->val->constr.term.val = _bind_stack[_bind_depth].val;
+    eval_invalidate();
     var->level = _bind_stack[_bind_depth].level;
     var->binds = _bind_stack[_bind_depth].prev;
   }
 }
 
+// get the size of the binding stack
+size_t bind_size(void) {
+  return _bind_stack_size;
+}
+
+// get the binding at a certain depth of the binding stack
+const struct binding_t *bind_get(size_t depth) {
+  return &_bind_stack[depth];
+}
+
+// relocate the clauses the bindings on the binding stack refer to
+void bind_relocate(relocate_t relocate) {
+  for (size_t i = 0; i < _bind_depth; i++) {
+    if (_bind_stack[i].clause != NULL) {
+      _bind_stack[i].clause = (const struct wand_expr_t *)relocate(_bind_stack[i].clause);
+    }
+  }
+}
+
+// swap two elements of a clause list
+static void clause_list_swap(struct clause_list_t *list, size_t i, size_t k) {
+  struct wand_expr_t *elem = list->elems[i];
+  list->elems[i] = list->elems[k];
+  list->elems[k] = elem;
+  prop_event_t events = list->events[i];
+  list->events[i] = list->events[k];
+  list->events[k] = events;
+}
+
 // the patching stack
-static struct patching_t *_patch_stack;
+static THREAD_LOCAL struct patching_t *_patch_stack;
 // the total size of the patching stack
-static size_t _patch_stack_size;
+static THREAD_LOCAL size_t _patch_stack_size;
 // the current depth of the patching stack
-static size_t _patch_depth;
+static THREAD_LOCAL size_t _patch_depth;
 
 // initialize patching stack
 void patch_init(size_t size) {
@@ -209,6 +259,7 @@ size_t patch(struct wand_expr_t *loc, struct constr_t *constr) {
     if (_patch_depth < _patch_stack_size) {
       _patch_stack[_patch_depth].loc = loc;
       _patch_stack[_patch_depth].constr = loc->constr;
+      _patch_stack[_patch_depth].list = NULL;
       loc->constr = constr;
       return _patch_depth++;
     }
@@ -225,13 +276,24 @@ void unpatch(size_t depth) {
   while (_patch_depth > depth) {
     --_patch_depth;
     struct wand_expr_t *loc = _patch_stack[_patch_depth].loc;
-    loc->constr = _patch_stack[_patch_depth].constr;
+    if (loc != NULL) {
+      loc->constr = _patch_stack[_patch_depth].constr;
+    } else {
+      // move dropped element back to where it was
+      struct clause_list_t *list = _patch_stack[_patch_depth].list;
+      clause_list_swap(list, --list->dead, _patch_stack[_patch_depth].index);
+    }
   }
 }
 
+// get the size of the patching stack
+size_t patch_size(void) {
+  return _patch_stack_size;
+}
+
 // initialize a semaphore
-void sema_init(sem_t *sema) {
-  int status = sem_init(sema, 1, 1);
+void sema_init(sem_t *sema, uint32_t value) {
+  int status = sem_init(sema, 1, value);
   if (status == -1) {
     print_fatal("%s", strerror(errno));
   }
@@ -264,8 +326,143 @@ bool clause_list_contains(struct clause_list_t *list, struct wand_expr_t *elem)
 }
 
 // add an element to a clause list
-void clause_list_append(struct clause_list_t *list, struct wand_expr_t *elem) {
+void clause_list_append(struct clause_list_t *list, struct wand_expr_t *elem, prop_event_t events) {
   list->length++;
   list->elems = (struct wand_expr_t **)realloc(list->elems, list->length * sizeof(struct wand_expr_t *));
+  list->events = (prop_event_t *)realloc(list->events, list->length * sizeof(prop_event_t));
+  // die if allocation failed
+  if (list->elems == NULL || list->events == NULL) {
+    print_fatal("%s", strerror(errno));
+  }
   list->elems[list->length-1] = elem;
+  list->events[list->length-1] = events;
+}
+
+// subscribe an element of a clause list to events, adding it if needed
+void clause_list_subscribe(struct clause_list_t *list, struct wand_expr_t *elem, prop_event_t events) {
+  for (size_t i = 0, l = list->length; i < l; i++) {
+    if (list->elems[i] == elem) {
+      list->events[i] |= events;
+      return;
+    }
+  }
+  clause_list_append(list, elem, events);
+}
+
+// release memory of a clause list
+void clause_list_free(struct clause_list_t *list) {
+  free(list->elems);
+  free(list->events);
+  *list = (struct clause_list_t){ .length = 0, .elems = NULL, .events = NULL, .dead = 0 };
+}
+
+// count the positions in a sorted array that are below a position
+static size_t clause_list_count_below(const size_t *positions, size_t length, size_t pos) {
+  size_t lo = 0;
+  size_t hi = length;
+  while (lo < hi) {
+    size_t mid = lo + (hi - lo) / 2;
+    if (positions[mid] < pos) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return lo;
+}
+
+// find a clause list in an array sorted by address, return the
+// length of the array if it is not contained
+static size_t clause_list_find(struct clause_list_t **lists, size_t count, const struct clause_list_t *list) {
+  size_t lo = 0;
+  size_t hi = count;
+  while (lo < hi) {
+    size_t mid = lo + (hi - lo) / 2;
+    if ((uintptr_t)lists[mid] < (uintptr_t)list) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return lo < count && lists[lo] == list ? lo : count;
+}
+
+// remove the elements that are not to be kept from the live parts of
+// clause lists, which must be sorted by address; the remaining
+// elements keep their order, such that unpatching still restores the
+// original order if the elements it moves are kept
+size_t clause_lists_compact(struct clause_list_t **lists, size_t count, bool (*keep)(const struct wand_expr_t *)) {
+  // positions of removed elements, grouped by clause list
+  size_t *starts = (size_t *)malloc((count + 1) * sizeof(size_t));
+  size_t *removed = NULL;
+  size_t total = 0;
+  size_t size = 0;
+  // die if allocation failed
+  if (starts == NULL) {
+    print_fatal("%s", strerror(errno));
+  }
+
+  for (size_t j = 0; j < count; j++) {
+    struct clause_list_t *list = lists[j];
+    starts[j] = total;
+    size_t length = list->dead;
+    for (size_t i = list->dead, l = list->length; i < l; i++) {
+      if (keep(list->elems[i])) {
+        list->elems[length] = list->elems[i];
+        list->events[length] = list->events[i];
+        length++;
+      } else {
+        if (total == size) {
+          size = size == 0 ? count : 2 * size;
+          removed = (size_t *)realloc(removed, size * sizeof(size_t));
+          // die if allocation failed
+          if (removed == NULL) {
+            print_fatal("%s", strerror(errno));
+          }
+        }
+        removed[total++] = i;
+      }
+    }
+    list->length = length;
+  }
+  starts[count] = total;
+
+  // shift the positions dropped elements are moved back to
+  for (size_t k = 0; k < _patch_depth && total > 0; k++) {
+    struct patching_t *p = &_patch_stack[k];
+    if (p->loc == NULL) {
+      size_t j = clause_list_find(lists, count, p->list);
+      if (j < count) {
+        p->index -= clause_list_count_below(&removed[starts[j]], starts[j+1] - starts[j], p->index);
+      }
+    }
+  }
+
+  free(starts);
+  free(removed);
+  return total;
+}
+
+// drop an element from the live part of a clause list
+size_t clause_list_drop(struct clause_list_t *list, size_t index) {
+  if (_patch_depth < _patch_stack_size) {
+    _patch_stack[_patch_depth].loc = NULL;
+    _patch_stack[_patch_depth].constr = NULL;
+    _patch_stack[_patch_depth].list = list;
+    _patch_stack[_patch_depth].index = index;
+    // dead elements are kept at the start of the list, such that
+    // appending elements does not move them
+    clause_list_swap(list, list->dead++, index);
+    return _patch_depth++;
+  }
+  // die if running out of space on the patching stack
+  print_fatal(ERROR_MSG_TOO_MANY_PATCHES);
+  return _patch_depth;
+}
+
+// remove an element from a clause list for good
+void clause_list_remove(struct clause_list_t *list, size_t index) {
+  list->length--;
+  list->elems[index] = list->elems[list->length];
+  list->events[index] = list->events[list->length];
 }
@@ -12,7 +12,8 @@ class Mock {
 
 Mock *MockProxy;
 
-size_t alloc_max;
+THREAD_LOCAL size_t alloc_max;
+THREAD_LOCAL uint64_t eval_epoch;
 
 void eval_cache_invalidate(void) {
   MockProxy->eval_cache_invalidate();
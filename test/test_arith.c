@@ -57,4 +57,20 @@ TEST(Max, Basic) {
   EXPECT_EQ(DOMAIN_MAX, max(DOMAIN_MAX, 0));
 }
 
+TEST(DivFloor, Basic) {
+  EXPECT_EQ(2, div_floor(7, 3));
+  EXPECT_EQ(-3, div_floor(-7, 3));
+  EXPECT_EQ(-3, div_floor(7, -3));
+  EXPECT_EQ(2, div_floor(-7, -3));
+  EXPECT_EQ(-2, div_floor(-6, 3));
+}
+
+TEST(DivCeil, Basic) {
+  EXPECT_EQ(3, div_ceil(7, 3));
+  EXPECT_EQ(-2, div_ceil(-7, 3));
+  EXPECT_EQ(-2, div_ceil(7, -3));
+  EXPECT_EQ(3, div_ceil(-7, -3));
+  EXPECT_EQ(2, div_ceil(6, 3));
+}
+
 } // end namespace
@@ -16,7 +16,8 @@ class Mock {
 
 Mock *MockProxy;
 
-size_t alloc_max;
+THREAD_LOCAL size_t alloc_max;
+THREAD_LOCAL uint64_t eval_epoch;
 
 void eval_cache_invalidate(void) {
   MockProxy->eval_cache_invalidate();
@@ -49,6 +50,7 @@ TEST(Bind, Free) {
 
 TEST(Bind, Success) {
   struct constr_t c;
+  c.constr.term.val = INTERVAL(0, 20);
   struct env_t loc = { .key = "x", .val = &c, .binds = NULL,
                        .clauses = { .length = 0, .elems = NULL },
                        .order = 0, .prio = 0, .level = 0 };
@@ -63,6 +65,27 @@ TEST(Bind, Success) {
   delete(MockProxy);
 }
 
+TEST(Bind, Events) {
+  struct constr_t c;
+  c.constr.term.val = INTERVAL(0, 20);
+  struct env_t loc = { .key = "x", .val = &c, .binds = NULL,
+                       .clauses = { .length = 0, .elems = NULL, .events = NULL },
+                       .order = 0, .prio = 0, .level = 0 };
+
+  bind_init(64);
+
+  MockProxy = new Mock();
+  _bind_depth = 0;
+  EXPECT_EQ(PROP_EVENT_LB, bind(&loc, INTERVAL(3, 20), NULL));
+  EXPECT_EQ(PROP_EVENT_UB, bind(&loc, INTERVAL(3, 17), NULL));
+  EXPECT_EQ(PROP_EVENT_LB | PROP_EVENT_UB, bind(&loc, INTERVAL(4, 16), NULL));
+  EXPECT_EQ(PROP_EVENT_UB | PROP_EVENT_FIX, bind(&loc, VALUE(4), NULL));
+  EXPECT_EQ(0, bind(&loc, VALUE(4), NULL));
+  c.constr.term.val = INTERVAL(0, 20);
+  EXPECT_EQ(PROP_EVENT_ANY, bind(&loc, VALUE(7), NULL));
+  delete(MockProxy);
+}
+
 TEST(Bind, Fail) {
   struct env_t loc;
 
@@ -98,6 +121,30 @@ TEST(Bind, Depth) {
   delete(MockProxy);
 }
 
+TEST(Bind, Get) {
+  struct constr_t c;
+  c.constr.term.val = INTERVAL(0, 20);
+  struct env_t loc = { .key = "x", .val = &c, .binds = NULL,
+                       .clauses = { .length = 0, .elems = NULL },
+                       .order = 0, .prio = 0, .level = 5 };
+
+  bind_init(64);
+
+  MockProxy = new Mock();
+  _bind_depth = 0;
+  bind(&loc, INTERVAL(3, 20), NULL);
+  bind(&loc, INTERVAL(3, 17), NULL);
+  EXPECT_EQ(&_bind_stack[0], bind_get(0));
+  EXPECT_EQ(&_bind_stack[1], bind_get(1));
+  EXPECT_EQ(loc.binds, bind_get(1));
+  EXPECT_EQ(bind_get(0), bind_get(1)->prev);
+  EXPECT_EQ(INTERVAL(0, 20), bind_get(0)->val);
+  EXPECT_EQ(5U, bind_get(0)->level);
+  delete(MockProxy);
+
+  bind_free();
+}
+
 TEST(Bind, LevelSet) {
   MockProxy = new Mock();
   bind_level_set(23);
@@ -142,4 +189,34 @@ TEST(Unbind, Sucess) {
   delete(MockProxy);
 }
 
+
+struct wand_expr_t relocate_from;
+struct wand_expr_t relocate_to;
+
+void *relocate_clause(const void *ptr) {
+  return ptr == &relocate_from ? &relocate_to : (void *)ptr;
+}
+
+TEST(Bind, Relocate) {
+  struct constr_t c;
+  c.constr.term.val = INTERVAL(0, 20);
+  struct env_t loc = { .key = "x", .val = &c, .binds = NULL,
+                       .clauses = { .length = 0, .elems = NULL, .events = NULL },
+                       .order = 0, .prio = 0, .level = 0 };
+  struct wand_expr_t other;
+
+  bind_init(64);
+
+  MockProxy = new Mock();
+  _bind_depth = 0;
+  bind(&loc, INTERVAL(3, 20), &relocate_from);
+  bind(&loc, INTERVAL(3, 17), NULL);
+  bind(&loc, INTERVAL(4, 17), &other);
+  bind_relocate(relocate_clause);
+  EXPECT_EQ(&relocate_to, _bind_stack[0].clause);
+  EXPECT_EQ((const struct wand_expr_t *)NULL, _bind_stack[1].clause);
+  EXPECT_EQ(&other, _bind_stack[2].clause);
+  delete(MockProxy);
+}
+
 } // end namespace
@@ -16,7 +16,8 @@ class Mock {
 
 Mock *MockProxy;
 
-size_t alloc_max;
+THREAD_LOCAL size_t alloc_max;
+THREAD_LOCAL uint64_t eval_epoch;
 
 void eval_cache_invalidate(void) {
   MockProxy->eval_cache_invalidate();
@@ -54,21 +55,212 @@ TEST(ClauseList, Append) {
   struct wand_expr_t w1;
   struct wand_expr_t w2;
 
-  struct clause_list_t list = { .length = 0, .elems = NULL };
+  struct clause_list_t list = { .length = 0, .elems = NULL, .events = NULL };
 
-  clause_list_append(&list, &w1);
+  clause_list_append(&list, &w1, PROP_EVENT_LB);
   EXPECT_EQ(1, list.length);
   EXPECT_EQ(&w1, list.elems[0]);
+  EXPECT_EQ(PROP_EVENT_LB, list.events[0]);
 
-  clause_list_append(&list, &w2);
+  clause_list_append(&list, &w2, PROP_EVENT_ANY);
   EXPECT_EQ(2, list.length);
   EXPECT_EQ(&w1, list.elems[0]);
   EXPECT_EQ(&w2, list.elems[1]);
+  EXPECT_EQ(PROP_EVENT_LB, list.events[0]);
+  EXPECT_EQ(PROP_EVENT_ANY, list.events[1]);
 
-  clause_list_append(&list, &w1);
+  clause_list_append(&list, &w1, PROP_EVENT_UB);
   EXPECT_EQ(3, list.length);
   EXPECT_EQ(&w1, list.elems[0]);
   EXPECT_EQ(&w2, list.elems[1]);
+  EXPECT_EQ(&w1, list.elems[2]);
+  EXPECT_EQ(PROP_EVENT_UB, list.events[2]);
+
+  clause_list_free(&list);
+}
+
+TEST(ClauseList, Subscribe) {
+  struct wand_expr_t w1;
+  struct wand_expr_t w2;
+
+  struct clause_list_t list = { .length = 0, .elems = NULL, .events = NULL };
+
+  clause_list_subscribe(&list, &w1, PROP_EVENT_LB);
+  EXPECT_EQ(1, list.length);
+  EXPECT_EQ(&w1, list.elems[0]);
+  EXPECT_EQ(PROP_EVENT_LB, list.events[0]);
+
+  clause_list_subscribe(&list, &w2, PROP_EVENT_UB);
+  EXPECT_EQ(2, list.length);
+  EXPECT_EQ(&w2, list.elems[1]);
+  EXPECT_EQ(PROP_EVENT_UB, list.events[1]);
+
+  clause_list_subscribe(&list, &w1, PROP_EVENT_UB);
+  EXPECT_EQ(2, list.length);
+  EXPECT_EQ(PROP_EVENT_LB | PROP_EVENT_UB, list.events[0]);
+  EXPECT_EQ(PROP_EVENT_UB, list.events[1]);
+
+  clause_list_free(&list);
+}
+
+TEST(ClauseList, Free) {
+  struct wand_expr_t w1;
+
+  struct clause_list_t list = { .length = 0, .elems = NULL, .events = NULL };
+  clause_list_append(&list, &w1, PROP_EVENT_ANY);
+
+  clause_list_free(&list);
+  EXPECT_EQ(0, list.length);
+  EXPECT_EQ(NULL, list.elems);
+  EXPECT_EQ(NULL, list.events);
+}
+
+TEST(ClauseList, Drop) {
+  struct wand_expr_t w1;
+  struct wand_expr_t w2;
+  struct wand_expr_t w3;
+  struct constr_t c;
+  struct constr_t d;
+  struct wand_expr_t loc = { .constr = &c, .orig = &c, .prop_tag = 0 };
+
+  struct clause_list_t list = { .length = 0, .elems = NULL, .events = NULL, .dead = 0 };
+  clause_list_append(&list, &w1, PROP_EVENT_LB);
+  clause_list_append(&list, &w2, PROP_EVENT_UB);
+  clause_list_append(&list, &w3, PROP_EVENT_ANY);
+
+  patch_init(64);
+
+  MockProxy = new Mock();
+  EXPECT_EQ(0U, clause_list_drop(&list, 2));
+  EXPECT_EQ(1U, list.dead);
+  EXPECT_EQ(&w3, list.elems[0]);
+  EXPECT_EQ(PROP_EVENT_ANY, list.events[0]);
+  EXPECT_EQ(&w1, list.elems[2]);
+  EXPECT_EQ(PROP_EVENT_LB, list.events[2]);
+
+  patch(&loc, &d);
+  EXPECT_EQ(2U, clause_list_drop(&list, 2));
+  EXPECT_EQ(2U, list.dead);
+  EXPECT_EQ(&w1, list.elems[1]);
+  EXPECT_EQ(&w2, list.elems[2]);
+
+  // elements appended later do not disturb restoring the list
+  struct wand_expr_t w4;
+  clause_list_append(&list, &w4, PROP_EVENT_ANY);
+
+  unpatch(1);
+  EXPECT_EQ(&c, loc.constr);
+  EXPECT_EQ(1U, list.dead);
+  EXPECT_EQ(&w3, list.elems[0]);
+  EXPECT_EQ(&w2, list.elems[1]);
+  EXPECT_EQ(&w1, list.elems[2]);
+
+  unpatch(0);
+  EXPECT_EQ(0U, list.dead);
+  EXPECT_EQ(&w1, list.elems[0]);
+  EXPECT_EQ(&w2, list.elems[1]);
+  EXPECT_EQ(&w3, list.elems[2]);
+  EXPECT_EQ(&w4, list.elems[3]);
+  EXPECT_EQ(PROP_EVENT_LB, list.events[0]);
+  EXPECT_EQ(PROP_EVENT_UB, list.events[1]);
+  EXPECT_EQ(PROP_EVENT_ANY, list.events[2]);
+  delete(MockProxy);
+
+  MockProxy = new Mock();
+  _patch_depth = _patch_stack_size;
+  EXPECT_CALL(*MockProxy, print_fatal(ERROR_MSG_TOO_MANY_PATCHES)).Times(1);
+  clause_list_drop(&list, 0);
+  delete(MockProxy);
+
+  _patch_depth = 0;
+  patch_free();
+  clause_list_free(&list);
+}
+
+
+
+TEST(ClauseList, Remove) {
+  struct wand_expr_t w1;
+  struct wand_expr_t w2;
+  struct wand_expr_t w3;
+
+  struct clause_list_t list = { .length = 0, .elems = NULL, .events = NULL, .dead = 0 };
+  clause_list_append(&list, &w1, PROP_EVENT_LB);
+  clause_list_append(&list, &w2, PROP_EVENT_UB);
+  clause_list_append(&list, &w3, PROP_EVENT_ANY);
+
+  clause_list_remove(&list, 0);
+  EXPECT_EQ(2U, list.length);
+  EXPECT_EQ(&w3, list.elems[0]);
+  EXPECT_EQ(PROP_EVENT_ANY, list.events[0]);
+  EXPECT_EQ(&w2, list.elems[1]);
+  EXPECT_EQ(PROP_EVENT_UB, list.events[1]);
+
+  clause_list_remove(&list, 1);
+  EXPECT_EQ(1U, list.length);
+  EXPECT_EQ(&w3, list.elems[0]);
+
+  clause_list_free(&list);
+}
+
+struct wand_expr_t *compact_gone;
+
+bool compact_keep(const struct wand_expr_t *elem) {
+  return elem != compact_gone;
+}
+
+TEST(ClauseList, Compact) {
+  struct wand_expr_t w1;
+  struct wand_expr_t w2;
+  struct wand_expr_t w3;
+  struct wand_expr_t w4;
+  struct wand_expr_t w5;
+
+  struct clause_list_t list = { .length = 0, .elems = NULL, .events = NULL, .dead = 0 };
+  clause_list_append(&list, &w1, PROP_EVENT_LB);
+  clause_list_append(&list, &w2, PROP_EVENT_UB);
+  clause_list_append(&list, &w3, PROP_EVENT_ANY);
+  clause_list_append(&list, &w4, PROP_EVENT_LB);
+  clause_list_append(&list, &w5, PROP_EVENT_UB);
+
+  patch_init(64);
+
+  MockProxy = new Mock();
+  clause_list_drop(&list, 1);
+  clause_list_drop(&list, 4);
+  EXPECT_EQ(2U, list.dead);
+
+  // only live elements are removed
+  compact_gone = &w3;
+  struct clause_list_t *lists [1] = { &list };
+  EXPECT_EQ(1U, clause_lists_compact(lists, 1, compact_keep));
+  EXPECT_EQ(4U, list.length);
+  EXPECT_EQ(2U, list.dead);
+  EXPECT_EQ(&w4, list.elems[2]);
+  EXPECT_EQ(PROP_EVENT_LB, list.events[2]);
+  EXPECT_EQ(&w1, list.elems[3]);
+  EXPECT_EQ(PROP_EVENT_LB, list.events[3]);
+
+  compact_gone = &w2;
+  EXPECT_EQ(0U, clause_lists_compact(lists, 1, compact_keep));
+  EXPECT_EQ(4U, list.length);
+
+  // restoring the list still works on the remapped positions
+  unpatch(0);
+  EXPECT_EQ(0U, list.dead);
+  EXPECT_EQ(&w1, list.elems[0]);
+  EXPECT_EQ(&w2, list.elems[1]);
+  EXPECT_EQ(&w4, list.elems[2]);
+  EXPECT_EQ(&w5, list.elems[3]);
+  EXPECT_EQ(PROP_EVENT_LB, list.events[0]);
+  EXPECT_EQ(PROP_EVENT_UB, list.events[1]);
+  EXPECT_EQ(PROP_EVENT_LB, list.events[2]);
+  EXPECT_EQ(PROP_EVENT_UB, list.events[3]);
+  delete(MockProxy);
+
+  _patch_depth = 0;
+  patch_free();
+  clause_list_free(&list);
 }
 
 } // end namespace
@@ -0,0 +1,221 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+namespace solver_clone {
+#include "../src/constr_types.c"
+#include "../src/clone.c"
+
+bool operator==(const struct val_t& lhs, const struct val_t& rhs) {
+  return memcmp(&lhs, &rhs, sizeof(lhs)) == 0;
+}
+
+class Mock {
+ public:
+  MOCK_METHOD1(alloc, void *(size_t));
+  MOCK_METHOD1(print_fatal, void (const char *));
+#define CONSTR_TYPE_MOCKS(UPNAME, NAME, OP) \
+  MOCK_METHOD1(eval_ ## NAME, struct val_t(const struct constr_t *)); \
+  MOCK_METHOD3(propagate_ ## NAME, prop_result_t(struct constr_t *, struct val_t, const struct wand_expr_t *)); \
+  MOCK_METHOD1(normal_ ## NAME, struct constr_t *(struct constr_t *));
+  CONSTR_TYPE_LIST(CONSTR_TYPE_MOCKS)
+};
+
+Mock *MockProxy;
+
+void *alloc(size_t size) {
+  return MockProxy->alloc(size);
+}
+
+void print_fatal(const char *fmt, ...) {
+  MockProxy->print_fatal(fmt);
+}
+
+#define CONSTR_TYPE_CMOCKS(UPNAME, NAME, OP)                            \
+struct val_t eval_ ## NAME(const struct constr_t *constr) {       \
+  return MockProxy->eval_ ## NAME(constr);                              \
+}                                                                       \
+prop_result_t propagate_ ## NAME(struct constr_t *constr, struct val_t val, const struct wand_expr_t *clause) { \
+  return MockProxy->propagate_ ## NAME(constr, val, clause);            \
+}                                                                       \
+struct constr_t *normal_ ## NAME(struct constr_t *constr) {             \
+  return MockProxy->normal_ ## NAME(constr);                            \
+}
+CONSTR_TYPE_LIST(CONSTR_TYPE_CMOCKS)
+
+static char _test_stack[1 << 16];
+static size_t _test_stack_ptr;
+
+void *test_alloc(size_t size) {
+  void *retval = &_test_stack[_test_stack_ptr];
+  _test_stack_ptr += (size + sizeof(void *) - 1) & ~(sizeof(void *) - 1);
+  return retval;
+}
+
+TEST(CloneMap, Basic) {
+  struct constr_t A, B, C, X, Y;
+  struct clone_map_t map;
+  clone_map_init(&map, 4);
+  EXPECT_EQ(4U, map.size);
+  EXPECT_EQ(0U, map.length);
+
+  clone_map_add(&map, &A, &X);
+  clone_map_add(&map, &B, &Y);
+  EXPECT_EQ(&X, clone_map_find(&map, &A));
+  EXPECT_EQ(&Y, clone_map_find(&map, &B));
+  EXPECT_EQ((struct constr_t *)NULL, clone_map_find(&map, &C));
+  EXPECT_EQ(4U, map.size);
+  EXPECT_EQ(2U, map.length);
+
+  clone_map_free(&map);
+  EXPECT_EQ((struct clone_entry_t *)NULL, map.elems);
+}
+
+TEST(CloneMap, Grow) {
+  struct constr_t keys[100];
+  struct constr_t vals[100];
+  struct clone_map_t map;
+  clone_map_init(&map, 4);
+
+  for (size_t i = 0; i < 100; i++) {
+    clone_map_add(&map, &keys[i], &vals[i]);
+  }
+  EXPECT_EQ(256U, map.size);
+  EXPECT_EQ(100U, map.length);
+  for (size_t i = 0; i < 100; i++) {
+    EXPECT_EQ(&vals[i], clone_map_find(&map, &keys[i]));
+  }
+
+  clone_map_free(&map);
+}
+
+TEST(SolverClone, Env) {
+  struct env_t env[2];
+  struct constr_t A = CONSTRAINT_TERM(INTERVAL(1, 5));
+  struct constr_t B = CONSTRAINT_TERM(VALUE(3));
+  env[0] = { .key = "a", .val = &A, .binds = NULL,
+             .clauses = { .length = 0, .elems = NULL },
+             .order = 1, .prio = 7, .level = 2 };
+  env[1] = { .key = "b", .val = &B, .binds = NULL,
+             .clauses = { .length = 0, .elems = NULL },
+             .order = 0, .prio = 3, .level = 1 };
+  A.constr.term.env = &env[0];
+  B.constr.term.env = &env[1];
+  struct constr_t X = CONSTRAINT_EXPR(LT, &A, &B);
+
+  struct solver_t src = { .size = 2, .env = env, .constr = &X, .obj = &B };
+  struct solver_t dst;
+  struct constr_t O;
+
+  _test_stack_ptr = 0;
+  MockProxy = new Mock();
+  EXPECT_CALL(*MockProxy, alloc(testing::_))
+    .WillRepeatedly(testing::Invoke(test_alloc));
+  solver_clone(&dst, &src, &O);
+  delete(MockProxy);
+
+  EXPECT_EQ(2U, dst.size);
+  EXPECT_NE(env, dst.env);
+  for (size_t i = 0; i < 2; i++) {
+    EXPECT_EQ(env[i].key, dst.env[i].key);
+    EXPECT_EQ(env[i].val->constr.term.val, dst.env[i].val->constr.term.val);
+    EXPECT_NE(env[i].val, dst.env[i].val);
+    EXPECT_EQ(&dst.env[i], dst.env[i].val->constr.term.env);
+    EXPECT_EQ(env[i].prio, dst.env[i].prio);
+    EXPECT_EQ(SIZE_MAX, dst.env[i].order);
+    EXPECT_EQ(SIZE_MAX, dst.env[i].level);
+    EXPECT_EQ(0U, dst.env[i].clauses.length);
+  }
+  EXPECT_EQ(&O, dst.obj);
+  EXPECT_EQ(&O, dst.env[1].val);
+
+  EXPECT_NE(&X, dst.constr);
+  EXPECT_EQ(&CONSTR_LT, dst.constr->type);
+  EXPECT_EQ(dst.env[0].val, dst.constr->constr.expr.l);
+  EXPECT_EQ(dst.env[1].val, dst.constr->constr.expr.r);
+}
+
+TEST(SolverClone, Shared) {
+  struct env_t env[1];
+  struct constr_t A = CONSTRAINT_TERM(INTERVAL(1, 5));
+  env[0] = { .key = "a", .val = &A, .binds = NULL,
+             .clauses = { .length = 0, .elems = NULL },
+             .order = 0, .prio = 0, .level = 0 };
+  A.constr.term.env = &env[0];
+  struct constr_t C = CONSTRAINT_TERM(VALUE(2));
+  struct constr_t N = CONSTRAINT_EXPR(NEG, &A, NULL);
+  struct constr_t X = CONSTRAINT_EXPR(LT, &N, &C);
+  struct constr_t Y = CONSTRAINT_EXPR(EQ, &N, &C);
+  struct wand_expr_t elems[2] = { { .constr = &X, .orig = &A, .prop_tag = 17 },
+                                  { .constr = &Y, .orig = &Y, .prop_tag = 0 } };
+  struct constr_t W = CONSTRAINT_WAND(2, elems);
+
+  struct solver_t src = { .size = 1, .env = env, .constr = &W, .obj = NULL };
+  struct solver_t dst;
+
+  _test_stack_ptr = 0;
+  MockProxy = new Mock();
+  EXPECT_CALL(*MockProxy, alloc(testing::_))
+    .WillRepeatedly(testing::Invoke(test_alloc));
+  solver_clone(&dst, &src, NULL);
+  delete(MockProxy);
+
+  EXPECT_EQ((struct constr_t *)NULL, dst.obj);
+
+  struct constr_t *w = dst.constr;
+  EXPECT_EQ(&CONSTR_WAND, w->type);
+  EXPECT_EQ(2U, w->constr.wand.length);
+  for (size_t i = 0; i < 2; i++) {
+    EXPECT_EQ(w->constr.wand.elems[i].constr, w->constr.wand.elems[i].orig);
+    EXPECT_EQ(0U, w->constr.wand.elems[i].prop_tag);
+  }
+
+  struct constr_t *x = w->constr.wand.elems[0].constr;
+  struct constr_t *y = w->constr.wand.elems[1].constr;
+  EXPECT_EQ(&CONSTR_LT, x->type);
+  EXPECT_EQ(&CONSTR_EQ, y->type);
+  // common sub-expressions stay shared
+  EXPECT_EQ(x->constr.expr.l, y->constr.expr.l);
+  EXPECT_EQ(x->constr.expr.r, y->constr.expr.r);
+  EXPECT_NE(&N, x->constr.expr.l);
+  EXPECT_NE(&C, x->constr.expr.r);
+  EXPECT_EQ(VALUE(2), x->constr.expr.r->constr.term.val);
+  EXPECT_EQ(dst.env[0].val, x->constr.expr.l->constr.expr.l);
+  EXPECT_EQ((struct constr_t *)NULL, x->constr.expr.l->constr.expr.r);
+}
+
+TEST(SolverClone, Confl) {
+  struct env_t env[2];
+  struct constr_t A = CONSTRAINT_TERM(INTERVAL(1, 5));
+  struct constr_t B = CONSTRAINT_TERM(INTERVAL(0, 1));
+  env[0] = { .key = "a", .val = &A, .binds = NULL,
+             .clauses = { .length = 0, .elems = NULL },
+             .order = 0, .prio = 0, .level = 0 };
+  env[1] = { .key = "b", .val = &B, .binds = NULL,
+             .clauses = { .length = 0, .elems = NULL },
+             .order = 0, .prio = 0, .level = 0 };
+  A.constr.term.env = &env[0];
+  B.constr.term.env = &env[1];
+  struct confl_elem_t elems[2] = { { .val = VALUE(3), .var = &A },
+                                   { .val = VALUE(1), .var = &B } };
+  struct constr_t X = CONSTRAINT_CONFL(2, elems);
+
+  struct solver_t src = { .size = 2, .env = env, .constr = &X, .obj = NULL };
+  struct solver_t dst;
+
+  _test_stack_ptr = 0;
+  MockProxy = new Mock();
+  EXPECT_CALL(*MockProxy, alloc(testing::_))
+    .WillRepeatedly(testing::Invoke(test_alloc));
+  solver_clone(&dst, &src, NULL);
+  delete(MockProxy);
+
+  EXPECT_EQ(&CONSTR_CONFL, dst.constr->type);
+  EXPECT_EQ(2U, dst.constr->constr.confl.length);
+  EXPECT_NE(elems, dst.constr->constr.confl.elems);
+  EXPECT_EQ(VALUE(3), dst.constr->constr.confl.elems[0].val);
+  EXPECT_EQ(dst.env[0].val, dst.constr->constr.confl.elems[0].var);
+  EXPECT_EQ(VALUE(1), dst.constr->constr.confl.elems[1].val);
+  EXPECT_EQ(dst.env[1].val, dst.constr->constr.confl.elems[1].var);
+}
+
+}
@@ -0,0 +1,235 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+namespace compile {
+#include "../src/arith.c"
+#include "../src/constr_types.c"
+#include "../src/eval.c"
+#include "../src/compile.c"
+
+bool operator==(const struct val_t& lhs, const struct val_t& rhs) {
+  return memcmp(&lhs, &rhs, sizeof(lhs)) == 0;
+}
+
+class Mock {
+ public:
+  MOCK_METHOD1(alloc, void *(size_t));
+  MOCK_METHOD1(dealloc, void (void *));
+  MOCK_METHOD1(print_fatal, void (const char *));
+#define CONSTR_TYPE_MOCKS(UPNAME, NAME, OP) \
+  MOCK_METHOD3(propagate_ ## NAME, prop_result_t(struct constr_t *, const struct val_t, const struct wand_expr_t *)); \
+  MOCK_METHOD1(normal_ ## NAME, struct constr_t *(struct constr_t *));
+  CONSTR_TYPE_LIST(CONSTR_TYPE_MOCKS)
+};
+
+Mock *MockProxy;
+
+void *alloc(size_t size) {
+  return MockProxy->alloc(size);
+}
+
+void dealloc(void *elem) {
+  MockProxy->dealloc(elem);
+}
+
+void print_fatal(const char *fmt, ...) {
+  MockProxy->print_fatal(fmt);
+}
+
+#define CONSTR_TYPE_CMOCKS(UPNAME, NAME, OP)                            \
+prop_result_t propagate_ ## NAME(struct constr_t *constr, struct val_t val, const struct wand_expr_t *clause) { \
+  return MockProxy->propagate_ ## NAME(constr, val, clause);            \
+}                                                                       \
+struct constr_t *normal_ ## NAME(struct constr_t *constr) {             \
+  return MockProxy->normal_ ## NAME(constr);                            \
+}
+CONSTR_TYPE_LIST(CONSTR_TYPE_CMOCKS)
+
+static char _test_stack[1 << 12];
+static size_t _test_stack_ptr;
+
+void *test_alloc(size_t size) {
+  void *retval = &_test_stack[_test_stack_ptr];
+  _test_stack_ptr += (size + sizeof(void *) - 1) & ~(sizeof(void *) - 1);
+  return retval;
+}
+
+// clause x + y + z + w - v = 40 over five variables
+class CompileTest : public testing::Test {
+ protected:
+  struct env_t env[5];
+  struct constr_t vars[5];
+  struct constr_t C, N, A1, A2, A3, A4, X;
+
+  void SetUp() {
+    MockProxy = new Mock();
+    _test_stack_ptr = 0;
+    for (size_t i = 0; i < 5; i++) {
+      vars[i] = CONSTRAINT_TERM(INTERVAL(0, 10));
+      vars[i].constr.term.env = &env[i];
+      env[i].val = &vars[i];
+    }
+    C = CONSTRAINT_TERM(VALUE(40));
+    A1 = CONSTRAINT_EXPR(ADD, &vars[0], &vars[1]);
+    A2 = CONSTRAINT_EXPR(ADD, &A1, &vars[2]);
+    A3 = CONSTRAINT_EXPR(ADD, &A2, &vars[3]);
+    N = CONSTRAINT_EXPR(NEG, &vars[4], NULL);
+    A4 = CONSTRAINT_EXPR(ADD, &A3, &N);
+    X = CONSTRAINT_EXPR(EQ, &A4, &C);
+    compile_init(env);
+  }
+
+  void TearDown() {
+    compile_free();
+    delete(MockProxy);
+  }
+};
+
+TEST_F(CompileTest, Layout) {
+  EXPECT_CALL(*MockProxy, alloc(testing::_))
+    .WillRepeatedly(testing::Invoke(test_alloc));
+
+  struct code_t *code = compile(&X);
+  ASSERT_NE((struct code_t *)NULL, code);
+  EXPECT_EQ(12U, code->length);
+
+  const enum opcode_t ops[] = { OPC_VAR, OPC_VAR, OPC_ADD, OPC_VAR, OPC_ADD, OPC_VAR, OPC_ADD,
+                                OPC_VAR, OPC_NEG, OPC_ADD, OPC_CONST, OPC_EQ };
+  const size_t sizes[] = { 1, 1, 3, 1, 5, 1, 7, 1, 2, 10, 1, 12 };
+  for (size_t i = 0; i < 12; i++) {
+    EXPECT_EQ(ops[i], code->instrs[i].op);
+    EXPECT_EQ(sizes[i], code->instrs[i].size);
+  }
+  EXPECT_EQ(0U, code->instrs[0].arg.var);
+  EXPECT_EQ(1U, code->instrs[1].arg.var);
+  EXPECT_EQ(0U, code->instrs[2].arg.left);
+  EXPECT_EQ(2U, code->instrs[4].arg.left);
+  EXPECT_EQ(4U, code->instrs[6].arg.left);
+  EXPECT_EQ(4U, code->instrs[7].arg.var);
+  EXPECT_EQ(7U, code->instrs[8].arg.left);
+  EXPECT_EQ(6U, code->instrs[9].arg.left);
+  EXPECT_EQ(VALUE(40), code->instrs[10].arg.val);
+  EXPECT_EQ(9U, code->instrs[11].arg.left);
+}
+
+TEST_F(CompileTest, NotCompiled) {
+  struct constr_t Y = CONSTRAINT_EXPR(NOT, &A1, NULL);
+  struct wand_expr_t elems[1] = { { &X, &X, 0, NULL } };
+  struct constr_t W = CONSTRAINT_WAND(1, elems);
+  struct constr_t Z = CONSTRAINT_EXPR(AND, &W, &X);
+  struct constr_t D = CONSTRAINT_TERM(INTERVAL(0, 40));
+  struct constr_t V = CONSTRAINT_EXPR(EQ, &A4, &D);
+
+  // terminals and small clauses are left as they are
+  EXPECT_EQ((struct code_t *)NULL, compile(&vars[0]));
+  EXPECT_EQ((struct code_t *)NULL, compile(&Y));
+  // wide-and expressions and non-value constants are not compiled
+  EXPECT_EQ((struct code_t *)NULL, compile(&W));
+  EXPECT_EQ((struct code_t *)NULL, compile(&Z));
+  EXPECT_EQ((struct code_t *)NULL, compile(&V));
+}
+
+TEST_F(CompileTest, Clauses) {
+  EXPECT_CALL(*MockProxy, alloc(testing::_))
+    .WillRepeatedly(testing::Invoke(test_alloc));
+
+  struct constr_t Y = CONSTRAINT_EXPR(NOT, &A1, NULL);
+  struct wand_expr_t inner[2] = { { &Y, &Y, 0, NULL }, { &X, &X, 0, NULL } };
+  struct constr_t W = CONSTRAINT_WAND(2, inner);
+  struct wand_expr_t outer[2] = { { &X, &X, 0, NULL }, { &W, &W, 0, NULL } };
+  struct constr_t V = CONSTRAINT_WAND(2, outer);
+
+  compile_clauses(&V);
+  EXPECT_NE((const struct code_t *)NULL, outer[0].code);
+  EXPECT_EQ((const struct code_t *)NULL, outer[1].code);
+  EXPECT_EQ((const struct code_t *)NULL, inner[0].code);
+  EXPECT_NE((const struct code_t *)NULL, inner[1].code);
+}
+
+TEST_F(CompileTest, Eval) {
+  EXPECT_CALL(*MockProxy, alloc(testing::_))
+    .WillRepeatedly(testing::Invoke(test_alloc));
+
+  struct code_t *code = compile(&X);
+  ASSERT_NE((struct code_t *)NULL, code);
+  EXPECT_EQ(INTERVAL(0, 1), code_eval(code));
+  EXPECT_EQ(X.type->eval(&X), code_eval(code));
+
+  for (size_t i = 0; i < 4; i++) {
+    vars[i].constr.term.val = VALUE(10);
+  }
+  EXPECT_EQ(INTERVAL(0, 1), code_eval(code));
+  vars[4].constr.term.val = VALUE(0);
+  eval_invalidate();
+  EXPECT_EQ(VALUE(1), code_eval(code));
+  EXPECT_EQ(X.type->eval(&X), code_eval(code));
+  vars[0].constr.term.val = VALUE(9);
+  eval_invalidate();
+  EXPECT_EQ(VALUE(0), code_eval(code));
+  EXPECT_EQ(X.type->eval(&X), code_eval(code));
+}
+
+TEST_F(CompileTest, Propagate) {
+  EXPECT_CALL(*MockProxy, alloc(testing::_))
+    .WillRepeatedly(testing::Invoke(test_alloc));
+
+  struct code_t *code = compile(&X);
+  ASSERT_NE((struct code_t *)NULL, code);
+
+  // operands see the values from before propagating
+  struct wand_expr_t clause = { &X, &X, 0, code };
+  testing::InSequence s;
+  EXPECT_CALL(*MockProxy, propagate_term(&vars[4], INTERVAL(-40, 0), &clause))
+    .WillOnce(testing::Return(1));
+  EXPECT_CALL(*MockProxy, propagate_term(&vars[3], INTERVAL(10, 50), &clause))
+    .WillOnce(testing::Return(1));
+  EXPECT_CALL(*MockProxy, propagate_term(&vars[2], INTERVAL(10, 50), &clause))
+    .WillOnce(testing::Return(1));
+  EXPECT_CALL(*MockProxy, propagate_term(&vars[1], INTERVAL(10, 50), &clause))
+    .WillOnce(testing::Return(1));
+  EXPECT_CALL(*MockProxy, propagate_term(&vars[0], INTERVAL(10, 50), &clause))
+    .WillOnce(testing::Return(PROP_NONE));
+  EXPECT_EQ(4, code_propagate(code, &clause));
+}
+
+TEST_F(CompileTest, PropagateError) {
+  EXPECT_CALL(*MockProxy, alloc(testing::_))
+    .WillRepeatedly(testing::Invoke(test_alloc));
+
+  struct code_t *code = compile(&X);
+  ASSERT_NE((struct code_t *)NULL, code);
+
+  // errors stop propagation
+  struct wand_expr_t clause = { &X, &X, 0, code };
+  EXPECT_CALL(*MockProxy, propagate_term(&vars[4], INTERVAL(-40, 0), &clause))
+    .WillOnce(testing::Return(PROP_ERROR));
+  EXPECT_EQ(PROP_ERROR, code_propagate(code, &clause));
+
+  // constants conflict if they are outside the propagated value
+  C = CONSTRAINT_TERM(VALUE(100));
+  code = compile(&X);
+  ASSERT_NE((struct code_t *)NULL, code);
+  EXPECT_EQ(PROP_ERROR, code_propagate(code, &clause));
+}
+
+TEST_F(CompileTest, PropagateFalse) {
+  EXPECT_CALL(*MockProxy, alloc(testing::_))
+    .WillRepeatedly(testing::Invoke(test_alloc));
+
+  // x + y + z + w - v != 40 restricts the upper bound
+  struct constr_t Y = CONSTRAINT_EXPR(NOT, &X, NULL);
+  struct code_t *code = compile(&Y);
+  ASSERT_NE((struct code_t *)NULL, code);
+
+  for (size_t i = 0; i < 4; i++) {
+    vars[i].constr.term.val = VALUE(10);
+  }
+  vars[4].constr.term.val = INTERVAL(0, 1);
+
+  struct wand_expr_t clause = { &Y, &Y, 0, code };
+  EXPECT_CALL(*MockProxy, propagate_term(&vars[4], INTERVAL(1, DOMAIN_MAX), &clause))
+    .WillOnce(testing::Return(PROP_ERROR));
+  EXPECT_EQ(PROP_ERROR, code_propagate(code, &clause));
+}
+
+}
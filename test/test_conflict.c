@@ -14,7 +14,13 @@ class Mock {
  public:
   MOCK_METHOD1(print_fatal, void (const char *));
   MOCK_METHOD0(bind_level_get, size_t (void));
-  MOCK_METHOD2(clause_list_append, void (struct clause_list_t *,  struct wand_expr_t *));
+  MOCK_METHOD0(bind_depth, size_t (void));
+  MOCK_METHOD1(bind_get, const struct binding_t *(size_t));
+  MOCK_METHOD1(propagate_watch, void (struct wand_expr_t *));
+  MOCK_METHOD1(sema_wait, void(sem_t *));
+  MOCK_METHOD1(sema_post, void(sem_t *));
+  MOCK_METHOD1(bind_relocate, void(relocate_t));
+  MOCK_METHOD3(clause_lists_compact, size_t(struct clause_list_t **, size_t, bool (*)(const struct wand_expr_t *)));
 #define CONSTR_TYPE_MOCKS(UPNAME, NAME, OP) \
   MOCK_METHOD1(eval_ ## NAME, struct val_t(const struct constr_t *)); \
   MOCK_METHOD3(propagate_ ## NAME, prop_result_t(struct constr_t *, struct val_t, const struct wand_expr_t *)); \
@@ -24,15 +30,45 @@ class Mock {
 
 Mock *MockProxy;
 
-uint64_t calloc_max;
-uint64_t confl;
+THREAD_LOCAL uint64_t calloc_max;
+THREAD_LOCAL uint64_t confl;
 
 size_t bind_level_get(void) {
   return MockProxy->bind_level_get();
 }
 
-void clause_list_append(struct clause_list_t *list, struct wand_expr_t *elem) {
-  MockProxy->clause_list_append(list, elem);
+size_t bind_depth(void) {
+  return MockProxy->bind_depth();
+}
+
+const struct binding_t *bind_get(size_t depth) {
+  return MockProxy->bind_get(depth);
+}
+
+void propagate_watch(struct wand_expr_t *clause) {
+  MockProxy->propagate_watch(clause);
+}
+
+void sema_wait(sem_t *sema) {
+  MockProxy->sema_wait(sema);
+}
+
+void sema_post(sem_t *sema) {
+  MockProxy->sema_post(sema);
+}
+
+void bind_relocate(relocate_t relocate) {
+  MockProxy->bind_relocate(relocate);
+}
+
+size_t clause_lists_compact(struct clause_list_t **lists, size_t count, bool (*keep)(const struct wand_expr_t *)) {
+  return MockProxy->clause_lists_compact(lists, count, keep);
+}
+
+struct shared_t _shared;
+
+struct shared_t *shared(void) {
+  return &_shared;
 }
 
 void print_fatal(const char *fmt, ...) {
@@ -128,6 +164,25 @@ TEST(ConflictDealloc, Fail) {
   delete(MockProxy);
 }
 
+TEST(ConflictAllocRelease, Success) {
+  conflict_alloc_init(1024);
+  _alloc_stack_pointer = 64;
+  EXPECT_EQ(64U, conflict_alloc_depth());
+  conflict_alloc_release(24);
+  EXPECT_EQ(24U, _alloc_stack_pointer);
+  EXPECT_EQ(24U, conflict_alloc_depth());
+}
+
+TEST(ConflictAllocRelease, Fail) {
+  conflict_alloc_init(1024);
+  _alloc_stack_pointer = 24;
+
+  MockProxy = new Mock();
+  EXPECT_CALL(*MockProxy, print_fatal(ERROR_MSG_WRONG_DEALLOC)).Times(1);
+  conflict_alloc_release(64);
+  delete(MockProxy);
+}
+
 TEST(ConflictLevel, Basic) {
   _conflict_level = 77;
   EXPECT_EQ(77, conflict_level());
@@ -156,52 +211,43 @@ TEST(ConflictReset, Basic) {
 }
 
 TEST(ConflictSeen, Basic) {
-  struct constr_t c1;
-  struct constr_t c2;
-  struct env_t v1;
-  struct env_t v2;
+  struct constr_t c1 = CONSTRAINT_TERM(VALUE(0));
+  struct constr_t c2 = CONSTRAINT_TERM(VALUE(1));
+  struct env_t v1 = { .key = NULL, .val = &c1, .binds = NULL,
+                      .clauses = { .length = 0, .elems = NULL },
+                      .order = 0, .prio = 0, .level = 0 };
+  struct env_t v2 = { .key = NULL, .val = &c2, .binds = NULL,
+                      .clauses = { .length = 0, .elems = NULL },
+                      .order = 0, .prio = 0, .level = 0 };
 
   conflict_seen_reset();
 
   EXPECT_EQ(conflict_seen(&c1), false);
   EXPECT_EQ(conflict_seen(&c2), false);
-  EXPECT_EQ(conflict_seen(&v1), false);
-  EXPECT_EQ(conflict_seen(&v2), false);
+  EXPECT_EQ(conflict_var_seen(&v1), false);
+  EXPECT_EQ(conflict_var_seen(&v2), false);
 
-  EXPECT_EQ(conflict_seen_add(&c1), CONFL_OK);
+  conflict_seen_add(&c1);
 
   EXPECT_EQ(conflict_seen(&c1), true);
   EXPECT_EQ(conflict_seen(&c2), false);
-  EXPECT_EQ(conflict_seen(&v1), false);
-  EXPECT_EQ(conflict_seen(&v2), false);
+  EXPECT_EQ(conflict_var_seen(&v1), false);
+  EXPECT_EQ(conflict_var_seen(&v2), false);
 
-  EXPECT_EQ(conflict_seen_add(&c2), CONFL_OK);
+  conflict_var_seen_add(&v2);
 
   EXPECT_EQ(conflict_seen(&c1), true);
-  EXPECT_EQ(conflict_seen(&c2), true);
-  EXPECT_EQ(conflict_seen(&v1), false);
-  EXPECT_EQ(conflict_seen(&v2), false);
-
-  EXPECT_EQ(conflict_seen_add(&v1), CONFL_OK);
-
-  EXPECT_EQ(conflict_seen(&c1), true);
-  EXPECT_EQ(conflict_seen(&c2), true);
-  EXPECT_EQ(conflict_seen(&v1), true);
-  EXPECT_EQ(conflict_seen(&v2), false);
-
-  EXPECT_EQ(conflict_seen_add(&v2), CONFL_OK);
-
-  EXPECT_EQ(conflict_seen(&c1), true);
-  EXPECT_EQ(conflict_seen(&c2), true);
-  EXPECT_EQ(conflict_seen(&v1), true);
-  EXPECT_EQ(conflict_seen(&v2), true);
+  EXPECT_EQ(conflict_seen(&c2), false);
+  EXPECT_EQ(conflict_var_seen(&v1), false);
+  EXPECT_EQ(conflict_var_seen(&v2), true);
 
+  // starting a new epoch forgets everything at once
   conflict_seen_reset();
 
   EXPECT_EQ(conflict_seen(&c1), false);
   EXPECT_EQ(conflict_seen(&c2), false);
-  EXPECT_EQ(conflict_seen(&v1), false);
-  EXPECT_EQ(conflict_seen(&v2), false);
+  EXPECT_EQ(conflict_var_seen(&v1), false);
+  EXPECT_EQ(conflict_var_seen(&v2), false);
 }
 
 TEST(ConflictAddTerm, Basic) {
@@ -219,226 +265,313 @@ TEST(ConflictAddTerm, Basic) {
 
   struct constr_t confl = CONSTRAINT_CONFL(0, NULL);
 
+  conflict_seen_reset();
   _conflict_max_level = 0;
-  EXPECT_EQ(CONFL_OK, conflict_add_term(&confl, &c1));
+  EXPECT_EQ(CONFL_OK, conflict_add_term(&confl, &c1, c1.constr.term.val));
   EXPECT_EQ(1, confl.constr.confl.length);
   EXPECT_EQ(&c1, confl.constr.confl.elems[0].var);
   EXPECT_EQ(VALUE(0), confl.constr.confl.elems[0].val);
   EXPECT_EQ(_conflict_max_level, 23);
 
-  EXPECT_EQ(CONFL_OK, conflict_add_term(&confl, &c2));
+  EXPECT_EQ(CONFL_OK, conflict_add_term(&confl, &c2, c2.constr.term.val));
   EXPECT_EQ(2, confl.constr.confl.length);
   EXPECT_EQ(&c1, confl.constr.confl.elems[0].var);
   EXPECT_EQ(VALUE(0), confl.constr.confl.elems[0].val);
   EXPECT_EQ(&c2, confl.constr.confl.elems[1].var);
   EXPECT_EQ(VALUE(1), confl.constr.confl.elems[1].val);
   EXPECT_EQ(_conflict_max_level, 23);
-}
 
-TEST(ConflictAddTerm, Error) {
-  struct constr_t c = CONSTRAINT_TERM(INTERVAL(0, 1));
-  struct constr_t d = CONSTRAINT_TERM(VALUE(2));
-  struct constr_t e = CONSTRAINT_TERM(VALUE(-3));
+  // variables are added only once
+  EXPECT_EQ(CONFL_OK, conflict_add_term(&confl, &c1, c1.constr.term.val));
+  EXPECT_EQ(2, confl.constr.confl.length);
+}
 
+TEST(ConflictAddTerm, Bounds) {
   struct constr_t confl = CONSTRAINT_CONFL(0, NULL);
 
-  EXPECT_EQ(CONFL_ERROR, conflict_add_term(&confl, &c));
-  EXPECT_EQ(CONFL_ERROR, conflict_add_term(&confl, &d));
-  EXPECT_EQ(CONFL_ERROR, conflict_add_term(&confl, &e));
+  // values inside the domain would make for x = v literals
+  struct binding_t b = { .var = NULL, .val = INTERVAL(0, 4),
+                         .level = SIZE_MAX, .clause = NULL, .prev = NULL };
+  struct constr_t f = CONSTRAINT_TERM(VALUE(1));
+  struct env_t v =  { .key = NULL, .val = &f, .binds = &b,
+                      .clauses = { .length = 0, .elems = NULL },
+                      .order = 0, .prio = 0, .level = 23 };
+  f.constr.term.env = &v;
+  _conflict_max_level = 0;
+  _conflict_backjump = true;
+  EXPECT_EQ(CONFL_ERROR, conflict_add_term(&confl, &f, f.constr.term.val));
+  EXPECT_EQ(0, confl.constr.confl.length);
+
+  // bounds of the original domain are left open
+  b.val = INTERVAL(1, 4);
+  conflict_seen_reset();
+  EXPECT_EQ(CONFL_OK, conflict_add_term(&confl, &f, f.constr.term.val));
+  EXPECT_EQ(1, confl.constr.confl.length);
+  EXPECT_EQ(&f, confl.constr.confl.elems[0].var);
+  EXPECT_EQ(INTERVAL(DOMAIN_MIN, 1), confl.constr.confl.elems[0].val);
+  EXPECT_EQ(23, _conflict_max_level);
+  EXPECT_EQ(false, _conflict_backjump);
+
+  // bounds from different levels result in separate literals
+  struct binding_t c = { .var = NULL, .val = INTERVAL(1, 4),
+                         .level = 17, .clause = NULL, .prev = &b };
+  b.val = INTERVAL(0, 4);
+  v.binds = &c;
+  confl = CONSTRAINT_CONFL(0, NULL);
+  conflict_seen_reset();
+  EXPECT_EQ(CONFL_OK, conflict_add_term(&confl, &f, f.constr.term.val));
+  EXPECT_EQ(2, confl.constr.confl.length);
+  EXPECT_EQ(INTERVAL(1, DOMAIN_MAX), confl.constr.confl.elems[0].val);
+  EXPECT_EQ(INTERVAL(DOMAIN_MIN, 1), confl.constr.confl.elems[1].val);
+  EXPECT_EQ(17, conflict_elem_level(&confl.constr.confl.elems[0]));
+  EXPECT_EQ(23, conflict_elem_level(&confl.constr.confl.elems[1]));
+
+  // variables with their original value are skipped
+  struct constr_t g = CONSTRAINT_TERM(INTERVAL(0, 4));
+  struct env_t w =  { .key = NULL, .val = &g, .binds = &b,
+                      .clauses = { .length = 0, .elems = NULL },
+                      .order = 0, .prio = 0, .level = 23 };
+  g.constr.term.env = &w;
+  EXPECT_EQ(CONFL_OK, conflict_add_term(&confl, &g, g.constr.term.val));
+  EXPECT_EQ(2, confl.constr.confl.length);
 }
 
- TEST(ConflictAddConstrTerm, Basic) {
+TEST(ConflictAddConstrTerm, Basic) {
   struct constr_t c1 = CONSTRAINT_TERM(VALUE(0));
-  struct env_t var1 =  { .key = NULL, .val = &c1, .binds = NULL,
-                         .clauses = { .length = 0, .elems = NULL },
-                         .order = 0, .prio = 0, .level = 17 };
   c1.constr.term.env = NULL;
 
+  struct binding_t b2 = { .var = NULL, .val = INTERVAL(0, 1),
+                          .level = SIZE_MAX, .clause = NULL, .prev = NULL };
   struct constr_t c2 = CONSTRAINT_TERM(VALUE(1));
-  struct env_t var2 =  { .key = NULL, .val = &c2, .binds = NULL,
+  struct env_t var2 =  { .key = NULL, .val = &c2, .binds = &b2,
                          .clauses = { .length = 0, .elems = NULL },
                          .order = 0, .prio = 0, .level = 23 };
   c2.constr.term.env = &var2;
 
-  struct binding_t b3 = { .var = NULL, .val = INTERVAL(DOMAIN_MIN, DOMAIN_MAX),
-                          .level = SIZE_MAX, .clause = NULL, .prev = NULL };
-  struct constr_t c3 = CONSTRAINT_TERM(VALUE(1));
-  struct env_t var3 =  { .key = NULL, .val = &c3, .binds = &b3,
+  struct constr_t c3 = CONSTRAINT_TERM(INTERVAL(0, 1));
+  struct env_t var3 =  { .key = NULL, .val = &c3, .binds = NULL,
                          .clauses = { .length = 0, .elems = NULL },
-                         .order = 0, .prio = 0, .level = 23 };
+                         .order = 0, .prio = 0, .level = SIZE_MAX };
   c3.constr.term.env = &var3;
 
-  struct constr_t constr = CONSTRAINT_TERM(INTERVAL(DOMAIN_MIN, DOMAIN_MAX));
-  struct wand_expr_t cl = { &constr, &constr, 0 };
-  struct binding_t b4 = { .var = NULL, .val = INTERVAL(DOMAIN_MIN, DOMAIN_MAX),
-                          .level = SIZE_MAX, .clause = &cl, .prev = NULL };
+  struct binding_t b4 = { .var = NULL, .val = INTERVAL(0, 1),
+                          .level = SIZE_MAX, .clause = NULL, .prev = NULL };
   struct constr_t c4 = CONSTRAINT_TERM(VALUE(1));
   struct env_t var4 =  { .key = NULL, .val = &c4, .binds = &b4,
                          .clauses = { .length = 0, .elems = NULL },
-                         .order = 0, .prio = 0, .level = 23 };
+                         .order = 0, .prio = 0, .level = SIZE_MAX };
   c4.constr.term.env = &var4;
 
   struct constr_t confl = CONSTRAINT_CONFL(0, NULL);
 
+  conflict_seen_reset();
+  _conflict_bind = NULL;
+  _conflict_pending = 0;
+
+  // constants and the variable being explained are skipped
   MockProxy = new Mock();
   EXPECT_EQ(CONFL_OK, conflict_add_constr_term(&var2, &confl, &c1));
+  EXPECT_EQ(CONFL_OK, conflict_add_constr_term(&var2, &confl, &c2));
   EXPECT_EQ(0, confl.constr.confl.length);
-  EXPECT_EQ(conflict_seen(&var1), false);
-  EXPECT_EQ(conflict_seen(&var2), false);
-  EXPECT_EQ(conflict_seen(&var3), false);
-  EXPECT_EQ(conflict_seen(&var4), false);
+  EXPECT_EQ(conflict_var_seen(&var2), false);
   delete(MockProxy);
 
+  // original values and committed bindings at the root level hold anyway
   MockProxy = new Mock();
-  EXPECT_EQ(CONFL_OK, conflict_add_constr_term(&var2, &confl, &c2));
+  EXPECT_CALL(*MockProxy, bind_get(0)).WillRepeatedly(::testing::Return(&b4));
+  EXPECT_EQ(CONFL_OK, conflict_add_constr_term(&var2, &confl, &c3));
+  EXPECT_EQ(CONFL_OK, conflict_add_constr_term(&var2, &confl, &c4));
   EXPECT_EQ(0, confl.constr.confl.length);
-  EXPECT_EQ(conflict_seen(&var1), false);
-  EXPECT_EQ(conflict_seen(&var2), false);
-  EXPECT_EQ(conflict_seen(&var3), false);
-  EXPECT_EQ(conflict_seen(&var4), false);
+  EXPECT_EQ(conflict_var_seen(&var3), false);
+  EXPECT_EQ(conflict_var_seen(&var4), false);
   delete(MockProxy);
 
+  // bindings at the root level of the current run, such as
+  // assumptions, are added without raising the maximum level
   MockProxy = new Mock();
-  EXPECT_CALL(*MockProxy, bind_level_get()).Times(1).WillOnce(::testing::Return(0));
-  EXPECT_EQ(CONFL_OK, conflict_add_constr_term(&var1, &confl, &c2));
-  EXPECT_EQ(0, confl.constr.confl.length);
-  EXPECT_EQ(conflict_seen(&var1), false);
-  EXPECT_EQ(conflict_seen(&var2), true);
-  EXPECT_EQ(conflict_seen(&var3), false);
-  EXPECT_EQ(conflict_seen(&var4), false);
+  conflict_root_init(0);
+  _conflict_max_level = 0;
+  EXPECT_CALL(*MockProxy, bind_get(0)).WillRepeatedly(::testing::Return(&b4));
+  EXPECT_CALL(*MockProxy, bind_level_get()).WillRepeatedly(::testing::Return(23));
+  EXPECT_EQ(CONFL_OK, conflict_add_constr_term(&var2, &confl, &c4));
+  EXPECT_EQ(1, confl.constr.confl.length);
+  EXPECT_EQ(&c4, confl.constr.confl.elems[0].var);
+  EXPECT_EQ(INTERVAL(1, DOMAIN_MAX), confl.constr.confl.elems[0].val);
+  EXPECT_EQ(0U, _conflict_max_level);
+  conflict_root_init(SIZE_MAX);
   conflict_seen_reset();
+  confl = CONSTRAINT_CONFL(0, NULL);
   delete(MockProxy);
 
+  // bindings at the current level are marked for resolving
   MockProxy = new Mock();
-  EXPECT_CALL(*MockProxy, bind_level_get()).Times(1).WillOnce(::testing::Return(66));
-  EXPECT_EQ(CONFL_OK, conflict_add_constr_term(&var1, &confl, &c2));
-  EXPECT_EQ(1, confl.constr.confl.length);
-  EXPECT_EQ(conflict_seen(&var1), false);
-  EXPECT_EQ(conflict_seen(&var2), false);
-  EXPECT_EQ(conflict_seen(&var3), false);
-  EXPECT_EQ(conflict_seen(&var4), false);
+  EXPECT_CALL(*MockProxy, bind_level_get()).Times(2).WillRepeatedly(::testing::Return(23));
+  EXPECT_EQ(CONFL_OK, conflict_add_constr_term(&var4, &confl, &c2));
+  EXPECT_EQ(CONFL_OK, conflict_add_constr_term(&var4, &confl, &c2));
+  EXPECT_EQ(0, confl.constr.confl.length);
+  EXPECT_EQ(conflict_var_seen(&var2), true);
+  EXPECT_EQ(&b2, var2.seen_bind);
+  EXPECT_EQ(1U, _conflict_pending);
   conflict_seen_reset();
+  _conflict_pending = 0;
   delete(MockProxy);
 
+  // bindings at lower levels are added
   MockProxy = new Mock();
-  EXPECT_CALL(*MockProxy, bind_level_get()).Times(1).WillOnce(::testing::Return(0));
-  EXPECT_EQ(CONFL_OK, conflict_add_constr_term(&var1, &confl, &c3));
-  EXPECT_EQ(2, confl.constr.confl.length);
-  EXPECT_EQ(conflict_seen(&var1), false);
-  EXPECT_EQ(conflict_seen(&var2), false);
-  EXPECT_EQ(conflict_seen(&var3), false);
-  EXPECT_EQ(conflict_seen(&var4), false);
+  EXPECT_CALL(*MockProxy, bind_level_get()).Times(1).WillOnce(::testing::Return(66));
+  EXPECT_EQ(CONFL_OK, conflict_add_constr_term(&var4, &confl, &c2));
+  EXPECT_EQ(1, confl.constr.confl.length);
+  EXPECT_EQ(&c2, confl.constr.confl.elems[0].var);
+  EXPECT_EQ(INTERVAL(1, DOMAIN_MAX), confl.constr.confl.elems[0].val);
+  EXPECT_EQ(conflict_var_seen(&var2), false);
+  EXPECT_EQ(0U, _conflict_pending);
   conflict_seen_reset();
   delete(MockProxy);
 
+  // the value before the binding being explained is used, which is
+  // the original value here
+  confl = CONSTRAINT_CONFL(0, NULL);
+  _conflict_bind = &b2;
   MockProxy = new Mock();
-  EXPECT_CALL(*MockProxy, bind_level_get()).Times(1).WillOnce(::testing::Return(0));
-  EXPECT_EQ(CONFL_OK, conflict_add_constr_term(&var1, &confl, &c4));
-  EXPECT_EQ(2, confl.constr.confl.length);
-  EXPECT_EQ(conflict_seen(&var1), false);
-  EXPECT_EQ(conflict_seen(&var2), false);
-  EXPECT_EQ(conflict_seen(&var3), false);
-  EXPECT_EQ(conflict_seen(&var4), true);
-  conflict_seen_reset();
+  EXPECT_EQ(CONFL_OK, conflict_add_constr_term(&var4, &confl, &c2));
+  EXPECT_EQ(0, confl.constr.confl.length);
+  EXPECT_EQ(conflict_var_seen(&var2), false);
+  _conflict_bind = NULL;
   delete(MockProxy);
 }
 
-TEST(ConflictAddConstrWand, Basic) {
+TEST(ConflictWalk, Wand) {
+  struct binding_t bA = { .var = NULL, .val = INTERVAL(0, 1),
+                          .level = SIZE_MAX, .clause = NULL, .prev = NULL };
   struct constr_t A = CONSTRAINT_TERM(INTERVAL(0, 1));
+  struct env_t vA = { .key = NULL, .val = &A, .binds = &bA,
+                      .clauses = { .length = 0, .elems = NULL },
+                      .order = 0, .prio = 0, .level = 0 };
+  A.constr.term.env = &vA;
+  struct binding_t bB = { .var = NULL, .val = INTERVAL(0, 1),
+                          .level = SIZE_MAX, .clause = NULL, .prev = NULL };
   struct constr_t B = CONSTRAINT_TERM(INTERVAL(0, 1));
+  struct env_t vB = { .key = NULL, .val = &B, .binds = &bB,
+                      .clauses = { .length = 0, .elems = NULL },
+                      .order = 0, .prio = 0, .level = 0 };
+  B.constr.term.env = &vB;
   struct wand_expr_t E [2] = { { .constr = &A, .orig = &A, .prop_tag = 0 },
                                { .constr = &B, .orig = &B, .prop_tag = 0 } };
   struct constr_t X = CONSTRAINT_WAND(2, E);
 
   MockProxy = new Mock();
-  EXPECT_EQ(CONFL_OK, conflict_add_constr_wand(NULL, NULL, &X));
-  EXPECT_EQ(conflict_seen(&A), true);
-  EXPECT_EQ(conflict_seen(&B), true);
+  EXPECT_EQ(CONFL_OK, conflict_walk(NULL, NULL, &X, conflict_add_constr));
+  EXPECT_EQ(conflict_var_seen(&vA), true);
+  EXPECT_EQ(conflict_var_seen(&vB), true);
   conflict_seen_reset();
   delete(MockProxy);
 }
 
-TEST(ConflictAddConstrConfl, Basic) {
+TEST(ConflictWalk, Confl) {
+  struct binding_t bA = { .var = NULL, .val = INTERVAL(0, 1),
+                          .level = SIZE_MAX, .clause = NULL, .prev = NULL };
   struct constr_t A = CONSTRAINT_TERM(INTERVAL(0, 1));
+  struct env_t vA = { .key = NULL, .val = &A, .binds = &bA,
+                      .clauses = { .length = 0, .elems = NULL },
+                      .order = 0, .prio = 0, .level = 0 };
+  A.constr.term.env = &vA;
+  struct binding_t bB = { .var = NULL, .val = INTERVAL(0, 1),
+                          .level = SIZE_MAX, .clause = NULL, .prev = NULL };
   struct constr_t B = CONSTRAINT_TERM(INTERVAL(0, 1));
+  struct env_t vB = { .key = NULL, .val = &B, .binds = &bB,
+                      .clauses = { .length = 0, .elems = NULL },
+                      .order = 0, .prio = 0, .level = 0 };
+  B.constr.term.env = &vB;
   struct confl_elem_t E [2] = { { .val = VALUE(0), .var = &A },
                                 { .val = VALUE(0), .var = &B } };
   struct constr_t X = CONSTRAINT_CONFL(2, E);
 
   MockProxy = new Mock();
-  EXPECT_EQ(CONFL_OK, conflict_add_constr_confl(NULL, NULL, &X));
-  EXPECT_EQ(conflict_seen(&A), true);
-  EXPECT_EQ(conflict_seen(&B), true);
+  EXPECT_EQ(CONFL_OK, conflict_walk(NULL, NULL, &X, conflict_add_constr));
+  EXPECT_EQ(conflict_var_seen(&vA), true);
+  EXPECT_EQ(conflict_var_seen(&vB), true);
   conflict_seen_reset();
   delete(MockProxy);
 }
 
-TEST(ConflictAddConstrExpr, Basic) {
+TEST(ConflictWalk, Expr) {
+  struct binding_t bA = { .var = NULL, .val = INTERVAL(0, 1),
+                          .level = SIZE_MAX, .clause = NULL, .prev = NULL };
   struct constr_t A = CONSTRAINT_TERM(INTERVAL(0, 1));
+  struct env_t vA = { .key = NULL, .val = &A, .binds = &bA,
+                      .clauses = { .length = 0, .elems = NULL },
+                      .order = 0, .prio = 0, .level = 0 };
+  A.constr.term.env = &vA;
+  struct binding_t bB = { .var = NULL, .val = INTERVAL(0, 1),
+                          .level = SIZE_MAX, .clause = NULL, .prev = NULL };
   struct constr_t B = CONSTRAINT_TERM(INTERVAL(0, 1));
+  struct env_t vB = { .key = NULL, .val = &B, .binds = &bB,
+                      .clauses = { .length = 0, .elems = NULL },
+                      .order = 0, .prio = 0, .level = 0 };
+  B.constr.term.env = &vB;
   struct constr_t X;
 
   MockProxy = new Mock();
   X = CONSTRAINT_EXPR(EQ, &A, &B);
-  EXPECT_EQ(CONFL_OK, conflict_add_constr_expr(NULL, NULL, &X));
-  EXPECT_EQ(conflict_seen(&A), true);
-  EXPECT_EQ(conflict_seen(&B), true);
+  EXPECT_EQ(CONFL_OK, conflict_walk(NULL, NULL, &X, conflict_add_constr));
+  EXPECT_EQ(conflict_var_seen(&vA), true);
+  EXPECT_EQ(conflict_var_seen(&vB), true);
   conflict_seen_reset();
   delete(MockProxy);
 
   MockProxy = new Mock();
   X = CONSTRAINT_EXPR(LT, &A, &B);
-  EXPECT_EQ(CONFL_OK, conflict_add_constr_expr(NULL, NULL, &X));
-  EXPECT_EQ(conflict_seen(&A), true);
-  EXPECT_EQ(conflict_seen(&B), true);
+  EXPECT_EQ(CONFL_OK, conflict_walk(NULL, NULL, &X, conflict_add_constr));
+  EXPECT_EQ(conflict_var_seen(&vA), true);
+  EXPECT_EQ(conflict_var_seen(&vB), true);
   conflict_seen_reset();
   delete(MockProxy);
 
   MockProxy = new Mock();
   X = CONSTRAINT_EXPR(ADD, &A, &B);
-  EXPECT_EQ(CONFL_OK, conflict_add_constr_expr(NULL, NULL, &X));
-  EXPECT_EQ(conflict_seen(&A), true);
-  EXPECT_EQ(conflict_seen(&B), true);
+  EXPECT_EQ(CONFL_OK, conflict_walk(NULL, NULL, &X, conflict_add_constr));
+  EXPECT_EQ(conflict_var_seen(&vA), true);
+  EXPECT_EQ(conflict_var_seen(&vB), true);
   conflict_seen_reset();
   delete(MockProxy);
 
   MockProxy = new Mock();
   X = CONSTRAINT_EXPR(MUL, &A, &B);
-  EXPECT_EQ(CONFL_OK, conflict_add_constr_expr(NULL, NULL, &X));
-  EXPECT_EQ(conflict_seen(&A), true);
-  EXPECT_EQ(conflict_seen(&B), true);
+  EXPECT_EQ(CONFL_OK, conflict_walk(NULL, NULL, &X, conflict_add_constr));
+  EXPECT_EQ(conflict_var_seen(&vA), true);
+  EXPECT_EQ(conflict_var_seen(&vB), true);
   conflict_seen_reset();
   delete(MockProxy);
 
   MockProxy = new Mock();
   X = CONSTRAINT_EXPR(AND, &A, &B);
-  EXPECT_EQ(CONFL_OK, conflict_add_constr_expr(NULL, NULL, &X));
-  EXPECT_EQ(conflict_seen(&A), true);
-  EXPECT_EQ(conflict_seen(&B), true);
+  EXPECT_EQ(CONFL_OK, conflict_walk(NULL, NULL, &X, conflict_add_constr));
+  EXPECT_EQ(conflict_var_seen(&vA), true);
+  EXPECT_EQ(conflict_var_seen(&vB), true);
   conflict_seen_reset();
   delete(MockProxy);
 
   MockProxy = new Mock();
   X = CONSTRAINT_EXPR(OR, &A, &B);
-  EXPECT_EQ(CONFL_OK, conflict_add_constr_expr(NULL, NULL, &X));
-  EXPECT_EQ(conflict_seen(&A), true);
-  EXPECT_EQ(conflict_seen(&B), true);
+  EXPECT_EQ(CONFL_OK, conflict_walk(NULL, NULL, &X, conflict_add_constr));
+  EXPECT_EQ(conflict_var_seen(&vA), true);
+  EXPECT_EQ(conflict_var_seen(&vB), true);
   conflict_seen_reset();
   delete(MockProxy);
 
   MockProxy = new Mock();
   X = CONSTRAINT_EXPR(NEG, &A, NULL);
-  EXPECT_EQ(CONFL_OK, conflict_add_constr_expr(NULL, NULL, &X));
-  EXPECT_EQ(conflict_seen(&A), true);
-  EXPECT_EQ(conflict_seen(&B), false);
+  EXPECT_EQ(CONFL_OK, conflict_walk(NULL, NULL, &X, conflict_add_constr));
+  EXPECT_EQ(conflict_var_seen(&vA), true);
+  EXPECT_EQ(conflict_var_seen(&vB), false);
   conflict_seen_reset();
   delete(MockProxy);
 
   MockProxy = new Mock();
   X = CONSTRAINT_EXPR(NOT, &B, NULL);
-  EXPECT_EQ(CONFL_OK, conflict_add_constr_expr(NULL, NULL, &X));
-  EXPECT_EQ(conflict_seen(&A), false);
-  EXPECT_EQ(conflict_seen(&B), true);
+  EXPECT_EQ(CONFL_OK, conflict_walk(NULL, NULL, &X, conflict_add_constr));
+  EXPECT_EQ(conflict_var_seen(&vA), false);
+  EXPECT_EQ(conflict_var_seen(&vB), true);
   conflict_seen_reset();
   delete(MockProxy);
 
@@ -446,61 +579,425 @@ TEST(ConflictAddConstrExpr, Basic) {
   MockProxy = new Mock();
   X = CONSTRAINT_EXPR(FOO, &B, NULL);
   EXPECT_CALL(*MockProxy, print_fatal(ERROR_MSG_INVALID_OPERATION)).Times(1);
-  EXPECT_EQ(CONFL_OK, conflict_add_constr_expr(NULL, NULL, &X));
-  EXPECT_EQ(conflict_seen(&A), false);
-  EXPECT_EQ(conflict_seen(&B), false);
+  EXPECT_EQ(CONFL_OK, conflict_walk(NULL, NULL, &X, conflict_add_constr));
+  EXPECT_EQ(conflict_var_seen(&vA), false);
+  EXPECT_EQ(conflict_var_seen(&vB), false);
   conflict_seen_reset();
   delete(MockProxy);
 }
 
 TEST(ConflictAddConstr, Wand) {
+  struct binding_t bA = { .var = NULL, .val = INTERVAL(0, 1),
+                          .level = SIZE_MAX, .clause = NULL, .prev = NULL };
   struct constr_t A = CONSTRAINT_TERM(INTERVAL(0, 1));
+  struct env_t vA = { .key = NULL, .val = &A, .binds = &bA,
+                      .clauses = { .length = 0, .elems = NULL },
+                      .order = 0, .prio = 0, .level = 0 };
+  A.constr.term.env = &vA;
+  struct binding_t bB = { .var = NULL, .val = INTERVAL(0, 1),
+                          .level = SIZE_MAX, .clause = NULL, .prev = NULL };
   struct constr_t B = CONSTRAINT_TERM(INTERVAL(0, 1));
+  struct env_t vB = { .key = NULL, .val = &B, .binds = &bB,
+                      .clauses = { .length = 0, .elems = NULL },
+                      .order = 0, .prio = 0, .level = 0 };
+  B.constr.term.env = &vB;
   struct wand_expr_t E [2] = { { .constr = &A, .orig = &A, .prop_tag = 0 },
                                { .constr = &B, .orig = &B, .prop_tag = 0 } };
   struct constr_t X = CONSTRAINT_WAND(2, E);
 
   MockProxy = new Mock();
   EXPECT_EQ(CONFL_OK, conflict_add_constr(NULL, NULL, &X));
-  EXPECT_EQ(conflict_seen(&A), true);
-  EXPECT_EQ(conflict_seen(&B), true);
+  EXPECT_EQ(conflict_var_seen(&vA), true);
+  EXPECT_EQ(conflict_var_seen(&vB), true);
   EXPECT_EQ(CONFL_OK, conflict_add_constr(NULL, NULL, &X));
-  EXPECT_EQ(conflict_seen(&A), true);
-  EXPECT_EQ(conflict_seen(&B), true);
+  EXPECT_EQ(conflict_var_seen(&vA), true);
+  EXPECT_EQ(conflict_var_seen(&vB), true);
   conflict_seen_reset();
   delete(MockProxy);
 }
 
- TEST(ConflictAddConstr, Confl) {
+TEST(ConflictAddConstr, Confl) {
+  struct binding_t bA = { .var = NULL, .val = INTERVAL(0, 1),
+                          .level = SIZE_MAX, .clause = NULL, .prev = NULL };
   struct constr_t A = CONSTRAINT_TERM(INTERVAL(0, 1));
+  struct env_t vA = { .key = NULL, .val = &A, .binds = &bA,
+                      .clauses = { .length = 0, .elems = NULL },
+                      .order = 0, .prio = 0, .level = 0 };
+  A.constr.term.env = &vA;
+  struct binding_t bB = { .var = NULL, .val = INTERVAL(0, 1),
+                          .level = SIZE_MAX, .clause = NULL, .prev = NULL };
   struct constr_t B = CONSTRAINT_TERM(INTERVAL(0, 1));
+  struct env_t vB = { .key = NULL, .val = &B, .binds = &bB,
+                      .clauses = { .length = 0, .elems = NULL },
+                      .order = 0, .prio = 0, .level = 0 };
+  B.constr.term.env = &vB;
   struct confl_elem_t E [2] = { { .val = VALUE(0), .var = &A },
                                 { .val = VALUE(0), .var = &B } };
   struct constr_t X = CONSTRAINT_CONFL(2, E);
 
   MockProxy = new Mock();
   EXPECT_EQ(CONFL_OK, conflict_add_constr(NULL, NULL, &X));
-  EXPECT_EQ(conflict_seen(&A), true);
-  EXPECT_EQ(conflict_seen(&B), true);
+  EXPECT_EQ(conflict_var_seen(&vA), true);
+  EXPECT_EQ(conflict_var_seen(&vB), true);
   EXPECT_EQ(CONFL_OK, conflict_add_constr(NULL, NULL, &X));
-  EXPECT_EQ(conflict_seen(&A), true);
-  EXPECT_EQ(conflict_seen(&B), true);
+  EXPECT_EQ(conflict_var_seen(&vA), true);
+  EXPECT_EQ(conflict_var_seen(&vB), true);
   conflict_seen_reset();
   delete(MockProxy);
 }
 
- TEST(ConflictAddConstr, Expr) {
+TEST(ConflictAddConstr, Expr) {
+  struct binding_t bA = { .var = NULL, .val = INTERVAL(0, 1),
+                          .level = SIZE_MAX, .clause = NULL, .prev = NULL };
   struct constr_t A = CONSTRAINT_TERM(INTERVAL(0, 1));
+  struct env_t vA = { .key = NULL, .val = &A, .binds = &bA,
+                      .clauses = { .length = 0, .elems = NULL },
+                      .order = 0, .prio = 0, .level = 0 };
+  A.constr.term.env = &vA;
+  struct binding_t bB = { .var = NULL, .val = INTERVAL(0, 1),
+                          .level = SIZE_MAX, .clause = NULL, .prev = NULL };
   struct constr_t B = CONSTRAINT_TERM(INTERVAL(0, 1));
+  struct env_t vB = { .key = NULL, .val = &B, .binds = &bB,
+                      .clauses = { .length = 0, .elems = NULL },
+                      .order = 0, .prio = 0, .level = 0 };
+  B.constr.term.env = &vB;
   struct constr_t X;
 
   MockProxy = new Mock();
   X = CONSTRAINT_EXPR(EQ, &A, &B);
   EXPECT_EQ(CONFL_OK, conflict_add_constr(NULL, NULL, &X));
-  EXPECT_EQ(conflict_seen(&A), true);
-  EXPECT_EQ(conflict_seen(&B), true);
+  EXPECT_EQ(conflict_var_seen(&vA), true);
+  EXPECT_EQ(conflict_var_seen(&vB), true);
+  conflict_seen_reset();
+  delete(MockProxy);
+}
+
+TEST(ConflictResolve, Basic) {
+  struct constr_t A = CONSTRAINT_TERM(VALUE(1));
+  struct constr_t X = CONSTRAINT_TERM(VALUE(1));
+  struct constr_t Y = CONSTRAINT_TERM(VALUE(1));
+  struct constr_t R = CONSTRAINT_EXPR(EQ, &X, &Y);
+  struct wand_expr_t reason = { .constr = &R, .orig = &R, .prop_tag = 0 };
+  struct env_t vA = { .key = NULL, .val = &A, .binds = NULL,
+                      .clauses = { .length = 0, .elems = NULL },
+                      .order = 0, .prio = 0, .level = 2 };
+  struct env_t vX = { .key = NULL, .val = &X, .binds = NULL,
+                      .clauses = { .length = 0, .elems = NULL },
+                      .order = 0, .prio = 0, .level = 5 };
+  struct env_t vY = { .key = NULL, .val = &Y, .binds = NULL,
+                      .clauses = { .length = 0, .elems = NULL },
+                      .order = 0, .prio = 0, .level = 5 };
+  A.constr.term.env = &vA;
+  X.constr.term.env = &vX;
+  Y.constr.term.env = &vY;
+
+  // a is bound at a lower level, x is decided at the current level
+  // and implies y
+  struct binding_t S [3] = {
+    { .var = &vA, .val = INTERVAL(0, 1), .level = SIZE_MAX, .clause = NULL, .prev = NULL },
+    { .var = &vX, .val = INTERVAL(0, 1), .level = SIZE_MAX, .clause = NULL, .prev = NULL },
+    { .var = &vY, .val = INTERVAL(0, 1), .level = SIZE_MAX, .clause = &reason, .prev = NULL } };
+  vA.binds = &S[0];
+  vX.binds = &S[1];
+  vY.binds = &S[2];
+
+  struct constr_t confl = CONSTRAINT_CONFL(0, NULL);
+
+  conflict_alloc_init(4096);
   conflict_seen_reset();
+  _conflict_bind = NULL;
+  _conflict_pending = 0;
+  _conflict_max_level = 0;
+
+  MockProxy = new Mock();
+  EXPECT_CALL(*MockProxy, bind_level_get()).WillRepeatedly(::testing::Return(5));
+  EXPECT_CALL(*MockProxy, bind_depth()).Times(1).WillOnce(::testing::Return(3));
+  EXPECT_CALL(*MockProxy, bind_get(2)).Times(1).WillOnce(::testing::Return(&S[2]));
+  EXPECT_CALL(*MockProxy, bind_get(1)).Times(1).WillOnce(::testing::Return(&S[1]));
+  EXPECT_EQ(CONFL_OK, conflict_add_env(&confl, &vA));
+  EXPECT_EQ(CONFL_OK, conflict_add_env(&confl, &vX));
+  EXPECT_EQ(CONFL_OK, conflict_add_env(&confl, &vY));
+  EXPECT_EQ(1, confl.constr.confl.length);
+  EXPECT_EQ(2U, _conflict_pending);
+
+  // y is replaced by its reason, leaving x as the only variable at
+  // the current level
+  EXPECT_EQ(CONFL_OK, conflict_resolve(&confl));
+  EXPECT_EQ(0U, _conflict_pending);
+  ASSERT_EQ(2, confl.constr.confl.length);
+  EXPECT_EQ(&A, confl.constr.confl.elems[0].var);
+  EXPECT_EQ(&X, confl.constr.confl.elems[1].var);
+  EXPECT_EQ(INTERVAL(1, DOMAIN_MAX), confl.constr.confl.elems[1].val);
+  EXPECT_EQ(5U, _conflict_max_level);
   delete(MockProxy);
+
+  _conflict_bind = NULL;
+  conflict_alloc_free();
+}
+
+TEST(ConflictMinimize, Basic) {
+  struct constr_t A = CONSTRAINT_TERM(VALUE(1));
+  struct constr_t B = CONSTRAINT_TERM(VALUE(1));
+  struct constr_t C = CONSTRAINT_TERM(VALUE(1));
+  struct constr_t R = CONSTRAINT_EXPR(EQ, &A, &B);
+  struct wand_expr_t reason = { .constr = &R, .orig = &R, .prop_tag = 0 };
+  struct env_t vA = { .key = NULL, .val = &A, .binds = NULL,
+                      .clauses = { .length = 0, .elems = NULL },
+                      .order = 0, .prio = 0, .level = 2 };
+  struct env_t vB = { .key = NULL, .val = &B, .binds = NULL,
+                      .clauses = { .length = 0, .elems = NULL },
+                      .order = 0, .prio = 0, .level = 3 };
+  struct env_t vC = { .key = NULL, .val = &C, .binds = NULL,
+                      .clauses = { .length = 0, .elems = NULL },
+                      .order = 0, .prio = 0, .level = 4 };
+  A.constr.term.env = &vA;
+  B.constr.term.env = &vB;
+  C.constr.term.env = &vC;
+
+  // a and c are decisions, b is implied by a
+  struct binding_t S [3] = {
+    { .var = &vA, .val = INTERVAL(0, 1), .level = SIZE_MAX, .clause = NULL, .prev = NULL },
+    { .var = &vB, .val = INTERVAL(0, 1), .level = SIZE_MAX, .clause = &reason, .prev = NULL },
+    { .var = &vC, .val = INTERVAL(0, 1), .level = SIZE_MAX, .clause = NULL, .prev = NULL } };
+  vA.binds = &S[0];
+  vB.binds = &S[1];
+  vC.binds = &S[2];
+
+  conflict_alloc_init(4096);
+  struct confl_elem_t *E = (struct confl_elem_t *)conflict_alloc(NULL, 3 * sizeof(struct confl_elem_t));
+  E[0] = { .val = INTERVAL(1, DOMAIN_MAX), .var = &A };
+  E[1] = { .val = INTERVAL(1, DOMAIN_MAX), .var = &B };
+  E[2] = { .val = INTERVAL(1, DOMAIN_MAX), .var = &C };
+  struct constr_t confl = CONSTRAINT_CONFL(3, E);
+  _conflict_max_level = 4;
+
+  MockProxy = new Mock();
+  conflict_minimize(&confl);
+  ASSERT_EQ(2, confl.constr.confl.length);
+  EXPECT_EQ(&A, confl.constr.confl.elems[0].var);
+  EXPECT_EQ(&C, confl.constr.confl.elems[1].var);
+  delete(MockProxy);
+
+  // the element at the maximum level is kept
+  E = (struct confl_elem_t *)conflict_alloc(NULL, 2 * sizeof(struct confl_elem_t));
+  E[0] = { .val = INTERVAL(1, DOMAIN_MAX), .var = &A };
+  E[1] = { .val = INTERVAL(1, DOMAIN_MAX), .var = &B };
+  confl = CONSTRAINT_CONFL(2, E);
+  _conflict_max_level = 3;
+
+  MockProxy = new Mock();
+  conflict_minimize(&confl);
+  EXPECT_EQ(2, confl.constr.confl.length);
+  delete(MockProxy);
+
+  conflict_alloc_free();
+}
+
+TEST(ConflictShare, Init) {
+  struct env_t env[1];
+
+  _shared.confl_head = 17;
+  MockProxy = new Mock();
+  EXPECT_CALL(*MockProxy, sema_wait(&_shared.confl_semaphore)).Times(1);
+  EXPECT_CALL(*MockProxy, sema_post(&_shared.confl_semaphore)).Times(1);
+  conflict_share_init(env, 3);
+  EXPECT_EQ(env, _share_env);
+  EXPECT_EQ(3U, _share_id);
+  EXPECT_EQ(17U, _share_tail);
+  delete(MockProxy);
+
+  MockProxy = new Mock();
+  conflict_share_init(NULL, 1);
+  EXPECT_EQ((struct env_t *)NULL, _share_env);
+  EXPECT_EQ(0U, _share_tail);
+  delete(MockProxy);
+}
+
+TEST(ConflictShare, Export) {
+  struct constr_t c[3];
+  struct env_t env[3];
+  for (size_t i = 0; i < 3; i++) {
+    c[i] = CONSTRAINT_TERM(VALUE(1));
+    c[i].constr.term.env = &env[i];
+    env[i] = { .key = NULL, .val = &c[i], .binds = NULL,
+               .clauses = { .length = 0, .elems = NULL },
+               .order = 0, .prio = 0, .level = i };
+  }
+  struct confl_elem_t E [2] = { { .val = VALUE(0), .var = &c[2] },
+                                { .val = VALUE(1), .var = &c[0] } };
+  struct constr_t X = CONSTRAINT_CONFL(2, E);
+
+  _share_env = env;
+  _share_id = 2;
+  _shared.confl_head = CONFLICT_SHARE_RING_SIZE + 5;
+  MockProxy = new Mock();
+  EXPECT_CALL(*MockProxy, sema_wait(&_shared.confl_semaphore)).Times(1);
+  EXPECT_CALL(*MockProxy, sema_post(&_shared.confl_semaphore)).Times(1);
+  conflict_export(&X);
+  EXPECT_EQ(CONFLICT_SHARE_RING_SIZE + 6U, _shared.confl_head);
+  EXPECT_EQ(2U, _shared.confls[5].worker);
+  EXPECT_EQ(2U, _shared.confls[5].length);
+  EXPECT_EQ(2U, _shared.confls[5].elems[0].var);
+  EXPECT_EQ(VALUE(0), _shared.confls[5].elems[0].val);
+  EXPECT_EQ(0U, _shared.confls[5].elems[1].var);
+  EXPECT_EQ(VALUE(1), _shared.confls[5].elems[1].val);
+  delete(MockProxy);
+}
+
+TEST(ConflictShare, ExportFilter) {
+  const size_t length = CONFLICT_SHARE_LENGTH_MAX+1;
+  struct constr_t c[length];
+  struct env_t env[length];
+  struct confl_elem_t E[length];
+  for (size_t i = 0; i < length; i++) {
+    c[i] = CONSTRAINT_TERM(VALUE(1));
+    c[i].constr.term.env = &env[i];
+    env[i] = { .key = NULL, .val = &c[i], .binds = NULL,
+               .clauses = { .length = 0, .elems = NULL },
+               .order = 0, .prio = 0, .level = i };
+    E[i] = { .val = VALUE(1), .var = &c[i] };
+  }
+
+  _share_env = env;
+  _shared.confl_head = 0;
+  MockProxy = new Mock();
+  // too long
+  struct constr_t X = CONSTRAINT_CONFL(length, E);
+  conflict_export(&X);
+  EXPECT_EQ(0U, _shared.confl_head);
+  // too many levels
+  struct constr_t Y = CONSTRAINT_CONFL(CONFLICT_SHARE_LEVELS_MAX+1, E);
+  conflict_export(&Y);
+  EXPECT_EQ(0U, _shared.confl_head);
+  delete(MockProxy);
+}
+
+TEST(ConflictShare, Import) {
+  struct constr_t c[3];
+  struct env_t env[3];
+  for (size_t i = 0; i < 3; i++) {
+    c[i] = CONSTRAINT_TERM(INTERVAL(0, 1));
+    c[i].constr.term.env = &env[i];
+    env[i] = { .key = NULL, .val = &c[i], .binds = NULL,
+               .clauses = { .length = 0, .elems = NULL },
+               .order = 0, .prio = 0, .level = 0 };
+  }
+
+  _shared.confls[0] = { .worker = 1, .length = 2, .elems = { { .var = 1, .val = VALUE(1) },
+                                                             { .var = 2, .val = VALUE(0) } } };
+  _shared.confls[1] = { .worker = 2, .length = 1, .elems = { { .var = 0, .val = VALUE(0) } } };
+  _shared.confl_head = 2;
+
+  conflict_alloc_init(1024);
+  _share_env = env;
+  _share_id = 2;
+  _share_tail = 0;
+  MockProxy = new Mock();
+  EXPECT_CALL(*MockProxy, sema_wait(&_shared.confl_semaphore)).Times(1);
+  EXPECT_CALL(*MockProxy, sema_post(&_shared.confl_semaphore)).Times(1);
+  struct wand_expr_t *w1 = NULL;
+  EXPECT_CALL(*MockProxy, propagate_watch(testing::_))
+    .WillOnce(testing::SaveArg<0>(&w1));
+  conflict_import();
+  EXPECT_EQ(2U, _share_tail);
+  delete(MockProxy);
+
+  ASSERT_NE((struct wand_expr_t *)NULL, w1);
+  struct constr_t *X = w1->constr;
+  EXPECT_EQ(X, w1->orig);
+  EXPECT_EQ(&CONSTR_CONFL, X->type);
+  EXPECT_EQ(2U, X->constr.confl.length);
+  EXPECT_EQ(&c[1], X->constr.confl.elems[0].var);
+  EXPECT_EQ(VALUE(1), X->constr.confl.elems[0].val);
+  EXPECT_EQ(&c[2], X->constr.confl.elems[1].var);
+  EXPECT_EQ(VALUE(0), X->constr.confl.elems[1].val);
+
+  // nothing to import
+  MockProxy = new Mock();
+  conflict_import();
+  delete(MockProxy);
+
+  // skip conflicts that have been overwritten
+  _shared.confl_head = CONFLICT_SHARE_RING_SIZE + 3;
+  for (size_t i = 0; i < CONFLICT_SHARE_RING_SIZE; i++) {
+    _shared.confls[i].worker = 2;
+  }
+  MockProxy = new Mock();
+  EXPECT_CALL(*MockProxy, sema_wait(&_shared.confl_semaphore)).Times(1);
+  EXPECT_CALL(*MockProxy, sema_post(&_shared.confl_semaphore)).Times(1);
+  conflict_import();
+  EXPECT_EQ(CONFLICT_SHARE_RING_SIZE + 3, _share_tail);
+  delete(MockProxy);
+
+  conflict_alloc_free();
+  _share_env = NULL;
+}
+
+
+TEST(ConflictReduce, Basic) {
+  struct constr_t c[3];
+  struct env_t env[3];
+  for (size_t i = 0; i < 3; i++) {
+    c[i] = CONSTRAINT_TERM(INTERVAL(0, 1));
+    c[i].constr.term.env = &env[i];
+    env[i] = { .key = NULL, .val = &c[i], .binds = NULL,
+               .clauses = { .length = 0, .elems = NULL },
+               .order = 0, .prio = 0, .level = i };
+  }
+
+  conflict_alloc_init(4096);
+  MockProxy = new Mock();
+  EXPECT_CALL(*MockProxy, propagate_watch(testing::_)).Times(3);
+  struct constr_t *X[3];
+  for (size_t i = 0; i < 3; i++) {
+    X[i] = (struct constr_t *)conflict_alloc(NULL, sizeof(struct constr_t));
+    struct confl_elem_t *E = (struct confl_elem_t *)conflict_alloc(NULL, 3 * sizeof(struct confl_elem_t));
+    for (size_t k = 0; k < 3; k++) {
+      E[k] = { .val = VALUE(i == k), .var = &c[k] };
+    }
+    *X[i] = CONSTRAINT_CONFL(3, E);
+    conflict_attach(X[i]);
+  }
+  delete(MockProxy);
+  ASSERT_EQ(3U, _db_length);
+  EXPECT_EQ(3U, _db[0].lbd);
+
+  // below the limit
+  conflict_reduce_init();
+  _db_floor = 0;
+  _db_limit = 3;
+  MockProxy = new Mock();
+  conflict_reduce();
+  EXPECT_EQ(3U, _db_length);
+  delete(MockProxy);
+
+  // the conflict that never took part in other conflicts is removed
+  _db_limit = 1;
+  _db[0].activity = 4;
+  _db[2].activity = 4;
+  const size_t pointer = _alloc_stack_pointer;
+  MockProxy = new Mock();
+  EXPECT_CALL(*MockProxy, bind_relocate(testing::_)).Times(2);
+  EXPECT_CALL(*MockProxy, clause_lists_compact(testing::_, 3, testing::_)).Times(1);
+  conflict_reduce();
+  delete(MockProxy);
+
+  ASSERT_EQ(2U, _db_length);
+  EXPECT_EQ(1U + CONFLICT_DB_SIZE_INC, _db_limit);
+  EXPECT_EQ(X[0], _db[0].confl);
+  EXPECT_EQ(2U, _db[0].activity);
+  EXPECT_EQ(X[1], _db[1].confl);
+  EXPECT_EQ(2U, _db[1].activity);
+  EXPECT_EQ(pointer - _db[1].size, _alloc_stack_pointer);
+  EXPECT_EQ(X[1], _db[1].clause->constr);
+  EXPECT_EQ(X[1], _db[1].clause->orig);
+  EXPECT_EQ(3U, X[1]->constr.confl.length);
+  ASSERT_EQ((struct confl_elem_t *)&X[1][1], X[1]->constr.confl.elems);
+  EXPECT_EQ(VALUE(0), X[1]->constr.confl.elems[1].val);
+  EXPECT_EQ(VALUE(1), X[1]->constr.confl.elems[2].val);
+  EXPECT_EQ(&c[2], X[1]->constr.confl.elems[2].var);
+
+  conflict_alloc_free();
 }
 
 }
@@ -24,27 +24,67 @@ class Mock {
   MOCK_METHOD0(cache_clean, void(void));
   MOCK_METHOD0(bind_depth, size_t(void));
   MOCK_METHOD1(bind_level_set, void(size_t));
-  MOCK_METHOD3(bind, void(struct env_t *, struct val_t, const struct wand_expr_t *));
+  MOCK_METHOD3(bind, prop_event_t(struct env_t *, struct val_t, const struct wand_expr_t *));
   MOCK_METHOD1(unbind, void(size_t));
   MOCK_METHOD2(patch, size_t(struct wand_expr_t *, struct constr_t *));
   MOCK_METHOD1(unpatch, void(size_t));
-  MOCK_METHOD1(sema_init, void(sem_t *));
+  MOCK_METHOD2(sema_init, void(sem_t *, uint32_t));
   MOCK_METHOD1(sema_wait, void(sem_t *));
   MOCK_METHOD1(sema_post, void(sem_t *));
   MOCK_METHOD1(normal, struct constr_t *(struct constr_t *));
-  MOCK_METHOD1(propagate_clauses, prop_result_t(const struct clause_list_t *));
+  MOCK_METHOD1(propagate_clauses, prop_result_t(struct env_t *));
   MOCK_METHOD0(conflict_level, size_t(void));
   MOCK_METHOD0(conflict_var, struct env_t *(void));
+  MOCK_METHOD2(conflict_share_init, void(struct env_t *, uint32_t));
+  MOCK_METHOD0(conflict_import, void(void));
+  MOCK_METHOD0(conflict_reduce_init, void(void));
+  MOCK_METHOD0(conflict_reduce, void(void));
   MOCK_METHOD0(objective, enum objective_t(void));
   MOCK_METHOD0(objective_better, bool(void));
-  MOCK_METHOD0(objective_update_best, void(void));
+  MOCK_METHOD0(objective_update_best, bool(void));
+  MOCK_METHOD0(objective_solution, domain_t(void));
   MOCK_METHOD0(objective_update_val, void(void));
   MOCK_METHOD0(objective_val, struct constr_t*(void));
   MOCK_METHOD0(strategy_create_conflicts, bool(void));
   MOCK_METHOD0(strategy_restart_frequency, uint64_t(void));
   MOCK_METHOD0(strategy_var_order_pop, struct env_t *(void));
   MOCK_METHOD1(strategy_var_order_push, void(struct env_t *));
+  MOCK_METHOD1(alloc_init, void(size_t));
+  MOCK_METHOD0(alloc_free, void(void));
+  MOCK_METHOD0(alloc_size, size_t(void));
+  MOCK_METHOD1(bind_init, void(size_t));
+  MOCK_METHOD0(bind_free, void(void));
+  MOCK_METHOD0(bind_size, size_t(void));
+  MOCK_METHOD1(patch_init, void(size_t));
+  MOCK_METHOD0(patch_free, void(void));
+  MOCK_METHOD0(patch_size, size_t(void));
+  MOCK_METHOD1(conflict_alloc_init, void(size_t));
+  MOCK_METHOD0(conflict_alloc_free, void(void));
+  MOCK_METHOD0(conflict_alloc_size, size_t(void));
+  MOCK_METHOD2(clauses_init, void(struct constr_t *, struct wand_expr_t *));
+  MOCK_METHOD1(compile_init, void(struct env_t *));
+  MOCK_METHOD3(solver_clone, void(struct solver_t *, const struct solver_t *, struct constr_t *));
+  MOCK_METHOD2(strategy_var_order_init, void(size_t, struct env_t *));
+  MOCK_METHOD0(strategy_var_order_free, void(void));
+  MOCK_METHOD0(propagate_free, void(void));
+  MOCK_METHOD0(compile_free, void(void));
+  MOCK_METHOD1(clause_list_free, void(struct clause_list_t *));
+  MOCK_METHOD1(strategy_var_order_remove, void(struct env_t *));
+  MOCK_METHOD0(strategy_portfolio, bool(void));
+  MOCK_METHOD0(strategy_eps, uint32_t(void));
+  MOCK_METHOD0(cube_count, uint32_t(void));
+  MOCK_METHOD0(cube_file, const char *(void));
+  MOCK_METHOD3(cube_write, void(FILE *, struct env_t *, const struct task_t *));
+  MOCK_METHOD3(cube_read, size_t(size_t, struct env_t *, struct decision_t **));
+  MOCK_METHOD1(strategy_get, void(struct strategy_t *));
+  MOCK_METHOD1(strategy_set, void(const struct strategy_t *));
+  MOCK_METHOD1(strategy_diversify, void(uint32_t));
+  MOCK_METHOD0(strategy_rand, int(void));
+  MOCK_METHOD2(min, domain_t(domain_t, domain_t));
+  MOCK_METHOD2(max, domain_t(domain_t, domain_t));
+  MOCK_METHOD1(print_fatal, void(const char *));
   MOCK_METHOD1(print_error, void(const char *));
+  MOCK_METHOD1(print_warning, void(const char *));
   MOCK_METHOD3(print_solution, void(FILE *, size_t, struct env_t *));
 #define CONSTR_TYPE_MOCKS(UPNAME, NAME, OP) \
   MOCK_METHOD1(eval_ ## NAME, struct val_t(const struct constr_t *)); \
@@ -75,8 +115,8 @@ size_t bind_depth(void) {
   MockProxy->bind_level_set(level);
 }
 
- void bind(struct env_t *var, struct val_t val, const struct wand_expr_t *clause) {
-  MockProxy->bind(var, val, clause);
+ prop_event_t bind(struct env_t *var, struct val_t val, const struct wand_expr_t *clause) {
+  return MockProxy->bind(var, val, clause);
 }
 
 void unbind(size_t depth) {
@@ -91,8 +131,8 @@ void unpatch(size_t depth) {
   MockProxy->unpatch(depth);
 }
 
-void sema_init(sem_t *sema) {
-  MockProxy->sema_init(sema);
+void sema_init(sem_t *sema, uint32_t value) {
+  MockProxy->sema_init(sema, value);
 }
 
 void sema_wait(sem_t *sema) {
@@ -107,8 +147,8 @@ struct constr_t *normal(struct constr_t *constr) {
   return MockProxy->normal(constr);
 }
 
-prop_result_t propagate_clauses(const struct clause_list_t *clauses) {
-  return MockProxy->propagate_clauses(clauses);
+prop_result_t propagate_clauses(struct env_t *var) {
+  return MockProxy->propagate_clauses(var);
 }
 
 size_t conflict_level(void) {
@@ -119,6 +159,22 @@ struct env_t *conflict_var(void) {
   return MockProxy->conflict_var();
 }
 
+void conflict_share_init(struct env_t *env, uint32_t id) {
+  MockProxy->conflict_share_init(env, id);
+}
+
+void conflict_import(void) {
+  MockProxy->conflict_import();
+}
+
+void conflict_reduce_init(void) {
+  MockProxy->conflict_reduce_init();
+}
+
+void conflict_reduce(void) {
+  MockProxy->conflict_reduce();
+}
+
 enum objective_t objective(void) {
   return MockProxy->objective();
 }
@@ -143,8 +199,12 @@ bool objective_better() {
   return MockProxy->objective_better();
 }
 
-void objective_update_best() {
-  MockProxy->objective_update_best();
+bool objective_update_best() {
+  return MockProxy->objective_update_best();
+}
+
+domain_t objective_solution() {
+  return MockProxy->objective_solution();
 }
 
 void objective_update_val() {
@@ -155,10 +215,150 @@ struct constr_t *objective_val(void) {
   return MockProxy->objective_val();
 }
 
+void alloc_init(size_t size) {
+  MockProxy->alloc_init(size);
+}
+
+void alloc_free(void) {
+  MockProxy->alloc_free();
+}
+
+size_t alloc_size(void) {
+  return MockProxy->alloc_size();
+}
+
+void bind_init(size_t size) {
+  MockProxy->bind_init(size);
+}
+
+void bind_free(void) {
+  MockProxy->bind_free();
+}
+
+size_t bind_size(void) {
+  return MockProxy->bind_size();
+}
+
+void patch_init(size_t size) {
+  MockProxy->patch_init(size);
+}
+
+void patch_free(void) {
+  MockProxy->patch_free();
+}
+
+size_t patch_size(void) {
+  return MockProxy->patch_size();
+}
+
+void conflict_alloc_init(size_t size) {
+  MockProxy->conflict_alloc_init(size);
+}
+
+void conflict_alloc_free(void) {
+  MockProxy->conflict_alloc_free();
+}
+
+size_t conflict_alloc_size(void) {
+  return MockProxy->conflict_alloc_size();
+}
+
+void clauses_init(struct constr_t *constr, struct wand_expr_t *clause) {
+  MockProxy->clauses_init(constr, clause);
+}
+
+void compile_init(struct env_t *env) {
+  MockProxy->compile_init(env);
+}
+
+void solver_clone(struct solver_t *dst, const struct solver_t *src, struct constr_t *obj) {
+  MockProxy->solver_clone(dst, src, obj);
+}
+
+void strategy_var_order_init(size_t size, struct env_t *env) {
+  MockProxy->strategy_var_order_init(size, env);
+}
+
+void strategy_var_order_free(void) {
+  MockProxy->strategy_var_order_free();
+}
+
+void propagate_free(void) {
+  MockProxy->propagate_free();
+}
+
+void compile_free(void) {
+  MockProxy->compile_free();
+}
+
+void clause_list_free(struct clause_list_t *list) {
+  MockProxy->clause_list_free(list);
+}
+
+void strategy_var_order_remove(struct env_t *var) {
+  MockProxy->strategy_var_order_remove(var);
+}
+
+bool strategy_portfolio(void) {
+  return MockProxy->strategy_portfolio();
+}
+
+uint32_t strategy_eps(void) {
+  return MockProxy->strategy_eps();
+}
+
+uint32_t cube_count(void) {
+  return MockProxy->cube_count();
+}
+
+const char *cube_file(void) {
+  return MockProxy->cube_file();
+}
+
+void cube_write(FILE *file, struct env_t *env, const struct task_t *task) {
+  MockProxy->cube_write(file, env, task);
+}
+
+size_t cube_read(size_t size, struct env_t *env, struct decision_t **decs) {
+  return MockProxy->cube_read(size, env, decs);
+}
+
+void strategy_get(struct strategy_t *strategy) {
+  MockProxy->strategy_get(strategy);
+}
+
+void strategy_set(const struct strategy_t *strategy) {
+  MockProxy->strategy_set(strategy);
+}
+
+void strategy_diversify(uint32_t id) {
+  MockProxy->strategy_diversify(id);
+}
+
+int strategy_rand(void) {
+  return MockProxy->strategy_rand();
+}
+
+domain_t min(domain_t a, domain_t b) {
+  return MockProxy->min(a, b);
+}
+
+domain_t max(domain_t a, domain_t b) {
+  return MockProxy->max(a, b);
+}
+
+void print_fatal(const char *fmt, ...) {
+  MockProxy->print_fatal(fmt);
+}
+
 void print_error(const char *fmt, ...) {
   MockProxy->print_error(fmt);
 }
 
+void print_warning(const char *fmt, ...) {
+  MockProxy->print_warning(fmt);
+}
+
 void print_solution(FILE *file, size_t size, struct env_t *env) {
   MockProxy->print_solution(file, size, env);
 }
@@ -283,18 +483,49 @@ TEST(PrintStats, Stderr) {
 
 TEST(Shared, Init) {
   MockProxy = new Mock();
-  EXPECT_CALL(*MockProxy, sema_init(testing::_))
+  EXPECT_CALL(*MockProxy, sema_init(testing::_, 1))
+    .Times(2);
+  EXPECT_CALL(*MockProxy, sema_init(testing::_, 0))
     .Times(1);
   shared_init(7);
   EXPECT_EQ(7U, _workers_max);
   EXPECT_NE((struct shared_t *)NULL, _shared);
   EXPECT_EQ(1U, shared()->workers);
-  EXPECT_EQ(1U, shared()->workers_id);
+  EXPECT_EQ((struct task_t *)NULL, shared()->tasks);
+  EXPECT_EQ(0U, shared()->idle);
+  EXPECT_FALSE(shared()->done);
+  EXPECT_EQ((struct task_t *)NULL, shared()->subproblems);
+  EXPECT_EQ(0U, shared()->objective_epoch);
+  EXPECT_EQ(0U, shared()->confl_head);
+  EXPECT_FALSE(shared()->timeout);
   EXPECT_EQ(1U, _worker_id);
   EXPECT_EQ(0U, _worker_min_level);
   delete(MockProxy);
 }
 
+TEST(Shared, Reset) {
+  struct shared_t s;
+  _shared = &s;
+  s.workers = 4;
+  s.done = true;
+  s.timeout = true;
+  s.solutions = 17;
+  s.confl_head = 5;
+  _worker_id = 3;
+
+  MockProxy = new Mock();
+  EXPECT_CALL(*MockProxy, sema_init(testing::_, testing::_))
+    .Times(3);
+  shared_reset();
+  EXPECT_EQ(1U, s.workers);
+  EXPECT_FALSE(s.done);
+  EXPECT_FALSE(s.timeout);
+  EXPECT_EQ(0U, s.solutions);
+  EXPECT_EQ(0U, s.confl_head);
+  EXPECT_EQ(1U, _worker_id);
+  delete(MockProxy);
+}
+
 TEST(Shared, Get) {
   struct shared_t s;
   _shared = &s;
@@ -360,10 +591,6 @@ TEST(UpdateSolution, AnySolution) {
   EXPECT_CALL(*MockProxy, eval_term(&C))
     .Times(::testing::AtLeast(1))
     .WillRepeatedly(::testing::Return(VALUE(1)));
-  EXPECT_CALL(*MockProxy, sema_wait(&s.semaphore))
-    .Times(1);
-  EXPECT_CALL(*MockProxy, sema_post(&s.semaphore))
-    .Times(1);
   EXPECT_CALL(*MockProxy, objective())
     .Times(::testing::AtLeast(1))
     .WillRepeatedly(::testing::Return(OBJ_ANY));
@@ -383,10 +610,6 @@ TEST(UpdateSolution, NotBetter) {
   EXPECT_CALL(*MockProxy, eval_term(&C))
     .Times(::testing::AtLeast(1))
     .WillRepeatedly(::testing::Return(VALUE(1)));
-  EXPECT_CALL(*MockProxy, sema_wait(&s.semaphore))
-    .Times(1);
-  EXPECT_CALL(*MockProxy, sema_post(&s.semaphore))
-    .Times(1);
   EXPECT_CALL(*MockProxy, objective())
     .Times(::testing::AtLeast(1))
     .WillRepeatedly(::testing::Return(OBJ_ALL));
@@ -413,10 +636,6 @@ TEST(UpdateSolution, Better) {
   EXPECT_CALL(*MockProxy, eval_term(&C))
     .Times(::testing::AtLeast(1))
     .WillRepeatedly(::testing::Return(VALUE(1)));
-  EXPECT_CALL(*MockProxy, sema_wait(&s.semaphore))
-    .Times(1);
-  EXPECT_CALL(*MockProxy, sema_post(&s.semaphore))
-    .Times(1);
   EXPECT_CALL(*MockProxy, objective())
     .Times(::testing::AtLeast(1))
     .WillRepeatedly(::testing::Return(OBJ_ANY));
@@ -424,14 +643,138 @@ TEST(UpdateSolution, Better) {
     .Times(::testing::AtLeast(1))
     .WillRepeatedly(::testing::Return(true));
   EXPECT_CALL(*MockProxy, objective_update_best())
-    .Times(::testing::AtLeast(1));
-  EXPECT_CALL(*MockProxy, print_solution(stdout, 0, env))
-    .Times(1);
+    .Times(::testing::AtLeast(1))
+    .WillRepeatedly(::testing::Return(true));
   testing::internal::CaptureStdout();
+  solution_open();
+  EXPECT_CALL(*MockProxy, print_solution(_solution_out, 0, env))
+    .Times(1);
   EXPECT_EQ(true, update_solution(0, env, &C));
   output = testing::internal::GetCapturedStdout();
   EXPECT_EQ("#17: ", output);
   EXPECT_EQ(1U, s.solutions);
+  solution_close();
+  delete(MockProxy);
+}
+
+TEST(UpdateSolution, Raced) {
+  struct constr_t C = CONSTRAINT_TERM(VALUE(0));
+  struct env_t env[0];
+
+  struct shared_t s;
+  s.solutions = 0;
+  _shared = &s;
+
+  MockProxy = new Mock();
+  EXPECT_CALL(*MockProxy, eval_term(&C))
+    .Times(::testing::AtLeast(1))
+    .WillRepeatedly(::testing::Return(VALUE(1)));
+  EXPECT_CALL(*MockProxy, objective())
+    .Times(::testing::AtLeast(1))
+    .WillRepeatedly(::testing::Return(OBJ_MIN));
+  EXPECT_CALL(*MockProxy, sema_wait(&s.semaphore)).Times(1);
+  EXPECT_CALL(*MockProxy, sema_post(&s.semaphore)).Times(1);
+  EXPECT_CALL(*MockProxy, objective_better())
+    .Times(::testing::AtLeast(1))
+    .WillRepeatedly(::testing::Return(true));
+  EXPECT_CALL(*MockProxy, objective_update_best())
+    .Times(::testing::AtLeast(1))
+    .WillRepeatedly(::testing::Return(false));
+  EXPECT_EQ(false, update_solution(0, env, &C));
+  EXPECT_EQ(0U, s.solutions);
+  delete(MockProxy);
+}
+
+TEST(UpdateSolution, Buffered) {
+  struct constr_t C = CONSTRAINT_TERM(VALUE(0));
+  struct env_t env[0];
+
+  struct shared_t s;
+  s.solutions = 0;
+  _shared = &s;
+
+  _worker_id = 17;
+
+  std::string output;
+
+  MockProxy = new Mock();
+  EXPECT_CALL(*MockProxy, eval_term(&C))
+    .Times(::testing::AtLeast(1))
+    .WillRepeatedly(::testing::Return(VALUE(1)));
+  EXPECT_CALL(*MockProxy, objective())
+    .Times(::testing::AtLeast(1))
+    .WillRepeatedly(::testing::Return(OBJ_ALL));
+  EXPECT_CALL(*MockProxy, objective_better())
+    .Times(::testing::AtLeast(1))
+    .WillRepeatedly(::testing::Return(true));
+  EXPECT_CALL(*MockProxy, objective_update_best())
+    .Times(::testing::AtLeast(1))
+    .WillRepeatedly(::testing::Return(true));
+  testing::internal::CaptureStdout();
+  solution_open();
+  EXPECT_CALL(*MockProxy, print_solution(_solution_out, 0, env))
+    .Times(2);
+  EXPECT_EQ(true, update_solution(0, env, &C));
+  EXPECT_EQ(true, update_solution(0, env, &C));
+  EXPECT_EQ(2U, s.solutions);
+  fflush(stdout);
+  EXPECT_EQ("", testing::internal::GetCapturedStdout());
+  testing::internal::CaptureStdout();
+  solution_close();
+  output = testing::internal::GetCapturedStdout();
+  EXPECT_EQ("#17: #17: ", output);
+  delete(MockProxy);
+}
+
+static size_t _callback_size;
+static const struct env_t *_callback_env;
+static domain_t _callback_objective;
+static void *_callback_data;
+
+void test_callback(size_t size, const struct env_t *env, domain_t objective, void *data) {
+  _callback_size = size;
+  _callback_env = env;
+  _callback_objective = objective;
+  _callback_data = data;
+}
+
+TEST(UpdateSolution, Callback) {
+  struct constr_t C = CONSTRAINT_TERM(VALUE(0));
+  struct env_t env[1];
+  int data;
+
+  struct shared_t s;
+  s.solutions = 0;
+  _shared = &s;
+
+  MockProxy = new Mock();
+  EXPECT_CALL(*MockProxy, eval_term(&C))
+    .Times(::testing::AtLeast(1))
+    .WillRepeatedly(::testing::Return(VALUE(1)));
+  EXPECT_CALL(*MockProxy, objective())
+    .Times(::testing::AtLeast(1))
+    .WillRepeatedly(::testing::Return(OBJ_MIN));
+  EXPECT_CALL(*MockProxy, sema_wait(&s.semaphore)).Times(1);
+  EXPECT_CALL(*MockProxy, sema_post(&s.semaphore)).Times(1);
+  EXPECT_CALL(*MockProxy, objective_better())
+    .Times(::testing::AtLeast(1))
+    .WillRepeatedly(::testing::Return(true));
+  EXPECT_CALL(*MockProxy, objective_update_best())
+    .Times(::testing::AtLeast(1))
+    .WillRepeatedly(::testing::Return(true));
+  EXPECT_CALL(*MockProxy, objective_solution())
+    .Times(1)
+    .WillOnce(::testing::Return(23));
+  EXPECT_CALL(*MockProxy, print_solution(testing::_, testing::_, testing::_))
+    .Times(0);
+  solution_callback_init(test_callback, &data);
+  EXPECT_EQ(true, update_solution(1, env, &C));
+  solution_callback_init(NULL, NULL);
+  EXPECT_EQ(1U, s.solutions);
+  EXPECT_EQ(1U, _callback_size);
+  EXPECT_EQ(env, _callback_env);
+  EXPECT_EQ(23, _callback_objective);
+  EXPECT_EQ(&data, _callback_data);
   delete(MockProxy);
 }
 
@@ -444,7 +787,7 @@ TEST(CheckAssignment, Infeasible) {
   stats_init();
 
   MockProxy = new Mock();
-  EXPECT_CALL(*MockProxy, propagate_clauses(&e.clauses))
+  EXPECT_CALL(*MockProxy, propagate_clauses(&e))
     .Times(1)
     .WillRepeatedly(::testing::Return(PROP_ERROR));
   EXPECT_EQ(true, check_assignment(&e, 0));
@@ -462,7 +805,7 @@ TEST(CheckAssignment, Feasible) {
   stats_init();
 
   MockProxy = new Mock();
-  EXPECT_CALL(*MockProxy, propagate_clauses(&e.clauses))
+  EXPECT_CALL(*MockProxy, propagate_clauses(&e))
     .Times(::testing::AtLeast(1))
     .WillRepeatedly(::testing::Return(PROP_NONE));
   EXPECT_CALL(*MockProxy, objective_val())
@@ -546,6 +889,22 @@ TEST(Step, Activate) {
   EXPECT_EQ(0U, s.iter);
   EXPECT_EQ(0U, s.seed);
   delete(MockProxy);
+
+  MockProxy = new Mock();
+  EXPECT_CALL(*MockProxy, strategy_restart_frequency())
+    .Times(::testing::AtLeast(0))
+    .WillRepeatedly(::testing::Return(100));
+  EXPECT_CALL(*MockProxy, objective())
+    .Times(::testing::AtLeast(0))
+    .WillRepeatedly(::testing::Return(OBJ_ANY));
+  EXPECT_CALL(*MockProxy, strategy_rand())
+    .Times(1)
+    .WillOnce(::testing::Return(17));
+  s.active = false;
+  step_activate(&s, &e);
+  EXPECT_EQ(true, s.active);
+  EXPECT_EQ(17U, s.seed);
+  delete(MockProxy);
 }
 
 TEST(Step, Deactivate) {
@@ -656,6 +1015,32 @@ TEST(Step, Val) {
   EXPECT_NE(v1, v2);
 }
 
+TEST(Step, Remaining) {
+  struct step_t s;
+  domain_t lo, hi;
+
+  s.bounds = INTERVAL(3, 17);
+  for (udomain_t seed = 0; seed < 2; seed++) {
+    s.seed = seed;
+    for (s.iter = 0; s.iter < 14; s.iter++) {
+      EXPECT_EQ(true, step_remaining(&s, &lo, &hi));
+      EXPECT_EQ((domain_t)(17 - 3 - s.iter), hi - lo + 1);
+      // values tried so far lie outside of the remaining values
+      struct step_t t = s;
+      for (t.iter = 0; t.iter <= s.iter; t.iter++) {
+        domain_t v = step_val(&t);
+        EXPECT_TRUE(v < lo || v > hi);
+      }
+    }
+    s.iter = 14;
+    EXPECT_EQ(false, step_remaining(&s, &lo, &hi));
+  }
+
+  s.bounds = VALUE(5);
+  s.iter = 0;
+  EXPECT_EQ(false, step_remaining(&s, &lo, &hi));
+}
+
 TEST(Val, IsValue) {
   EXPECT_EQ(is_value(VALUE(7)), true);
   EXPECT_EQ(is_value(INTERVAL(7, 8)), false);
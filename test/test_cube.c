@@ -0,0 +1,205 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+namespace cube {
+#include "../src/cube.c"
+
+class Mock {
+ public:
+  MOCK_METHOD2(print_val, void(FILE *, struct val_t));
+  MOCK_METHOD1(print_fatal, void (const char *));
+};
+
+Mock *MockProxy;
+
+void print_val(FILE *file, struct val_t val) {
+  MockProxy->print_val(file, val);
+}
+
+void print_fatal(const char *fmt, ...) {
+  MockProxy->print_fatal(fmt);
+}
+
+void print_val_value(FILE *file, struct val_t val) {
+  fprintf(file, " %d", get_lo(val));
+}
+
+// write a string to a temporary file and return its name
+static std::string temp_file(const char *content) {
+  char name[] = "/tmp/test_cube_XXXXXX";
+  int fd = mkstemp(name);
+  FILE *file = fdopen(fd, "w");
+  fputs(content, file);
+  fclose(file);
+  return std::string(name);
+}
+
+TEST(CubeCount, Init) {
+  cube_count_init(17);
+  EXPECT_EQ(17U, _cube_count);
+  cube_count_init(0);
+  EXPECT_EQ(0U, _cube_count);
+}
+
+TEST(CubeCount, Get) {
+  _cube_count = 23;
+  EXPECT_EQ(23U, cube_count());
+  _cube_count = 0;
+  EXPECT_EQ(0U, cube_count());
+}
+
+TEST(CubeFile, Init) {
+  cube_file_init("foo");
+  EXPECT_STREQ("foo", _cube_file);
+  cube_file_init(NULL);
+  EXPECT_EQ((const char *)NULL, _cube_file);
+}
+
+TEST(CubeFile, Get) {
+  _cube_file = "bar";
+  EXPECT_STREQ("bar", cube_file());
+  _cube_file = NULL;
+  EXPECT_EQ((const char *)NULL, cube_file());
+}
+
+TEST(CubeWrite, Basic) {
+  struct env_t env[3];
+  env[0].key = "a";
+  env[1].key = "b";
+  env[2].key = "c";
+  struct decision_t decs[2] = { { .var = 2, .val = VALUE(1) },
+                                { .var = 0, .val = VALUE(-7) } };
+  struct task_t task = { .level = 2, .length = 2, .decs = decs, .next = NULL };
+
+  char *buf = NULL;
+  size_t size = 0;
+  FILE *file = open_memstream(&buf, &size);
+  MockProxy = new Mock();
+  EXPECT_CALL(*MockProxy, print_val(file, testing::_))
+    .Times(2)
+    .WillRepeatedly(testing::Invoke(print_val_value));
+  cube_write(file, env, &task);
+  delete(MockProxy);
+  fclose(file);
+
+  EXPECT_STREQ("CUBE: c = 1, a = -7, \n", buf);
+  free(buf);
+}
+
+TEST(CubeRead, Basic) {
+  struct env_t env[3];
+  env[0].key = "a";
+  env[1].key = "b";
+  env[2].key = "c";
+
+  std::string name = temp_file("CUBE: c = 1, a = -7, \nb=0\n");
+  _cube_file = name.c_str();
+  struct decision_t *decs = NULL;
+  MockProxy = new Mock();
+  size_t length = cube_read(3, env, &decs);
+  delete(MockProxy);
+  unlink(name.c_str());
+  _cube_file = NULL;
+
+  EXPECT_EQ(3U, length);
+  EXPECT_EQ(2U, decs[0].var);
+  EXPECT_EQ(1, get_lo(decs[0].val));
+  EXPECT_EQ(1, get_hi(decs[0].val));
+  EXPECT_EQ(0U, decs[1].var);
+  EXPECT_EQ(-7, get_lo(decs[1].val));
+  EXPECT_EQ(-7, get_hi(decs[1].val));
+  EXPECT_EQ(1U, decs[2].var);
+  EXPECT_EQ(0, get_lo(decs[2].val));
+  EXPECT_EQ(0, get_hi(decs[2].val));
+  free(decs);
+}
+
+TEST(CubeRead, Empty) {
+  struct env_t env[1];
+  env[0].key = "a";
+
+  std::string name = temp_file("CUBE: \n");
+  _cube_file = name.c_str();
+  struct decision_t *decs = NULL;
+  MockProxy = new Mock();
+  EXPECT_EQ(0U, cube_read(1, env, &decs));
+  delete(MockProxy);
+  unlink(name.c_str());
+  _cube_file = NULL;
+
+  EXPECT_EQ((struct decision_t *)NULL, decs);
+}
+
+TEST(CubeRead, Interval) {
+  struct env_t env[2];
+  env[0].key = "a";
+  env[1].key = "b";
+
+  std::string name = temp_file("CUBE: b = 4, a = [-2;5], \n");
+  _cube_file = name.c_str();
+  struct decision_t *decs = NULL;
+  MockProxy = new Mock();
+  size_t length = cube_read(2, env, &decs);
+  delete(MockProxy);
+  unlink(name.c_str());
+  _cube_file = NULL;
+
+  EXPECT_EQ(2U, length);
+  EXPECT_EQ(1U, decs[0].var);
+  EXPECT_EQ(4, get_lo(decs[0].val));
+  EXPECT_EQ(4, get_hi(decs[0].val));
+  EXPECT_EQ(0U, decs[1].var);
+  EXPECT_EQ(-2, get_lo(decs[1].val));
+  EXPECT_EQ(5, get_hi(decs[1].val));
+  free(decs);
+}
+
+TEST(CubeRead, Errors) {
+  struct env_t env[1];
+  env[0].key = "a";
+  struct decision_t *decs = NULL;
+
+  std::string name = temp_file("x = 1");
+  _cube_file = name.c_str();
+  MockProxy = new Mock();
+  EXPECT_CALL(*MockProxy, print_fatal(ERROR_MSG_UNKNOWN_CUBE_VARIABLE)).Times(1);
+  cube_read(1, env, &decs);
+  delete(MockProxy);
+  unlink(name.c_str());
+  free(decs);
+  decs = NULL;
+
+  name = temp_file("a := 1");
+  _cube_file = name.c_str();
+  MockProxy = new Mock();
+  EXPECT_CALL(*MockProxy, print_fatal(ERROR_MSG_INVALID_CUBE)).Times(1);
+  cube_read(1, env, &decs);
+  delete(MockProxy);
+  unlink(name.c_str());
+  free(decs);
+  decs = NULL;
+
+  // empty intervals
+  name = temp_file("a = [3;2]");
+  _cube_file = name.c_str();
+  MockProxy = new Mock();
+  EXPECT_CALL(*MockProxy, print_fatal(ERROR_MSG_INVALID_CUBE)).Times(1);
+  cube_read(1, env, &decs);
+  delete(MockProxy);
+  unlink(name.c_str());
+  free(decs);
+  decs = NULL;
+
+  // intervals before other bindings
+  name = temp_file("a = [1;2], a = 1");
+  _cube_file = name.c_str();
+  MockProxy = new Mock();
+  EXPECT_CALL(*MockProxy, print_fatal(ERROR_MSG_INVALID_CUBE)).Times(1);
+  cube_read(1, env, &decs);
+  delete(MockProxy);
+  unlink(name.c_str());
+  free(decs);
+  _cube_file = NULL;
+}
+
+}
@@ -21,6 +21,19 @@ class Mock {
 
 Mock *MockProxy;
 
+static char _test_stack[1 << 12];
+static size_t _test_stack_ptr;
+
+void *alloc(size_t size) {
+  void *retval = &_test_stack[_test_stack_ptr];
+  _test_stack_ptr += (size + sizeof(void *) - 1) & ~(sizeof(void *) - 1);
+  return retval;
+}
+
+void dealloc(void *elem) {
+  _test_stack_ptr = (char *)elem - _test_stack;
+}
+
 void print_fatal(const char *fmt, ...) {
   MockProxy->print_fatal(fmt);
 }
@@ -209,6 +222,111 @@ TEST(EvalMul, Min) {
   EXPECT_EQ(INTERVAL(DOMAIN_MIN, DOMAIN_MAX), eval_mul(&X));
 }
 
+TEST(EvalQuotVals, Basic) {
+  // product and factor without zero
+  EXPECT_EQ(VALUE(3), eval_quot_vals(VALUE(21), INTERVAL(7, 8)));
+  EXPECT_EQ(INTERVAL(2, 3), eval_quot_vals(INTERVAL(14, 24), INTERVAL(7, 8)));
+  EXPECT_EQ(INTERVAL(-3, -2), eval_quot_vals(INTERVAL(14, 24), INTERVAL(-8, -7)));
+  // factor crossing zero
+  EXPECT_EQ(INTERVAL(-12, 12), eval_quot_vals(VALUE(12), INTERVAL(-3, 3)));
+  EXPECT_EQ(INTERVAL(-3, 3), eval_quot_vals(INTERVAL(-6, 6), INTERVAL(2, 3)));
+  // any value fits if both may be zero
+  EXPECT_EQ(INTERVAL(DOMAIN_MIN, DOMAIN_MAX), eval_quot_vals(INTERVAL(-1, 1), INTERVAL(0, 3)));
+  // no value fits
+  struct val_t v = eval_quot_vals(VALUE(5), VALUE(2));
+  EXPECT_GT(get_lo(v), get_hi(v));
+  v = eval_quot_vals(VALUE(5), VALUE(0));
+  EXPECT_GT(get_lo(v), get_hi(v));
+  // saturated bounds act as infinity
+  EXPECT_EQ(INTERVAL(1, DOMAIN_MAX), eval_quot_vals(INTERVAL(2, DOMAIN_MAX), VALUE(2)));
+}
+
+TEST(EvalDiv, Basic) {
+  struct constr_t A = CONSTRAINT_TERM(VALUE(7));
+  struct constr_t B = CONSTRAINT_TERM(VALUE(-2));
+  struct constr_t C = CONSTRAINT_TERM(INTERVAL(-7, 9));
+  struct constr_t D = CONSTRAINT_TERM(INTERVAL(2, 3));
+  struct constr_t E = CONSTRAINT_TERM(INTERVAL(-1, 2));
+  struct constr_t Z = CONSTRAINT_TERM(VALUE(0));
+  struct constr_t X;
+
+  X = CONSTRAINT_EXPR(DIV, &A, &B);
+  EXPECT_EQ(VALUE(-3), eval_div(&X));
+  X = CONSTRAINT_EXPR(DIV, &C, &D);
+  EXPECT_EQ(INTERVAL(-3, 4), eval_div(&X));
+  X = CONSTRAINT_EXPR(DIV, &A, &E);
+  EXPECT_EQ(INTERVAL(-7, 7), eval_div(&X));
+  X = CONSTRAINT_EXPR(DIV, &A, &Z);
+  EXPECT_EQ(VALUE(0), eval_div(&X));
+}
+
+TEST(EvalMod, Basic) {
+  struct constr_t A = CONSTRAINT_TERM(VALUE(7));
+  struct constr_t B = CONSTRAINT_TERM(VALUE(-3));
+  struct constr_t C = CONSTRAINT_TERM(INTERVAL(-7, 9));
+  struct constr_t D = CONSTRAINT_TERM(INTERVAL(2, 3));
+  struct constr_t E = CONSTRAINT_TERM(INTERVAL(0, 1));
+  struct constr_t F = CONSTRAINT_TERM(INTERVAL(10, 20));
+  struct constr_t Z = CONSTRAINT_TERM(VALUE(0));
+  struct constr_t X;
+
+  X = CONSTRAINT_EXPR(MOD, &A, &B);
+  EXPECT_EQ(VALUE(1), eval_mod(&X));
+  X = CONSTRAINT_EXPR(MOD, &B, &A);
+  EXPECT_EQ(VALUE(-3), eval_mod(&X));
+  X = CONSTRAINT_EXPR(MOD, &C, &D);
+  EXPECT_EQ(INTERVAL(-2, 2), eval_mod(&X));
+  X = CONSTRAINT_EXPR(MOD, &E, &F);
+  EXPECT_EQ(INTERVAL(0, 1), eval_mod(&X));
+  X = CONSTRAINT_EXPR(MOD, &F, &E);
+  EXPECT_EQ(INTERVAL(0, 20), eval_mod(&X));
+  X = CONSTRAINT_EXPR(MOD, &A, &Z);
+  EXPECT_EQ(VALUE(7), eval_mod(&X));
+}
+
+TEST(EvalAbs, Basic) {
+  struct constr_t A = CONSTRAINT_TERM(VALUE(-7));
+  struct constr_t B = CONSTRAINT_TERM(INTERVAL(-3, 5));
+  struct constr_t C = CONSTRAINT_TERM(INTERVAL(-9, -2));
+  struct constr_t D = CONSTRAINT_TERM(INTERVAL(DOMAIN_MIN, 1));
+  struct constr_t X;
+
+  X = CONSTRAINT_EXPR(ABS, &A, NULL);
+  EXPECT_EQ(VALUE(7), eval_abs(&X));
+  X = CONSTRAINT_EXPR(ABS, &B, NULL);
+  EXPECT_EQ(INTERVAL(0, 5), eval_abs(&X));
+  X = CONSTRAINT_EXPR(ABS, &C, NULL);
+  EXPECT_EQ(INTERVAL(2, 9), eval_abs(&X));
+  X = CONSTRAINT_EXPR(ABS, &D, NULL);
+  EXPECT_EQ(INTERVAL(0, DOMAIN_MAX), eval_abs(&X));
+}
+
+TEST(EvalMin, Basic) {
+  struct constr_t A = CONSTRAINT_TERM(INTERVAL(1, 5));
+  struct constr_t B = CONSTRAINT_TERM(INTERVAL(3, 4));
+  struct constr_t X;
+
+  X = CONSTRAINT_EXPR(MIN, &A, &B);
+  EXPECT_EQ(INTERVAL(1, 4), eval_min(&X));
+  X = CONSTRAINT_EXPR(MAX, &A, &B);
+  EXPECT_EQ(INTERVAL(3, 5), eval_max(&X));
+}
+
+TEST(EvalLin, Basic) {
+  struct constr_t A = CONSTRAINT_TERM(VALUE(5));
+  struct constr_t B = CONSTRAINT_TERM(INTERVAL(1, 2));
+  struct constr_t C = CONSTRAINT_TERM(INTERVAL(0, DOMAIN_MAX));
+  struct lin_term_t terms[3] = { { 2, &A }, { -3, &B }, { 4, &C } };
+  struct constr_t X;
+
+  X = CONSTRAINT_LIN(2, terms);
+  EXPECT_EQ(INTERVAL(4, 7), eval_lin(&X));
+  X = CONSTRAINT_LIN(3, terms);
+  EXPECT_EQ(INTERVAL(4, DOMAIN_MAX), eval_lin(&X));
+  X = CONSTRAINT_LIN(1, terms);
+  EXPECT_EQ(VALUE(10), eval_lin(&X));
+}
+
 TEST(EvalLt, Basic) {
   struct constr_t A = CONSTRAINT_TERM(VALUE(2));
   struct constr_t B = CONSTRAINT_TERM(VALUE(-3));
@@ -375,6 +493,108 @@ TEST(EvalOr, Basic) {
   EXPECT_EQ(INTERVAL(0, 1), eval_or(&X));
 }
 
+TEST(EvalDiff, Basic) {
+  struct constr_t A = CONSTRAINT_TERM(INTERVAL(0, 3));
+  struct constr_t B = CONSTRAINT_TERM(INTERVAL(2, 5));
+  struct constr_t X;
+
+  // A - B lies within [-5;1]
+  X = CONSTRAINT_DIFF(&A, &B, 1);
+  EXPECT_EQ(VALUE(1), eval_diff(&X));
+  X = CONSTRAINT_DIFF(&A, &B, 0);
+  EXPECT_EQ(INTERVAL(0, 1), eval_diff(&X));
+  X = CONSTRAINT_DIFF(&A, &B, -5);
+  EXPECT_EQ(INTERVAL(0, 1), eval_diff(&X));
+  X = CONSTRAINT_DIFF(&A, &B, -6);
+  EXPECT_EQ(VALUE(0), eval_diff(&X));
+
+  // no conclusions on saturated values
+  struct constr_t C = CONSTRAINT_TERM(INTERVAL(0, DOMAIN_MAX));
+  X = CONSTRAINT_DIFF(&A, &C, DOMAIN_MAX);
+  EXPECT_EQ(INTERVAL(0, 1), eval_diff(&X));
+}
+
+TEST(EvalAlldiff, Basic) {
+  struct constr_t A = CONSTRAINT_TERM(VALUE(1));
+  struct constr_t B = CONSTRAINT_TERM(VALUE(2));
+  struct constr_t C = CONSTRAINT_TERM(INTERVAL(3, 5));
+  struct constr_t D = CONSTRAINT_TERM(INTERVAL(0, 4));
+  struct constr_t E = CONSTRAINT_TERM(VALUE(1));
+  struct constr_t X;
+
+  struct constr_t *diff[3] = { &C, &B, &A };
+  X = CONSTRAINT_ALLDIFF(3, diff);
+  EXPECT_EQ(VALUE(1), eval_alldiff(&X));
+
+  struct constr_t *overlap[3] = { &A, &D, &C };
+  X = CONSTRAINT_ALLDIFF(3, overlap);
+  EXPECT_EQ(INTERVAL(0, 1), eval_alldiff(&X));
+
+  struct constr_t *same[3] = { &A, &D, &E };
+  X = CONSTRAINT_ALLDIFF(3, same);
+  EXPECT_EQ(VALUE(0), eval_alldiff(&X));
+
+  X = CONSTRAINT_ALLDIFF(0, NULL);
+  EXPECT_EQ(VALUE(1), eval_alldiff(&X));
+}
+
+TEST(EvalDisj, Basic) {
+  struct constr_t A = CONSTRAINT_TERM(VALUE(0));
+  struct constr_t B = CONSTRAINT_TERM(INTERVAL(5, 6));
+  struct constr_t C = CONSTRAINT_TERM(INTERVAL(2, 6));
+  struct constr_t D = CONSTRAINT_TERM(INTERVAL(1, 2));
+  struct constr_t K0 = CONSTRAINT_TERM(VALUE(0));
+  struct constr_t K2 = CONSTRAINT_TERM(VALUE(2));
+  struct constr_t K3 = CONSTRAINT_TERM(VALUE(3));
+  struct constr_t X;
+
+  struct sched_task_t apart[2] = { { &A, &K3, NULL }, { &B, &K2, NULL } };
+  X = CONSTRAINT_DISJ(2, apart);
+  EXPECT_EQ(VALUE(1), eval_disj(&X));
+
+  struct sched_task_t maybe[2] = { { &A, &K3, NULL }, { &C, &K2, NULL } };
+  X = CONSTRAINT_DISJ(2, maybe);
+  EXPECT_EQ(INTERVAL(0, 1), eval_disj(&X));
+
+  // both tasks must run at time 2
+  struct sched_task_t overlap[2] = { { &D, &K3, NULL }, { &K2, &K2, NULL } };
+  X = CONSTRAINT_DISJ(2, overlap);
+  EXPECT_EQ(VALUE(0), eval_disj(&X));
+
+  // tasks without duration do not use the resource
+  struct sched_task_t empty[2] = { { &A, &K3, NULL }, { &D, &K0, NULL } };
+  X = CONSTRAINT_DISJ(2, empty);
+  EXPECT_EQ(VALUE(1), eval_disj(&X));
+
+  X = CONSTRAINT_DISJ(0, NULL);
+  EXPECT_EQ(VALUE(1), eval_disj(&X));
+}
+
+TEST(EvalCumul, Basic) {
+  struct constr_t A = CONSTRAINT_TERM(VALUE(0));
+  struct constr_t B = CONSTRAINT_TERM(INTERVAL(0, 1));
+  struct constr_t C = CONSTRAINT_TERM(INTERVAL(0, 9));
+  struct constr_t K1 = CONSTRAINT_TERM(VALUE(1));
+  struct constr_t K2 = CONSTRAINT_TERM(VALUE(2));
+  struct constr_t K3 = CONSTRAINT_TERM(VALUE(3));
+  struct constr_t X;
+
+  struct sched_task_t fit[2] = { { &A, &K2, &K1 }, { &B, &K2, &K1 } };
+  X = CONSTRAINT_CUMUL(2, fit, &K2);
+  EXPECT_EQ(VALUE(1), eval_cumul(&X));
+  X = CONSTRAINT_CUMUL(2, fit, &K1);
+  EXPECT_EQ(VALUE(0), eval_cumul(&X));
+
+  struct sched_task_t maybe[3] = { { &A, &K2, &K1 }, { &B, &K2, &K1 }, { &C, &K1, &K1 } };
+  X = CONSTRAINT_CUMUL(3, maybe, &K2);
+  EXPECT_EQ(INTERVAL(0, 1), eval_cumul(&X));
+
+  // a task may need more than the capacity
+  struct sched_task_t large[1] = { { &C, &K1, &K3 } };
+  X = CONSTRAINT_CUMUL(1, large, &K2);
+  EXPECT_EQ(VALUE(0), eval_cumul(&X));
+}
+
 TEST(EvalWand, Basic) {
   struct constr_t A = CONSTRAINT_TERM(VALUE(0));
   struct constr_t B = CONSTRAINT_TERM(VALUE(1));
@@ -417,4 +637,24 @@ TEST(EvalWand, Basic) {
   EXPECT_EQ(INTERVAL(0, 1), eval_wand(&X9));
 }
 
+TEST(EvalCache, Basic) {
+  struct constr_t A = CONSTRAINT_TERM(VALUE(1));
+  struct constr_t B = CONSTRAINT_TERM(INTERVAL(0, 99));
+  struct constr_t S = CONSTRAINT_EXPR(ADD, &A, &B);
+  struct constr_t X = CONSTRAINT_EXPR(NEG, &S, NULL);
+
+  EXPECT_EQ(0U, X.cache_epoch);
+  EXPECT_EQ(INTERVAL(-100, -1), eval_neg(&X));
+  EXPECT_EQ(eval_epoch, X.cache_epoch);
+  EXPECT_EQ(eval_epoch, S.cache_epoch);
+  EXPECT_EQ(INTERVAL(1, 100), S.cache);
+
+  // values are reused until a terminal changes
+  B.constr.term.val = VALUE(9);
+  EXPECT_EQ(INTERVAL(-100, -1), eval_neg(&X));
+  eval_invalidate();
+  EXPECT_EQ(VALUE(-10), eval_neg(&X));
+  EXPECT_EQ(VALUE(10), eval_add(&S));
+}
+
 } // end namespace
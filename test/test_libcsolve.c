@@ -0,0 +1,678 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+namespace libcsolve {
+#include "../src/constr_types.c"
+#include "../src/libcsolve.c"
+
+bool operator==(const struct val_t& lhs, const struct val_t& rhs) {
+  return memcmp(&lhs, &rhs, sizeof(lhs)) == 0;
+}
+
+class Mock {
+ public:
+  MOCK_METHOD1(alloc, void *(size_t));
+  MOCK_METHOD1(dealloc, void(void *));
+  MOCK_METHOD1(alloc_init, void(size_t));
+  MOCK_METHOD0(alloc_free, void(void));
+  MOCK_METHOD1(bind_init, void(size_t));
+  MOCK_METHOD0(bind_free, void(void));
+  MOCK_METHOD1(bind_level_set, void(size_t));
+  MOCK_METHOD1(patch_init, void(size_t));
+  MOCK_METHOD0(patch_free, void(void));
+  MOCK_METHOD1(conflict_alloc_init, void(size_t));
+  MOCK_METHOD0(conflict_alloc_free, void(void));
+  MOCK_METHOD1(shared_init, void(uint32_t));
+  MOCK_METHOD0(shared_free, void(void));
+  MOCK_METHOD0(shared, struct shared_t *(void));
+  MOCK_METHOD3(objective_init, void(enum objective_t, volatile domain_t *, volatile uint64_t *));
+  MOCK_METHOD0(objective_val, struct constr_t *(void));
+  MOCK_METHOD1(strategy_create_conflicts_init, void(bool));
+  MOCK_METHOD1(strategy_prefer_failing_init, void(bool));
+  MOCK_METHOD1(strategy_compute_weights_init, void(bool));
+  MOCK_METHOD1(strategy_restart_frequency_init, void(uint64_t));
+  MOCK_METHOD1(strategy_order_init, void(enum order_t));
+  MOCK_METHOD1(strategy_prop_order_init, void(enum prop_order_t));
+  MOCK_METHOD1(strategy_portfolio_init, void(bool));
+  MOCK_METHOD1(strategy_eps_init, void(uint32_t));
+  MOCK_METHOD1(strategy_set, void(const struct strategy_t *));
+  MOCK_METHOD0(strategy_var_order_free, void(void));
+  MOCK_METHOD0(propagate_free, void(void));
+  MOCK_METHOD0(compile_free, void(void));
+  MOCK_METHOD1(cube_count_init, void(uint32_t));
+  MOCK_METHOD1(cube_file_init, void(const char *));
+  MOCK_METHOD1(stats_frequency_init, void(uint64_t));
+  MOCK_METHOD1(timeout_init, void(uint32_t));
+  MOCK_METHOD2(vars_add, void(const char *, struct constr_t *));
+  MOCK_METHOD0(env_free, void(void));
+  MOCK_METHOD1(expr_free, void(struct constr_t *));
+  MOCK_METHOD2(model_presolve, struct constr_t *(struct constr_t *, struct env_t **));
+  MOCK_METHOD0(var_count, size_t(void));
+  MOCK_METHOD2(clauses_init, void(struct constr_t *, struct wand_expr_t *));
+  MOCK_METHOD0(bind_depth, size_t(void));
+  MOCK_METHOD3(bind, prop_event_t(struct env_t *, struct val_t, const struct wand_expr_t *));
+  MOCK_METHOD1(unbind, void(size_t));
+  MOCK_METHOD2(patch, size_t(struct wand_expr_t *, struct constr_t *));
+  MOCK_METHOD1(unpatch, void(size_t));
+  MOCK_METHOD0(conflict_alloc_depth, size_t(void));
+  MOCK_METHOD1(conflict_alloc_release, void(size_t));
+  MOCK_METHOD1(conflict_root_init, void(size_t));
+  MOCK_METHOD2(propagate, prop_result_t(struct constr_t *, size_t));
+  MOCK_METHOD1(propagate_clauses, prop_result_t(struct env_t *));
+  MOCK_METHOD0(shared_reset, void(void));
+  MOCK_METHOD0(objective_reset, void(void));
+  MOCK_METHOD0(objective, enum objective_t(void));
+  MOCK_METHOD2(strategy_var_order_init, void(size_t, struct env_t *));
+  MOCK_METHOD3(solve, void(size_t, struct env_t *, struct constr_t *));
+  MOCK_METHOD2(solution_callback_init, void(solution_callback_t, void *));
+  MOCK_METHOD1(print_fatal, void (const char *));
+#define CONSTR_TYPE_MOCKS(UPNAME, NAME, OP) \
+  MOCK_METHOD1(eval_ ## NAME, struct val_t(const struct constr_t *)); \
+  MOCK_METHOD3(propagate_ ## NAME, prop_result_t(struct constr_t *, struct val_t, const struct wand_expr_t *)); \
+  MOCK_METHOD1(normal_ ## NAME, struct constr_t *(struct constr_t *));
+  CONSTR_TYPE_LIST(CONSTR_TYPE_MOCKS)
+};
+
+Mock *MockProxy;
+
+THREAD_LOCAL uint64_t eval_epoch;
+
+void *alloc(size_t size) {
+  return MockProxy->alloc(size);
+}
+
+void dealloc(void *elem) {
+  MockProxy->dealloc(elem);
+}
+
+void alloc_init(size_t size) {
+  MockProxy->alloc_init(size);
+}
+
+void alloc_free(void) {
+  MockProxy->alloc_free();
+}
+
+void bind_init(size_t size) {
+  MockProxy->bind_init(size);
+}
+
+void bind_free(void) {
+  MockProxy->bind_free();
+}
+
+void bind_level_set(size_t level) {
+  MockProxy->bind_level_set(level);
+}
+
+void patch_init(size_t size) {
+  MockProxy->patch_init(size);
+}
+
+void patch_free(void) {
+  MockProxy->patch_free();
+}
+
+void conflict_alloc_init(size_t size) {
+  MockProxy->conflict_alloc_init(size);
+}
+
+void conflict_alloc_free(void) {
+  MockProxy->conflict_alloc_free();
+}
+
+void shared_init(uint32_t workers_max) {
+  MockProxy->shared_init(workers_max);
+}
+
+void shared_free(void) {
+  MockProxy->shared_free();
+}
+
+struct shared_t *shared(void) {
+  return MockProxy->shared();
+}
+
+void objective_init(enum objective_t o, volatile domain_t *best, volatile uint64_t *epoch) {
+  MockProxy->objective_init(o, best, epoch);
+}
+
+struct constr_t *objective_val(void) {
+  return MockProxy->objective_val();
+}
+
+void strategy_create_conflicts_init(bool create_conflicts) {
+  MockProxy->strategy_create_conflicts_init(create_conflicts);
+}
+
+void strategy_prefer_failing_init(bool prefer_failing) {
+  MockProxy->strategy_prefer_failing_init(prefer_failing);
+}
+
+void strategy_compute_weights_init(bool compute_weights) {
+  MockProxy->strategy_compute_weights_init(compute_weights);
+}
+
+void strategy_restart_frequency_init(uint64_t restart_frequency) {
+  MockProxy->strategy_restart_frequency_init(restart_frequency);
+}
+
+void strategy_order_init(enum order_t order) {
+  MockProxy->strategy_order_init(order);
+}
+
+void strategy_prop_order_init(enum prop_order_t prop_order) {
+  MockProxy->strategy_prop_order_init(prop_order);
+}
+
+void strategy_portfolio_init(bool portfolio) {
+  MockProxy->strategy_portfolio_init(portfolio);
+}
+
+void strategy_eps_init(uint32_t eps) {
+  MockProxy->strategy_eps_init(eps);
+}
+
+void strategy_set(const struct strategy_t *strategy) {
+  MockProxy->strategy_set(strategy);
+}
+
+void strategy_var_order_free(void) {
+  MockProxy->strategy_var_order_free();
+}
+
+void propagate_free(void) {
+  MockProxy->propagate_free();
+}
+
+void compile_free(void) {
+  MockProxy->compile_free();
+}
+
+void cube_count_init(uint32_t count) {
+  MockProxy->cube_count_init(count);
+}
+
+void cube_file_init(const char *file) {
+  MockProxy->cube_file_init(file);
+}
+
+void stats_frequency_init(uint64_t freq) {
+  MockProxy->stats_frequency_init(freq);
+}
+
+void timeout_init(uint32_t time_max) {
+  MockProxy->timeout_init(time_max);
+}
+
+void vars_add(const char *key, struct constr_t *val) {
+  MockProxy->vars_add(key, val);
+}
+
+void env_free(void) {
+  MockProxy->env_free();
+}
+
+void expr_free(struct constr_t *constr) {
+  MockProxy->expr_free(constr);
+}
+
+struct constr_t *model_presolve(struct constr_t *constr, struct env_t **env) {
+  return MockProxy->model_presolve(constr, env);
+}
+
+size_t var_count(void) {
+  return MockProxy->var_count();
+}
+
+void clauses_init(struct constr_t *constr, struct wand_expr_t *clause) {
+  MockProxy->clauses_init(constr, clause);
+}
+
+size_t bind_depth(void) {
+  return MockProxy->bind_depth();
+}
+
+prop_event_t bind(struct env_t *var, struct val_t val, const struct wand_expr_t *clause) {
+  return MockProxy->bind(var, val, clause);
+}
+
+void unbind(size_t depth) {
+  MockProxy->unbind(depth);
+}
+
+size_t patch(struct wand_expr_t *loc, struct constr_t *constr) {
+  return MockProxy->patch(loc, constr);
+}
+
+void unpatch(size_t depth) {
+  MockProxy->unpatch(depth);
+}
+
+size_t conflict_alloc_depth(void) {
+  return MockProxy->conflict_alloc_depth();
+}
+
+void conflict_alloc_release(size_t depth) {
+  MockProxy->conflict_alloc_release(depth);
+}
+
+void conflict_root_init(size_t depth) {
+  MockProxy->conflict_root_init(depth);
+}
+
+prop_result_t propagate(struct constr_t *constr, size_t limit) {
+  return MockProxy->propagate(constr, limit);
+}
+
+prop_result_t propagate_clauses(struct env_t *var) {
+  return MockProxy->propagate_clauses(var);
+}
+
+void shared_reset(void) {
+  MockProxy->shared_reset();
+}
+
+void objective_reset(void) {
+  MockProxy->objective_reset();
+}
+
+enum objective_t objective(void) {
+  return MockProxy->objective();
+}
+
+void strategy_var_order_init(size_t size, struct env_t *env) {
+  MockProxy->strategy_var_order_init(size, env);
+}
+
+void solve(size_t size, struct env_t *env, struct constr_t *constr) {
+  MockProxy->solve(size, env, constr);
+}
+
+void solution_callback_init(solution_callback_t callback, void *data) {
+  MockProxy->solution_callback_init(callback, data);
+}
+
+void print_fatal(const char *fmt, ...) {
+  MockProxy->print_fatal(fmt);
+}
+
+#define CONSTR_TYPE_CMOCKS(UPNAME, NAME, OP)                            \
+struct val_t eval_ ## NAME(const struct constr_t *constr) {       \
+  return MockProxy->eval_ ## NAME(constr);                              \
+}                                                                       \
+prop_result_t propagate_ ## NAME(struct constr_t *constr, struct val_t val, const struct wand_expr_t *clause) { \
+  return MockProxy->propagate_ ## NAME(constr, val, clause);            \
+}                                                                       \
+struct constr_t *normal_ ## NAME(struct constr_t *constr) {             \
+  return MockProxy->normal_ ## NAME(constr);                            \
+}
+CONSTR_TYPE_LIST(CONSTR_TYPE_CMOCKS)
+
+static char _test_stack[1 << 16];
+static size_t _test_stack_ptr;
+
+void *test_alloc(size_t size) {
+  void *retval = &_test_stack[_test_stack_ptr];
+  _test_stack_ptr += (size + sizeof(void *) - 1) & ~(sizeof(void *) - 1);
+  return retval;
+}
+
+// set up a handle without going through csolve_new
+static void test_handle(struct csolve_t *h, struct shared_t *s) {
+  _test_stack_ptr = 0;
+  h->workers = 3;
+  h->mark = _test_stack;
+  EXPECT_CALL(*MockProxy, alloc(testing::_))
+    .WillRepeatedly(testing::Invoke(test_alloc));
+  EXPECT_CALL(*MockProxy, shared())
+    .WillRepeatedly(testing::Return(s));
+  EXPECT_CALL(*MockProxy, shared_init(3)).Times(1);
+  EXPECT_CALL(*MockProxy, objective_init(OBJ_ANY, &s->objective_best, &s->objective_epoch)).Times(1);
+  EXPECT_CALL(*MockProxy, bind_level_set(-1)).Times(1);
+  model_init(h);
+}
+
+TEST(Csolve, New) {
+  struct shared_t s;
+
+  MockProxy = new Mock();
+  _test_stack_ptr = 0;
+  EXPECT_CALL(*MockProxy, alloc(testing::_))
+    .WillRepeatedly(testing::Invoke(test_alloc));
+  EXPECT_CALL(*MockProxy, shared())
+    .WillRepeatedly(testing::Return(&s));
+  EXPECT_CALL(*MockProxy, alloc_init(ALLOC_STACK_SIZE_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, bind_init(BIND_STACK_SIZE_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, patch_init(PATCH_STACK_SIZE_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, conflict_alloc_init(CONFLICT_ALLOC_STACK_SIZE_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, strategy_create_conflicts_init(STRATEGY_CREATE_CONFLICTS_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, strategy_prefer_failing_init(STRATEGY_PREFER_FAILING_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, strategy_compute_weights_init(STRATEGY_COMPUTE_WEIGHTS_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, strategy_restart_frequency_init(STRATEGY_RESTART_FREQUENCY_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, strategy_order_init(STRATEGY_ORDER_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, strategy_prop_order_init(STRATEGY_PROP_ORDER_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, strategy_portfolio_init(STRATEGY_PORTFOLIO_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, strategy_eps_init(STRATEGY_EPS_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, cube_count_init(CUBE_COUNT_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, cube_file_init(NULL)).Times(1);
+  EXPECT_CALL(*MockProxy, stats_frequency_init(0)).Times(1);
+  EXPECT_CALL(*MockProxy, timeout_init(0)).Times(1);
+  EXPECT_CALL(*MockProxy, shared_init(2)).Times(1);
+  EXPECT_CALL(*MockProxy, objective_init(OBJ_ANY, &s.objective_best, &s.objective_epoch)).Times(1);
+  EXPECT_CALL(*MockProxy, bind_level_set(-1)).Times(1);
+  struct csolve_t *h = csolve_new(2);
+  EXPECT_EQ(2U, h->workers);
+  EXPECT_EQ((void *)&_test_stack[0], h->mark);
+  EXPECT_EQ(&CONSTR_WAND, h->model->type);
+  EXPECT_EQ(1U, h->model->constr.wand.length);
+  EXPECT_EQ(VALUE(1), h->model->constr.wand.elems[0].constr->constr.term.val);
+  delete(MockProxy);
+
+  MockProxy = new Mock();
+  struct constr_t *model = h->model;
+  EXPECT_CALL(*MockProxy, expr_free(model)).Times(1);
+  EXPECT_CALL(*MockProxy, env_free()).Times(1);
+  EXPECT_CALL(*MockProxy, strategy_var_order_free()).Times(1);
+  EXPECT_CALL(*MockProxy, conflict_alloc_free()).Times(2);
+  EXPECT_CALL(*MockProxy, conflict_alloc_init(CONFLICT_ALLOC_STACK_SIZE_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, dealloc(&_test_stack[0])).Times(1);
+  EXPECT_CALL(*MockProxy, shared_free()).Times(1);
+  EXPECT_CALL(*MockProxy, propagate_free()).Times(1);
+  EXPECT_CALL(*MockProxy, compile_free()).Times(1);
+  EXPECT_CALL(*MockProxy, patch_free()).Times(1);
+  EXPECT_CALL(*MockProxy, bind_free()).Times(1);
+  EXPECT_CALL(*MockProxy, alloc_free()).Times(1);
+  free(model->constr.wand.elems);
+  csolve_free(h);
+  delete(MockProxy);
+}
+
+TEST(Csolve, Build) {
+  struct shared_t s;
+  struct csolve_t h;
+
+  MockProxy = new Mock();
+  test_handle(&h, &s);
+
+  struct constr_t *x = NULL;
+  EXPECT_CALL(*MockProxy, vars_add(testing::StrEq("x"), testing::_))
+    .WillOnce(testing::SaveArg<1>(&x));
+  struct constr_t *v = csolve_var(&h, "x", 1, 5);
+  EXPECT_EQ(x, v);
+  EXPECT_EQ(&CONSTR_TERM, v->type);
+  EXPECT_EQ(INTERVAL(1, 5), v->constr.term.val);
+
+  struct constr_t *c = csolve_constr(&h, CONSTRAINT_TERM(VALUE(3)));
+  struct constr_t *e = csolve_constr(&h, CONSTRAINT_EXPR(LT, v, c));
+  EXPECT_EQ(&CONSTR_LT, e->type);
+  EXPECT_EQ(v, e->constr.expr.l);
+  EXPECT_EQ(c, e->constr.expr.r);
+
+  csolve_add(&h, e);
+  EXPECT_EQ(2U, h.model->constr.wand.length);
+  EXPECT_EQ(e, h.model->constr.wand.elems[1].constr);
+  EXPECT_EQ(e, h.model->constr.wand.elems[1].orig);
+
+  free(h.model->constr.wand.elems);
+  delete(MockProxy);
+}
+
+TEST(Csolve, Objective) {
+  struct shared_t s;
+  struct csolve_t h;
+  struct constr_t o = CONSTRAINT_TERM(INTERVAL(DOMAIN_MIN+1, DOMAIN_MAX-1));
+  struct constr_t x = CONSTRAINT_TERM(INTERVAL(0, 7));
+
+  MockProxy = new Mock();
+  test_handle(&h, &s);
+  EXPECT_CALL(*MockProxy, objective_init(OBJ_MIN, &s.objective_best, &s.objective_epoch)).Times(1);
+  EXPECT_CALL(*MockProxy, objective_val())
+    .WillRepeatedly(testing::Return(&o));
+  EXPECT_CALL(*MockProxy, vars_add(testing::StrEq("<obj>"), &o)).Times(1);
+  csolve_objective(&h, OBJ_MIN, &x);
+  struct constr_t *obj = h.model->constr.wand.elems[0].constr;
+  EXPECT_EQ(&CONSTR_EQ, obj->type);
+  EXPECT_EQ(&x, obj->constr.expr.l);
+  EXPECT_EQ(&o, obj->constr.expr.r);
+  free(h.model->constr.wand.elems);
+  delete(MockProxy);
+
+  MockProxy = new Mock();
+  test_handle(&h, &s);
+  EXPECT_CALL(*MockProxy, objective_init(OBJ_ALL, &s.objective_best, &s.objective_epoch)).Times(1);
+  EXPECT_CALL(*MockProxy, vars_add(testing::_, testing::_)).Times(0);
+  csolve_objective(&h, OBJ_ALL, NULL);
+  EXPECT_EQ(VALUE(1), h.model->constr.wand.elems[0].constr->constr.term.val);
+  free(h.model->constr.wand.elems);
+  delete(MockProxy);
+}
+
+void test_callback(size_t size, const struct env_t *env, domain_t objective, void *data) {
+}
+
+// presolve the model of a handle
+static void test_presolve(struct csolve_t *h, struct constr_t *norm, struct env_t *env, size_t size) {
+  EXPECT_CALL(*MockProxy, model_presolve(h->model, testing::_))
+    .WillOnce(testing::DoAll(testing::SetArgPointee<1>(env), testing::Return(norm)));
+  EXPECT_CALL(*MockProxy, var_count())
+    .WillOnce(testing::Return(size));
+}
+
+TEST(Csolve, Solve) {
+  struct shared_t s;
+  struct csolve_t h;
+  struct constr_t norm = CONSTRAINT_TERM(VALUE(1));
+  struct env_t env[2];
+  struct constr_t o = CONSTRAINT_TERM(INTERVAL(0, 9));
+  int data;
+
+  MockProxy = new Mock();
+  test_handle(&h, &s);
+  test_presolve(&h, &norm, env, 2);
+  s.solutions = 17;
+  {
+    testing::InSequence seq;
+    EXPECT_CALL(*MockProxy, bind_depth()).WillOnce(testing::Return(5));
+    EXPECT_CALL(*MockProxy, patch(NULL, NULL)).WillOnce(testing::Return(6));
+    EXPECT_CALL(*MockProxy, conflict_alloc_depth()).WillOnce(testing::Return(7));
+    EXPECT_CALL(*MockProxy, objective_val()).WillOnce(testing::Return(&o));
+    EXPECT_CALL(*MockProxy, shared_reset()).Times(1);
+    EXPECT_CALL(*MockProxy, objective_reset()).Times(1);
+    EXPECT_CALL(*MockProxy, conflict_root_init(SIZE_MAX)).Times(1);
+    EXPECT_CALL(*MockProxy, bind_level_set(-1)).Times(1);
+    EXPECT_CALL(*MockProxy, strategy_var_order_init(2, env)).Times(1);
+    EXPECT_CALL(*MockProxy, solution_callback_init(test_callback, &data)).Times(1);
+    EXPECT_CALL(*MockProxy, solve(2, env, &norm))
+      .WillOnce(testing::InvokeWithoutArgs([&o]() { o.constr.term.val = INTERVAL(0, 3); }));
+    EXPECT_CALL(*MockProxy, solution_callback_init(NULL, NULL)).Times(1);
+    EXPECT_CALL(*MockProxy, strategy_var_order_free()).Times(1);
+    EXPECT_CALL(*MockProxy, objective_val()).WillOnce(testing::Return(&o));
+    EXPECT_CALL(*MockProxy, objective()).WillOnce(testing::Return(OBJ_MIN));
+    EXPECT_CALL(*MockProxy, conflict_alloc_release(7)).Times(1);
+    EXPECT_CALL(*MockProxy, unbind(5)).Times(1);
+    EXPECT_CALL(*MockProxy, unpatch(6)).Times(1);
+    EXPECT_CALL(*MockProxy, dealloc(testing::_)).Times(1);
+  }
+  EXPECT_EQ(17U, csolve_solve(&h, test_callback, &data));
+  // the bound of the objective and conflicts learned under it are dropped
+  EXPECT_EQ(INTERVAL(0, 9), o.constr.term.val);
+  EXPECT_TRUE(h.presolved);
+  EXPECT_FALSE(h.infeasible);
+  EXPECT_EQ(&norm, h.norm);
+  EXPECT_EQ(2U, h.size);
+  free(h.model->constr.wand.elems);
+  delete(MockProxy);
+
+  MockProxy = new Mock();
+  test_handle(&h, &s);
+  test_presolve(&h, NULL, env, 2);
+  EXPECT_CALL(*MockProxy, solve(testing::_, testing::_, testing::_)).Times(0);
+  EXPECT_EQ(0U, csolve_solve(&h, test_callback, &data));
+  EXPECT_TRUE(h.infeasible);
+  EXPECT_EQ(0U, csolve_solve(&h, test_callback, &data));
+  free(h.model->constr.wand.elems);
+  delete(MockProxy);
+}
+
+// expect a run that looks for any solution under assumptions, the
+// handle has several workers, which do not keep track of assumptions
+// in conflicts
+static void test_run(struct constr_t *o) {
+  EXPECT_CALL(*MockProxy, conflict_alloc_depth()).WillOnce(testing::Return(7));
+  EXPECT_CALL(*MockProxy, objective_val()).WillRepeatedly(testing::Return(o));
+  EXPECT_CALL(*MockProxy, conflict_root_init(5)).Times(1);
+  EXPECT_CALL(*MockProxy, objective()).WillRepeatedly(testing::Return(OBJ_ANY));
+  EXPECT_CALL(*MockProxy, conflict_alloc_release(7)).Times(1);
+}
+
+TEST(Csolve, Assume) {
+  struct shared_t s;
+  struct csolve_t h;
+  struct constr_t norm = CONSTRAINT_TERM(VALUE(1));
+  struct env_t env[2];
+  struct constr_t x = CONSTRAINT_TERM(INTERVAL(0, 3));
+  struct constr_t y = CONSTRAINT_TERM(INTERVAL(0, 3));
+  x.constr.term.env = &env[0];
+  y.constr.term.env = &env[1];
+  struct csolve_assumption_t assumptions[2] = { { &x, 2 }, { &y, 1 } };
+  struct constr_t o = CONSTRAINT_TERM(INTERVAL(DOMAIN_MIN+1, DOMAIN_MAX-1));
+
+  MockProxy = new Mock();
+  test_handle(&h, &s);
+  test_presolve(&h, &norm, env, 2);
+  s.solutions = 3;
+  EXPECT_CALL(*MockProxy, bind_depth()).WillOnce(testing::Return(5));
+  EXPECT_CALL(*MockProxy, patch(NULL, NULL)).WillOnce(testing::Return(6));
+  test_run(&o);
+  EXPECT_CALL(*MockProxy, shared_reset()).Times(1);
+  EXPECT_CALL(*MockProxy, objective_reset()).Times(1);
+  EXPECT_CALL(*MockProxy, bind_level_set(-1)).Times(1);
+  EXPECT_CALL(*MockProxy, bind(&env[0], VALUE(2), NULL)).Times(1);
+  EXPECT_CALL(*MockProxy, bind(&env[1], VALUE(1), NULL)).Times(1);
+  EXPECT_CALL(*MockProxy, propagate_clauses(testing::_))
+    .WillRepeatedly(testing::Return(PROP_NONE));
+  EXPECT_CALL(*MockProxy, strategy_var_order_init(2, env)).Times(1);
+  EXPECT_CALL(*MockProxy, solution_callback_init(testing::_, testing::_)).Times(2);
+  EXPECT_CALL(*MockProxy, solve(2, env, &norm)).Times(1);
+  EXPECT_CALL(*MockProxy, strategy_var_order_free()).Times(1);
+  EXPECT_CALL(*MockProxy, unbind(5)).Times(1);
+  EXPECT_CALL(*MockProxy, unpatch(6)).Times(1);
+  EXPECT_CALL(*MockProxy, dealloc(testing::_)).Times(1);
+  EXPECT_EQ(3U, csolve_solve_assuming(&h, 2, assumptions, test_callback, NULL));
+  delete(MockProxy);
+
+  // assumptions outside the domain are unsatisfiable
+  MockProxy = new Mock();
+  EXPECT_CALL(*MockProxy, alloc(testing::_))
+    .WillRepeatedly(testing::Invoke(test_alloc));
+  EXPECT_CALL(*MockProxy, shared())
+    .WillRepeatedly(testing::Return(&s));
+  assumptions[1].val = 4;
+  EXPECT_CALL(*MockProxy, bind_depth()).WillOnce(testing::Return(5));
+  EXPECT_CALL(*MockProxy, patch(NULL, NULL)).WillOnce(testing::Return(6));
+  test_run(&o);
+  EXPECT_CALL(*MockProxy, shared_reset()).Times(1);
+  EXPECT_CALL(*MockProxy, objective_reset()).Times(1);
+  EXPECT_CALL(*MockProxy, bind_level_set(-1)).Times(1);
+  EXPECT_CALL(*MockProxy, bind(&env[0], VALUE(2), NULL)).Times(1);
+  EXPECT_CALL(*MockProxy, propagate_clauses(&env[0]))
+    .WillOnce(testing::Return(PROP_NONE));
+  EXPECT_CALL(*MockProxy, bind(&env[1], testing::_, testing::_)).Times(0);
+  EXPECT_CALL(*MockProxy, solve(testing::_, testing::_, testing::_)).Times(0);
+  EXPECT_CALL(*MockProxy, unbind(5)).Times(1);
+  EXPECT_CALL(*MockProxy, unpatch(6)).Times(1);
+  EXPECT_CALL(*MockProxy, dealloc(testing::_)).Times(1);
+  EXPECT_EQ(0U, csolve_solve_assuming(&h, 2, assumptions, test_callback, NULL));
+  delete(MockProxy);
+
+  // assumptions that fail propagation are unsatisfiable
+  MockProxy = new Mock();
+  EXPECT_CALL(*MockProxy, alloc(testing::_))
+    .WillRepeatedly(testing::Invoke(test_alloc));
+  EXPECT_CALL(*MockProxy, shared())
+    .WillRepeatedly(testing::Return(&s));
+  EXPECT_CALL(*MockProxy, bind_depth()).WillOnce(testing::Return(5));
+  EXPECT_CALL(*MockProxy, patch(NULL, NULL)).WillOnce(testing::Return(6));
+  test_run(&o);
+  EXPECT_CALL(*MockProxy, shared_reset()).Times(1);
+  EXPECT_CALL(*MockProxy, objective_reset()).Times(1);
+  EXPECT_CALL(*MockProxy, bind_level_set(-1)).Times(1);
+  EXPECT_CALL(*MockProxy, bind(&env[0], VALUE(2), NULL)).Times(1);
+  EXPECT_CALL(*MockProxy, propagate_clauses(&env[0]))
+    .WillOnce(testing::Return(PROP_ERROR));
+  EXPECT_CALL(*MockProxy, solve(testing::_, testing::_, testing::_)).Times(0);
+  EXPECT_CALL(*MockProxy, unbind(5)).Times(1);
+  EXPECT_CALL(*MockProxy, unpatch(6)).Times(1);
+  EXPECT_CALL(*MockProxy, dealloc(testing::_)).Times(1);
+  EXPECT_EQ(0U, csolve_solve_assuming(&h, 2, assumptions, test_callback, NULL));
+  free(h.model->constr.wand.elems);
+  delete(MockProxy);
+}
+
+TEST(Csolve, Scope) {
+  struct shared_t s;
+  struct csolve_t h;
+  struct constr_t norm = CONSTRAINT_TERM(VALUE(1));
+  struct env_t env[2];
+  struct wand_expr_t *clauses[3];
+  struct constr_t c = CONSTRAINT_TERM(VALUE(1));
+  prop_event_t events[3];
+  env[0].clauses = (struct clause_list_t){ 1, clauses, events };
+  env[1].clauses = (struct clause_list_t){ 2, clauses, events };
+
+  MockProxy = new Mock();
+  test_handle(&h, &s);
+  test_presolve(&h, &norm, env, 2);
+  EXPECT_CALL(*MockProxy, bind_depth()).WillOnce(testing::Return(5));
+  EXPECT_CALL(*MockProxy, patch(NULL, NULL)).WillOnce(testing::Return(6));
+  EXPECT_CALL(*MockProxy, conflict_alloc_depth()).WillOnce(testing::Return(7));
+  csolve_push(&h);
+  EXPECT_EQ(1U, h.depth);
+  delete(MockProxy);
+
+  // constraints added within the scope are propagated right away
+  MockProxy = new Mock();
+  EXPECT_CALL(*MockProxy, alloc(testing::_))
+    .WillRepeatedly(testing::Invoke(test_alloc));
+  EXPECT_CALL(*MockProxy, clauses_init(&c, testing::_)).Times(1);
+  EXPECT_CALL(*MockProxy, bind_level_set(-1)).Times(1);
+  EXPECT_CALL(*MockProxy, propagate(&c, 2))
+    .WillOnce(testing::Return(PROP_ERROR));
+  csolve_add(&h, &c);
+  EXPECT_TRUE(h.infeasible);
+  EXPECT_EQ(&CONSTR_WAND, h.norm->type);
+  EXPECT_EQ(&norm, h.norm->constr.wand.elems[0].constr);
+  EXPECT_EQ(&c, h.norm->constr.wand.elems[1].constr);
+  delete(MockProxy);
+
+  // popping the scope removes constraints and learned conflicts
+  MockProxy = new Mock();
+  env[0].clauses.length = 2;
+  env[1].clauses.length = 3;
+  EXPECT_CALL(*MockProxy, unbind(5)).Times(1);
+  EXPECT_CALL(*MockProxy, unpatch(6)).Times(1);
+  EXPECT_CALL(*MockProxy, expr_free(&c)).Times(1);
+  EXPECT_CALL(*MockProxy, conflict_alloc_release(7)).Times(1);
+  EXPECT_CALL(*MockProxy, dealloc(testing::_)).Times(1);
+  csolve_pop(&h);
+  EXPECT_EQ(0U, h.depth);
+  EXPECT_FALSE(h.infeasible);
+  EXPECT_EQ(&norm, h.norm);
+  EXPECT_EQ(1U, env[0].clauses.length);
+  EXPECT_EQ(2U, env[1].clauses.length);
+  free(h.scopes);
+  free(h.model->constr.wand.elems);
+  delete(MockProxy);
+
+  // variables cannot be added after presolving
+  MockProxy = new Mock();
+  EXPECT_CALL(*MockProxy, alloc(testing::_))
+    .WillRepeatedly(testing::Invoke(test_alloc));
+  EXPECT_CALL(*MockProxy, print_fatal(testing::StrEq(ERROR_MSG_PRESOLVED_MODEL))).Times(1);
+  EXPECT_CALL(*MockProxy, vars_add(testing::_, testing::_)).Times(1);
+  csolve_var(&h, "x", 0, 1);
+  delete(MockProxy);
+}
+
+}
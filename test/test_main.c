@@ -25,7 +25,14 @@ class Mock {
   MOCK_METHOD1(strategy_compute_weights_init, void(bool));
   MOCK_METHOD1(strategy_restart_frequency_init, void(uint64_t));
   MOCK_METHOD1(strategy_order_init, void(enum order_t));
+  MOCK_METHOD1(strategy_prop_order_init, void(enum prop_order_t));
+  MOCK_METHOD1(strategy_portfolio_init, void(bool));
+  MOCK_METHOD1(strategy_eps_init, void(uint32_t));
+  MOCK_METHOD1(cube_count_init, void(uint32_t));
+  MOCK_METHOD1(cube_file_init, void(const char *));
   MOCK_METHOD0(strategy_var_order_free, void(void));
+  MOCK_METHOD0(propagate_free, void(void));
+  MOCK_METHOD0(compile_free, void(void));
   MOCK_METHOD1(stats_frequency_init, void(uint64_t));
   MOCK_METHOD1(print_fatal, void (const char *));
 };
@@ -108,10 +115,38 @@ void strategy_order_init(enum order_t order) {
   MockProxy->strategy_order_init(order);
 }
 
+void strategy_prop_order_init(enum prop_order_t prop_order) {
+  MockProxy->strategy_prop_order_init(prop_order);
+}
+
+void strategy_portfolio_init(bool portfolio) {
+  MockProxy->strategy_portfolio_init(portfolio);
+}
+
+void strategy_eps_init(uint32_t eps) {
+  MockProxy->strategy_eps_init(eps);
+}
+
+void cube_count_init(uint32_t count) {
+  MockProxy->cube_count_init(count);
+}
+
+void cube_file_init(const char *file) {
+  MockProxy->cube_file_init(file);
+}
+
 void strategy_var_order_free(void) {
   MockProxy->strategy_var_order_free();
 }
 
+void propagate_free(void) {
+  MockProxy->propagate_free();
+}
+
+void compile_free(void) {
+  MockProxy->compile_free();
+}
+
 void stats_frequency_init(uint64_t freq) {
   MockProxy->stats_frequency_init(freq);
 }
@@ -184,13 +219,18 @@ TEST(PrintHelp, Basic) {
             "Options:\n"
             "  -b --binds <size>           maximum number of binds (default: " + std::to_string(BIND_STACK_SIZE_DEFAULT) + ")\n"
             "  -c --conflicts <bool>       create conflict clauses (default: true)\n"
+            "  -C --cubes <int>            print cubes splitting the problem instead of solving it (default: " + std::to_string(CUBE_COUNT_DEFAULT) + "), set to 0 to disable\n"
+            "  -e --eps <int>              subproblems per job to decompose the problem into upfront (default: " + std::to_string(STRATEGY_EPS_DEFAULT) + "), set to 0 to disable\n"
             "  -f --prefer-failing <bool>  prefer failing variables when ordering (default: true)\n"
             "  -h --help                   show this message and exit\n"
             "  -j --jobs <int>             number of jobs to run simultaneously (default: " + std::to_string(WORKERS_MAX_DEFAULT) + ")\n"
+            "  -k --cube <file>            solve only the cube in the file\n"
             "  -m --memory <size>          allocation stack size in bytes (default: " + std::to_string(ALLOC_STACK_SIZE_DEFAULT) + ")\n"
             "  -M --confl-memory <size>    conflict allocation stack size in bytes (default: " + std::to_string(CONFLICT_ALLOC_STACK_SIZE_DEFAULT) + ")\n"
             "  -o --order <order>          how to order variables during solving (default: ORDER_NONE)\n"
             "  -p --patches <size>         maximum number of patches (default: " + std::to_string(PATCH_STACK_SIZE_DEFAULT) + ")\n"
+            "  -P --portfolio <bool>       run jobs with different strategies (default: false)\n"
+            "  -q --queue <order>          how to order clauses queued for propagation (default: PROP_ORDER_FIFO)\n"
             "  -r --restart-freq <int>     restart frequency when looking for any solution (default: " + std::to_string(STRATEGY_RESTART_FREQUENCY_DEFAULT) + "), set to 0 to disable\n"
             "  -s --stats-freq <int>       statistics printing frequency (default: " + std::to_string(STATS_FREQUENCY_DEFAULT) + "), set to 0 to disable\n"
             "  -t --time <int>             maximum solving time in seconds (default: " + std::to_string(TIME_MAX_DEFAULT) + "), set to 0 to disable\n"
@@ -214,13 +254,18 @@ TEST(ParseOptions, Help) {
             "Options:\n"
             "  -b --binds <size>           maximum number of binds (default: " + std::to_string(BIND_STACK_SIZE_DEFAULT) + ")\n"
             "  -c --conflicts <bool>       create conflict clauses (default: true)\n"
+            "  -C --cubes <int>            print cubes splitting the problem instead of solving it (default: " + std::to_string(CUBE_COUNT_DEFAULT) + "), set to 0 to disable\n"
+            "  -e --eps <int>              subproblems per job to decompose the problem into upfront (default: " + std::to_string(STRATEGY_EPS_DEFAULT) + "), set to 0 to disable\n"
             "  -f --prefer-failing <bool>  prefer failing variables when ordering (default: true)\n"
             "  -h --help                   show this message and exit\n"
             "  -j --jobs <int>             number of jobs to run simultaneously (default: " + std::to_string(WORKERS_MAX_DEFAULT) + ")\n"
+            "  -k --cube <file>            solve only the cube in the file\n"
             "  -m --memory <size>          allocation stack size in bytes (default: " + std::to_string(ALLOC_STACK_SIZE_DEFAULT) + ")\n"
             "  -M --confl-memory <size>    conflict allocation stack size in bytes (default: " + std::to_string(CONFLICT_ALLOC_STACK_SIZE_DEFAULT) + ")\n"
             "  -o --order <order>          how to order variables during solving (default: ORDER_NONE)\n"
             "  -p --patches <size>         maximum number of patches (default: " + std::to_string(PATCH_STACK_SIZE_DEFAULT) + ")\n"
+            "  -P --portfolio <bool>       run jobs with different strategies (default: false)\n"
+            "  -q --queue <order>          how to order clauses queued for propagation (default: PROP_ORDER_FIFO)\n"
             "  -r --restart-freq <int>     restart frequency when looking for any solution (default: " + std::to_string(STRATEGY_RESTART_FREQUENCY_DEFAULT) + "), set to 0 to disable\n"
             "  -s --stats-freq <int>       statistics printing frequency (default: " + std::to_string(STATS_FREQUENCY_DEFAULT) + "), set to 0 to disable\n"
             "  -t --time <int>             maximum solving time in seconds (default: " + std::to_string(TIME_MAX_DEFAULT) + "), set to 0 to disable\n"
@@ -262,10 +307,15 @@ TEST(ParseOptions, Stdout) {
   EXPECT_CALL(*MockProxy, timeout_init(TIME_MAX_DEFAULT)).Times(1);
   EXPECT_CALL(*MockProxy, conflict_alloc_init(CONFLICT_ALLOC_STACK_SIZE_DEFAULT)).Times(1);
   EXPECT_CALL(*MockProxy, strategy_order_init(STRATEGY_ORDER_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, strategy_prop_order_init(STRATEGY_PROP_ORDER_DEFAULT)).Times(1);
   EXPECT_CALL(*MockProxy, strategy_create_conflicts_init(STRATEGY_CREATE_CONFLICTS_DEFAULT)).Times(1);
   EXPECT_CALL(*MockProxy, strategy_prefer_failing_init(STRATEGY_PREFER_FAILING_DEFAULT)).Times(1);
   EXPECT_CALL(*MockProxy, strategy_compute_weights_init(STRATEGY_COMPUTE_WEIGHTS_DEFAULT)).Times(1);
   EXPECT_CALL(*MockProxy, strategy_restart_frequency_init(STRATEGY_RESTART_FREQUENCY_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, strategy_portfolio_init(STRATEGY_PORTFOLIO_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, strategy_eps_init(STRATEGY_EPS_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, cube_count_init(CUBE_COUNT_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, cube_file_init(NULL)).Times(1);
   EXPECT_CALL(*MockProxy, stats_frequency_init(STATS_FREQUENCY_DEFAULT)).Times(1);
   EXPECT_CALL(*MockProxy, yyset_in(stdin)).Times(1);
   parse_options(argc1, (char **)argv1);
@@ -282,10 +332,15 @@ TEST(ParseOptions, Stdout) {
   EXPECT_CALL(*MockProxy, timeout_init(TIME_MAX_DEFAULT)).Times(1);
   EXPECT_CALL(*MockProxy, conflict_alloc_init(CONFLICT_ALLOC_STACK_SIZE_DEFAULT)).Times(1);
   EXPECT_CALL(*MockProxy, strategy_order_init(STRATEGY_ORDER_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, strategy_prop_order_init(STRATEGY_PROP_ORDER_DEFAULT)).Times(1);
   EXPECT_CALL(*MockProxy, strategy_create_conflicts_init(STRATEGY_CREATE_CONFLICTS_DEFAULT)).Times(1);
   EXPECT_CALL(*MockProxy, strategy_prefer_failing_init(STRATEGY_PREFER_FAILING_DEFAULT)).Times(1);
   EXPECT_CALL(*MockProxy, strategy_compute_weights_init(STRATEGY_COMPUTE_WEIGHTS_DEFAULT)).Times(1);
   EXPECT_CALL(*MockProxy, strategy_restart_frequency_init(STRATEGY_RESTART_FREQUENCY_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, strategy_portfolio_init(STRATEGY_PORTFOLIO_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, strategy_eps_init(STRATEGY_EPS_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, cube_count_init(CUBE_COUNT_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, cube_file_init(NULL)).Times(1);
   EXPECT_CALL(*MockProxy, stats_frequency_init(STATS_FREQUENCY_DEFAULT)).Times(1);
   EXPECT_CALL(*MockProxy, yyset_in(stdin)).Times(1);
   parse_options(argc2, (char **)argv2);
@@ -304,10 +359,15 @@ TEST(ParseOptions, NonExistentFile) {
   EXPECT_CALL(*MockProxy, timeout_init(TIME_MAX_DEFAULT)).Times(1);
   EXPECT_CALL(*MockProxy, conflict_alloc_init(CONFLICT_ALLOC_STACK_SIZE_DEFAULT)).Times(1);
   EXPECT_CALL(*MockProxy, strategy_order_init(STRATEGY_ORDER_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, strategy_prop_order_init(STRATEGY_PROP_ORDER_DEFAULT)).Times(1);
   EXPECT_CALL(*MockProxy, strategy_create_conflicts_init(STRATEGY_CREATE_CONFLICTS_DEFAULT)).Times(1);
   EXPECT_CALL(*MockProxy, strategy_prefer_failing_init(STRATEGY_PREFER_FAILING_DEFAULT)).Times(1);
   EXPECT_CALL(*MockProxy, strategy_compute_weights_init(STRATEGY_COMPUTE_WEIGHTS_DEFAULT)).Times(1);
   EXPECT_CALL(*MockProxy, strategy_restart_frequency_init(STRATEGY_RESTART_FREQUENCY_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, strategy_portfolio_init(STRATEGY_PORTFOLIO_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, strategy_eps_init(STRATEGY_EPS_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, cube_count_init(CUBE_COUNT_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, cube_file_init(NULL)).Times(1);
   EXPECT_CALL(*MockProxy, stats_frequency_init(STATS_FREQUENCY_DEFAULT)).Times(1);
   EXPECT_CALL(*MockProxy, print_fatal("%s: %s")).Times(1);
   parse_options(argc, (char **)argv);
@@ -327,10 +387,15 @@ TEST(ParseOptions, Bind) {
   EXPECT_CALL(*MockProxy, timeout_init(TIME_MAX_DEFAULT)).Times(1);
   EXPECT_CALL(*MockProxy, conflict_alloc_init(CONFLICT_ALLOC_STACK_SIZE_DEFAULT)).Times(1);
   EXPECT_CALL(*MockProxy, strategy_order_init(STRATEGY_ORDER_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, strategy_prop_order_init(STRATEGY_PROP_ORDER_DEFAULT)).Times(1);
   EXPECT_CALL(*MockProxy, strategy_create_conflicts_init(STRATEGY_CREATE_CONFLICTS_DEFAULT)).Times(1);
   EXPECT_CALL(*MockProxy, strategy_prefer_failing_init(STRATEGY_PREFER_FAILING_DEFAULT)).Times(1);
   EXPECT_CALL(*MockProxy, strategy_compute_weights_init(STRATEGY_COMPUTE_WEIGHTS_DEFAULT)).Times(1);
   EXPECT_CALL(*MockProxy, strategy_restart_frequency_init(STRATEGY_RESTART_FREQUENCY_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, strategy_portfolio_init(STRATEGY_PORTFOLIO_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, strategy_eps_init(STRATEGY_EPS_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, cube_count_init(CUBE_COUNT_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, cube_file_init(NULL)).Times(1);
   EXPECT_CALL(*MockProxy, stats_frequency_init(STATS_FREQUENCY_DEFAULT)).Times(1);
   EXPECT_CALL(*MockProxy, yyset_in(stdin)).Times(1);
   parse_options(argc, (char **)argv);
@@ -350,10 +415,15 @@ TEST(ParseOptions, Alloc) {
   EXPECT_CALL(*MockProxy, timeout_init(TIME_MAX_DEFAULT)).Times(1);
   EXPECT_CALL(*MockProxy, conflict_alloc_init(CONFLICT_ALLOC_STACK_SIZE_DEFAULT)).Times(1);
   EXPECT_CALL(*MockProxy, strategy_order_init(STRATEGY_ORDER_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, strategy_prop_order_init(STRATEGY_PROP_ORDER_DEFAULT)).Times(1);
   EXPECT_CALL(*MockProxy, strategy_create_conflicts_init(STRATEGY_CREATE_CONFLICTS_DEFAULT)).Times(1);
   EXPECT_CALL(*MockProxy, strategy_prefer_failing_init(STRATEGY_PREFER_FAILING_DEFAULT)).Times(1);
   EXPECT_CALL(*MockProxy, strategy_compute_weights_init(STRATEGY_COMPUTE_WEIGHTS_DEFAULT)).Times(1);
   EXPECT_CALL(*MockProxy, strategy_restart_frequency_init(STRATEGY_RESTART_FREQUENCY_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, strategy_portfolio_init(STRATEGY_PORTFOLIO_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, strategy_eps_init(STRATEGY_EPS_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, cube_count_init(CUBE_COUNT_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, cube_file_init(NULL)).Times(1);
   EXPECT_CALL(*MockProxy, stats_frequency_init(STATS_FREQUENCY_DEFAULT)).Times(1);
   EXPECT_CALL(*MockProxy, yyset_in(stdin)).Times(1);
   parse_options(argc, (char **)argv);
@@ -373,10 +443,15 @@ TEST(ParseOptions, Jobs) {
   EXPECT_CALL(*MockProxy, timeout_init(TIME_MAX_DEFAULT)).Times(1);
   EXPECT_CALL(*MockProxy, conflict_alloc_init(CONFLICT_ALLOC_STACK_SIZE_DEFAULT)).Times(1);
   EXPECT_CALL(*MockProxy, strategy_order_init(STRATEGY_ORDER_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, strategy_prop_order_init(STRATEGY_PROP_ORDER_DEFAULT)).Times(1);
   EXPECT_CALL(*MockProxy, strategy_create_conflicts_init(STRATEGY_CREATE_CONFLICTS_DEFAULT)).Times(1);
   EXPECT_CALL(*MockProxy, strategy_prefer_failing_init(STRATEGY_PREFER_FAILING_DEFAULT)).Times(1);
   EXPECT_CALL(*MockProxy, strategy_compute_weights_init(STRATEGY_COMPUTE_WEIGHTS_DEFAULT)).Times(1);
   EXPECT_CALL(*MockProxy, strategy_restart_frequency_init(STRATEGY_RESTART_FREQUENCY_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, strategy_portfolio_init(STRATEGY_PORTFOLIO_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, strategy_eps_init(STRATEGY_EPS_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, cube_count_init(CUBE_COUNT_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, cube_file_init(NULL)).Times(1);
   EXPECT_CALL(*MockProxy, stats_frequency_init(STATS_FREQUENCY_DEFAULT)).Times(1);
   EXPECT_CALL(*MockProxy, yyset_in(stdin)).Times(1);
   parse_options(argc, (char **)argv);
@@ -396,10 +471,15 @@ TEST(ParseOptions, Order) {
   EXPECT_CALL(*MockProxy, timeout_init(TIME_MAX_DEFAULT)).Times(1);
   EXPECT_CALL(*MockProxy, conflict_alloc_init(CONFLICT_ALLOC_STACK_SIZE_DEFAULT)).Times(1);
   EXPECT_CALL(*MockProxy, strategy_order_init(ORDER_LARGEST_VALUE)).Times(1);
+  EXPECT_CALL(*MockProxy, strategy_prop_order_init(STRATEGY_PROP_ORDER_DEFAULT)).Times(1);
   EXPECT_CALL(*MockProxy, strategy_create_conflicts_init(STRATEGY_CREATE_CONFLICTS_DEFAULT)).Times(1);
   EXPECT_CALL(*MockProxy, strategy_prefer_failing_init(STRATEGY_PREFER_FAILING_DEFAULT)).Times(1);
   EXPECT_CALL(*MockProxy, strategy_compute_weights_init(STRATEGY_COMPUTE_WEIGHTS_DEFAULT)).Times(1);
   EXPECT_CALL(*MockProxy, strategy_restart_frequency_init(STRATEGY_RESTART_FREQUENCY_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, strategy_portfolio_init(STRATEGY_PORTFOLIO_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, strategy_eps_init(STRATEGY_EPS_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, cube_count_init(CUBE_COUNT_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, cube_file_init(NULL)).Times(1);
   EXPECT_CALL(*MockProxy, stats_frequency_init(STATS_FREQUENCY_DEFAULT)).Times(1);
   EXPECT_CALL(*MockProxy, yyset_in(stdin)).Times(1);
   parse_options(argc, (char **)argv);
@@ -419,10 +499,15 @@ TEST(ParseOptions, PreferFailing) {
   EXPECT_CALL(*MockProxy, timeout_init(TIME_MAX_DEFAULT)).Times(1);
   EXPECT_CALL(*MockProxy, conflict_alloc_init(CONFLICT_ALLOC_STACK_SIZE_DEFAULT)).Times(1);
   EXPECT_CALL(*MockProxy, strategy_order_init(STRATEGY_ORDER_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, strategy_prop_order_init(STRATEGY_PROP_ORDER_DEFAULT)).Times(1);
   EXPECT_CALL(*MockProxy, strategy_create_conflicts_init(STRATEGY_CREATE_CONFLICTS_DEFAULT)).Times(1);
   EXPECT_CALL(*MockProxy, strategy_prefer_failing_init(false)).Times(1);
   EXPECT_CALL(*MockProxy, strategy_compute_weights_init(STRATEGY_COMPUTE_WEIGHTS_DEFAULT)).Times(1);
   EXPECT_CALL(*MockProxy, strategy_restart_frequency_init(STRATEGY_RESTART_FREQUENCY_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, strategy_portfolio_init(STRATEGY_PORTFOLIO_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, strategy_eps_init(STRATEGY_EPS_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, cube_count_init(CUBE_COUNT_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, cube_file_init(NULL)).Times(1);
   EXPECT_CALL(*MockProxy, stats_frequency_init(STATS_FREQUENCY_DEFAULT)).Times(1);
   EXPECT_CALL(*MockProxy, yyset_in(stdin)).Times(1);
   parse_options(argc1, (char **)argv1);
@@ -440,10 +525,15 @@ TEST(ParseOptions, PreferFailing) {
   EXPECT_CALL(*MockProxy, timeout_init(TIME_MAX_DEFAULT)).Times(1);
   EXPECT_CALL(*MockProxy, conflict_alloc_init(CONFLICT_ALLOC_STACK_SIZE_DEFAULT)).Times(1);
   EXPECT_CALL(*MockProxy, strategy_order_init(STRATEGY_ORDER_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, strategy_prop_order_init(STRATEGY_PROP_ORDER_DEFAULT)).Times(1);
   EXPECT_CALL(*MockProxy, strategy_create_conflicts_init(STRATEGY_CREATE_CONFLICTS_DEFAULT)).Times(1);
   EXPECT_CALL(*MockProxy, strategy_prefer_failing_init(true)).Times(1);
   EXPECT_CALL(*MockProxy, strategy_compute_weights_init(STRATEGY_COMPUTE_WEIGHTS_DEFAULT)).Times(1);
   EXPECT_CALL(*MockProxy, strategy_restart_frequency_init(STRATEGY_RESTART_FREQUENCY_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, strategy_portfolio_init(STRATEGY_PORTFOLIO_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, strategy_eps_init(STRATEGY_EPS_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, cube_count_init(CUBE_COUNT_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, cube_file_init(NULL)).Times(1);
   EXPECT_CALL(*MockProxy, stats_frequency_init(STATS_FREQUENCY_DEFAULT)).Times(1);
   EXPECT_CALL(*MockProxy, yyset_in(stdin)).Times(1);
   parse_options(argc2, (char **)argv2);
@@ -463,10 +553,155 @@ TEST(ParseOptions, Restarts) {
   EXPECT_CALL(*MockProxy, timeout_init(TIME_MAX_DEFAULT)).Times(1);
   EXPECT_CALL(*MockProxy, conflict_alloc_init(CONFLICT_ALLOC_STACK_SIZE_DEFAULT)).Times(1);
   EXPECT_CALL(*MockProxy, strategy_order_init(STRATEGY_ORDER_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, strategy_prop_order_init(STRATEGY_PROP_ORDER_DEFAULT)).Times(1);
   EXPECT_CALL(*MockProxy, strategy_create_conflicts_init(STRATEGY_CREATE_CONFLICTS_DEFAULT)).Times(1);
   EXPECT_CALL(*MockProxy, strategy_prefer_failing_init(STRATEGY_PREFER_FAILING_DEFAULT)).Times(1);
   EXPECT_CALL(*MockProxy, strategy_compute_weights_init(STRATEGY_COMPUTE_WEIGHTS_DEFAULT)).Times(1);
   EXPECT_CALL(*MockProxy, strategy_restart_frequency_init(1234)).Times(1);
+  EXPECT_CALL(*MockProxy, strategy_portfolio_init(STRATEGY_PORTFOLIO_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, strategy_eps_init(STRATEGY_EPS_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, cube_count_init(CUBE_COUNT_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, cube_file_init(NULL)).Times(1);
+  EXPECT_CALL(*MockProxy, stats_frequency_init(STATS_FREQUENCY_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, yyset_in(stdin)).Times(1);
+  parse_options(argc, (char **)argv);
+  delete(MockProxy);
+}
+
+TEST(ParseOptions, Portfolio) {
+  int argc = 3;
+  const char *argv [argc] = { "<xxx>", "-P", "true" };
+  optind = 1;
+
+  MockProxy = new Mock();
+  EXPECT_CALL(*MockProxy, bind_init(BIND_STACK_SIZE_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, patch_init(PATCH_STACK_SIZE_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, alloc_init(ALLOC_STACK_SIZE_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, shared_init(WORKERS_MAX_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, timeout_init(TIME_MAX_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, conflict_alloc_init(CONFLICT_ALLOC_STACK_SIZE_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, strategy_order_init(STRATEGY_ORDER_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, strategy_prop_order_init(STRATEGY_PROP_ORDER_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, strategy_create_conflicts_init(STRATEGY_CREATE_CONFLICTS_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, strategy_prefer_failing_init(STRATEGY_PREFER_FAILING_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, strategy_compute_weights_init(STRATEGY_COMPUTE_WEIGHTS_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, strategy_restart_frequency_init(STRATEGY_RESTART_FREQUENCY_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, strategy_portfolio_init(true)).Times(1);
+  EXPECT_CALL(*MockProxy, strategy_eps_init(STRATEGY_EPS_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, cube_count_init(CUBE_COUNT_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, cube_file_init(NULL)).Times(1);
+  EXPECT_CALL(*MockProxy, stats_frequency_init(STATS_FREQUENCY_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, yyset_in(stdin)).Times(1);
+  parse_options(argc, (char **)argv);
+  delete(MockProxy);
+}
+
+TEST(ParseOptions, Queue) {
+  int argc = 3;
+  const char *argv [argc] = { "<xxx>", "-q", "fifo" };
+  optind = 1;
+
+  MockProxy = new Mock();
+  EXPECT_CALL(*MockProxy, bind_init(BIND_STACK_SIZE_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, patch_init(PATCH_STACK_SIZE_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, alloc_init(ALLOC_STACK_SIZE_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, shared_init(WORKERS_MAX_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, timeout_init(TIME_MAX_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, conflict_alloc_init(CONFLICT_ALLOC_STACK_SIZE_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, strategy_order_init(STRATEGY_ORDER_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, strategy_prop_order_init(PROP_ORDER_FIFO)).Times(1);
+  EXPECT_CALL(*MockProxy, strategy_create_conflicts_init(STRATEGY_CREATE_CONFLICTS_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, strategy_prefer_failing_init(STRATEGY_PREFER_FAILING_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, strategy_compute_weights_init(STRATEGY_COMPUTE_WEIGHTS_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, strategy_restart_frequency_init(STRATEGY_RESTART_FREQUENCY_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, strategy_portfolio_init(STRATEGY_PORTFOLIO_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, strategy_eps_init(STRATEGY_EPS_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, cube_count_init(CUBE_COUNT_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, cube_file_init(NULL)).Times(1);
+  EXPECT_CALL(*MockProxy, stats_frequency_init(STATS_FREQUENCY_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, yyset_in(stdin)).Times(1);
+  parse_options(argc, (char **)argv);
+  delete(MockProxy);
+}
+
+TEST(ParseOptions, Eps) {
+  int argc = 3;
+  const char *argv [argc] = { "<xxx>", "-e", "30" };
+  optind = 1;
+
+  MockProxy = new Mock();
+  EXPECT_CALL(*MockProxy, bind_init(BIND_STACK_SIZE_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, patch_init(PATCH_STACK_SIZE_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, alloc_init(ALLOC_STACK_SIZE_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, shared_init(WORKERS_MAX_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, timeout_init(TIME_MAX_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, conflict_alloc_init(CONFLICT_ALLOC_STACK_SIZE_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, strategy_order_init(STRATEGY_ORDER_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, strategy_prop_order_init(STRATEGY_PROP_ORDER_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, strategy_create_conflicts_init(STRATEGY_CREATE_CONFLICTS_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, strategy_prefer_failing_init(STRATEGY_PREFER_FAILING_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, strategy_compute_weights_init(STRATEGY_COMPUTE_WEIGHTS_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, strategy_restart_frequency_init(STRATEGY_RESTART_FREQUENCY_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, strategy_portfolio_init(STRATEGY_PORTFOLIO_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, strategy_eps_init(30)).Times(1);
+  EXPECT_CALL(*MockProxy, cube_count_init(CUBE_COUNT_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, cube_file_init(NULL)).Times(1);
+  EXPECT_CALL(*MockProxy, stats_frequency_init(STATS_FREQUENCY_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, yyset_in(stdin)).Times(1);
+  parse_options(argc, (char **)argv);
+  delete(MockProxy);
+}
+
+TEST(ParseOptions, Cubes) {
+  int argc = 3;
+  const char *argv [argc] = { "<xxx>", "-C", "100" };
+  optind = 1;
+
+  MockProxy = new Mock();
+  EXPECT_CALL(*MockProxy, bind_init(BIND_STACK_SIZE_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, patch_init(PATCH_STACK_SIZE_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, alloc_init(ALLOC_STACK_SIZE_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, shared_init(WORKERS_MAX_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, timeout_init(TIME_MAX_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, conflict_alloc_init(CONFLICT_ALLOC_STACK_SIZE_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, strategy_order_init(STRATEGY_ORDER_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, strategy_prop_order_init(STRATEGY_PROP_ORDER_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, strategy_create_conflicts_init(STRATEGY_CREATE_CONFLICTS_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, strategy_prefer_failing_init(STRATEGY_PREFER_FAILING_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, strategy_compute_weights_init(STRATEGY_COMPUTE_WEIGHTS_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, strategy_restart_frequency_init(STRATEGY_RESTART_FREQUENCY_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, strategy_portfolio_init(STRATEGY_PORTFOLIO_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, strategy_eps_init(STRATEGY_EPS_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, cube_count_init(100)).Times(1);
+  EXPECT_CALL(*MockProxy, cube_file_init(NULL)).Times(1);
+  EXPECT_CALL(*MockProxy, stats_frequency_init(STATS_FREQUENCY_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, yyset_in(stdin)).Times(1);
+  parse_options(argc, (char **)argv);
+  delete(MockProxy);
+}
+
+TEST(ParseOptions, Cube) {
+  int argc = 3;
+  const char *argv [argc] = { "<xxx>", "-k", "foo" };
+  optind = 1;
+
+  MockProxy = new Mock();
+  EXPECT_CALL(*MockProxy, bind_init(BIND_STACK_SIZE_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, patch_init(PATCH_STACK_SIZE_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, alloc_init(ALLOC_STACK_SIZE_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, shared_init(WORKERS_MAX_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, timeout_init(TIME_MAX_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, conflict_alloc_init(CONFLICT_ALLOC_STACK_SIZE_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, strategy_order_init(STRATEGY_ORDER_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, strategy_prop_order_init(STRATEGY_PROP_ORDER_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, strategy_create_conflicts_init(STRATEGY_CREATE_CONFLICTS_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, strategy_prefer_failing_init(STRATEGY_PREFER_FAILING_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, strategy_compute_weights_init(STRATEGY_COMPUTE_WEIGHTS_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, strategy_restart_frequency_init(STRATEGY_RESTART_FREQUENCY_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, strategy_portfolio_init(STRATEGY_PORTFOLIO_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, strategy_eps_init(STRATEGY_EPS_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, cube_count_init(CUBE_COUNT_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, cube_file_init(testing::StrEq("foo"))).Times(1);
   EXPECT_CALL(*MockProxy, stats_frequency_init(STATS_FREQUENCY_DEFAULT)).Times(1);
   EXPECT_CALL(*MockProxy, yyset_in(stdin)).Times(1);
   parse_options(argc, (char **)argv);
@@ -486,10 +721,15 @@ TEST(ParseOptions, Weighten) {
   EXPECT_CALL(*MockProxy, timeout_init(TIME_MAX_DEFAULT)).Times(1);
   EXPECT_CALL(*MockProxy, conflict_alloc_init(CONFLICT_ALLOC_STACK_SIZE_DEFAULT)).Times(1);
   EXPECT_CALL(*MockProxy, strategy_order_init(STRATEGY_ORDER_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, strategy_prop_order_init(STRATEGY_PROP_ORDER_DEFAULT)).Times(1);
   EXPECT_CALL(*MockProxy, strategy_create_conflicts_init(STRATEGY_CREATE_CONFLICTS_DEFAULT)).Times(1);
   EXPECT_CALL(*MockProxy, strategy_prefer_failing_init(STRATEGY_PREFER_FAILING_DEFAULT)).Times(1);
   EXPECT_CALL(*MockProxy, strategy_compute_weights_init(false)).Times(1);
   EXPECT_CALL(*MockProxy, strategy_restart_frequency_init(STRATEGY_RESTART_FREQUENCY_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, strategy_portfolio_init(STRATEGY_PORTFOLIO_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, strategy_eps_init(STRATEGY_EPS_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, cube_count_init(CUBE_COUNT_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, cube_file_init(NULL)).Times(1);
   EXPECT_CALL(*MockProxy, stats_frequency_init(STATS_FREQUENCY_DEFAULT)).Times(1);
   EXPECT_CALL(*MockProxy, yyset_in(stdin)).Times(1);
   parse_options(argc1, (char **)argv1);
@@ -507,10 +747,15 @@ TEST(ParseOptions, Weighten) {
   EXPECT_CALL(*MockProxy, timeout_init(TIME_MAX_DEFAULT)).Times(1);
   EXPECT_CALL(*MockProxy, conflict_alloc_init(CONFLICT_ALLOC_STACK_SIZE_DEFAULT)).Times(1);
   EXPECT_CALL(*MockProxy, strategy_order_init(STRATEGY_ORDER_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, strategy_prop_order_init(STRATEGY_PROP_ORDER_DEFAULT)).Times(1);
   EXPECT_CALL(*MockProxy, strategy_create_conflicts_init(STRATEGY_CREATE_CONFLICTS_DEFAULT)).Times(1);
   EXPECT_CALL(*MockProxy, strategy_prefer_failing_init(STRATEGY_PREFER_FAILING_DEFAULT)).Times(1);
   EXPECT_CALL(*MockProxy, strategy_compute_weights_init(true)).Times(1);
   EXPECT_CALL(*MockProxy, strategy_restart_frequency_init(STRATEGY_RESTART_FREQUENCY_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, strategy_portfolio_init(STRATEGY_PORTFOLIO_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, strategy_eps_init(STRATEGY_EPS_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, cube_count_init(CUBE_COUNT_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, cube_file_init(NULL)).Times(1);
   EXPECT_CALL(*MockProxy, stats_frequency_init(STATS_FREQUENCY_DEFAULT)).Times(1);
   EXPECT_CALL(*MockProxy, yyset_in(stdin)).Times(1);
   parse_options(argc2, (char **)argv2);
@@ -557,6 +802,18 @@ TEST(ParseOrder, Error) {
   delete(MockProxy);
 }
 
+TEST(ParsePropOrder, Basic) {
+  EXPECT_EQ(PROP_ORDER_FIFO, parse_prop_order("fifo"));
+  EXPECT_EQ(PROP_ORDER_CHEAP_FIRST, parse_prop_order("cheap-first"));
+}
+
+TEST(ParsePropOrder, Error) {
+  MockProxy = new Mock();
+  EXPECT_CALL(*MockProxy, print_fatal(ERROR_MSG_INVALID_QUEUE_ARG)).Times(1);
+  parse_prop_order("abc");
+  delete(MockProxy);
+}
+
 TEST(ParseSize, Basic) {
   EXPECT_EQ(7U, parse_size("7"));
   EXPECT_EQ(10U*1024, parse_size("10k"));
@@ -592,6 +849,8 @@ TEST(Cleanup, Basic) {
   EXPECT_CALL(*MockProxy, alloc_free()).Times(1);
   EXPECT_CALL(*MockProxy, conflict_alloc_free()).Times(1);
   EXPECT_CALL(*MockProxy, strategy_var_order_free()).Times(1);
+  EXPECT_CALL(*MockProxy, propagate_free()).Times(1);
+  EXPECT_CALL(*MockProxy, compile_free()).Times(1);
   EXPECT_CALL(*MockProxy, yyget_in()).Times(1).WillRepeatedly(::testing::Return(f));
   EXPECT_CALL(*MockProxy, yylex_destroy()).Times(1);
   cleanup();
@@ -616,10 +875,15 @@ TEST(Main, Basic) {
   EXPECT_CALL(*MockProxy, timeout_init(TIME_MAX_DEFAULT)).Times(1);
   EXPECT_CALL(*MockProxy, conflict_alloc_init(CONFLICT_ALLOC_STACK_SIZE_DEFAULT)).Times(1);
   EXPECT_CALL(*MockProxy, strategy_order_init(STRATEGY_ORDER_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, strategy_prop_order_init(STRATEGY_PROP_ORDER_DEFAULT)).Times(1);
   EXPECT_CALL(*MockProxy, strategy_create_conflicts_init(STRATEGY_PREFER_FAILING_DEFAULT)).Times(1);
   EXPECT_CALL(*MockProxy, strategy_prefer_failing_init(STRATEGY_PREFER_FAILING_DEFAULT)).Times(1);
   EXPECT_CALL(*MockProxy, strategy_compute_weights_init(STRATEGY_COMPUTE_WEIGHTS_DEFAULT)).Times(1);
   EXPECT_CALL(*MockProxy, strategy_restart_frequency_init(STRATEGY_RESTART_FREQUENCY_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, strategy_portfolio_init(STRATEGY_PORTFOLIO_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, strategy_eps_init(STRATEGY_EPS_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, cube_count_init(CUBE_COUNT_DEFAULT)).Times(1);
+  EXPECT_CALL(*MockProxy, cube_file_init(NULL)).Times(1);
   EXPECT_CALL(*MockProxy, stats_frequency_init(STATS_FREQUENCY_DEFAULT)).Times(1);
   EXPECT_CALL(*MockProxy, yyset_in(stdin)).Times(1);
   EXPECT_CALL(*MockProxy, yyparse()).Times(1);
@@ -628,6 +892,8 @@ TEST(Main, Basic) {
   EXPECT_CALL(*MockProxy, alloc_free()).Times(1);
   EXPECT_CALL(*MockProxy, conflict_alloc_free()).Times(1);
   EXPECT_CALL(*MockProxy, strategy_var_order_free()).Times(1);
+  EXPECT_CALL(*MockProxy, propagate_free()).Times(1);
+  EXPECT_CALL(*MockProxy, compile_free()).Times(1);
   EXPECT_CALL(*MockProxy, yyget_in()).Times(1).WillRepeatedly(::testing::Return(f));
   EXPECT_CALL(*MockProxy, yylex_destroy()).Times(1);
   EXPECT_EQ(EXIT_SUCCESS, main(argc, (char **)argv));
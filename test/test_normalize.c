@@ -374,6 +374,108 @@ TEST(NormalizeAdd, Pattern) {
   delete(MockProxy);
 }
 
+TEST(NormalizeAdd, Lin) {
+  struct constr_t A = CONSTRAINT_TERM(INTERVAL(0, 17));
+  struct constr_t B = CONSTRAINT_TERM(INTERVAL(23, 42));
+  struct constr_t C = CONSTRAINT_TERM(INTERVAL(-5, 5));
+  struct constr_t K3 = CONSTRAINT_TERM(VALUE(3));
+  struct constr_t K5 = CONSTRAINT_TERM(VALUE(5));
+  struct constr_t M, N, P, X, Y, Z;
+  struct lin_term_t terms[4];
+
+  // sum with constant offset
+  MockProxy = new Mock();
+  M = CONSTRAINT_EXPR(MUL, &K3, &B);
+  N = CONSTRAINT_EXPR(ADD, &A, &M);
+  P = CONSTRAINT_EXPR(ADD, &C, &K5);
+  X = CONSTRAINT_EXPR(ADD, &N, &P);
+  EXPECT_CALL(*MockProxy, eval_add(&X))
+    .Times(1)
+    .WillOnce(::testing::Return(INTERVAL(69, 148)));
+  {
+    // the terms may have the same size as a constraint
+    ::testing::InSequence seq;
+    EXPECT_CALL(*MockProxy, alloc(3 * sizeof(struct lin_term_t)))
+      .Times(1)
+      .WillOnce(::testing::Return(terms));
+    EXPECT_CALL(*MockProxy, alloc(sizeof(struct constr_t)))
+      .Times(3)
+      .WillOnce(::testing::Return(&Y))
+      .WillOnce(::testing::Return(&Z))
+      .WillOnce(::testing::Return(&M));
+  }
+  EXPECT_EQ(&M, normal_add(&X));
+  EXPECT_EQ(&CONSTR_ADD, M.type);
+  EXPECT_EQ(&Y, M.constr.expr.l);
+  EXPECT_EQ(&Z, M.constr.expr.r);
+  EXPECT_EQ(VALUE(5), Z.constr.term.val);
+  EXPECT_EQ(&CONSTR_LIN, Y.type);
+  EXPECT_EQ(3U, Y.constr.lin.length);
+  EXPECT_EQ(1, terms[0].coef);
+  EXPECT_EQ(&A, terms[0].var);
+  EXPECT_EQ(3, terms[1].coef);
+  EXPECT_EQ(&B, terms[1].var);
+  EXPECT_EQ(1, terms[2].coef);
+  EXPECT_EQ(&C, terms[2].var);
+  delete(MockProxy);
+
+  // terms of the same variable are merged
+  MockProxy = new Mock();
+  N = CONSTRAINT_EXPR(ADD, &A, &B);
+  P = CONSTRAINT_EXPR(ADD, &A, &C);
+  X = CONSTRAINT_EXPR(ADD, &N, &P);
+  EXPECT_CALL(*MockProxy, eval_add(&X))
+    .Times(1)
+    .WillOnce(::testing::Return(INTERVAL(18, 81)));
+  EXPECT_CALL(*MockProxy, alloc(4 * sizeof(struct lin_term_t)))
+    .Times(1)
+    .WillOnce(::testing::Return(terms));
+  EXPECT_CALL(*MockProxy, alloc(sizeof(struct constr_t)))
+    .Times(1)
+    .WillOnce(::testing::Return(&Y));
+  EXPECT_EQ(&Y, normal_add(&X));
+  EXPECT_EQ(&CONSTR_LIN, Y.type);
+  EXPECT_EQ(3U, Y.constr.lin.length);
+  EXPECT_EQ(2, terms[0].coef);
+  EXPECT_EQ(&A, terms[0].var);
+  EXPECT_EQ(1, terms[1].coef);
+  EXPECT_EQ(&B, terms[1].var);
+  EXPECT_EQ(1, terms[2].coef);
+  EXPECT_EQ(&C, terms[2].var);
+  delete(MockProxy);
+
+  // non-linear sums are left alone
+  MockProxy = new Mock();
+  M = CONSTRAINT_EXPR(MUL, &A, &B);
+  N = CONSTRAINT_EXPR(ADD, &A, &M);
+  X = CONSTRAINT_EXPR(ADD, &N, &C);
+  EXPECT_CALL(*MockProxy, eval_add(&X))
+    .Times(1)
+    .WillOnce(::testing::Return(INTERVAL(-5, 736)));
+  EXPECT_CALL(*MockProxy, eval_add(&N))
+    .Times(1)
+    .WillOnce(::testing::Return(INTERVAL(0, 731)));
+  EXPECT_CALL(*MockProxy, eval_mul(&M))
+    .Times(1)
+    .WillOnce(::testing::Return(INTERVAL(0, 714)));
+  EXPECT_EQ(&X, normal_add(&X));
+  delete(MockProxy);
+}
+
+TEST(NormalizeLin, Basic) {
+  struct constr_t A = CONSTRAINT_TERM(INTERVAL(0, 17));
+  struct constr_t B = CONSTRAINT_TERM(INTERVAL(23, 42));
+  struct lin_term_t terms[2] = { { 1, &A }, { 2, &B } };
+  struct constr_t X = CONSTRAINT_LIN(2, terms);
+
+  MockProxy = new Mock();
+  EXPECT_CALL(*MockProxy, eval_lin(&X))
+    .Times(1)
+    .WillOnce(::testing::Return(INTERVAL(46, 101)));
+  EXPECT_EQ(&X, normal_lin(&X));
+  delete(MockProxy);
+}
+
 TEST(NormalizeMul, Basic) {
   struct constr_t A = CONSTRAINT_TERM(INTERVAL(0, 17));
   struct constr_t B = CONSTRAINT_TERM(VALUE(23));
@@ -447,6 +549,132 @@ TEST(NormalizeMul, Pattern) {
   delete(MockProxy);
 }
 
+TEST(NormalizeDiv, Basic) {
+  struct constr_t A = CONSTRAINT_TERM(INTERVAL(0, 17));
+  struct constr_t B = CONSTRAINT_TERM(INTERVAL(2, 3));
+  struct constr_t C = CONSTRAINT_TERM(VALUE(1));
+  struct constr_t X;
+
+  MockProxy = new Mock();
+  X = CONSTRAINT_EXPR(DIV, &A, &B);
+  EXPECT_CALL(*MockProxy, eval_div(&X))
+    .Times(1)
+    .WillOnce(::testing::Return(INTERVAL(0, 8)));
+  EXPECT_EQ(&X, normal_div(&X));
+  delete(MockProxy);
+
+  MockProxy = new Mock();
+  X = CONSTRAINT_EXPR(DIV, &A, &C);
+  EXPECT_CALL(*MockProxy, eval_div(&X))
+    .Times(1)
+    .WillOnce(::testing::Return(INTERVAL(0, 17)));
+  EXPECT_EQ(&A, normal_div(&X));
+  delete(MockProxy);
+
+  MockProxy = new Mock();
+  X = CONSTRAINT_EXPR(MOD, &A, &B);
+  EXPECT_CALL(*MockProxy, eval_mod(&X))
+    .Times(1)
+    .WillOnce(::testing::Return(INTERVAL(0, 2)));
+  EXPECT_EQ(&X, normal_mod(&X));
+  delete(MockProxy);
+}
+
+TEST(NormalizeAbs, Basic) {
+  struct constr_t A = CONSTRAINT_TERM(INTERVAL(-3, 5));
+  struct constr_t X, Y, Z;
+
+  MockProxy = new Mock();
+  X = CONSTRAINT_EXPR(ABS, &A, NULL);
+  EXPECT_CALL(*MockProxy, eval_abs(&X))
+    .Times(1)
+    .WillOnce(::testing::Return(INTERVAL(0, 5)));
+  EXPECT_CALL(*MockProxy, eval_term(&A))
+    .Times(1)
+    .WillOnce(::testing::Return(INTERVAL(-3, 5)));
+  EXPECT_EQ(&X, normal_abs(&X));
+  delete(MockProxy);
+
+  // non-negative sub-expressions are their own absolute value
+  MockProxy = new Mock();
+  X = CONSTRAINT_EXPR(ABS, &A, NULL);
+  EXPECT_CALL(*MockProxy, eval_abs(&X))
+    .Times(1)
+    .WillOnce(::testing::Return(INTERVAL(0, 5)));
+  EXPECT_CALL(*MockProxy, eval_term(&A))
+    .Times(1)
+    .WillOnce(::testing::Return(INTERVAL(0, 5)));
+  EXPECT_EQ(&A, normal_abs(&X));
+  delete(MockProxy);
+
+  // negation does not change the absolute value
+  MockProxy = new Mock();
+  Y = CONSTRAINT_EXPR(NEG, &A, NULL);
+  X = CONSTRAINT_EXPR(ABS, &Y, NULL);
+  EXPECT_CALL(*MockProxy, eval_abs(&X))
+    .Times(1)
+    .WillOnce(::testing::Return(INTERVAL(0, 5)));
+  EXPECT_CALL(*MockProxy, eval_neg(&Y))
+    .Times(1)
+    .WillOnce(::testing::Return(INTERVAL(-5, 3)));
+  EXPECT_CALL(*MockProxy, alloc(sizeof(struct constr_t)))
+    .Times(1)
+    .WillOnce(::testing::Return(&Z));
+  EXPECT_EQ(&Z, normal_abs(&X));
+  EXPECT_EQ(&CONSTR_ABS, Z.type);
+  EXPECT_EQ(&A, Z.constr.expr.l);
+  delete(MockProxy);
+}
+
+TEST(NormalizeMin, Basic) {
+  struct constr_t A = CONSTRAINT_TERM(INTERVAL(0, 17));
+  struct constr_t B = CONSTRAINT_TERM(INTERVAL(10, 20));
+  struct constr_t X;
+
+  MockProxy = new Mock();
+  X = CONSTRAINT_EXPR(MIN, &A, &B);
+  EXPECT_CALL(*MockProxy, eval_min(&X))
+    .Times(1)
+    .WillOnce(::testing::Return(INTERVAL(0, 17)));
+  EXPECT_CALL(*MockProxy, eval_term(&A))
+    .Times(::testing::AtLeast(1))
+    .WillRepeatedly(::testing::Return(INTERVAL(0, 17)));
+  EXPECT_CALL(*MockProxy, eval_term(&B))
+    .Times(::testing::AtLeast(1))
+    .WillRepeatedly(::testing::Return(INTERVAL(10, 20)));
+  EXPECT_EQ(&X, normal_min(&X));
+  delete(MockProxy);
+
+  // reduce to the side that always is the minimum
+  MockProxy = new Mock();
+  X = CONSTRAINT_EXPR(MIN, &A, &B);
+  EXPECT_CALL(*MockProxy, eval_min(&X))
+    .Times(1)
+    .WillOnce(::testing::Return(INTERVAL(0, 9)));
+  EXPECT_CALL(*MockProxy, eval_term(&A))
+    .Times(::testing::AtLeast(1))
+    .WillRepeatedly(::testing::Return(INTERVAL(0, 9)));
+  EXPECT_CALL(*MockProxy, eval_term(&B))
+    .Times(::testing::AtLeast(1))
+    .WillRepeatedly(::testing::Return(INTERVAL(10, 20)));
+  EXPECT_EQ(&A, normal_min(&X));
+  delete(MockProxy);
+
+  MockProxy = new Mock();
+  X = CONSTRAINT_EXPR(MAX, &A, &B);
+  EXPECT_CALL(*MockProxy, eval_max(&X))
+    .Times(1)
+    .WillOnce(::testing::Return(INTERVAL(10, 20)));
+  EXPECT_CALL(*MockProxy, eval_term(&A))
+    .Times(::testing::AtLeast(1))
+    .WillRepeatedly(::testing::Return(INTERVAL(0, 9)));
+  EXPECT_CALL(*MockProxy, eval_term(&B))
+    .Times(::testing::AtLeast(1))
+    .WillRepeatedly(::testing::Return(INTERVAL(10, 20)));
+  EXPECT_EQ(&B, normal_max(&X));
+  delete(MockProxy);
+}
+
 TEST(NormalizeNot, Basic) {
   struct constr_t A = CONSTRAINT_TERM(INTERVAL(0, 1));
   struct constr_t X;
@@ -725,6 +953,123 @@ TEST(NormalizeOr, HalfNot) {
   delete(MockProxy);
 }
 
+TEST(NormalizeDiff, Basic) {
+  struct constr_t A = CONSTRAINT_TERM(INTERVAL(0, 1));
+  struct constr_t B = CONSTRAINT_TERM(INTERVAL(0, 1));
+  struct constr_t X = CONSTRAINT_DIFF(&A, &B, 0);
+
+  MockProxy = new Mock();
+  EXPECT_CALL(*MockProxy, eval_diff(&X))
+    .Times(1)
+    .WillOnce(::testing::Return(INTERVAL(0, 1)));
+  EXPECT_EQ(&X, normal_diff(&X));
+  delete(MockProxy);
+}
+
+TEST(NormalizeAlldiff, Basic) {
+  struct constr_t A = CONSTRAINT_TERM(INTERVAL(0, 1));
+  struct constr_t B = CONSTRAINT_TERM(INTERVAL(0, 1));
+  struct constr_t *E [2] = { &A, &B };
+  struct constr_t X = CONSTRAINT_ALLDIFF(2, E);
+
+  MockProxy = new Mock();
+  EXPECT_CALL(*MockProxy, eval_alldiff(&X))
+    .Times(1)
+    .WillOnce(::testing::Return(INTERVAL(0, 1)));
+  EXPECT_EQ(&X, normal_alldiff(&X));
+  delete(MockProxy);
+}
+
+TEST(NormalizeAlldiff, Copy) {
+  struct constr_t A = CONSTRAINT_TERM(INTERVAL(0, 1));
+  struct constr_t B = CONSTRAINT_TERM(INTERVAL(0, 1));
+  struct constr_t Y = CONSTRAINT_EXPR(NOT, &B, NULL);
+  struct constr_t Z = CONSTRAINT_EXPR(NOT, &Y, NULL);
+  struct constr_t *E [2] = { &A, &Z };
+  struct constr_t X = CONSTRAINT_ALLDIFF(2, E);
+  struct constr_t *F [2];
+  struct constr_t V;
+
+  MockProxy = new Mock();
+  EXPECT_CALL(*MockProxy, eval_alldiff(&X))
+    .Times(1)
+    .WillOnce(::testing::Return(INTERVAL(0, 1)));
+  EXPECT_CALL(*MockProxy, eval_not(::testing::_))
+    .Times(2)
+    .WillRepeatedly(::testing::Return(INTERVAL(0, 1)));
+  EXPECT_CALL(*MockProxy, alloc(2 * sizeof(struct constr_t *)))
+    .Times(1)
+    .WillOnce(::testing::Return(F));
+  EXPECT_CALL(*MockProxy, alloc(sizeof(struct constr_t)))
+    .Times(1)
+    .WillOnce(::testing::Return(&V));
+  EXPECT_EQ(&V, normal_alldiff(&X));
+  EXPECT_EQ(&CONSTR_ALLDIFF, V.type);
+  EXPECT_EQ(2U, V.constr.alldiff.length);
+  EXPECT_EQ(F, V.constr.alldiff.elems);
+  EXPECT_EQ(&A, F[0]);
+  EXPECT_EQ(&B, F[1]);
+  EXPECT_EQ(E[1], &Z);
+  delete(MockProxy);
+}
+
+TEST(NormalizeDisj, Basic) {
+  struct constr_t A = CONSTRAINT_TERM(INTERVAL(0, 9));
+  struct constr_t B = CONSTRAINT_TERM(INTERVAL(0, 9));
+  struct constr_t K = CONSTRAINT_TERM(VALUE(2));
+  struct sched_task_t T [2] = { { &A, &K, NULL }, { &B, &K, NULL } };
+  struct constr_t X = CONSTRAINT_DISJ(2, T);
+
+  MockProxy = new Mock();
+  EXPECT_CALL(*MockProxy, eval_disj(&X))
+    .Times(1)
+    .WillOnce(::testing::Return(INTERVAL(0, 1)));
+  EXPECT_EQ(&X, normal_disj(&X));
+  delete(MockProxy);
+}
+
+TEST(NormalizeCumul, Copy) {
+  struct constr_t A = CONSTRAINT_TERM(INTERVAL(0, 9));
+  struct constr_t B = CONSTRAINT_TERM(INTERVAL(0, 9));
+  struct constr_t C = CONSTRAINT_TERM(INTERVAL(0, 1));
+  struct constr_t Y = CONSTRAINT_EXPR(NOT, &C, NULL);
+  struct constr_t Z = CONSTRAINT_EXPR(NOT, &Y, NULL);
+  struct constr_t K = CONSTRAINT_TERM(VALUE(2));
+  struct sched_task_t T [2] = { { &A, &K, &K }, { &B, &K, &Z } };
+  struct constr_t X = CONSTRAINT_CUMUL(2, T, &K);
+  struct sched_task_t U [2];
+  struct constr_t V;
+
+  MockProxy = new Mock();
+  EXPECT_CALL(*MockProxy, eval_cumul(&X))
+    .Times(1)
+    .WillOnce(::testing::Return(INTERVAL(0, 1)));
+  EXPECT_CALL(*MockProxy, eval_not(::testing::_))
+    .Times(2)
+    .WillRepeatedly(::testing::Return(INTERVAL(0, 1)));
+  {
+    // the tasks may have the same size as a constraint
+    ::testing::InSequence seq;
+    EXPECT_CALL(*MockProxy, alloc(2 * sizeof(struct sched_task_t)))
+      .Times(1)
+      .WillOnce(::testing::Return(U));
+    EXPECT_CALL(*MockProxy, alloc(sizeof(struct constr_t)))
+      .Times(1)
+      .WillOnce(::testing::Return(&V));
+  }
+  EXPECT_EQ(&V, normal_cumul(&X));
+  EXPECT_EQ(&CONSTR_CUMUL, V.type);
+  EXPECT_EQ(2U, V.constr.sched.length);
+  EXPECT_EQ(U, V.constr.sched.tasks);
+  EXPECT_EQ(&K, V.constr.sched.cap);
+  EXPECT_EQ(&A, U[0].start);
+  EXPECT_EQ(&K, U[0].demand);
+  EXPECT_EQ(&B, U[1].start);
+  EXPECT_EQ(&C, U[1].demand);
+  EXPECT_EQ(&Z, T[1].demand);
+  delete(MockProxy);
+}
+
 TEST(NormalizeWand, Basic) {
   struct constr_t A = CONSTRAINT_TERM(VALUE(0));
   struct constr_t B = CONSTRAINT_TERM(VALUE(1));
@@ -773,6 +1118,50 @@ TEST(NormalizeWand, Patch) {
   delete(MockProxy);
 }
 
+TEST(NormalizeWand, Diff) {
+  struct constr_t A = CONSTRAINT_TERM(INTERVAL(0, 9));
+  struct constr_t B = CONSTRAINT_TERM(INTERVAL(0, 9));
+  struct constr_t K = CONSTRAINT_TERM(VALUE(2));
+  struct constr_t S = CONSTRAINT_EXPR(ADD, &A, &K);
+  struct constr_t X = CONSTRAINT_EXPR(LT, &S, &B);
+  struct constr_t Y = CONSTRAINT_EXPR(LT, &B, &A);
+  struct constr_t Z = CONSTRAINT_EXPR(NOT, &Y, NULL);
+  struct wand_expr_t E [2] = { { .constr = &X, .orig = &X, .prop_tag = 0 },
+                               { .constr = &Z, .orig = &Z, .prop_tag = 0 } };
+  struct constr_t W = CONSTRAINT_WAND(2, E);
+  struct constr_t U, V;
+
+  // A + 2 < B becomes A - B <= -3, !(B < A) becomes A - B <= 0
+  MockProxy = new Mock();
+  {
+    ::testing::InSequence seq;
+    EXPECT_CALL(*MockProxy, alloc(sizeof(struct constr_t)))
+      .WillOnce(::testing::Return(&U));
+    EXPECT_CALL(*MockProxy, patch(&E[0], &U))
+      .Times(1);
+    EXPECT_CALL(*MockProxy, alloc(sizeof(struct constr_t)))
+      .WillOnce(::testing::Return(&V));
+    EXPECT_CALL(*MockProxy, patch(&E[1], &V))
+      .Times(1);
+  }
+  EXPECT_CALL(*MockProxy, eval_lt(::testing::_))
+    .WillRepeatedly(::testing::Return(INTERVAL(0, 1)));
+  EXPECT_CALL(*MockProxy, eval_add(&S))
+    .WillRepeatedly(::testing::Return(INTERVAL(2, 11)));
+  EXPECT_CALL(*MockProxy, eval_not(&Z))
+    .WillRepeatedly(::testing::Return(INTERVAL(0, 1)));
+  EXPECT_EQ(&W, normal_wand(&W));
+  EXPECT_TRUE(IS_TYPE(DIFF, &U));
+  EXPECT_EQ(&A, U.constr.diff.l);
+  EXPECT_EQ(&B, U.constr.diff.r);
+  EXPECT_EQ(-3, U.constr.diff.c);
+  EXPECT_TRUE(IS_TYPE(DIFF, &V));
+  EXPECT_EQ(&A, V.constr.diff.l);
+  EXPECT_EQ(&B, V.constr.diff.r);
+  EXPECT_EQ(0, V.constr.diff.c);
+  delete(MockProxy);
+}
+
 TEST(Normalize, Loop) {
   struct constr_t A = CONSTRAINT_TERM(INTERVAL(17, 23));
   struct constr_t X, Y;
@@ -22,6 +22,8 @@ class Mock {
 
 Mock *MockProxy;
 
+THREAD_LOCAL uint64_t eval_epoch;
+
 void print_fatal(const char *fmt, ...) {
   MockProxy->print_fatal(fmt);
 }
@@ -40,35 +42,69 @@ CONSTR_TYPE_LIST(CONSTR_TYPE_CMOCKS)
 
 TEST(ObjectiveInit, Basic) {
   domain_t best;
+  uint64_t epoch;
 
-  objective_init(OBJ_ANY, &best);
+  objective_init(OBJ_ANY, &best, &epoch);
   EXPECT_EQ(OBJ_ANY, _objective);
   EXPECT_EQ(&best, _objective_best);
+  EXPECT_EQ(&epoch, _objective_epoch);
+  EXPECT_EQ(&epoch, _objective_epoch);
+  EXPECT_EQ(&epoch, _objective_epoch);
+  EXPECT_EQ(&epoch, _objective_epoch);
   EXPECT_EQ(0, *_objective_best);
 
-  objective_init(OBJ_ALL, &best);
+  objective_init(OBJ_ALL, &best, &epoch);
   EXPECT_EQ(OBJ_ALL, _objective);
   EXPECT_EQ(&best, _objective_best);
+  EXPECT_EQ(&epoch, _objective_epoch);
+  EXPECT_EQ(&epoch, _objective_epoch);
+  EXPECT_EQ(&epoch, _objective_epoch);
+  EXPECT_EQ(&epoch, _objective_epoch);
   EXPECT_EQ(0, *_objective_best);
 
-  objective_init(OBJ_MIN, &best);
+  objective_init(OBJ_MIN, &best, &epoch);
   EXPECT_EQ(OBJ_MIN, _objective);
   EXPECT_EQ(&best, _objective_best);
+  EXPECT_EQ(&epoch, _objective_epoch);
+  EXPECT_EQ(&epoch, _objective_epoch);
+  EXPECT_EQ(&epoch, _objective_epoch);
+  EXPECT_EQ(&epoch, _objective_epoch);
   EXPECT_EQ(DOMAIN_MAX, *_objective_best);
 
-  objective_init(OBJ_MAX, &best);
+  objective_init(OBJ_MAX, &best, &epoch);
   EXPECT_EQ(OBJ_MAX, _objective);
   EXPECT_EQ(&best, _objective_best);
+  EXPECT_EQ(&epoch, _objective_epoch);
+  EXPECT_EQ(&epoch, _objective_epoch);
+  EXPECT_EQ(&epoch, _objective_epoch);
+  EXPECT_EQ(&epoch, _objective_epoch);
   EXPECT_EQ(DOMAIN_MIN, *_objective_best);
 }
 
 TEST(ObjectiveInit, Errors) {
   MockProxy = new Mock();
   EXPECT_CALL(*MockProxy, print_fatal(ERROR_MSG_INVALID_OBJ_FUNC_TYPE)).Times(1);
-  objective_init((objective_t)-1, NULL);
+  objective_init((objective_t)-1, NULL, NULL);
   delete(MockProxy);
 }
 
+TEST(ObjectiveReset, Basic) {
+  domain_t best;
+  uint64_t epoch;
+
+  objective_init(OBJ_MIN, &best, &epoch);
+  best = 17;
+  _objective_epoch_seen = 3;
+  objective_reset();
+  EXPECT_EQ(DOMAIN_MAX, best);
+  EXPECT_EQ(0U, _objective_epoch_seen);
+
+  objective_init(OBJ_MAX, &best, &epoch);
+  best = 17;
+  objective_reset();
+  EXPECT_EQ(DOMAIN_MIN, best);
+}
+
 TEST(Objective, Basic) {
   _objective = OBJ_MAX;
   EXPECT_EQ(OBJ_MAX, objective());
@@ -201,38 +237,65 @@ TEST(ObjectiveBetter, Errors) {
 
 TEST(ObjectiveUpdateBest, Basic) {
   domain_t best;
+  uint64_t epoch = 0;
   _objective_best = &best;
+  _objective_epoch = &epoch;
 
   _objective = OBJ_ANY;
   *_objective_best = -1;
   _objective_val = CONSTRAINT_TERM(VALUE(17));
   MockProxy = new Mock();
-  objective_update_best();
+  EXPECT_TRUE(objective_update_best());
   EXPECT_EQ(-1, *_objective_best);
+  EXPECT_EQ(0U, epoch);
   delete(MockProxy);
 
   _objective = OBJ_ALL;
   *_objective_best = -1;
   _objective_val = CONSTRAINT_TERM(VALUE(17));
   MockProxy = new Mock();
-  objective_update_best();
+  EXPECT_TRUE(objective_update_best());
   EXPECT_EQ(-1, *_objective_best);
+  EXPECT_EQ(0U, epoch);
   delete(MockProxy);
 
   _objective = OBJ_MAX;
   *_objective_best = -1;
   _objective_val = CONSTRAINT_TERM(VALUE(17));
   MockProxy = new Mock();
-  objective_update_best();
+  EXPECT_TRUE(objective_update_best());
   EXPECT_EQ(17, *_objective_best);
+  EXPECT_EQ(17, objective_solution());
+  EXPECT_EQ(1U, epoch);
   delete(MockProxy);
 
    _objective = OBJ_MIN;
   *_objective_best = -1;
   _objective_val = CONSTRAINT_TERM(VALUE(-17));
   MockProxy = new Mock();
-  objective_update_best();
+  EXPECT_TRUE(objective_update_best());
   EXPECT_EQ(-17, *_objective_best);
+  EXPECT_EQ(-17, objective_solution());
+  EXPECT_EQ(2U, epoch);
+  delete(MockProxy);
+
+  _objective = OBJ_MIN;
+  *_objective_best = -17;
+  _objective_val = CONSTRAINT_TERM(VALUE(-17));
+  MockProxy = new Mock();
+  EXPECT_FALSE(objective_update_best());
+  EXPECT_EQ(-17, *_objective_best);
+  EXPECT_EQ(2U, epoch);
+  delete(MockProxy);
+
+  _objective = OBJ_MAX;
+  *_objective_best = 18;
+  _objective_val = CONSTRAINT_TERM(INTERVAL(0, 17));
+  MockProxy = new Mock();
+  EXPECT_FALSE(objective_update_best());
+  EXPECT_EQ(18, *_objective_best);
+  EXPECT_EQ(17, objective_solution());
+  EXPECT_EQ(2U, epoch);
   delete(MockProxy);
 }
 
@@ -300,6 +363,36 @@ TEST(ObjectiveUpdateVal, Errors) {
   delete(MockProxy);
 }
 
+TEST(ObjectivePoll, Basic) {
+  domain_t best;
+  uint64_t epoch = 0;
+  _objective_best = &best;
+  _objective_epoch = &epoch;
+  _objective_epoch_seen = 0;
+  _objective = OBJ_MIN;
+
+  // no update of best value
+  *_objective_best = 13;
+  _objective_val = CONSTRAINT_TERM(INTERVAL(0, 17));
+  EXPECT_FALSE(objective_poll());
+  EXPECT_EQ(_objective_val.constr.term.val, INTERVAL(0, 17));
+
+  // update that still allows better values
+  epoch = 1;
+  EXPECT_FALSE(objective_poll());
+  EXPECT_EQ(_objective_val.constr.term.val, INTERVAL(0, 12));
+  EXPECT_EQ(1U, _objective_epoch_seen);
+
+  // update that rules out better values
+  *_objective_best = 0;
+  epoch = 2;
+  EXPECT_TRUE(objective_poll());
+  EXPECT_EQ(2U, _objective_epoch_seen);
+
+  // the same update is only reported once
+  EXPECT_FALSE(objective_poll());
+}
+
 TEST(ObjectiveBest, Basic) {
   domain_t best;
   _objective_best = &best;
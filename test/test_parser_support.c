@@ -16,11 +16,21 @@ bool operator==(const struct val_t& lhs, const struct val_t& rhs) {
 class Mock {
  public:
   MOCK_METHOD0(objective_best, domain_t(void));
-  MOCK_METHOD2(clause_list_append, void(clause_list_t*, wand_expr_t*));
-  MOCK_METHOD2(clause_list_contains, bool(clause_list_t*, wand_expr_t*));
+  MOCK_METHOD3(clause_list_subscribe, void(clause_list_t*, wand_expr_t*, prop_event_t));
+  MOCK_METHOD1(clause_list_free, void(clause_list_t*));
   MOCK_METHOD1(print_fatal, void (const char *));
   MOCK_METHOD2(print_val, void(FILE *, struct val_t));
   MOCK_METHOD1(free, void(void *));
+  MOCK_METHOD1(alloc, void *(size_t));
+  MOCK_METHOD2(propagate, prop_result_t(struct constr_t *, size_t));
+  MOCK_METHOD1(normalize, struct constr_t *(struct constr_t *));
+  MOCK_METHOD0(bind_commit, void(void));
+  MOCK_METHOD0(patch_commit, void(void));
+  MOCK_METHOD1(compile_init, void(struct env_t *));
+  MOCK_METHOD1(compile_clauses, void(struct constr_t *));
+  MOCK_METHOD0(stats_init, void(void));
+  MOCK_METHOD2(strategy_var_order_init, void(size_t, struct env_t *));
+  MOCK_METHOD3(solve, void(size_t, struct env_t *, struct constr_t *));
 #define CONSTR_TYPE_MOCKS(UPNAME, NAME, OP) \
   MOCK_METHOD1(eval_ ## NAME, struct val_t(const struct constr_t *)); \
   MOCK_METHOD3(propagate_ ## NAME, prop_result_t(struct constr_t *, struct val_t, const struct wand_expr_t *)); \
@@ -34,12 +44,12 @@ domain_t objective_best(void) {
   return MockProxy->objective_best();
 }
 
-void clause_list_append(clause_list_t *list, wand_expr_t *elem) {
-  MockProxy->clause_list_append(list, elem);
+void clause_list_subscribe(clause_list_t *list, wand_expr_t *elem, prop_event_t events) {
+  MockProxy->clause_list_subscribe(list, elem, events);
 }
 
-bool clause_list_contains(clause_list_t *list, wand_expr_t *elem) {
-  return MockProxy->clause_list_contains(list, elem);
+void clause_list_free(clause_list_t *list) {
+  MockProxy->clause_list_free(list);
 }
 
 void print_fatal(const char *fmt, ...) {
@@ -56,6 +66,46 @@ void free(void *ptr) {
   MockProxy->free(ptr);
 }
 
+void *alloc(size_t size) {
+  return MockProxy->alloc(size);
+}
+
+prop_result_t propagate(struct constr_t *constr, size_t size) {
+  return MockProxy->propagate(constr, size);
+}
+
+struct constr_t *normalize(struct constr_t *constr) {
+  return MockProxy->normalize(constr);
+}
+
+void bind_commit(void) {
+  MockProxy->bind_commit();
+}
+
+void compile_init(struct env_t *env) {
+  MockProxy->compile_init(env);
+}
+
+void compile_clauses(struct constr_t *constr) {
+  MockProxy->compile_clauses(constr);
+}
+
+void patch_commit(void) {
+  MockProxy->patch_commit();
+}
+
+void stats_init(void) {
+  MockProxy->stats_init();
+}
+
+void strategy_var_order_init(size_t size, struct env_t *env) {
+  MockProxy->strategy_var_order_init(size, env);
+}
+
+void solve(size_t size, struct env_t *env, struct constr_t *constr) {
+  MockProxy->solve(size, env, constr);
+}
+
 #define CONSTR_TYPE_CMOCKS(UPNAME, NAME, OP)                            \
 struct val_t eval_ ## NAME(const struct constr_t *constr) {       \
   return MockProxy->eval_ ## NAME(constr);                              \
@@ -70,8 +120,8 @@ CONSTR_TYPE_LIST(CONSTR_TYPE_CMOCKS)
 
 TEST(VarsFindKey, Find) {
   struct constr_t val = CONSTRAINT_TERM(INTERVAL(DOMAIN_MIN, DOMAIN_MAX));
-  struct env_t v[2]  = { { "x", &val, NULL, {0, NULL}, 0, 1, 0 },
-                         { "y", &val, NULL, {0, NULL}, 1, 0, 0 } };
+  struct env_t v[2]  = { { "x", &val, NULL, {0, NULL}, {0, NULL}, 0, 1, 0 },
+                         { "y", &val, NULL, {0, NULL}, {0, NULL}, 1, 0, 0 } };
   _vars = &v[0];
   _var_count = 2;
   keytab_add(0);
@@ -89,8 +139,8 @@ TEST(VarsFindKey, Find) {
 
 TEST(VarsFindKey, NotFound) {
   struct constr_t val = CONSTRAINT_TERM(INTERVAL(DOMAIN_MIN, DOMAIN_MAX));
-  struct env_t v[2]  = { { "x", &val, NULL, {0, NULL}, 0, 1, 0 },
-                         { "y", &val, NULL, {0, NULL}, 1, 0, 0 } };
+  struct env_t v[2]  = { { "x", &val, NULL, {0, NULL}, {0, NULL}, 0, 1, 0 },
+                         { "y", &val, NULL, {0, NULL}, {0, NULL}, 1, 0, 0 } };
   _vars = &v[0];
   _var_count = 2;
   keytab_add(0);
@@ -108,8 +158,8 @@ TEST(VarsFindKey, NotFound) {
 TEST(VarsFindVal, Find) {
   struct constr_t val1 = CONSTRAINT_TERM(INTERVAL(DOMAIN_MIN, DOMAIN_MAX));
   struct constr_t val2 = CONSTRAINT_TERM(INTERVAL(DOMAIN_MIN, DOMAIN_MAX));
-  struct env_t v[2]  = { { "x", &val1, NULL, {0, NULL}, 0, 1, 0 },
-                         { "y", &val2, NULL, {0, NULL}, 1, 0, 0 } };
+  struct env_t v[2]  = { { "x", &val1, NULL, {0, NULL}, {0, NULL}, 0, 1, 0 },
+                         { "y", &val2, NULL, {0, NULL}, {0, NULL}, 1, 0, 0 } };
   _vars = &v[0];
   _var_count = 2;
   valtab_add(0);
@@ -129,8 +179,8 @@ TEST(VarsFindVal, NotFound) {
   struct constr_t val1 = CONSTRAINT_TERM(INTERVAL(DOMAIN_MIN, DOMAIN_MAX));
   struct constr_t val2 = CONSTRAINT_TERM(INTERVAL(DOMAIN_MIN, DOMAIN_MAX));
   struct constr_t val3 = CONSTRAINT_TERM(INTERVAL(DOMAIN_MIN, DOMAIN_MAX));
-  struct env_t v[2]  = { { "x", &val1, NULL, {0, NULL}, 0, 1, 0 },
-                         { "y", &val2, NULL, {0, NULL}, 1, 0, 0 } };
+  struct env_t v[2]  = { { "x", &val1, NULL, {0, NULL}, {0, NULL}, 0, 1, 0 },
+                         { "y", &val2, NULL, {0, NULL}, {0, NULL}, 1, 0, 0 } };
   _vars = &v[0];
   _var_count = 2;
   valtab_add(0);
@@ -227,8 +277,8 @@ TEST(VarsCount, Errors) {
 TEST(VarsWeighten, Basic) {
   struct constr_t X = CONSTRAINT_TERM(INTERVAL(DOMAIN_MIN, DOMAIN_MAX));
   struct constr_t Y = CONSTRAINT_TERM(INTERVAL(DOMAIN_MIN, DOMAIN_MAX));
-  struct env_t v[2]  = { { "x", &X, NULL, {0, NULL}, 0, 0, 0 },
-                         { "y", &Y, NULL, {0, NULL}, 1, 3, 0 } };
+  struct env_t v[2]  = { { "x", &X, NULL, {0, NULL}, {0, NULL}, 0, 0, 0 },
+                         { "y", &Y, NULL, {0, NULL}, {0, NULL}, 1, 3, 0 } };
   _vars = &v[0];
   _var_count = 2;
   valtab_add(0);
@@ -359,8 +409,10 @@ TEST(EnvFree, Basic) {
   MockProxy = new Mock();
   EXPECT_CALL(*MockProxy, free((void *)env[0].key));
   EXPECT_CALL(*MockProxy, free((void *)env[1].key));
-  EXPECT_CALL(*MockProxy, free((void *)env[0].clauses.elems));
-  EXPECT_CALL(*MockProxy, free((void *)env[1].clauses.elems));
+  EXPECT_CALL(*MockProxy, clause_list_free(&env[0].clauses));
+  EXPECT_CALL(*MockProxy, clause_list_free(&env[0].watches));
+  EXPECT_CALL(*MockProxy, clause_list_free(&env[1].clauses));
+  EXPECT_CALL(*MockProxy, clause_list_free(&env[1].watches));
   EXPECT_CALL(*MockProxy, free((void *)_vars));
   env_free();
   delete(MockProxy);
@@ -396,38 +448,80 @@ TEST(ExprListFree, Basic) {
   delete(MockProxy);
 }
 
+TEST(ExprListTasks, Basic) {
+  struct constr_t s1, s2, d1, d2, c1, c2;
+  struct expr_list_t *starts = expr_list_append(expr_list_append(NULL, &s1), &s2);
+  struct expr_list_t *durs = expr_list_append(expr_list_append(NULL, &d1), &d2);
+  struct expr_list_t *demands = expr_list_append(expr_list_append(NULL, &c1), &c2);
+  struct sched_task_t tasks[2];
+  size_t length = 0;
+
+  MockProxy = new Mock();
+  EXPECT_CALL(*MockProxy, alloc(2 * sizeof(struct sched_task_t)))
+    .Times(2)
+    .WillRepeatedly(::testing::Return(tasks));
+  EXPECT_EQ(tasks, expr_list_tasks(starts, durs, NULL, &length));
+  EXPECT_EQ(2U, length);
+  EXPECT_EQ(&s1, tasks[0].start);
+  EXPECT_EQ(&d1, tasks[0].dur);
+  EXPECT_EQ((struct constr_t *)NULL, tasks[0].demand);
+  EXPECT_EQ(&s2, tasks[1].start);
+  EXPECT_EQ(&d2, tasks[1].dur);
+  EXPECT_EQ((struct constr_t *)NULL, tasks[1].demand);
+
+  EXPECT_EQ(tasks, expr_list_tasks(starts, durs, demands, &length));
+  EXPECT_EQ(2U, length);
+  EXPECT_EQ(&c1, tasks[0].demand);
+  EXPECT_EQ(&c2, tasks[1].demand);
+  delete(MockProxy);
+}
+
+TEST(ExprListTasks, Length) {
+  struct constr_t s1, s2, d1, c1;
+  struct expr_list_t *starts = expr_list_append(expr_list_append(NULL, &s1), &s2);
+  struct expr_list_t *durs = expr_list_append(NULL, &d1);
+  struct expr_list_t *demands = expr_list_append(NULL, &c1);
+  struct sched_task_t tasks[2];
+  size_t length = 0;
+
+  MockProxy = new Mock();
+  EXPECT_CALL(*MockProxy, alloc(::testing::_))
+    .Times(2)
+    .WillRepeatedly(::testing::Return(tasks));
+  EXPECT_EQ((struct sched_task_t *)NULL, expr_list_tasks(starts, durs, NULL, &length));
+  EXPECT_EQ((struct sched_task_t *)NULL, expr_list_tasks(durs, starts, demands, &length));
+  EXPECT_EQ(0U, length);
+  delete(MockProxy);
+}
+
 TEST(ClausesInit, Term) {
   struct constr_t e1 = CONSTRAINT_TERM(VALUE(1));
   struct constr_t e2 = CONSTRAINT_TERM(INTERVAL(0, 1));
 
-  struct env_t v[2]  = { { "x", &e1, NULL, {0, NULL}, 0, 0, 0 },
-                         { "y", &e2, NULL, {0, NULL}, 1, 3, 0 } };
+  struct env_t v[2]  = { { "x", &e1, NULL, {0, NULL}, {0, NULL}, 0, 0, 0 },
+                         { "y", &e2, NULL, {0, NULL}, {0, NULL}, 1, 3, 0 } };
   e1.constr.term.env = &v[0];
   e2.constr.term.env = &v[1];
 
   struct wand_expr_t w;
 
   MockProxy = new Mock();
-  EXPECT_CALL(*MockProxy, clause_list_contains(testing::_, testing::_)).Times(0);
-  EXPECT_CALL(*MockProxy, clause_list_append(testing::_, testing::_)).Times(0);
+  EXPECT_CALL(*MockProxy, clause_list_subscribe(testing::_, testing::_, testing::_)).Times(0);
   clauses_init(&e1, NULL);
   delete(MockProxy);
 
   MockProxy = new Mock();
-  EXPECT_CALL(*MockProxy, clause_list_contains(testing::_, testing::_)).Times(0);
-  EXPECT_CALL(*MockProxy, clause_list_append(testing::_, testing::_)).Times(0);
+  EXPECT_CALL(*MockProxy, clause_list_subscribe(testing::_, testing::_, testing::_)).Times(0);
   clauses_init(&e1, &w);
   delete(MockProxy);
 
   MockProxy = new Mock();
-  EXPECT_CALL(*MockProxy, clause_list_contains(testing::_, testing::_)).Times(0);
-  EXPECT_CALL(*MockProxy, clause_list_append(testing::_, testing::_)).Times(0);
+  EXPECT_CALL(*MockProxy, clause_list_subscribe(testing::_, testing::_, testing::_)).Times(0);
   clauses_init(&e2, NULL);
   delete(MockProxy);
 
   MockProxy = new Mock();
-  EXPECT_CALL(*MockProxy, clause_list_contains(&v[1].clauses, &w)).Times(1).WillRepeatedly(::testing::Return(false));
-  EXPECT_CALL(*MockProxy, clause_list_append(&v[1].clauses, &w)).Times(1);
+  EXPECT_CALL(*MockProxy, clause_list_subscribe(&v[1].clauses, &w, PROP_EVENT_ANY)).Times(1);
   clauses_init(&e2, &w);
   delete(MockProxy);
 }
@@ -435,8 +529,8 @@ TEST(ClausesInit, Term) {
 TEST(ClausesInit, Wand) {
   struct constr_t e1 = CONSTRAINT_TERM(VALUE(11));
   struct constr_t e2 = CONSTRAINT_TERM(INTERVAL(0,1));
-  struct env_t v[2]  = { { "x", &e1, NULL, {0, NULL}, 0, 0, 0 },
-                         { "y", &e2, NULL, {0, NULL}, 1, 3, 0 } };
+  struct env_t v[2]  = { { "x", &e1, NULL, {0, NULL}, {0, NULL}, 0, 0, 0 },
+                         { "y", &e2, NULL, {0, NULL}, {0, NULL}, 1, 3, 0 } };
   e1.constr.term.env = &v[0];
   e2.constr.term.env = &v[1];
 
@@ -447,8 +541,7 @@ TEST(ClausesInit, Wand) {
   struct constr_t Y = CONSTRAINT_WAND(2, F);
 
   MockProxy = new Mock();
-  EXPECT_CALL(*MockProxy, clause_list_contains(&v[1].clauses, &E[1])).Times(1).WillRepeatedly(::testing::Return(false));
-  EXPECT_CALL(*MockProxy, clause_list_append(&v[1].clauses, &E[1])).Times(1);
+  EXPECT_CALL(*MockProxy, clause_list_subscribe(&v[1].clauses, &E[1], PROP_EVENT_ANY)).Times(1);
   clauses_init(&Y, NULL);
   delete(MockProxy);
 }
@@ -460,8 +553,8 @@ TEST(ClausesInit, Expr) {
   struct constr_t e2 = CONSTRAINT_TERM(INTERVAL(0, 1));
   struct constr_t e3 = CONSTRAINT_TERM(VALUE(1));
 
-  struct env_t v[2]  = { { "x", &e1, NULL, {0, NULL}, 0, 0, 0 },
-                         { "y", &e2, NULL, {0, NULL}, 1, 3, 0 } };
+  struct env_t v[2]  = { { "x", &e1, NULL, {0, NULL}, {0, NULL}, 0, 0, 0 },
+                         { "y", &e2, NULL, {0, NULL}, {0, NULL}, 1, 3, 0 } };
   e1.constr.term.env = &v[0];
   e2.constr.term.env = &v[1];
 
@@ -471,83 +564,67 @@ TEST(ClausesInit, Expr) {
 
   MockProxy = new Mock();
   X = CONSTRAINT_EXPR(EQ, &e1, &e2);
-  EXPECT_CALL(*MockProxy, clause_list_contains(testing::_, testing::_)).Times(0);
-  EXPECT_CALL(*MockProxy, clause_list_append(testing::_, testing::_)).Times(0);
+  EXPECT_CALL(*MockProxy, clause_list_subscribe(testing::_, testing::_, testing::_)).Times(0);
   clauses_init(&X, NULL);
   delete(MockProxy);
 
   MockProxy = new Mock();
   X = CONSTRAINT_EXPR(EQ, &e3, &e3);
-  EXPECT_CALL(*MockProxy, clause_list_contains(testing::_, testing::_)).Times(0);
-  EXPECT_CALL(*MockProxy, clause_list_append(testing::_, testing::_)).Times(0);
+  EXPECT_CALL(*MockProxy, clause_list_subscribe(testing::_, testing::_, testing::_)).Times(0);
   clauses_init(&X, &w);
   delete(MockProxy);
 
   MockProxy = new Mock();
   X = CONSTRAINT_EXPR(EQ, &e1, &e2);
-  EXPECT_CALL(*MockProxy, clause_list_contains(&v[0].clauses, &w)).Times(1).WillRepeatedly(::testing::Return(false));
-  EXPECT_CALL(*MockProxy, clause_list_append(&v[0].clauses, &w)).Times(1);
-  EXPECT_CALL(*MockProxy, clause_list_contains(&v[1].clauses, &w)).Times(1).WillRepeatedly(::testing::Return(false));
-  EXPECT_CALL(*MockProxy, clause_list_append(&v[1].clauses, &w)).Times(1);
+  EXPECT_CALL(*MockProxy, clause_list_subscribe(&v[0].clauses, &w, PROP_EVENT_ANY)).Times(1);
+  EXPECT_CALL(*MockProxy, clause_list_subscribe(&v[1].clauses, &w, PROP_EVENT_ANY)).Times(1);
   clauses_init(&X, &w);
   delete(MockProxy);
 
   MockProxy = new Mock();
   X = CONSTRAINT_EXPR(LT, &e1, &e2);
-  EXPECT_CALL(*MockProxy, clause_list_contains(&v[0].clauses, &w)).Times(1).WillRepeatedly(::testing::Return(false));
-  EXPECT_CALL(*MockProxy, clause_list_append(&v[0].clauses, &w)).Times(1);
-  EXPECT_CALL(*MockProxy, clause_list_contains(&v[1].clauses, &w)).Times(1).WillRepeatedly(::testing::Return(false));
-  EXPECT_CALL(*MockProxy, clause_list_append(&v[1].clauses, &w)).Times(1);
+  EXPECT_CALL(*MockProxy, clause_list_subscribe(&v[0].clauses, &w, PROP_EVENT_LB)).Times(1);
+  EXPECT_CALL(*MockProxy, clause_list_subscribe(&v[1].clauses, &w, PROP_EVENT_UB)).Times(1);
   clauses_init(&X, &w);
   delete(MockProxy);
 
   MockProxy = new Mock();
   X = CONSTRAINT_EXPR(ADD, &e1, &e2);
-  EXPECT_CALL(*MockProxy, clause_list_contains(&v[0].clauses, &w)).Times(1).WillRepeatedly(::testing::Return(false));
-  EXPECT_CALL(*MockProxy, clause_list_append(&v[0].clauses, &w)).Times(1);
-  EXPECT_CALL(*MockProxy, clause_list_contains(&v[1].clauses, &w)).Times(1).WillRepeatedly(::testing::Return(false));
-  EXPECT_CALL(*MockProxy, clause_list_append(&v[1].clauses, &w)).Times(1);
+  EXPECT_CALL(*MockProxy, clause_list_subscribe(&v[0].clauses, &w, PROP_EVENT_ANY)).Times(1);
+  EXPECT_CALL(*MockProxy, clause_list_subscribe(&v[1].clauses, &w, PROP_EVENT_ANY)).Times(1);
   clauses_init(&X, &w);
   delete(MockProxy);
 
   MockProxy = new Mock();
   X = CONSTRAINT_EXPR(MUL, &e1, &e2);
-  EXPECT_CALL(*MockProxy, clause_list_contains(&v[0].clauses, &w)).Times(1).WillRepeatedly(::testing::Return(false));
-  EXPECT_CALL(*MockProxy, clause_list_append(&v[0].clauses, &w)).Times(1);
-  EXPECT_CALL(*MockProxy, clause_list_contains(&v[1].clauses, &w)).Times(1).WillRepeatedly(::testing::Return(false));
-  EXPECT_CALL(*MockProxy, clause_list_append(&v[1].clauses, &w)).Times(1);
+  EXPECT_CALL(*MockProxy, clause_list_subscribe(&v[0].clauses, &w, PROP_EVENT_ANY)).Times(1);
+  EXPECT_CALL(*MockProxy, clause_list_subscribe(&v[1].clauses, &w, PROP_EVENT_ANY)).Times(1);
   clauses_init(&X, &w);
   delete(MockProxy);
 
   MockProxy = new Mock();
   X = CONSTRAINT_EXPR(AND, &e1, &e2);
-  EXPECT_CALL(*MockProxy, clause_list_contains(&v[0].clauses, &w)).Times(1).WillRepeatedly(::testing::Return(false));
-  EXPECT_CALL(*MockProxy, clause_list_append(&v[0].clauses, &w)).Times(1);
-  EXPECT_CALL(*MockProxy, clause_list_contains(&v[1].clauses, &w)).Times(1).WillRepeatedly(::testing::Return(false));
-  EXPECT_CALL(*MockProxy, clause_list_append(&v[1].clauses, &w)).Times(1);
+  EXPECT_CALL(*MockProxy, clause_list_subscribe(&v[0].clauses, &w, PROP_EVENT_ANY)).Times(1);
+  EXPECT_CALL(*MockProxy, clause_list_subscribe(&v[1].clauses, &w, PROP_EVENT_ANY)).Times(1);
   clauses_init(&X, &w);
   delete(MockProxy);
 
   MockProxy = new Mock();
   X = CONSTRAINT_EXPR(OR, &e1, &e2);
-  EXPECT_CALL(*MockProxy, clause_list_contains(&v[0].clauses, &w)).Times(1).WillRepeatedly(::testing::Return(false));
-  EXPECT_CALL(*MockProxy, clause_list_append(&v[0].clauses, &w)).Times(1);
-  EXPECT_CALL(*MockProxy, clause_list_contains(&v[1].clauses, &w)).Times(1).WillRepeatedly(::testing::Return(false));
-  EXPECT_CALL(*MockProxy, clause_list_append(&v[1].clauses, &w)).Times(1);
+  EXPECT_CALL(*MockProxy, clause_list_subscribe(&v[0].clauses, &w, PROP_EVENT_ANY)).Times(1);
+  EXPECT_CALL(*MockProxy, clause_list_subscribe(&v[1].clauses, &w, PROP_EVENT_ANY)).Times(1);
   clauses_init(&X, &w);
   delete(MockProxy);
 
   MockProxy = new Mock();
   X = CONSTRAINT_EXPR(NEG, &e1, NULL);
-  EXPECT_CALL(*MockProxy, clause_list_contains(&v[0].clauses, &w)).Times(1).WillRepeatedly(::testing::Return(false));
-  EXPECT_CALL(*MockProxy, clause_list_append(&v[0].clauses, &w)).Times(1);
+  EXPECT_CALL(*MockProxy, clause_list_subscribe(&v[0].clauses, &w, PROP_EVENT_ANY)).Times(1);
   clauses_init(&X, &w);
   delete(MockProxy);
 
   MockProxy = new Mock();
   X = CONSTRAINT_EXPR(NOT, &e1, NULL);
-  EXPECT_CALL(*MockProxy, clause_list_contains(&v[0].clauses, &w)).Times(1).WillRepeatedly(::testing::Return(false));
-  EXPECT_CALL(*MockProxy, clause_list_append(&v[0].clauses, &w)).Times(1);
+  EXPECT_CALL(*MockProxy, clause_list_subscribe(&v[0].clauses, &w, PROP_EVENT_ANY)).Times(1);
   clauses_init(&X, &w);
   delete(MockProxy);
 
@@ -558,4 +635,140 @@ TEST(ClausesInit, Expr) {
   delete(MockProxy);
 }
 
+TEST(ClausesInit, Events) {
+  struct constr_t e1 = CONSTRAINT_TERM(INTERVAL(2, 3));
+  struct constr_t e2 = CONSTRAINT_TERM(INTERVAL(0, 1));
+  struct constr_t e3 = CONSTRAINT_TERM(INTERVAL(0, 5));
+
+  struct env_t v[3]  = { { "x", &e1, NULL, {0, NULL}, {0, NULL}, 0, 0, 0 },
+                         { "y", &e2, NULL, {0, NULL}, {0, NULL}, 1, 3, 0 },
+                         { "z", &e3, NULL, {0, NULL}, {0, NULL}, 2, 1, 0 } };
+  e1.constr.term.env = &v[0];
+  e2.constr.term.env = &v[1];
+  e3.constr.term.env = &v[2];
+
+  struct wand_expr_t w;
+
+  // !(-x + y < z)
+  struct constr_t N = CONSTRAINT_EXPR(NEG, &e1, NULL);
+  struct constr_t A = CONSTRAINT_EXPR(ADD, &N, &e2);
+  struct constr_t L = CONSTRAINT_EXPR(LT, &A, &e3);
+  struct constr_t X = CONSTRAINT_EXPR(NOT, &L, NULL);
+  MockProxy = new Mock();
+  EXPECT_CALL(*MockProxy, clause_list_subscribe(&v[0].clauses, &w, PROP_EVENT_LB)).Times(1);
+  EXPECT_CALL(*MockProxy, clause_list_subscribe(&v[1].clauses, &w, PROP_EVENT_UB)).Times(1);
+  EXPECT_CALL(*MockProxy, clause_list_subscribe(&v[2].clauses, &w, PROP_EVENT_LB)).Times(1);
+  clauses_init(&X, &w);
+  delete(MockProxy);
+
+  // x < y && y < z
+  struct constr_t L1 = CONSTRAINT_EXPR(LT, &e1, &e2);
+  struct constr_t L2 = CONSTRAINT_EXPR(LT, &e2, &e3);
+  struct constr_t Y = CONSTRAINT_EXPR(AND, &L1, &L2);
+  MockProxy = new Mock();
+  EXPECT_CALL(*MockProxy, clause_list_subscribe(&v[0].clauses, &w, PROP_EVENT_LB)).Times(1);
+  EXPECT_CALL(*MockProxy, clause_list_subscribe(&v[1].clauses, &w, PROP_EVENT_UB)).Times(1);
+  EXPECT_CALL(*MockProxy, clause_list_subscribe(&v[1].clauses, &w, PROP_EVENT_LB)).Times(1);
+  EXPECT_CALL(*MockProxy, clause_list_subscribe(&v[2].clauses, &w, PROP_EVENT_UB)).Times(1);
+  clauses_init(&Y, &w);
+  delete(MockProxy);
+
+  // !(x < y || y < z)
+  struct constr_t O = CONSTRAINT_EXPR(OR, &L1, &L2);
+  struct constr_t Z = CONSTRAINT_EXPR(NOT, &O, NULL);
+  MockProxy = new Mock();
+  EXPECT_CALL(*MockProxy, clause_list_subscribe(&v[0].clauses, &w, PROP_EVENT_UB)).Times(1);
+  EXPECT_CALL(*MockProxy, clause_list_subscribe(&v[1].clauses, &w, PROP_EVENT_LB)).Times(1);
+  EXPECT_CALL(*MockProxy, clause_list_subscribe(&v[1].clauses, &w, PROP_EVENT_UB)).Times(1);
+  EXPECT_CALL(*MockProxy, clause_list_subscribe(&v[2].clauses, &w, PROP_EVENT_LB)).Times(1);
+  clauses_init(&Z, &w);
+  delete(MockProxy);
+
+  // x < y || y < z
+  MockProxy = new Mock();
+  EXPECT_CALL(*MockProxy, clause_list_subscribe(&v[0].clauses, &w, PROP_EVENT_ANY)).Times(1);
+  EXPECT_CALL(*MockProxy, clause_list_subscribe(&v[1].clauses, &w, PROP_EVENT_ANY)).Times(2);
+  EXPECT_CALL(*MockProxy, clause_list_subscribe(&v[2].clauses, &w, PROP_EVENT_ANY)).Times(1);
+  clauses_init(&O, &w);
+  delete(MockProxy);
+}
+
+TEST(ModelSolve, Infeasible) {
+  struct constr_t X = CONSTRAINT_TERM(VALUE(0));
+  _vars = NULL;
+  _var_count = 0;
+
+  MockProxy = new Mock();
+  EXPECT_CALL(*MockProxy, propagate(&X, 0)).Times(1).WillOnce(::testing::Return(PROP_ERROR));
+  EXPECT_CALL(*MockProxy, bind_commit()).Times(1);
+  EXPECT_CALL(*MockProxy, patch_commit()).Times(1);
+  EXPECT_CALL(*MockProxy, stats_init()).Times(1);
+  EXPECT_CALL(*MockProxy, solve(testing::_, testing::_, testing::_)).Times(0);
+  EXPECT_CALL(*MockProxy, free(testing::_)).Times(testing::AnyNumber());
+  EXPECT_FALSE(model_solve(&X));
+  delete(MockProxy);
+}
+
+TEST(ModelSolve, Feasible) {
+  struct constr_t X = CONSTRAINT_TERM(VALUE(1));
+  struct constr_t Y = CONSTRAINT_TERM(VALUE(1));
+  _vars = NULL;
+  _var_count = 0;
+
+  MockProxy = new Mock();
+  EXPECT_CALL(*MockProxy, propagate(&X, 0)).Times(1).WillOnce(::testing::Return(PROP_NONE));
+  EXPECT_CALL(*MockProxy, normalize(&X)).Times(1).WillOnce(::testing::Return(&Y));
+  EXPECT_CALL(*MockProxy, normalize(&Y)).Times(1).WillOnce(::testing::Return(&Y));
+  EXPECT_CALL(*MockProxy, propagate(&Y, 0)).Times(2).WillRepeatedly(::testing::Return(PROP_NONE));
+  EXPECT_CALL(*MockProxy, bind_commit()).Times(1);
+  EXPECT_CALL(*MockProxy, patch_commit()).Times(1);
+  EXPECT_CALL(*MockProxy, stats_init()).Times(1);
+  EXPECT_CALL(*MockProxy, compile_init(testing::_)).Times(1);
+  EXPECT_CALL(*MockProxy, compile_clauses(&Y)).Times(1);
+  EXPECT_CALL(*MockProxy, strategy_var_order_init(0, testing::_)).Times(1);
+  EXPECT_CALL(*MockProxy, solve(0, testing::_, &Y)).Times(1);
+  EXPECT_CALL(*MockProxy, free(testing::_)).Times(testing::AnyNumber());
+  EXPECT_TRUE(model_solve(&X));
+  delete(MockProxy);
+}
+
+TEST(ModelPresolve, Infeasible) {
+  struct constr_t X = CONSTRAINT_TERM(VALUE(0));
+  struct env_t *env = NULL;
+  _vars = NULL;
+  _var_count = 0;
+
+  MockProxy = new Mock();
+  EXPECT_CALL(*MockProxy, propagate(&X, 0)).Times(1).WillOnce(::testing::Return(PROP_ERROR));
+  EXPECT_CALL(*MockProxy, bind_commit()).Times(1);
+  EXPECT_CALL(*MockProxy, patch_commit()).Times(1);
+  EXPECT_CALL(*MockProxy, stats_init()).Times(1);
+  EXPECT_EQ((struct constr_t *)NULL, model_presolve(&X, &env));
+  EXPECT_EQ((struct env_t *)NULL, env);
+  delete(MockProxy);
+}
+
+TEST(ModelPresolve, Feasible) {
+  struct constr_t X = CONSTRAINT_TERM(VALUE(1));
+  struct constr_t Y = CONSTRAINT_TERM(VALUE(1));
+  struct env_t *env = (struct env_t *)&X;
+  _vars = NULL;
+  _var_count = 0;
+
+  MockProxy = new Mock();
+  EXPECT_CALL(*MockProxy, propagate(&X, 0)).Times(1).WillOnce(::testing::Return(PROP_NONE));
+  EXPECT_CALL(*MockProxy, normalize(&X)).Times(1).WillOnce(::testing::Return(&Y));
+  EXPECT_CALL(*MockProxy, normalize(&Y)).Times(1).WillOnce(::testing::Return(&Y));
+  EXPECT_CALL(*MockProxy, propagate(&Y, 0)).Times(2).WillRepeatedly(::testing::Return(PROP_NONE));
+  EXPECT_CALL(*MockProxy, bind_commit()).Times(1);
+  EXPECT_CALL(*MockProxy, patch_commit()).Times(1);
+  EXPECT_CALL(*MockProxy, stats_init()).Times(1);
+  EXPECT_CALL(*MockProxy, compile_init(testing::_)).Times(1);
+  EXPECT_CALL(*MockProxy, compile_clauses(&Y)).Times(1);
+  EXPECT_CALL(*MockProxy, solve(testing::_, testing::_, testing::_)).Times(0);
+  EXPECT_EQ(&Y, model_presolve(&X, &env));
+  EXPECT_EQ(_vars, env);
+  delete(MockProxy);
+}
+
 }
@@ -16,7 +16,8 @@ class Mock {
 
 Mock *MockProxy;
 
-size_t alloc_max;
+THREAD_LOCAL size_t alloc_max;
+THREAD_LOCAL uint64_t eval_epoch;
 
 void eval_cache_invalidate(void) {
   MockProxy->eval_cache_invalidate();
@@ -120,4 +121,5 @@ TEST(Unpatch, Sucess) {
   delete(MockProxy);
 }
 
+
 } // end namespace
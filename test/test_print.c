@@ -11,7 +11,7 @@ void mock_exit(int code);
 
 class Mock {
  public:
-  MOCK_METHOD0(objective_best, domain_t(void));
+  MOCK_METHOD0(objective_solution, domain_t(void));
   MOCK_METHOD0(main_name, const char *(void));
   MOCK_METHOD1(exit, void(int));
 #define CONSTR_TYPE_MOCKS(UPNAME, NAME, OP) \
@@ -23,8 +23,8 @@ class Mock {
 
 Mock *MockProxy;
 
-domain_t objective_best(void) {
-  return MockProxy->objective_best();
+domain_t objective_solution(void) {
+  return MockProxy->objective_solution();
 }
 
 const char *main_name(void) {
@@ -193,7 +193,7 @@ TEST(PrintSolution, Basic) {
                            { "c", &c } };
 
   MockProxy = new Mock();
-  EXPECT_CALL(*MockProxy, objective_best())
+  EXPECT_CALL(*MockProxy, objective_solution())
     .Times(::testing::AtLeast(1))
     .WillRepeatedly(::testing::Return(77));
   testing::internal::CaptureStderr();
@@ -203,7 +203,7 @@ TEST(PrintSolution, Basic) {
   delete(MockProxy);
 
   MockProxy = new Mock();
-  EXPECT_CALL(*MockProxy, objective_best())
+  EXPECT_CALL(*MockProxy, objective_solution())
     .Times(::testing::AtLeast(1))
     .WillRepeatedly(::testing::Return(77));
   testing::internal::CaptureStdout();
@@ -246,4 +246,16 @@ TEST(PrintFatal, Basic) {
   delete(MockProxy);
 }
 
+TEST(PrintWarning, Basic) {
+  std::string output;
+
+  MockProxy = new Mock();
+  EXPECT_CALL(*MockProxy, main_name()).Times(1).WillOnce(::testing::Return("<name>"));
+  testing::internal::CaptureStderr();
+  print_warning(WARNING_MSG_SINGLE_CUBE);
+  output = testing::internal::GetCapturedStderr();
+  EXPECT_EQ(output, "<name>: warning: " WARNING_MSG_SINGLE_CUBE "\n");
+  delete(MockProxy);
+}
+
 } // end namespace
@@ -36,13 +36,20 @@ bool operator==(const struct constr_t& lhs, const struct constr_t& rhs) {
 
 class Mock {
  public:
-  MOCK_METHOD3(bind, void(struct env_t *, const struct val_t, const struct wand_expr_t *));
+  MOCK_METHOD3(bind, prop_event_t(struct env_t *, const struct val_t, const struct wand_expr_t *));
   MOCK_METHOD0(conflict_reset, void(void));
   MOCK_METHOD2(conflict_create, void(struct env_t *, const struct wand_expr_t *));
   MOCK_METHOD0(strategy_create_conflicts, bool(void));
   MOCK_METHOD1(strategy_var_order_update, void(struct env_t *));
   MOCK_METHOD2(patch, size_t(struct wand_expr_t *, struct constr_t *));
+  MOCK_METHOD2(clause_list_drop, size_t(struct clause_list_t *, size_t));
+  MOCK_METHOD3(clause_list_append, void(struct clause_list_t *, struct wand_expr_t *, prop_event_t));
+  MOCK_METHOD2(clause_list_remove, void(struct clause_list_t *, size_t));
+  MOCK_METHOD0(objective_poll, bool(void));
+  MOCK_METHOD0(strategy_prop_order, enum prop_order_t(void));
   MOCK_METHOD1(print_fatal, void (const char *));
+  MOCK_METHOD1(code_eval, struct val_t(const struct code_t *));
+  MOCK_METHOD2(code_propagate, prop_result_t(const struct code_t *, const struct wand_expr_t *));
 #define CONSTR_TYPE_MOCKS(UPNAME, NAME, OP) \
   MOCK_METHOD1(normal_ ## NAME, struct constr_t *(struct constr_t *));
   CONSTR_TYPE_LIST(CONSTR_TYPE_MOCKS)
@@ -50,10 +57,23 @@ class Mock {
 
 Mock *MockProxy;
 
-uint64_t props;
+THREAD_LOCAL uint64_t props;
 
-void bind(struct env_t *var, const struct val_t val, const struct wand_expr_t *clause) {
-  MockProxy->bind(var, val, clause);
+static char _test_stack[1 << 12];
+static size_t _test_stack_ptr;
+
+void *alloc(size_t size) {
+  void *retval = &_test_stack[_test_stack_ptr];
+  _test_stack_ptr += (size + sizeof(void *) - 1) & ~(sizeof(void *) - 1);
+  return retval;
+}
+
+void dealloc(void *elem) {
+  _test_stack_ptr = (char *)elem - _test_stack;
+}
+
+prop_event_t bind(struct env_t *var, const struct val_t val, const struct wand_expr_t *clause) {
+  return MockProxy->bind(var, val, clause);
 }
 
 void conflict_reset(void) {
@@ -76,10 +96,45 @@ size_t patch(struct wand_expr_t *loc, struct constr_t *constr) {
   return MockProxy->patch(loc, constr);
 }
 
+size_t clause_list_drop(struct clause_list_t *list, size_t index) {
+  return MockProxy->clause_list_drop(list, index);
+}
+
+void clause_list_append(struct clause_list_t *list, struct wand_expr_t *elem, prop_event_t events) {
+  MockProxy->clause_list_append(list, elem, events);
+}
+
+void clause_list_remove(struct clause_list_t *list, size_t index) {
+  MockProxy->clause_list_remove(list, index);
+}
+
+bool objective_poll(void) {
+  return MockProxy->objective_poll();
+}
+
+static struct constr_t _test_no_objective = CONSTRAINT_TERM(INTERVAL(0, 0));
+static struct constr_t *_test_objective = &_test_no_objective;
+
+struct constr_t *objective_val(void) {
+  return _test_objective;
+}
+
+enum prop_order_t strategy_prop_order(void) {
+  return MockProxy->strategy_prop_order();
+}
+
 void print_fatal(const char *fmt, ...) {
   MockProxy->print_fatal(fmt);
 }
 
+struct val_t code_eval(const struct code_t *code) {
+  return MockProxy->code_eval(code);
+}
+
+prop_result_t code_propagate(const struct code_t *code, const struct wand_expr_t *clause) {
+  return MockProxy->code_propagate(code, clause);
+}
+
 #define CONSTR_TYPE_CMOCKS(UPNAME, NAME, OP)                \
 struct constr_t *normal_ ## NAME(struct constr_t *constr) { \
   return MockProxy->normal_ ## NAME(constr);                \
@@ -746,22 +801,232 @@ TEST(PropagateMul, Interval) {
 
   MockProxy = new Mock();
   X = CONSTRAINT_EXPR(MUL, &A, &B);
-  EXPECT_EQ(PROP_NONE, propagate_mul(&X, VALUE(21), NULL));
+  EXPECT_EQ(1, propagate_mul(&X, VALUE(21), NULL));
+  EXPECT_EQ(VALUE(3), A.constr.term.val);
+  EXPECT_EQ(INTERVAL(7,8), B.constr.term.val);
   delete(MockProxy);
 
+  A.constr.term.val = INTERVAL(1,3);
   MockProxy = new Mock();
   X = CONSTRAINT_EXPR(MUL, &A, &B);
-  EXPECT_EQ(PROP_NONE, propagate_mul(&X, INTERVAL(14, 24), NULL));
+  EXPECT_EQ(1, propagate_mul(&X, INTERVAL(14, 24), NULL));
+  EXPECT_EQ(INTERVAL(2,3), A.constr.term.val);
+  EXPECT_EQ(INTERVAL(7,8), B.constr.term.val);
   delete(MockProxy);
 
+  A.constr.term.val = INTERVAL(1,3);
   MockProxy = new Mock();
   X = CONSTRAINT_EXPR(MUL, &A, &B);
-  EXPECT_EQ(PROP_NONE, propagate_mul(&X, VALUE(1), NULL));
+  EXPECT_EQ(PROP_ERROR, propagate_mul(&X, VALUE(1), NULL));
   delete(MockProxy);
 
   MockProxy = new Mock();
   X = CONSTRAINT_EXPR(MUL, &A, &B);
-  EXPECT_EQ(PROP_NONE, propagate_mul(&X, INTERVAL(-100, 0), NULL));
+  EXPECT_EQ(PROP_ERROR, propagate_mul(&X, INTERVAL(-100, 0), NULL));
+  delete(MockProxy);
+}
+
+TEST(PropagateMul, Zero) {
+  struct constr_t A = CONSTRAINT_TERM(INTERVAL(2,3));
+  struct constr_t B = CONSTRAINT_TERM(INTERVAL(-10,10));
+  struct constr_t X = CONSTRAINT_EXPR(MUL, &A, &B);
+
+  // factors that may be zero only restrict through the other factor
+  MockProxy = new Mock();
+  EXPECT_EQ(1, propagate_mul(&X, INTERVAL(-6, 6), NULL));
+  EXPECT_EQ(INTERVAL(2,3), A.constr.term.val);
+  EXPECT_EQ(INTERVAL(-3,3), B.constr.term.val);
+  delete(MockProxy);
+
+  // quotients for both signs of the other factor are merged
+  A.constr.term.val = INTERVAL(-1,1);
+  B.constr.term.val = INTERVAL(-10,10);
+  MockProxy = new Mock();
+  EXPECT_EQ(PROP_NONE, propagate_mul(&X, INTERVAL(20, 30), NULL));
+  EXPECT_EQ(INTERVAL(-1,1), A.constr.term.val);
+  EXPECT_EQ(INTERVAL(-10,10), B.constr.term.val);
+  delete(MockProxy);
+}
+
+TEST(PropagateDiv, Basic) {
+  struct constr_t A = CONSTRAINT_TERM(INTERVAL(-100, 100));
+  struct constr_t B = CONSTRAINT_TERM(INTERVAL(0, 10));
+  struct constr_t X = CONSTRAINT_EXPR(DIV, &A, &B);
+
+  MockProxy = new Mock();
+  EXPECT_EQ(2, propagate_div(&X, INTERVAL(3, 5), NULL));
+  EXPECT_EQ(INTERVAL(3, 59), A.constr.term.val);
+  EXPECT_EQ(INTERVAL(1, 10), B.constr.term.val);
+  delete(MockProxy);
+
+  // a quotient of zero needs a divisor above the dividend
+  A.constr.term.val = INTERVAL(5, 100);
+  B.constr.term.val = INTERVAL(1, 200);
+  MockProxy = new Mock();
+  EXPECT_EQ(1, propagate_div(&X, VALUE(0), NULL));
+  EXPECT_EQ(INTERVAL(5, 100), A.constr.term.val);
+  EXPECT_EQ(INTERVAL(6, 200), B.constr.term.val);
+  delete(MockProxy);
+
+  // only dividing by zero yields zero
+  A.constr.term.val = VALUE(7);
+  B.constr.term.val = VALUE(0);
+  MockProxy = new Mock();
+  EXPECT_EQ(PROP_NONE, propagate_div(&X, VALUE(0), NULL));
+  EXPECT_EQ(PROP_ERROR, propagate_div(&X, VALUE(1), NULL));
+  delete(MockProxy);
+}
+
+TEST(PropagateMod, Basic) {
+  struct constr_t A = CONSTRAINT_TERM(INTERVAL(-20, 20));
+  struct constr_t B = CONSTRAINT_TERM(INTERVAL(-5, 5));
+  struct constr_t X = CONSTRAINT_EXPR(MOD, &A, &B);
+
+  // the remainder has the sign of the dividend
+  MockProxy = new Mock();
+  EXPECT_EQ(1, propagate_mod(&X, INTERVAL(2, 3), NULL));
+  EXPECT_EQ(INTERVAL(2, 20), A.constr.term.val);
+  EXPECT_EQ(INTERVAL(-5, 5), B.constr.term.val);
+  delete(MockProxy);
+
+  // small dividends are their own remainder
+  A.constr.term.val = INTERVAL(0, 3);
+  B.constr.term.val = INTERVAL(5, 8);
+  MockProxy = new Mock();
+  EXPECT_EQ(2, propagate_mod(&X, INTERVAL(1, 2), NULL));
+  EXPECT_EQ(INTERVAL(1, 2), A.constr.term.val);
+  EXPECT_EQ(INTERVAL(5, 8), B.constr.term.val);
+  delete(MockProxy);
+
+  // the divisor exceeds the remainder
+  A.constr.term.val = INTERVAL(0, 50);
+  B.constr.term.val = INTERVAL(1, 10);
+  MockProxy = new Mock();
+  EXPECT_EQ(2, propagate_mod(&X, VALUE(7), NULL));
+  EXPECT_EQ(INTERVAL(7, 50), A.constr.term.val);
+  EXPECT_EQ(INTERVAL(8, 10), B.constr.term.val);
+  delete(MockProxy);
+}
+
+TEST(PropagateAbs, Basic) {
+  struct constr_t A = CONSTRAINT_TERM(INTERVAL(-10, 10));
+  struct constr_t X = CONSTRAINT_EXPR(ABS, &A, NULL);
+
+  MockProxy = new Mock();
+  EXPECT_EQ(1, propagate_abs(&X, INTERVAL(3, 5), NULL));
+  EXPECT_EQ(INTERVAL(-5, 5), A.constr.term.val);
+  delete(MockProxy);
+
+  A.constr.term.val = INTERVAL(-1, 10);
+  MockProxy = new Mock();
+  EXPECT_EQ(2, propagate_abs(&X, INTERVAL(3, 5), NULL));
+  EXPECT_EQ(INTERVAL(3, 5), A.constr.term.val);
+  delete(MockProxy);
+
+  A.constr.term.val = INTERVAL(-10, 1);
+  MockProxy = new Mock();
+  EXPECT_EQ(2, propagate_abs(&X, INTERVAL(3, 5), NULL));
+  EXPECT_EQ(INTERVAL(-5, -3), A.constr.term.val);
+  delete(MockProxy);
+
+  MockProxy = new Mock();
+  EXPECT_EQ(PROP_ERROR, propagate_abs(&X, INTERVAL(-3, -1), NULL));
+  delete(MockProxy);
+}
+
+TEST(PropagateMin, Basic) {
+  struct constr_t A = CONSTRAINT_TERM(INTERVAL(0, 10));
+  struct constr_t B = CONSTRAINT_TERM(INTERVAL(5, 20));
+  struct constr_t X = CONSTRAINT_EXPR(MIN, &A, &B);
+
+  MockProxy = new Mock();
+  EXPECT_EQ(2, propagate_min(&X, INTERVAL(3, 4), NULL));
+  EXPECT_EQ(INTERVAL(3, 4), A.constr.term.val);
+  EXPECT_EQ(INTERVAL(5, 20), B.constr.term.val);
+  delete(MockProxy);
+
+  A.constr.term.val = INTERVAL(5, 10);
+  B.constr.term.val = INTERVAL(6, 8);
+  MockProxy = new Mock();
+  EXPECT_EQ(PROP_ERROR, propagate_min(&X, INTERVAL(0, 4), NULL));
+  delete(MockProxy);
+}
+
+TEST(PropagateMax, Basic) {
+  struct constr_t A = CONSTRAINT_TERM(INTERVAL(0, 10));
+  struct constr_t B = CONSTRAINT_TERM(INTERVAL(-5, 2));
+  struct constr_t X = CONSTRAINT_EXPR(MAX, &A, &B);
+
+  MockProxy = new Mock();
+  EXPECT_EQ(2, propagate_max(&X, INTERVAL(5, 7), NULL));
+  EXPECT_EQ(INTERVAL(5, 7), A.constr.term.val);
+  EXPECT_EQ(INTERVAL(-5, 2), B.constr.term.val);
+  delete(MockProxy);
+
+  A.constr.term.val = INTERVAL(0, 3);
+  MockProxy = new Mock();
+  EXPECT_EQ(PROP_ERROR, propagate_max(&X, INTERVAL(5, 7), NULL));
+  delete(MockProxy);
+}
+
+TEST(PropagateLin, Basic) {
+  struct constr_t A = CONSTRAINT_TERM(INTERVAL(0, 10));
+  struct constr_t B = CONSTRAINT_TERM(INTERVAL(0, 10));
+  struct constr_t C = CONSTRAINT_TERM(INTERVAL(0, 5));
+  struct lin_term_t terms[3] = { { 1, &A }, { 2, &B }, { -1, &C } };
+  struct constr_t X = CONSTRAINT_LIN(3, terms);
+
+  MockProxy = new Mock();
+  EXPECT_EQ(PROP_NONE, propagate_lin(&X, INTERVAL(DOMAIN_MIN, DOMAIN_MAX), NULL));
+  EXPECT_EQ(PROP_NONE, propagate_lin(&X, INTERVAL(-5, 30), NULL));
+  delete(MockProxy);
+
+  MockProxy = new Mock();
+  EXPECT_EQ(2, propagate_lin(&X, INTERVAL(DOMAIN_MIN, 4), NULL));
+  EXPECT_EQ(INTERVAL(0, 9), A.constr.term.val);
+  EXPECT_EQ(INTERVAL(0, 4), B.constr.term.val);
+  EXPECT_EQ(INTERVAL(0, 5), C.constr.term.val);
+  delete(MockProxy);
+
+  // later terms see the bounds restricted by earlier terms
+  A.constr.term.val = INTERVAL(0, 10);
+  B.constr.term.val = INTERVAL(0, 10);
+  MockProxy = new Mock();
+  EXPECT_EQ(3, propagate_lin(&X, VALUE(30), NULL));
+  EXPECT_EQ(VALUE(10), A.constr.term.val);
+  EXPECT_EQ(VALUE(10), B.constr.term.val);
+  EXPECT_EQ(VALUE(0), C.constr.term.val);
+  delete(MockProxy);
+
+  A.constr.term.val = INTERVAL(0, 10);
+  B.constr.term.val = INTERVAL(0, 10);
+  C.constr.term.val = INTERVAL(0, 5);
+  MockProxy = new Mock();
+  EXPECT_EQ(PROP_ERROR, propagate_lin(&X, VALUE(31), NULL));
+  delete(MockProxy);
+}
+
+TEST(PropagateLin, Unbounded) {
+  struct constr_t A = CONSTRAINT_TERM(INTERVAL(0, 10));
+  struct constr_t B = CONSTRAINT_TERM(INTERVAL(0, DOMAIN_MAX));
+  struct constr_t C = CONSTRAINT_TERM(INTERVAL(0, 10));
+  struct lin_term_t terms[3] = { { 1, &A }, { 1, &B }, { 3, &C } };
+  struct constr_t X = CONSTRAINT_LIN(3, terms);
+
+  // only the unbounded term can be restricted from below
+  MockProxy = new Mock();
+  EXPECT_EQ(1, propagate_lin(&X, INTERVAL(50, DOMAIN_MAX), NULL));
+  EXPECT_EQ(INTERVAL(0, 10), A.constr.term.val);
+  EXPECT_EQ(INTERVAL(10, DOMAIN_MAX), B.constr.term.val);
+  EXPECT_EQ(INTERVAL(0, 10), C.constr.term.val);
+  delete(MockProxy);
+
+  // bounded terms can be restricted from above again
+  MockProxy = new Mock();
+  EXPECT_EQ(2, propagate_lin(&X, INTERVAL(DOMAIN_MIN, 20), NULL));
+  EXPECT_EQ(INTERVAL(0, 10), A.constr.term.val);
+  EXPECT_EQ(INTERVAL(10, 20), B.constr.term.val);
+  EXPECT_EQ(INTERVAL(0, 3), C.constr.term.val);
   delete(MockProxy);
 }
 
@@ -993,6 +1258,187 @@ TEST(PropagateOr, Interval) {
   delete(MockProxy);
 }
 
+TEST(PropagateAlldiff, Lower) {
+  struct constr_t A = CONSTRAINT_TERM(INTERVAL(1, 2));
+  struct constr_t B = CONSTRAINT_TERM(INTERVAL(1, 2));
+  struct constr_t C = CONSTRAINT_TERM(INTERVAL(1, 4));
+  struct constr_t *elems[3] = { &A, &C, &B };
+  struct constr_t X = CONSTRAINT_ALLDIFF(3, elems);
+
+  // A and B use up the values 1 and 2
+  MockProxy = new Mock();
+  EXPECT_EQ(1, propagate_alldiff(&X, VALUE(1), NULL));
+  EXPECT_EQ(INTERVAL(1, 2), A.constr.term.val);
+  EXPECT_EQ(INTERVAL(1, 2), B.constr.term.val);
+  EXPECT_EQ(INTERVAL(3, 4), C.constr.term.val);
+  delete(MockProxy);
+
+  MockProxy = new Mock();
+  EXPECT_EQ(PROP_NONE, propagate_alldiff(&X, VALUE(1), NULL));
+  delete(MockProxy);
+}
+
+TEST(PropagateAlldiff, Upper) {
+  struct constr_t A = CONSTRAINT_TERM(VALUE(3));
+  struct constr_t B = CONSTRAINT_TERM(INTERVAL(2, 3));
+  struct constr_t C = CONSTRAINT_TERM(INTERVAL(1, 3));
+  struct constr_t D = CONSTRAINT_TERM(INTERVAL(0, 9));
+  struct constr_t *elems[4] = { &D, &C, &B, &A };
+  struct constr_t X = CONSTRAINT_ALLDIFF(4, elems);
+
+  // A, B and C use up the values 1 to 3 in turn
+  MockProxy = new Mock();
+  EXPECT_EQ(2, propagate_alldiff(&X, VALUE(1), NULL));
+  EXPECT_EQ(VALUE(3), A.constr.term.val);
+  EXPECT_EQ(VALUE(2), B.constr.term.val);
+  EXPECT_EQ(VALUE(1), C.constr.term.val);
+  EXPECT_EQ(INTERVAL(0, 9), D.constr.term.val);
+  delete(MockProxy);
+}
+
+TEST(PropagateAlldiff, Error) {
+  struct constr_t A = CONSTRAINT_TERM(INTERVAL(1, 2));
+  struct constr_t B = CONSTRAINT_TERM(INTERVAL(1, 2));
+  struct constr_t C = CONSTRAINT_TERM(INTERVAL(2, 2));
+  struct constr_t *elems[3] = { &A, &B, &C };
+  struct constr_t X = CONSTRAINT_ALLDIFF(3, elems);
+
+  // three sub-expressions cannot take two values
+  MockProxy = new Mock();
+  EXPECT_EQ(PROP_ERROR, propagate_alldiff(&X, VALUE(1), NULL));
+  delete(MockProxy);
+
+  MockProxy = new Mock();
+  EXPECT_EQ(PROP_NONE, propagate_alldiff(&X, VALUE(0), NULL));
+  delete(MockProxy);
+
+  // fail if different values must be the same
+  A.constr.term.val = VALUE(0);
+  B.constr.term.val = VALUE(1);
+  eval_invalidate();
+  MockProxy = new Mock();
+  EXPECT_EQ(PROP_ERROR, propagate_alldiff(&X, VALUE(0), NULL));
+  EXPECT_EQ(PROP_NONE, propagate_alldiff(&X, INTERVAL(0, 1), NULL));
+  delete(MockProxy);
+}
+
+TEST(PropagateDisj, EdgeFinding) {
+  struct constr_t A = CONSTRAINT_TERM(INTERVAL(0, 10));
+  struct constr_t B = CONSTRAINT_TERM(INTERVAL(0, 2));
+  struct constr_t C = CONSTRAINT_TERM(INTERVAL(0, 2));
+  struct constr_t K2 = CONSTRAINT_TERM(VALUE(2));
+  struct constr_t K3 = CONSTRAINT_TERM(VALUE(3));
+  struct sched_task_t tasks[3] = { { &A, &K3, NULL }, { &B, &K2, NULL }, { &C, &K2, NULL } };
+  struct constr_t X = CONSTRAINT_DISJ(3, tasks);
+
+  // B and C fill up the time until A may start
+  MockProxy = new Mock();
+  EXPECT_EQ(1, propagate_disj(&X, VALUE(1), NULL));
+  EXPECT_EQ(INTERVAL(4, 10), A.constr.term.val);
+  EXPECT_EQ(INTERVAL(0, 2), B.constr.term.val);
+  EXPECT_EQ(INTERVAL(0, 2), C.constr.term.val);
+  delete(MockProxy);
+
+  MockProxy = new Mock();
+  EXPECT_EQ(PROP_NONE, propagate_disj(&X, VALUE(1), NULL));
+  delete(MockProxy);
+}
+
+TEST(PropagateDisj, NotLast) {
+  struct constr_t A = CONSTRAINT_TERM(INTERVAL(0, 5));
+  struct constr_t B = CONSTRAINT_TERM(INTERVAL(2, 3));
+  struct constr_t K2 = CONSTRAINT_TERM(VALUE(2));
+  struct constr_t K4 = CONSTRAINT_TERM(VALUE(4));
+  struct sched_task_t tasks[2] = { { &A, &K2, NULL }, { &B, &K4, NULL } };
+  struct constr_t X = CONSTRAINT_DISJ(2, tasks);
+
+  // A cannot come after B and must end before B starts
+  MockProxy = new Mock();
+  EXPECT_EQ(1, propagate_disj(&X, VALUE(1), NULL));
+  EXPECT_EQ(INTERVAL(0, 1), A.constr.term.val);
+  EXPECT_EQ(INTERVAL(2, 3), B.constr.term.val);
+  delete(MockProxy);
+}
+
+TEST(PropagateDisj, Error) {
+  struct constr_t A = CONSTRAINT_TERM(INTERVAL(0, 2));
+  struct constr_t B = CONSTRAINT_TERM(INTERVAL(0, 2));
+  struct constr_t C = CONSTRAINT_TERM(INTERVAL(0, 2));
+  struct constr_t K2 = CONSTRAINT_TERM(VALUE(2));
+  struct sched_task_t tasks[3] = { { &A, &K2, NULL }, { &B, &K2, NULL }, { &C, &K2, NULL } };
+  struct constr_t X = CONSTRAINT_DISJ(3, tasks);
+
+  // three tasks do not fit into four time units
+  MockProxy = new Mock();
+  EXPECT_EQ(PROP_ERROR, propagate_disj(&X, VALUE(1), NULL));
+  EXPECT_EQ(PROP_NONE, propagate_disj(&X, VALUE(0), NULL));
+  delete(MockProxy);
+
+  // fail if tasks cannot overlap
+  A.constr.term.val = VALUE(0);
+  B.constr.term.val = VALUE(2);
+  C.constr.term.val = VALUE(4);
+  eval_invalidate();
+  MockProxy = new Mock();
+  EXPECT_EQ(PROP_ERROR, propagate_disj(&X, VALUE(0), NULL));
+  EXPECT_EQ(PROP_NONE, propagate_disj(&X, INTERVAL(0, 1), NULL));
+  delete(MockProxy);
+}
+
+TEST(PropagateCumul, TimeTable) {
+  struct constr_t A = CONSTRAINT_TERM(VALUE(0));
+  struct constr_t B = CONSTRAINT_TERM(INTERVAL(0, 5));
+  struct constr_t C = CONSTRAINT_TERM(INTERVAL(0, 6));
+  struct constr_t K1 = CONSTRAINT_TERM(VALUE(1));
+  struct constr_t K2 = CONSTRAINT_TERM(VALUE(2));
+  struct constr_t K3 = CONSTRAINT_TERM(VALUE(3));
+  struct sched_task_t tasks[3] = { { &A, &K3, &K2 }, { &B, &K2, &K1 }, { &C, &K2, &K2 } };
+  struct constr_t X = CONSTRAINT_CUMUL(3, tasks, &K2);
+
+  // B and C cannot run while A uses up the resource
+  MockProxy = new Mock();
+  EXPECT_EQ(2, propagate_cumul(&X, VALUE(1), NULL));
+  EXPECT_EQ(VALUE(0), A.constr.term.val);
+  EXPECT_EQ(INTERVAL(3, 5), B.constr.term.val);
+  EXPECT_EQ(INTERVAL(3, 6), C.constr.term.val);
+  delete(MockProxy);
+
+  // with B fixed, C must run before or after B
+  B.constr.term.val = VALUE(4);
+  eval_invalidate();
+  MockProxy = new Mock();
+  EXPECT_EQ(1, propagate_cumul(&X, VALUE(1), NULL));
+  EXPECT_EQ(VALUE(6), C.constr.term.val);
+  delete(MockProxy);
+}
+
+TEST(PropagateCumul, Error) {
+  struct constr_t A = CONSTRAINT_TERM(INTERVAL(0, 2));
+  struct constr_t B = CONSTRAINT_TERM(INTERVAL(0, 2));
+  struct constr_t C = CONSTRAINT_TERM(INTERVAL(0, 2));
+  struct constr_t K2 = CONSTRAINT_TERM(VALUE(2));
+  struct constr_t K3 = CONSTRAINT_TERM(VALUE(3));
+  struct sched_task_t tasks[3] = { { &A, &K2, &K2 }, { &B, &K2, &K2 }, { &C, &K2, &K2 } };
+  struct constr_t X = CONSTRAINT_CUMUL(3, tasks, &K2);
+
+  // the tasks need more energy than available until they must end
+  MockProxy = new Mock();
+  EXPECT_EQ(PROP_ERROR, propagate_cumul(&X, VALUE(1), NULL));
+  delete(MockProxy);
+
+  // a task needs more than the capacity
+  X = CONSTRAINT_CUMUL(1, tasks, &K3);
+  tasks[0].demand = &K3;
+  tasks[0].dur = &K3;
+  MockProxy = new Mock();
+  EXPECT_EQ(PROP_NONE, propagate_cumul(&X, VALUE(1), NULL));
+  delete(MockProxy);
+  X = CONSTRAINT_CUMUL(1, tasks, &K2);
+  MockProxy = new Mock();
+  EXPECT_EQ(PROP_ERROR, propagate_cumul(&X, VALUE(1), NULL));
+  delete(MockProxy);
+}
+
 TEST(PropagateWand, Basic) {
   struct constr_t A = CONSTRAINT_TERM(VALUE(0));
   struct constr_t B = CONSTRAINT_TERM(VALUE(1));
@@ -1154,6 +1600,158 @@ TEST(PropagateConfl, DomainMax) {
   delete(MockProxy);
 }
 
+TEST(PropagateConfl, Bounds) {
+  struct constr_t A = CONSTRAINT_TERM(VALUE(2));
+  struct env_t e = { .key = NULL, .val = &A, .binds = NULL,
+                     .clauses = { .length = 0, .elems = NULL },
+                     .order = 0, .prio = 0, .level = 0 };
+  A.constr.term.env = &e;
+
+  struct constr_t B = CONSTRAINT_TERM(INTERVAL(0, 9));
+  struct env_t f = { .key = NULL, .val = &B, .binds = NULL,
+                     .clauses = { .length = 0, .elems = NULL },
+                     .order = 0, .prio = 0, .level = 0 };
+  B.constr.term.env = &f;
+
+  struct confl_elem_t E [2] = { { .val = INTERVAL(1, 5), .var = &A },
+                                { .val = INTERVAL(DOMAIN_MIN, 3), .var = &B } };
+  struct constr_t X = CONSTRAINT_CONFL(2, E);
+
+  MockProxy = new Mock();
+  EXPECT_CALL(*MockProxy, bind(&f, INTERVAL(4, 9), NULL)).Times(1);
+  EXPECT_EQ(1, propagate_confl(&X, VALUE(1), NULL));
+  delete(MockProxy);
+
+  // the remaining literal is excluded from the lower bound
+  E[1].val = INTERVAL(0, 3);
+  MockProxy = new Mock();
+  EXPECT_CALL(*MockProxy, bind(&f, INTERVAL(4, 9), NULL)).Times(1);
+  EXPECT_EQ(1, propagate_confl(&X, VALUE(1), NULL));
+  delete(MockProxy);
+
+  // the remaining literal is excluded from the upper bound
+  E[1].val = INTERVAL(6, DOMAIN_MAX);
+  MockProxy = new Mock();
+  EXPECT_CALL(*MockProxy, bind(&f, INTERVAL(0, 5), NULL)).Times(1);
+  EXPECT_EQ(1, propagate_confl(&X, VALUE(1), NULL));
+  delete(MockProxy);
+
+  // values inside the domain cannot be excluded
+  E[1].val = INTERVAL(3, 5);
+  MockProxy = new Mock();
+  EXPECT_EQ(PROP_NONE, propagate_confl(&X, VALUE(1), NULL));
+  delete(MockProxy);
+
+  // no propagation if one literal does not hold
+  E[0].val = INTERVAL(3, DOMAIN_MAX);
+  E[1].val = INTERVAL(DOMAIN_MIN, 3);
+  MockProxy = new Mock();
+  EXPECT_EQ(PROP_NONE, propagate_confl(&X, VALUE(1), NULL));
+  delete(MockProxy);
+
+  // fail if all literals hold
+  E[0].val = INTERVAL(DOMAIN_MIN, 2);
+  E[1].val = INTERVAL(DOMAIN_MIN, 9);
+  MockProxy = new Mock();
+  EXPECT_CALL(*MockProxy, strategy_var_order_update(&e)).Times(1);
+  EXPECT_CALL(*MockProxy, strategy_create_conflicts()).Times(1).WillOnce(::testing::Return(false));
+  EXPECT_EQ(PROP_ERROR, propagate_confl(&X, VALUE(1), NULL));
+  delete(MockProxy);
+}
+
+TEST(PropagateWatch, Basic) {
+  struct constr_t A = CONSTRAINT_TERM(INTERVAL(0, 1));
+  struct env_t e = { .key = NULL, .val = &A, .binds = NULL,
+                     .clauses = { .length = 0, .elems = NULL },
+                     .order = 0, .prio = 0, .level = 0 };
+  A.constr.term.env = &e;
+
+  struct constr_t B = CONSTRAINT_TERM(INTERVAL(0, 9));
+  struct env_t f = { .key = NULL, .val = &B, .binds = NULL,
+                     .clauses = { .length = 0, .elems = NULL },
+                     .order = 0, .prio = 0, .level = 0 };
+  B.constr.term.env = &f;
+
+  struct confl_elem_t E [3] = { { .val = INTERVAL(1, DOMAIN_MAX), .var = &A },
+                                { .val = INTERVAL(DOMAIN_MIN, 3), .var = &B },
+                                { .val = INTERVAL(0, 0), .var = &A } };
+  struct constr_t X = CONSTRAINT_CONFL(3, E);
+  struct wand_expr_t w = { .constr = &X, .orig = &X, .prop_tag = 0 };
+
+  MockProxy = new Mock();
+  EXPECT_CALL(*MockProxy, clause_list_append(&e.watches, &w, PROP_EVENT_LB)).Times(1);
+  EXPECT_CALL(*MockProxy, clause_list_append(&f.watches, &w, PROP_EVENT_UB)).Times(1);
+  propagate_watch(&w);
+  delete(MockProxy);
+}
+
+TEST(PropagateWatches, Basic) {
+  struct constr_t A = CONSTRAINT_TERM(VALUE(1));
+  struct env_t e = { .key = NULL, .val = &A, .binds = NULL,
+                     .clauses = { .length = 0, .elems = NULL },
+                     .order = 0, .prio = 0, .level = 0 };
+  A.constr.term.env = &e;
+
+  struct constr_t B = CONSTRAINT_TERM(INTERVAL(0, 1));
+  struct env_t f = { .key = NULL, .val = &B, .binds = NULL,
+                     .clauses = { .length = 0, .elems = NULL },
+                     .order = 0, .prio = 0, .level = 0 };
+  B.constr.term.env = &f;
+
+  struct constr_t C = CONSTRAINT_TERM(INTERVAL(0, 1));
+  struct env_t g = { .key = NULL, .val = &C, .binds = NULL,
+                     .clauses = { .length = 0, .elems = NULL },
+                     .order = 0, .prio = 0, .level = 0 };
+  C.constr.term.env = &g;
+
+  struct confl_elem_t E [3] = { { .val = INTERVAL(1, DOMAIN_MAX), .var = &A },
+                                { .val = INTERVAL(1, DOMAIN_MAX), .var = &B },
+                                { .val = INTERVAL(1, DOMAIN_MAX), .var = &C } };
+  struct constr_t X = CONSTRAINT_CONFL(3, E);
+  struct wand_expr_t w = { .constr = &X, .orig = &X, .prop_tag = 0 };
+  struct wand_expr_t *elems [1] = { &w };
+  prop_event_t events [1] = { PROP_EVENT_LB };
+  e.watches = { .length = 1, .elems = elems, .events = events, .dead = 0 };
+
+  // changes that cannot make the watched element true are ignored
+  MockProxy = new Mock();
+  EXPECT_EQ(PROP_NONE, propagate_watches(&e, PROP_EVENT_UB));
+  delete(MockProxy);
+
+  // nothing to do while the other watched element is false
+  B.constr.term.val = VALUE(0);
+  MockProxy = new Mock();
+  EXPECT_EQ(PROP_NONE, propagate_watches(&e, PROP_EVENT_LB));
+  delete(MockProxy);
+
+  // infer the other watched element if no other element is left
+  B.constr.term.val = INTERVAL(0, 1);
+  C.constr.term.val = VALUE(1);
+  MockProxy = new Mock();
+  EXPECT_CALL(*MockProxy, bind(&f, VALUE(0), &w)).Times(1);
+  EXPECT_EQ(1, propagate_watches(&e, PROP_EVENT_LB));
+  delete(MockProxy);
+
+  // fail if the other watched element is true as well
+  B.constr.term.val = VALUE(1);
+  MockProxy = new Mock();
+  EXPECT_CALL(*MockProxy, strategy_var_order_update(&e)).Times(1);
+  EXPECT_CALL(*MockProxy, strategy_create_conflicts()).Times(1).WillOnce(::testing::Return(false));
+  EXPECT_EQ(PROP_ERROR, propagate_watches(&e, PROP_EVENT_LB));
+  delete(MockProxy);
+
+  // move the watch to another element
+  B.constr.term.val = INTERVAL(0, 1);
+  C.constr.term.val = INTERVAL(0, 1);
+  MockProxy = new Mock();
+  EXPECT_CALL(*MockProxy, clause_list_append(&g.watches, &w, PROP_EVENT_LB)).Times(1);
+  EXPECT_CALL(*MockProxy, clause_list_remove(&e.watches, 0)).Times(1);
+  EXPECT_EQ(PROP_NONE, propagate_watches(&e, PROP_EVENT_LB));
+  EXPECT_EQ(&C, E[0].var);
+  EXPECT_EQ(&A, E[2].var);
+  delete(MockProxy);
+}
+
 TEST(Propagate, Loop) {
   struct constr_t A = CONSTRAINT_TERM(VALUE(0));
   struct constr_t B = CONSTRAINT_TERM(VALUE(1));
@@ -1165,4 +1763,456 @@ TEST(Propagate, Loop) {
   delete(MockProxy);
 }
 
+prop_event_t test_bind(struct env_t *var, const struct val_t val, const struct wand_expr_t *clause) {
+  struct val_t prev = var->val->constr.term.val;
+  var->val->constr.term.val = val;
+  return (get_lo(val) > get_lo(prev) ? PROP_EVENT_LB : 0) |
+    (get_hi(val) < get_hi(prev) ? PROP_EVENT_UB : 0) |
+    (is_value(val) && !is_value(prev) ? PROP_EVENT_FIX : 0);
+}
+
+TEST(PropagateQueue, Cheap) {
+  struct constr_t A = CONSTRAINT_TERM(INTERVAL(0, 1));
+  struct constr_t B = CONSTRAINT_TERM(INTERVAL(0, 1));
+  struct constr_t X = CONSTRAINT_EXPR(LT, &A, &B);
+  struct constr_t Y = CONSTRAINT_EXPR(NEG, &A, NULL);
+  struct constr_t Z = CONSTRAINT_EXPR(NOT, &X, NULL);
+  struct constr_t U = CONSTRAINT_EXPR(ADD, &A, &B);
+  struct constr_t V = CONSTRAINT_EXPR(EQ, &U, &B);
+  struct wand_expr_t elems[1] = { { &X, &X, 0 } };
+  struct constr_t W = CONSTRAINT_WAND(1, elems);
+  struct confl_elem_t celems[1] = { { VALUE(0), &A } };
+  struct constr_t C = CONSTRAINT_CONFL(1, celems);
+
+  EXPECT_TRUE(propagate_cheap(&X));
+  EXPECT_TRUE(propagate_cheap(&Y));
+  EXPECT_TRUE(propagate_cheap(&Z));
+  EXPECT_TRUE(propagate_cheap(&C));
+  EXPECT_FALSE(propagate_cheap(&V));
+  EXPECT_FALSE(propagate_cheap(&W));
+}
+
+TEST(PropagateQueue, Grow) {
+  const size_t count = 3 * PROP_QUEUE_SIZE_INIT;
+  struct env_t e[count];
+  struct prop_queue_t queue = { .elems = NULL, .size = 0, .head = 0, .tail = 0 };
+  struct prop_entry_t entry;
+
+  // wrap around before growing the queue
+  for (size_t i = 0; i < PROP_QUEUE_SIZE_INIT / 2; i++) {
+    propagate_enqueue(&queue, NULL, &e[i]);
+    EXPECT_TRUE(propagate_dequeue(&queue, &entry));
+  }
+  for (size_t i = 0; i < count; i++) {
+    propagate_enqueue(&queue, NULL, &e[i]);
+  }
+  EXPECT_EQ(4U * PROP_QUEUE_SIZE_INIT, queue.size);
+  for (size_t i = 0; i < count; i++) {
+    EXPECT_TRUE(propagate_dequeue(&queue, &entry));
+    EXPECT_EQ(&e[i], entry.var);
+  }
+  EXPECT_FALSE(propagate_dequeue(&queue, &entry));
+  free(queue.elems);
+}
+
+TEST(PropagateQueue, Changed) {
+  struct env_t e = { .key = NULL, .val = NULL, .binds = NULL,
+                     .clauses = { .length = 0, .elems = NULL, .events = NULL },
+                     .order = 0, .prio = 0, .level = 0, .prop_tag = 0, .prop_events = 0 };
+  struct prop_entry_t entry;
+
+  MockProxy = new Mock();
+  EXPECT_CALL(*MockProxy, strategy_prop_order())
+    .WillRepeatedly(testing::Return(PROP_ORDER_FIFO));
+  propagate_start();
+  // variables are queued only once, but remember their latest change
+  // and all events since they were queued
+  propagate_changed(&e, PROP_EVENT_LB);
+  prop_tag_t tag = e.prop_tag;
+  EXPECT_EQ(PROP_EVENT_LB, e.prop_events);
+  propagate_changed(&e, PROP_EVENT_UB | PROP_EVENT_FIX);
+  EXPECT_LT(tag, e.prop_tag);
+  EXPECT_EQ(PROP_EVENT_ANY, e.prop_events);
+  EXPECT_TRUE(propagate_dequeue(&_prop_queue[PROP_QUEUE_VARS], &entry));
+  EXPECT_EQ(&e, entry.var);
+  EXPECT_FALSE(propagate_dequeue(&_prop_queue[PROP_QUEUE_VARS], &entry));
+  e.prop_tag = 0;
+
+  // starting a new run drops variables that are still queued
+  propagate_changed(&e, PROP_EVENT_LB);
+  EXPECT_EQ(PROP_EVENT_LB, e.prop_events);
+  propagate_start();
+  EXPECT_EQ(0U, e.prop_tag);
+  EXPECT_EQ(0U, e.prop_events);
+  EXPECT_FALSE(propagate_dequeue(&_prop_queue[PROP_QUEUE_VARS], &entry));
+  delete(MockProxy);
+
+  propagate_free();
+}
+
+TEST(PropagateClauses, Fixpoint) {
+  struct constr_t A = CONSTRAINT_TERM(INTERVAL(0, 2));
+  struct constr_t B = CONSTRAINT_TERM(INTERVAL(0, 2));
+  struct constr_t C = CONSTRAINT_TERM(INTERVAL(0, 2));
+  struct constr_t X = CONSTRAINT_EXPR(LT, &A, &B);
+  struct constr_t Y = CONSTRAINT_EXPR(LT, &B, &C);
+  struct wand_expr_t cx = { &X, &X, 0 };
+  struct wand_expr_t cy = { &Y, &Y, 0 };
+  struct wand_expr_t *la[1] = { &cx };
+  struct wand_expr_t *lb[2] = { &cx, &cy };
+  struct wand_expr_t *lc[1] = { &cy };
+  prop_event_t va[1] = { PROP_EVENT_LB };
+  prop_event_t vb[2] = { PROP_EVENT_UB, PROP_EVENT_LB };
+  prop_event_t vc[1] = { PROP_EVENT_UB };
+  struct env_t e[3] = {
+    { .key = NULL, .val = &A, .binds = NULL, .clauses = { 1, la, va }, .order = 0, .prio = 0, .level = 0 },
+    { .key = NULL, .val = &B, .binds = NULL, .clauses = { 2, lb, vb }, .order = 0, .prio = 0, .level = 0 },
+    { .key = NULL, .val = &C, .binds = NULL, .clauses = { 1, lc, vc }, .order = 0, .prio = 0, .level = 0 } };
+  A.constr.term.env = &e[0];
+  B.constr.term.env = &e[1];
+  C.constr.term.env = &e[2];
+
+  MockProxy = new Mock();
+  EXPECT_CALL(*MockProxy, strategy_prop_order())
+    .WillRepeatedly(testing::Return(PROP_ORDER_FIFO));
+  EXPECT_CALL(*MockProxy, objective_poll())
+    .WillRepeatedly(testing::Return(false));
+  EXPECT_CALL(*MockProxy, conflict_reset()).Times(1);
+  EXPECT_CALL(*MockProxy, bind(testing::_, testing::_, testing::_))
+    .WillRepeatedly(testing::Invoke(test_bind));
+  EXPECT_CALL(*MockProxy, normal_lt(testing::_))
+    .WillRepeatedly(testing::ReturnArg<0>());
+  EXPECT_LT(0, propagate_clauses(&e[0]));
+  EXPECT_EQ(VALUE(0), A.constr.term.val);
+  EXPECT_EQ(VALUE(1), B.constr.term.val);
+  EXPECT_EQ(VALUE(2), C.constr.term.val);
+  delete(MockProxy);
+
+  propagate_free();
+}
+
+TEST(PropagateClauses, Deferred) {
+  struct constr_t A = CONSTRAINT_TERM(INTERVAL(0, 3));
+  struct constr_t B = CONSTRAINT_TERM(INTERVAL(0, 4));
+  struct constr_t K = CONSTRAINT_TERM(VALUE(1));
+  struct constr_t X = CONSTRAINT_EXPR(LT, &K, &A);
+  struct constr_t U = CONSTRAINT_EXPR(ADD, &A, &K);
+  struct constr_t Y = CONSTRAINT_EXPR(LT, &U, &B);
+  struct wand_expr_t cx = { &X, &X, 0 };
+  struct wand_expr_t cy = { &Y, &Y, 0 };
+  struct wand_expr_t *la[2] = { &cy, &cx };
+  struct wand_expr_t *lb[1] = { &cy };
+  prop_event_t va[2] = { PROP_EVENT_LB, PROP_EVENT_UB };
+  prop_event_t vb[1] = { PROP_EVENT_UB };
+  struct env_t e[2] = {
+    { .key = NULL, .val = &A, .binds = NULL, .clauses = { 2, la, va }, .order = 0, .prio = 0, .level = 0 },
+    { .key = NULL, .val = &B, .binds = NULL, .clauses = { 1, lb, vb }, .order = 0, .prio = 0, .level = 0 } };
+  A.constr.term.env = &e[0];
+  B.constr.term.env = &e[1];
+
+  // the expensive clause is propagated after the cheap one
+  MockProxy = new Mock();
+  EXPECT_CALL(*MockProxy, strategy_prop_order())
+    .WillRepeatedly(testing::Return(PROP_ORDER_CHEAP_FIRST));
+  EXPECT_CALL(*MockProxy, objective_poll())
+    .WillRepeatedly(testing::Return(false));
+  EXPECT_CALL(*MockProxy, conflict_reset()).Times(1);
+  EXPECT_CALL(*MockProxy, bind(testing::_, testing::_, testing::_))
+    .WillRepeatedly(testing::Invoke(test_bind));
+  EXPECT_CALL(*MockProxy, normal_lt(testing::_))
+    .WillRepeatedly(testing::ReturnArg<0>());
+  EXPECT_LT(0, propagate_clauses(&e[0]));
+  EXPECT_EQ(VALUE(2), A.constr.term.val);
+  EXPECT_EQ(VALUE(4), B.constr.term.val);
+  EXPECT_NE(PROP_TAG_DEFERRED, cy.prop_tag);
+  delete(MockProxy);
+
+  propagate_free();
+}
+
+TEST(PropagateClauses, Error) {
+  struct constr_t A = CONSTRAINT_TERM(INTERVAL(0, 2));
+  struct constr_t B = CONSTRAINT_TERM(INTERVAL(0, 2));
+  struct constr_t X = CONSTRAINT_EXPR(LT, &A, &B);
+  struct constr_t Y = CONSTRAINT_EXPR(LT, &B, &A);
+  struct wand_expr_t cx = { &X, &X, 0 };
+  struct wand_expr_t cy = { &Y, &Y, 0 };
+  struct wand_expr_t *l[2] = { &cx, &cy };
+  prop_event_t v[2] = { PROP_EVENT_ANY, PROP_EVENT_ANY };
+  struct env_t e[2] = {
+    { .key = NULL, .val = &A, .binds = NULL, .clauses = { 2, l, v }, .order = 0, .prio = 0, .level = 0 },
+    { .key = NULL, .val = &B, .binds = NULL, .clauses = { 2, l, v }, .order = 0, .prio = 0, .level = 0 } };
+  A.constr.term.env = &e[0];
+  B.constr.term.env = &e[1];
+
+  MockProxy = new Mock();
+  EXPECT_CALL(*MockProxy, strategy_prop_order())
+    .WillRepeatedly(testing::Return(PROP_ORDER_FIFO));
+  EXPECT_CALL(*MockProxy, objective_poll())
+    .WillRepeatedly(testing::Return(false));
+  EXPECT_CALL(*MockProxy, conflict_reset()).Times(1);
+  EXPECT_CALL(*MockProxy, strategy_create_conflicts())
+    .WillRepeatedly(testing::Return(false));
+  EXPECT_CALL(*MockProxy, strategy_var_order_update(testing::_))
+    .Times(testing::AtLeast(1));
+  EXPECT_CALL(*MockProxy, bind(testing::_, testing::_, testing::_))
+    .WillRepeatedly(testing::Invoke(test_bind));
+  EXPECT_CALL(*MockProxy, normal_lt(testing::_))
+    .WillRepeatedly(testing::ReturnArg<0>());
+  EXPECT_EQ(PROP_ERROR, propagate_clauses(&e[0]));
+  EXPECT_LT(0, e[0].prio + e[1].prio);
+
+  // variables left over from the failed run are not propagated
+  struct prop_entry_t entry;
+  propagate_start();
+  EXPECT_FALSE(propagate_dequeue(&_prop_queue[PROP_QUEUE_VARS], &entry));
+  EXPECT_EQ(0U, e[0].prop_tag);
+  EXPECT_EQ(0U, e[1].prop_tag);
+  delete(MockProxy);
+
+  propagate_free();
+}
+
+TEST(PropagateClauses, Poll) {
+  struct constr_t A = CONSTRAINT_TERM(INTERVAL(0, 2));
+  struct constr_t B = CONSTRAINT_TERM(INTERVAL(0, 2));
+  struct constr_t X = CONSTRAINT_EXPR(LT, &A, &B);
+  struct wand_expr_t cx = { &X, &X, 0 };
+  struct wand_expr_t *l[1] = { &cx };
+  prop_event_t v[1] = { PROP_EVENT_ANY };
+  struct env_t e = { .key = NULL, .val = &A, .binds = NULL, .clauses = { 1, l, v },
+                     .order = 0, .prio = 0, .level = 0 };
+  A.constr.term.env = &e;
+
+  MockProxy = new Mock();
+  EXPECT_CALL(*MockProxy, strategy_prop_order())
+    .WillRepeatedly(testing::Return(PROP_ORDER_FIFO));
+  EXPECT_CALL(*MockProxy, objective_poll())
+    .WillOnce(testing::Return(true));
+  EXPECT_CALL(*MockProxy, conflict_reset()).Times(1);
+  EXPECT_EQ(PROP_ERROR, propagate_clauses(&e));
+  delete(MockProxy);
+
+  propagate_free();
+}
+
+size_t test_patch(struct wand_expr_t *loc, struct constr_t *constr) {
+  loc->constr = constr;
+  return 0;
+}
+
+TEST(PropagateClauses, Entailed) {
+  struct constr_t A = CONSTRAINT_TERM(INTERVAL(0, 5));
+  struct constr_t B = CONSTRAINT_TERM(VALUE(4));
+  struct constr_t C = CONSTRAINT_TERM(INTERVAL(2, 5));
+  struct constr_t X = CONSTRAINT_EXPR(LT, &A, &B);
+  struct constr_t Y = CONSTRAINT_EXPR(LT, &A, &C);
+  struct wand_expr_t cx = { &X, &X, 0 };
+  struct wand_expr_t cy = { &Y, &Y, 0 };
+  struct wand_expr_t ce = { &_prop_entailed, &Y, 0 };
+  struct wand_expr_t *l[3] = { &ce, &cx, &cy };
+  prop_event_t v[3] = { PROP_EVENT_ANY, PROP_EVENT_ANY, PROP_EVENT_ANY };
+  struct env_t e = { .key = NULL, .val = &C, .binds = NULL, .clauses = { 3, l, v },
+                     .order = 0, .prio = 0, .level = 0 };
+  struct env_t f = { .key = NULL, .val = &A, .binds = NULL, .clauses = { 0, NULL, NULL },
+                     .order = 0, .prio = 0, .level = 0 };
+  A.constr.term.env = &f;
+  C.constr.term.env = &e;
+
+  // entailed clauses are dropped without propagating them, clauses
+  // that become entailed are marked and dropped as well
+  MockProxy = new Mock();
+  EXPECT_CALL(*MockProxy, strategy_prop_order())
+    .WillRepeatedly(testing::Return(PROP_ORDER_FIFO));
+  EXPECT_CALL(*MockProxy, objective_poll())
+    .WillRepeatedly(testing::Return(false));
+  EXPECT_CALL(*MockProxy, conflict_reset()).Times(1);
+  EXPECT_CALL(*MockProxy, bind(testing::_, testing::_, testing::_))
+    .WillRepeatedly(testing::Invoke(test_bind));
+  EXPECT_CALL(*MockProxy, patch(&cx, &_prop_entailed))
+    .WillOnce(testing::Invoke(test_patch));
+  EXPECT_CALL(*MockProxy, clause_list_drop(&e.clauses, 0)).Times(1);
+  EXPECT_CALL(*MockProxy, clause_list_drop(&e.clauses, 1)).Times(1);
+  EXPECT_LT(0, propagate_clauses(&e));
+  EXPECT_EQ(INTERVAL(0, 3), A.constr.term.val);
+  EXPECT_EQ(&_prop_entailed, cx.constr);
+  EXPECT_EQ(&Y, cy.constr);
+  delete(MockProxy);
+
+  propagate_free();
+}
+
+TEST(PropagateClauses, Objective) {
+  struct constr_t A = CONSTRAINT_TERM(INTERVAL(0, 5));
+  struct constr_t B = CONSTRAINT_TERM(VALUE(4));
+  struct constr_t C = CONSTRAINT_TERM(INTERVAL(2, 5));
+  struct constr_t X = CONSTRAINT_EXPR(LT, &A, &B);
+  struct wand_expr_t cx = { &X, &X, 0 };
+  struct wand_expr_t *l[1] = { &cx };
+  prop_event_t v[1] = { PROP_EVENT_ANY };
+  struct env_t e = { .key = NULL, .val = &C, .binds = NULL, .clauses = { 1, l, v },
+                     .order = 0, .prio = 0, .level = 0 };
+  struct env_t f = { .key = NULL, .val = &A, .binds = NULL, .clauses = { 0, NULL, NULL },
+                     .order = 0, .prio = 0, .level = 0 };
+  A.constr.term.env = &f;
+  C.constr.term.env = &e;
+
+  // clauses with the objective value are neither marked as entailed
+  // nor normalized, as its bound may change off the binding trail
+  MockProxy = new Mock();
+  _test_objective = &C;
+  EXPECT_CALL(*MockProxy, strategy_prop_order())
+    .WillRepeatedly(testing::Return(PROP_ORDER_FIFO));
+  EXPECT_CALL(*MockProxy, objective_poll())
+    .WillRepeatedly(testing::Return(false));
+  EXPECT_CALL(*MockProxy, conflict_reset()).Times(1);
+  EXPECT_CALL(*MockProxy, bind(testing::_, testing::_, testing::_))
+    .WillRepeatedly(testing::Invoke(test_bind));
+  EXPECT_CALL(*MockProxy, patch(testing::_, testing::_)).Times(0);
+  EXPECT_CALL(*MockProxy, normal_lt(testing::_)).Times(0);
+  EXPECT_CALL(*MockProxy, clause_list_drop(testing::_, testing::_)).Times(0);
+  EXPECT_LT(0, propagate_clauses(&e));
+  EXPECT_EQ(INTERVAL(0, 3), A.constr.term.val);
+  EXPECT_EQ(&X, cx.constr);
+  _test_objective = &_test_no_objective;
+  delete(MockProxy);
+
+  propagate_free();
+}
+
+TEST(PropagateClauses, Events) {
+  struct constr_t A = CONSTRAINT_TERM(INTERVAL(0, 2));
+  struct constr_t B = CONSTRAINT_TERM(INTERVAL(0, 2));
+  struct constr_t C = CONSTRAINT_TERM(INTERVAL(0, 2));
+  struct constr_t X = CONSTRAINT_EXPR(LT, &A, &B);
+  struct constr_t Y = CONSTRAINT_EXPR(LT, &C, &B);
+  struct wand_expr_t cx = { &X, &X, 0 };
+  struct wand_expr_t cy = { &Y, &Y, 0 };
+  struct wand_expr_t *la[1] = { &cx };
+  struct wand_expr_t *lb[2] = { &cx, &cy };
+  struct wand_expr_t *lc[1] = { &cy };
+  prop_event_t va[1] = { PROP_EVENT_LB };
+  prop_event_t vb[2] = { PROP_EVENT_UB, PROP_EVENT_UB };
+  prop_event_t vc[1] = { PROP_EVENT_LB };
+  struct env_t e[3] = {
+    { .key = NULL, .val = &A, .binds = NULL, .clauses = { 1, la, va }, .order = 0, .prio = 0, .level = 0 },
+    { .key = NULL, .val = &B, .binds = NULL, .clauses = { 2, lb, vb }, .order = 0, .prio = 0, .level = 0 },
+    { .key = NULL, .val = &C, .binds = NULL, .clauses = { 1, lc, vc }, .order = 0, .prio = 0, .level = 0 } };
+  A.constr.term.env = &e[0];
+  B.constr.term.env = &e[1];
+  C.constr.term.env = &e[2];
+
+  // raising the lower bound of B does not wake the clause on C
+  MockProxy = new Mock();
+  EXPECT_CALL(*MockProxy, strategy_prop_order())
+    .WillRepeatedly(testing::Return(PROP_ORDER_FIFO));
+  EXPECT_CALL(*MockProxy, objective_poll())
+    .WillRepeatedly(testing::Return(false));
+  EXPECT_CALL(*MockProxy, conflict_reset()).Times(1);
+  EXPECT_CALL(*MockProxy, bind(testing::_, testing::_, testing::_))
+    .WillRepeatedly(testing::Invoke(test_bind));
+  EXPECT_CALL(*MockProxy, normal_lt(testing::_))
+    .WillRepeatedly(testing::ReturnArg<0>());
+  EXPECT_LT(0, propagate_clauses(&e[0]));
+  EXPECT_EQ(INTERVAL(0, 1), A.constr.term.val);
+  EXPECT_EQ(INTERVAL(1, 2), B.constr.term.val);
+  EXPECT_EQ(INTERVAL(0, 2), C.constr.term.val);
+  EXPECT_EQ(0U, cy.prop_tag);
+  delete(MockProxy);
+
+  propagate_free();
+}
+
+TEST(PropagateDiff, Basic) {
+  struct constr_t A = CONSTRAINT_TERM(INTERVAL(0, 10));
+  struct constr_t B = CONSTRAINT_TERM(INTERVAL(0, 10));
+  struct constr_t X = CONSTRAINT_DIFF(&A, &B, -3);
+
+  // A + 3 <= B
+  MockProxy = new Mock();
+  EXPECT_EQ(2, propagate_diff(&X, VALUE(1), NULL));
+  EXPECT_EQ(INTERVAL(0, 7), A.constr.term.val);
+  EXPECT_EQ(INTERVAL(3, 10), B.constr.term.val);
+  EXPECT_EQ(PROP_NONE, propagate_diff(&X, VALUE(1), NULL));
+  EXPECT_EQ(PROP_NONE, propagate_diff(&X, INTERVAL(0, 1), NULL));
+  delete(MockProxy);
+
+  // B - A <= 2
+  A.constr.term.val = INTERVAL(0, 4);
+  B.constr.term.val = INTERVAL(5, 10);
+  MockProxy = new Mock();
+  EXPECT_EQ(2, propagate_diff(&X, VALUE(0), NULL));
+  EXPECT_EQ(INTERVAL(3, 4), A.constr.term.val);
+  EXPECT_EQ(INTERVAL(5, 6), B.constr.term.val);
+  delete(MockProxy);
+}
+
+TEST(PropagateDiff, Chain) {
+  struct constr_t A = CONSTRAINT_TERM(INTERVAL(2, 5));
+  struct constr_t B = CONSTRAINT_TERM(INTERVAL(2, 7));
+  struct constr_t C = CONSTRAINT_TERM(INTERVAL(5, 10));
+  struct constr_t X = CONSTRAINT_DIFF(&A, &B, -2);
+  struct constr_t Y = CONSTRAINT_DIFF(&B, &C, -3);
+  struct wand_expr_t cx = { &X, &X, 0 };
+  struct wand_expr_t cy = { &Y, &Y, 0 };
+  struct wand_expr_t *la[1] = { &cx };
+  struct wand_expr_t *lb[2] = { &cx, &cy };
+  struct wand_expr_t *lc[1] = { &cy };
+  prop_event_t va[1] = { PROP_EVENT_LB };
+  prop_event_t vb[2] = { PROP_EVENT_UB, PROP_EVENT_LB };
+  prop_event_t vc[1] = { PROP_EVENT_UB };
+  struct env_t e[3] = {
+    { .key = NULL, .val = &A, .binds = NULL, .clauses = { 1, la, va }, .order = 0, .prio = 0, .level = 0 },
+    { .key = NULL, .val = &B, .binds = NULL, .clauses = { 2, lb, vb }, .order = 0, .prio = 0, .level = 0 },
+    { .key = NULL, .val = &C, .binds = NULL, .clauses = { 1, lc, vc }, .order = 0, .prio = 0, .level = 0 } };
+  A.constr.term.env = &e[0];
+  B.constr.term.env = &e[1];
+  C.constr.term.env = &e[2];
+
+  // raising A moves B and C right away
+  MockProxy = new Mock();
+  EXPECT_CALL(*MockProxy, bind(&e[1], INTERVAL(4, 7), &cx))
+    .WillOnce(testing::Invoke(test_bind));
+  EXPECT_CALL(*MockProxy, bind(&e[2], INTERVAL(7, 10), &cy))
+    .WillOnce(testing::Invoke(test_bind));
+  EXPECT_EQ(2, propagate_diff(&X, VALUE(1), &cx));
+  EXPECT_EQ(INTERVAL(2, 5), A.constr.term.val);
+  EXPECT_EQ(INTERVAL(4, 7), B.constr.term.val);
+  EXPECT_EQ(INTERVAL(7, 10), C.constr.term.val);
+  delete(MockProxy);
+
+  propagate_free();
+}
+
+TEST(PropagateDiff, Cycle) {
+  struct constr_t A = CONSTRAINT_TERM(INTERVAL(0, 10));
+  struct constr_t B = CONSTRAINT_TERM(INTERVAL(0, 10));
+  struct constr_t X = CONSTRAINT_DIFF(&A, &B, -1);
+  struct constr_t Y = CONSTRAINT_DIFF(&B, &A, 0);
+  struct wand_expr_t cx = { &X, &X, 0 };
+  struct wand_expr_t cy = { &Y, &Y, 0 };
+  struct wand_expr_t *la[2] = { &cx, &cy };
+  struct wand_expr_t *lb[2] = { &cx, &cy };
+  prop_event_t va[2] = { PROP_EVENT_LB, PROP_EVENT_UB };
+  prop_event_t vb[2] = { PROP_EVENT_UB, PROP_EVENT_LB };
+  struct env_t e[2] = {
+    { .key = NULL, .val = &A, .binds = NULL, .clauses = { 2, la, va }, .order = 0, .prio = 0, .level = 0 },
+    { .key = NULL, .val = &B, .binds = NULL, .clauses = { 2, lb, vb }, .order = 0, .prio = 0, .level = 0 } };
+  A.constr.term.env = &e[0];
+  B.constr.term.env = &e[1];
+
+  // A < B <= A fails as soon as the walk comes back to A
+  MockProxy = new Mock();
+  EXPECT_CALL(*MockProxy, bind(testing::_, testing::_, testing::_))
+    .Times(3)
+    .WillRepeatedly(testing::Invoke(test_bind));
+  EXPECT_CALL(*MockProxy, strategy_var_order_update(&e[0]))
+    .Times(1);
+  EXPECT_EQ(PROP_ERROR, propagate_diff(&X, VALUE(1), &cx));
+  EXPECT_EQ(1, e[0].prio);
+  delete(MockProxy);
+
+  propagate_free();
+}
+
 } // end namespace
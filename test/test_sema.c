@@ -23,7 +23,8 @@ class Mock {
 
 Mock *MockProxy;
 
-size_t alloc_max;
+THREAD_LOCAL size_t alloc_max;
+THREAD_LOCAL uint64_t eval_epoch;
 
 void eval_cache_invalidate(void) {
   MockProxy->eval_cache_invalidate();
@@ -49,7 +50,7 @@ TEST(SemaInit, Basic) {
   sem_t sema;
   MockProxy = new Mock();
   EXPECT_CALL(*MockProxy, sem_init(&sema, 1, 1)).Times(1).WillOnce(::testing::Return(0));
-  sema_init(&sema);
+  sema_init(&sema, 1);
   delete(MockProxy);
 }
 
@@ -58,7 +59,7 @@ TEST(SemaInit, Error) {
   MockProxy = new Mock();
   EXPECT_CALL(*MockProxy, sem_init(&sema, 1, 1)).Times(1).WillOnce(::testing::Return(-1));
   EXPECT_CALL(*MockProxy, print_fatal("%s"));
-  sema_init(&sema);
+  sema_init(&sema, 1);
   delete(MockProxy);
 }
 
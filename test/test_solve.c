@@ -0,0 +1,212 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+extern "C" {
+#include "../src/libcsolve.h"
+}
+
+namespace solving {
+
+// solve models end to end through the library interface
+
+#define TEST_EXPR(H, T, L, R) csolve_constr(H, CONSTRAINT_EXPR(T, L, R))
+
+static struct constr_t *test_const(struct csolve_t *h, domain_t val) {
+  return csolve_constr(h, CONSTRAINT_TERM(VALUE(val)));
+}
+
+// build a <= b
+static struct constr_t *test_le(struct csolve_t *h, struct constr_t *a, struct constr_t *b) {
+  return TEST_EXPR(h, NOT, TEST_EXPR(h, LT, b, a), NULL);
+}
+
+// build a + d <= b
+static struct constr_t *test_before(struct csolve_t *h, struct constr_t *a, domain_t d, struct constr_t *b) {
+  return test_le(h, TEST_EXPR(h, ADD, a, test_const(h, d)), b);
+}
+
+// create a handle with a fixed strategy
+static struct csolve_t *test_handle(void) {
+  struct csolve_t *h = csolve_new(1);
+  struct strategy_t s = { .create_conflicts = true, .prefer_failing = true,
+                          .compute_weights = false, .restart_frequency = 0,
+                          .order = ORDER_SMALLEST_DOMAIN, .prop_order = PROP_ORDER_FIFO,
+                          .seed = 1 };
+  csolve_strategy(h, &s);
+  return h;
+}
+
+// remember the objective value of the last solution
+static void test_callback(size_t size, const struct env_t *env, domain_t objective, void *data) {
+  *(domain_t *)data = objective;
+}
+
+// result of an optimizing run
+struct test_result_t {
+  domain_t best; // objective value of the last solution
+  int count; // number of solutions
+};
+
+// count solutions and remember the last objective value, stop runaway
+// searches that keep finding "better" solutions
+static void test_count_callback(size_t size, const struct env_t *env, domain_t objective, void *data) {
+  struct test_result_t *r = (struct test_result_t *)data;
+  r->best = objective;
+  if (++r->count > 100) {
+    ADD_FAILURE() << "too many solutions";
+    abort();
+  }
+}
+
+TEST(Solve, Repeat) {
+  // schedule four tasks on one machine and minimize the makespan
+  const domain_t dur[4] = { 3, 2, 4, 1 };
+  struct csolve_t *h = test_handle();
+  struct constr_t *m = csolve_var(h, "m", 0, 20);
+  const char *keys[4] = { "t0", "t1", "t2", "t3" };
+  struct constr_t *t[4];
+  for (int i = 0; i < 4; i++) {
+    t[i] = csolve_var(h, keys[i], 0, 20);
+    csolve_add(h, test_before(h, t[i], dur[i], m));
+  }
+  for (int i = 0; i < 4; i++) {
+    for (int k = i + 1; k < 4; k++) {
+      csolve_add(h, TEST_EXPR(h, OR, test_before(h, t[i], dur[i], t[k]), test_before(h, t[k], dur[k], t[i])));
+    }
+  }
+  csolve_objective(h, OBJ_MIN, m);
+
+  // later runs must not inherit the bound of earlier ones
+  for (int run = 0; run < 3; run++) {
+    domain_t best = DOMAIN_MAX;
+    EXPECT_LT(0U, csolve_solve(h, test_callback, &best));
+    EXPECT_EQ(10, best);
+  }
+  csolve_free(h);
+}
+
+TEST(Solve, Optimize) {
+  // tightening the objective must wake the clause that contains it,
+  // even if that clause held before
+  for (enum objective_t o : { OBJ_MIN, OBJ_MAX }) {
+    struct csolve_t *h = csolve_new(1);
+    struct constr_t *x = csolve_var(h, "x", -2, -1);
+    struct constr_t *y = csolve_var(h, "y", -3, 1);
+    csolve_add(h, TEST_EXPR(h, LT, x, y));
+    csolve_objective(h, o, y);
+    struct test_result_t r = { 0, 0 };
+    EXPECT_LT(0U, csolve_solve(h, test_count_callback, &r));
+    EXPECT_EQ(o == OBJ_MIN ? -1 : 1, r.best);
+    csolve_free(h);
+  }
+}
+
+// count solutions
+static void test_all_callback(size_t size, const struct env_t *env, domain_t objective, void *data) {
+  (*(uint64_t *)data)++;
+}
+
+TEST(Solve, Assume) {
+  // three pigeons do not fit into two holes if x is set
+  struct csolve_t *h = test_handle();
+  struct constr_t *x = csolve_var(h, "x", 0, 1);
+  const char *keys[3][2] = { { "p00", "p01" }, { "p10", "p11" }, { "p20", "p21" } };
+  struct constr_t *p[3][2];
+  for (int i = 0; i < 3; i++) {
+    p[i][0] = csolve_var(h, keys[i][0], 0, 1);
+    p[i][1] = csolve_var(h, keys[i][1], 0, 1);
+    csolve_add(h, TEST_EXPR(h, OR, TEST_EXPR(h, NOT, x, NULL), TEST_EXPR(h, OR, p[i][0], p[i][1])));
+  }
+  for (int j = 0; j < 2; j++) {
+    for (int i = 0; i < 3; i++) {
+      for (int k = i + 1; k < 3; k++) {
+        csolve_add(h, TEST_EXPR(h, OR, TEST_EXPR(h, NOT, x, NULL),
+                                TEST_EXPR(h, OR, TEST_EXPR(h, NOT, p[i][j], NULL), TEST_EXPR(h, NOT, p[k][j], NULL))));
+      }
+    }
+  }
+  csolve_objective(h, OBJ_ALL, NULL);
+
+  // conflicts learned under the assumption must not prune the
+  // assignments with x = 0 afterwards
+  struct csolve_assumption_t a = { x, 1 };
+  uint64_t count = 0;
+  EXPECT_EQ(0U, csolve_solve_assuming(h, 1, &a, test_all_callback, &count));
+  EXPECT_EQ(0U, count);
+  EXPECT_EQ(64U, csolve_solve(h, test_all_callback, &count));
+  EXPECT_EQ(64U, count);
+  csolve_free(h);
+}
+
+TEST(Solve, ScopeInfeasible) {
+  // presolving an infeasible model leaves nothing to restore
+  struct csolve_t *h = test_handle();
+  struct constr_t *x = csolve_var(h, "x", 0, 0);
+  struct constr_t *y = csolve_var(h, "y", 0, 0);
+  csolve_add(h, TEST_EXPR(h, LT, x, y));
+  csolve_objective(h, OBJ_ALL, NULL);
+  csolve_push(h);
+  csolve_add(h, TEST_EXPR(h, LT, y, x));
+  uint64_t count = 0;
+  EXPECT_EQ(0U, csolve_solve(h, test_all_callback, &count));
+  csolve_pop(h);
+  EXPECT_EQ(0U, csolve_solve(h, test_all_callback, &count));
+  EXPECT_EQ(0U, count);
+  csolve_free(h);
+}
+
+TEST(Solve, Scope) {
+  // a constraint that contradicts the model after solving must be
+  // dropped with its scope
+  struct csolve_t *h = test_handle();
+  struct constr_t *x = csolve_var(h, "x", 0, 3);
+  struct constr_t *y = csolve_var(h, "y", 0, 3);
+  csolve_add(h, TEST_EXPR(h, LT, x, y));
+  csolve_objective(h, OBJ_ALL, NULL);
+  uint64_t count = 0;
+  EXPECT_EQ(6U, csolve_solve(h, test_all_callback, &count));
+  csolve_push(h);
+  csolve_add(h, TEST_EXPR(h, LT, y, x));
+  EXPECT_EQ(0U, csolve_solve(h, test_all_callback, &count));
+  csolve_pop(h);
+  EXPECT_EQ(6U, csolve_solve(h, test_all_callback, &count));
+  EXPECT_EQ(12U, count);
+  csolve_free(h);
+}
+
+// count solutions found by several workers
+static void test_atomic_callback(size_t size, const struct env_t *env, domain_t objective, void *data) {
+  __atomic_add_fetch((uint64_t *)data, 1, __ATOMIC_SEQ_CST);
+}
+
+TEST(Solve, Decompose) {
+  // workers may take all subproblems before the main worker starts,
+  // which must not search the whole problem on top of them
+  struct csolve_t *h = csolve_new(4);
+  struct constr_t *x = csolve_var(h, "x", 0, 3);
+  struct constr_t *y = csolve_var(h, "y", 0, 2);
+  csolve_add(h, TEST_EXPR(h, NOT, TEST_EXPR(h, EQ, x, y), NULL));
+  csolve_objective(h, OBJ_ALL, NULL);
+  strategy_eps_init(5);
+  for (int run = 0; run < 20; run++) {
+    uint64_t count = 0;
+    EXPECT_EQ(9U, csolve_solve(h, test_atomic_callback, &count));
+    EXPECT_EQ(9U, count);
+  }
+  csolve_free(h);
+
+  // wide domains are split into intervals
+  h = csolve_new(4);
+  x = csolve_var(h, "x", 0, 999);
+  y = csolve_var(h, "y", 0, 1);
+  csolve_add(h, TEST_EXPR(h, NOT, TEST_EXPR(h, EQ, x, y), NULL));
+  csolve_objective(h, OBJ_ALL, NULL);
+  strategy_eps_init(5);
+  uint64_t count = 0;
+  EXPECT_EQ(1998U, csolve_solve(h, test_atomic_callback, &count));
+  EXPECT_EQ(1998U, count);
+  strategy_eps_init(STRATEGY_EPS_DEFAULT);
+  csolve_free(h);
+}
+
+}
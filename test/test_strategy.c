@@ -102,6 +102,125 @@ TEST(Order, Init) {
   EXPECT_EQ(ORDER_LARGEST_VALUE, _order);
 }
 
+TEST(PropOrder, Init) {
+  strategy_prop_order_init(PROP_ORDER_FIFO);
+  EXPECT_EQ(PROP_ORDER_FIFO, _prop_order);
+  strategy_prop_order_init(PROP_ORDER_CHEAP_FIRST);
+  EXPECT_EQ(PROP_ORDER_CHEAP_FIRST, _prop_order);
+}
+
+TEST(PropOrder, Get) {
+  _prop_order = PROP_ORDER_FIFO;
+  EXPECT_EQ(PROP_ORDER_FIFO, strategy_prop_order());
+  _prop_order = PROP_ORDER_CHEAP_FIRST;
+  EXPECT_EQ(PROP_ORDER_CHEAP_FIRST, strategy_prop_order());
+}
+
+TEST(Portfolio, Init) {
+  strategy_portfolio_init(true);
+  EXPECT_EQ(true, _portfolio);
+  strategy_portfolio_init(false);
+  EXPECT_EQ(false, _portfolio);
+}
+
+TEST(Portfolio, Get) {
+  _portfolio = true;
+  EXPECT_EQ(true, strategy_portfolio());
+  _portfolio = false;
+  EXPECT_EQ(false, strategy_portfolio());
+}
+
+TEST(Eps, Init) {
+  strategy_eps_init(30);
+  EXPECT_EQ(30U, _eps);
+  strategy_eps_init(0);
+  EXPECT_EQ(0U, _eps);
+}
+
+TEST(Eps, Get) {
+  _eps = 17;
+  EXPECT_EQ(17U, strategy_eps());
+  _eps = 0;
+  EXPECT_EQ(0U, strategy_eps());
+}
+
+TEST(Strategy, GetSet) {
+  struct strategy_t s1 = { .create_conflicts = false, .prefer_failing = true,
+                           .compute_weights = false, .restart_frequency = 17,
+                           .order = ORDER_LARGEST_VALUE, .prop_order = PROP_ORDER_FIFO,
+                           .seed = 23 };
+  strategy_set(&s1);
+  EXPECT_EQ(false, _create_conflicts);
+  EXPECT_EQ(true, _prefer_failing);
+  EXPECT_EQ(false, _compute_weights);
+  EXPECT_EQ(17U, _restart_frequency);
+  EXPECT_EQ(ORDER_LARGEST_VALUE, _order);
+  EXPECT_EQ(PROP_ORDER_FIFO, _prop_order);
+  EXPECT_EQ(23U, _seed);
+
+  struct strategy_t s2;
+  strategy_get(&s2);
+  EXPECT_EQ(s1.create_conflicts, s2.create_conflicts);
+  EXPECT_EQ(s1.prefer_failing, s2.prefer_failing);
+  EXPECT_EQ(s1.compute_weights, s2.compute_weights);
+  EXPECT_EQ(s1.restart_frequency, s2.restart_frequency);
+  EXPECT_EQ(s1.order, s2.order);
+  EXPECT_EQ(s1.prop_order, s2.prop_order);
+  EXPECT_EQ(s1.seed, s2.seed);
+}
+
+TEST(Strategy, Diversify) {
+  struct strategy_t s = { .create_conflicts = true, .prefer_failing = true,
+                          .compute_weights = true, .restart_frequency = 100,
+                          .order = ORDER_NONE, .seed = 1 };
+
+  // first worker keeps settings
+  strategy_set(&s);
+  strategy_diversify(1);
+  EXPECT_EQ(true, _create_conflicts);
+  EXPECT_EQ(true, _prefer_failing);
+  EXPECT_EQ(100U, _restart_frequency);
+  EXPECT_EQ(ORDER_NONE, _order);
+  EXPECT_EQ(1U, _seed);
+
+  // other workers use different settings
+  strategy_set(&s);
+  strategy_diversify(2);
+  EXPECT_EQ(true, _create_conflicts);
+  EXPECT_EQ(true, _prefer_failing);
+  EXPECT_EQ(25U, _restart_frequency);
+  EXPECT_EQ(ORDER_SMALLEST_DOMAIN, _order);
+  EXPECT_EQ(2U, _seed);
+
+  strategy_set(&s);
+  strategy_diversify(3);
+  EXPECT_EQ(false, _create_conflicts);
+  EXPECT_EQ(400U, _restart_frequency);
+  EXPECT_EQ(ORDER_LARGEST_VALUE, _order);
+
+  strategy_set(&s);
+  strategy_diversify(7);
+  EXPECT_EQ(false, _prefer_failing);
+  EXPECT_EQ(ORDER_SMALLEST_DOMAIN, _order);
+
+  // disabled restarts stay disabled
+  s.restart_frequency = 0;
+  for (uint32_t id = 1; id < 8; id++) {
+    strategy_set(&s);
+    strategy_diversify(id);
+    EXPECT_EQ(0U, _restart_frequency);
+  }
+}
+
+TEST(Strategy, Rand) {
+  _seed = 17;
+  int r1 = strategy_rand();
+  int r2 = strategy_rand();
+  _seed = 17;
+  EXPECT_EQ(r1, strategy_rand());
+  EXPECT_EQ(r2, strategy_rand());
+}
+
 TEST(VarCmp, SmallestDomain) {
   _order = ORDER_SMALLEST_DOMAIN;
 
@@ -568,4 +687,74 @@ TEST(VarOrder, Update) {
   EXPECT_EQ(_var_order[2], &env[1]);
 }
 
+
+TEST(VarOrder, Remove) {
+  _order = ORDER_NONE;
+  _prefer_failing = true;
+
+  struct env_t env[3];
+
+  struct constr_t a = CONSTRAINT_TERM(INTERVAL(1, 27));
+  env[0] = { .key = "a", .val = &a, .binds = NULL,
+             .clauses = { .length = 0, .elems = NULL },
+             .order = SIZE_MAX, .prio = 3, .level = 0 };
+  struct constr_t b = CONSTRAINT_TERM(INTERVAL(3, 17));
+  env[1] = { .key = "b", .val = &b, .binds = NULL,
+             .clauses = { .length = 0, .elems = NULL },
+             .order = SIZE_MAX, .prio = 4, .level = 0 };
+  struct constr_t c = CONSTRAINT_TERM(INTERVAL(3, 17));
+  env[2] = { .key = "c", .val = &c, .binds = NULL,
+             .clauses = { .length = 0, .elems = NULL },
+             .order = SIZE_MAX, .prio = 5, .level = 0 };
+
+  _var_order_size = 0;
+  struct env_t *v[3];
+  _var_order = v;
+  strategy_var_order_push(&env[0]);
+  strategy_var_order_push(&env[1]);
+  strategy_var_order_push(&env[2]);
+
+  strategy_var_order_remove(&env[2]);
+  EXPECT_EQ(_var_order_size, 2);
+  EXPECT_EQ(env[2].order, SIZE_MAX);
+  EXPECT_EQ(_var_order[0], &env[1]);
+  EXPECT_EQ(_var_order[1], &env[0]);
+
+  strategy_var_order_remove(&env[2]);
+  EXPECT_EQ(_var_order_size, 2);
+
+  strategy_var_order_remove(&env[0]);
+  EXPECT_EQ(_var_order_size, 1);
+  EXPECT_EQ(_var_order[0], &env[1]);
+  EXPECT_EQ(env[1].order, 0);
+}
+
+TEST(VarOrder, Free) {
+  _order = ORDER_NONE;
+  _prefer_failing = true;
+
+  struct env_t env[2];
+
+  struct constr_t a = CONSTRAINT_TERM(INTERVAL(1, 27));
+  env[0] = { .key = "a", .val = &a, .binds = NULL,
+             .clauses = { .length = 0, .elems = NULL },
+             .order = SIZE_MAX, .prio = 3, .level = 0 };
+  struct constr_t b = CONSTRAINT_TERM(INTERVAL(3, 17));
+  env[1] = { .key = "b", .val = &b, .binds = NULL,
+             .clauses = { .length = 0, .elems = NULL },
+             .order = SIZE_MAX, .prio = 4, .level = 0 };
+
+  strategy_var_order_init(2, env);
+  strategy_var_order_pop();
+  strategy_var_order_free();
+  EXPECT_EQ(0U, _var_order_size);
+  EXPECT_EQ((struct env_t **)NULL, _var_order);
+  EXPECT_EQ(SIZE_MAX, env[0].order);
+  EXPECT_EQ(SIZE_MAX, env[1].order);
+
+  // updating variables after releasing the queue leaves them alone
+  strategy_var_order_update(&env[0]);
+  EXPECT_EQ(SIZE_MAX, env[0].order);
+}
+
 }